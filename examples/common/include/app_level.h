@@ -108,12 +108,10 @@
  * @param[in] _transition_cb        Callback for setting the application transition time and state value to given values.
 */
 #define APP_LEVEL_SERVER_DEF(_name, _force_segmented, _mic_size, _p_dtt, _set_cb, _get_cb, _transition_cb)  \
-    APP_TIMER_DEF(_name ## _timer); \
     static app_level_server_t _name =  \
     {  \
         .server.settings.force_segmented = _force_segmented,  \
         .server.settings.transmic_size = _mic_size,  \
-        .state.transition.timer.p_timer_id = &_name ## _timer,  \
         .p_dtt_ms = _p_dtt, \
         .level_set_cb = _set_cb,  \
         .level_get_cb = _get_cb,  \
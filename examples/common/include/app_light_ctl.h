@@ -113,12 +113,10 @@ typedef struct
  * @param[in] _light_ctl_transition_cb  Callback for setting the application transition time and state value to given values.
  */
 #define APP_LIGHT_CTL_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _light_ctl_set_cb, _light_ctl_get_cb, _light_ctl_transition_cb) \
-    APP_TIMER_DEF(_name ## _timer);                                           \
     static app_light_ctl_setup_server_t _name =                               \
     {                                                                         \
         .light_ctl_setup_srv.settings.force_segmented = _force_segmented,     \
         .light_ctl_setup_srv.settings.transmic_size = _mic_size,              \
-        .state.transition.timer.p_timer_id = &_name ## _timer,                \
         .app_light_ctl_set_cb = _light_ctl_set_cb,                            \
         .app_light_ctl_get_cb = _light_ctl_get_cb,                            \
         .app_light_ctl_transition_cb = _light_ctl_transition_cb,              \
@@ -92,14 +92,12 @@
  * @param[in] _transition_cb        Callback for setting the application transition time and state value to given values.
  */
 #define APP_LIGHT_LIGHTNESS_SETUP_SERVER_DEF(_name, _force_segmented, _mic_size, _set_cb, _get_cb, _transition_cb) \
-    APP_TIMER_DEF(_name ## _timer);                                     \
     static app_light_lightness_setup_server_t _name =                   \
     {                                                                   \
         .light_lightness_setup_server.settings.force_segmented = _force_segmented, \
         .light_lightness_setup_server.settings.transmic_size = _mic_size, \
         .app_add_notify.app_add_publish_cb = NULL,                      \
         .app_add_notify.app_notify_set_cb = NULL,                       \
-        .state.transition.timer.p_timer_id = &_name ## _timer,          \
         .app_light_lightness_set_cb = _set_cb,                          \
         .app_light_lightness_get_cb = _get_cb,                          \
         .app_light_lightness_transition_cb = _transition_cb             \
@@ -43,7 +43,6 @@
 #include "app_timer.h"
 #include "model_common.h"
 #include "fsm.h"
-#include "timer_scheduler.h"
 
 /**
  * @defgroup APP_TRANSITION Generic transition module
@@ -59,13 +58,18 @@
  * @ref app_transition_transition_tick_cb_t callbacks, therefore user must not do time
  * consuming operations inside the callback.
  *
- * The smallest possible callback interval for a given transition time will be limited by
- * @ref MODEL_TIMER_TIMEOUT_MIN_TICKS.
+ * All ongoing transitions are driven by a single timer, which only runs while a delay or transition
+ * needs an update. Updates are aligned to frames of @ref APP_TRANSITION_FRAME_INTERVAL_MS, so that
+ * transitions started together, for example by a scene recall, are ticked together in one batch.
+ * The smallest possible callback interval is one frame.
  *
  * @{
  */
 
 
+/** Fixed point representation of a complete transition, see @ref app_transition_interpolate. */
+#define APP_TRANSITION_PROGRESS_MAX (1UL << 16)
+
 /** Transition types */
 typedef enum
 {
@@ -154,14 +158,28 @@ struct __app_transition_t
     /** Time to delay the requested transition. */
     uint32_t delay_ms;
 
-    /** Transition timer */
-    model_timer_t timer;
-    /** Delay timer */
-    timer_event_t delay_timer;
     /** Context to be passed to triggered callbacks */
     void * p_context;
     /** Internal. */
     fsm_t fsm;
+    /** Internal. Start of the ongoing transition, in RTC ticks. */
+    uint64_t start_ticks;
+    /** Internal. Time of the next transition step, in RTC ticks. */
+    uint64_t next_ticks;
+    /** Internal. End of the delay, in RTC ticks. */
+    uint64_t delay_end_ticks;
+    /** Internal. Time between transition steps, in RTC ticks. */
+    uint32_t step_ticks;
+    /** Internal. Elapsed fraction of the transition time at the last step. */
+    uint32_t progress;
+    /** Internal. Whether the delay is running. */
+    bool delay_pending;
+    /** Internal. Whether the transition is stepping towards the target. */
+    bool stepping;
+    /** Internal. Whether the transition is in the list of transitions waiting for updates. */
+    bool active;
+    /** Internal. Next transition waiting for updates. */
+    app_transition_t * p_next;
 };
 
 /** Gets the remaining transition time in milliseconds.
@@ -195,6 +213,21 @@ uint32_t app_transition_elapsed_time_get(app_transition_t * p_transition);
  */
 bool app_transition_time_complete_check(app_transition_t * p_transition);
 
+/** Gets the part of a change that should be applied at the current step of the transition.
+ *
+ * The elapsed fraction of the transition is computed once per update, so this is cheap to call
+ * for several values in a transition tick callback. Not valid for move transitions.
+ *
+ * @param[in]  p_transition   Pointer to transition context.
+ * @param[in]  delta          Total change over the transition.
+ *
+ * @returns The part of @p delta that corresponds to the elapsed transition time.
+ */
+static inline int64_t app_transition_interpolate(const app_transition_t * p_transition, int64_t delta)
+{
+    return (delta * p_transition->progress) / (int64_t) APP_TRANSITION_PROGRESS_MAX;
+}
+
 /** Starts the transition with specified transition parameters
  *
  * @param[in]  p_transition   Pointer to transition context.
@@ -212,8 +245,6 @@ void app_transition_abort(app_transition_t *p_transition);
  * @param[in] p_transition          Pointer to the app_transition_t structure
  *
  * @retval NRF_SUCCESS              The transition module is initialized successfully.
- * @retval NRF_ERROR_NULL           NULL pointer is supplied to the function or to the required
- *                                  member variable pointers.
  * @retval NRF_ERROR_INVALID_PARAM  If the application timer module has not been initialized.
  * @retval NRF_ERROR_INVALID_STATE  If the application timer is running.
 */
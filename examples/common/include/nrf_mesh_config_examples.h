@@ -139,6 +139,25 @@
 
 /** @} end of DFU_SUPPORT_CONFIG */
 
+/**
+ * @defgroup APP_TRANSITION_CONFIG Transition module configuration
+ * @ingroup MESH_API_GROUP_APP_SUPPORT
+ * Configuration for compile time. Part of the transition module.
+ *
+ * @{
+ */
+
+/** Time between updates of ongoing transitions, in milliseconds.
+ *
+ * All transitions are updated together from a single timer, at most once per frame. A shorter
+ * interval gives smoother transitions at the cost of more CPU time.
+ */
+#ifndef APP_TRANSITION_FRAME_INTERVAL_MS
+#define APP_TRANSITION_FRAME_INTERVAL_MS 20
+#endif
+
+/** @} end of APP_TRANSITION_CONFIG */
+
 /** @} end of NRF_MESH_CONFIG_EXAMPLES */
 
 #endif /* NRF_MESH_CONFIG_EXAMPLES_H__ */
@@ -146,8 +146,7 @@ static void app_level_transition_tick_cb(const app_transition_t * p_transition)
         /* Calculate new value using linear interpolation and provide to the application. */
         int32_t delta = (p_app->state.target_level - p_app->state.initial_present_level);
         p_app->state.present_level = p_app->state.initial_present_level +
-                                        (delta * (int64_t)app_transition_elapsed_time_get(&p_app->state.transition) /
-                                          (int64_t)p_params->transition_time_ms);
+                                        app_transition_interpolate(p_transition, delta);
     }
     else
     {
@@ -882,11 +882,11 @@ static void transition_tick_cb(const app_transition_t * p_transition)
         delta_temperature32 =
             ((int64_t)p_app->state.target_temperature32 - (int64_t)p_app->state.initial_present_temperature32);
         p_app->state.present_temperature32 = p_app->state.initial_present_temperature32 +
-            ((int64_t)delta_temperature32 * (int64_t)elapsed_ms / total_time_ms);
+            app_transition_interpolate(p_transition, delta_temperature32);
 
         delta_duv = (p_app->state.target_delta_uv - p_app->state.initial_present_delta_uv);
         p_app->state.present_delta_uv = p_app->state.initial_present_delta_uv +
-            ((int64_t)delta_duv * (int64_t)elapsed_ms / total_time_ms);
+            app_transition_interpolate(p_transition, delta_duv);
     }
     else
     {
@@ -812,8 +812,7 @@ static void transition_tick_cb(const app_transition_t * p_transition)
     {
         int32_t delta = (p_app->state.target_lightness - p_app->state.initial_present_lightness);
         present_lightness = p_app->state.initial_present_lightness +
-            (delta * (int64_t)elapsed_ms /
-             (int32_t)p_params->transition_time_ms);
+            app_transition_interpolate(p_transition, delta);
     }
     else
     {
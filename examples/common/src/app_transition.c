@@ -40,11 +40,144 @@
 #include <stdlib.h>
 
 #include "sdk_config.h"
+#include "nrf_mesh_config_examples.h"
 #include "example_common.h"
 #include "fsm_assistant.h"
 #include "nrf_mesh_assert.h"
 #include "log.h"
 
+/** Frame length, in RTC ticks. */
+#define FRAME_TICKS     (APP_TIMER_TICKS(APP_TRANSITION_FRAME_INTERVAL_MS))
+
+/**************************************************************************************************/
+/* Shared transition engine */
+
+APP_TIMER_DEF(m_engine_timer);
+static bool m_engine_timer_created;
+/** Transitions that are waiting for an update. */
+static app_transition_t * mp_active;
+/** Engine time, in RTC ticks. Only advances while there are active transitions. */
+static uint64_t m_clock_ticks;
+static uint32_t m_clock_rtc_stamp;
+/** Whether the engine is updating transitions, all updates in a batch use the same time. */
+static bool m_batch_active;
+
+static uint64_t clock_now(void)
+{
+    if (!m_batch_active)
+    {
+        uint32_t rtc_now = app_timer_cnt_get();
+        m_clock_ticks += app_timer_cnt_diff_compute(rtc_now, m_clock_rtc_stamp);
+        m_clock_rtc_stamp = rtc_now;
+    }
+    return m_clock_ticks;
+}
+
+static uint64_t next_update_ticks_get(const app_transition_t * p_transition)
+{
+    uint64_t next_ticks = UINT64_MAX;
+    if (p_transition->delay_pending)
+    {
+        next_ticks = p_transition->delay_end_ticks;
+    }
+    if (p_transition->stepping && p_transition->next_ticks < next_ticks)
+    {
+        next_ticks = p_transition->next_ticks;
+    }
+    return next_ticks;
+}
+
+static void engine_schedule(void)
+{
+    (void) app_timer_stop(m_engine_timer);
+    if (mp_active == NULL)
+    {
+        return;
+    }
+
+    uint64_t next_ticks = UINT64_MAX;
+    for (app_transition_t * p_item = mp_active; p_item != NULL; p_item = p_item->p_next)
+    {
+        uint64_t item_next_ticks = next_update_ticks_get(p_item);
+        if (item_next_ticks < next_ticks)
+        {
+            next_ticks = item_next_ticks;
+        }
+    }
+
+    /* Only wake up at frame boundaries, so that transitions that are due around the same time
+     * are updated together. */
+    next_ticks = ((next_ticks + FRAME_TICKS - 1) / FRAME_TICKS) * FRAME_TICKS;
+
+    uint64_t now = clock_now();
+    uint64_t timeout = (next_ticks > now) ? (next_ticks - now) : 0;
+    if (timeout < APP_TIMER_MIN_TIMEOUT_TICKS)
+    {
+        timeout = APP_TIMER_MIN_TIMEOUT_TICKS;
+    }
+    else if (timeout > MODEL_TIMER_MAX_TIMEOUT_TICKS)
+    {
+        /* Wake up before the RTC wraps around, the engine will go back to sleep. */
+        timeout = MODEL_TIMER_MAX_TIMEOUT_TICKS;
+    }
+
+    uint32_t status = app_timer_start(m_engine_timer, (uint32_t) timeout, NULL);
+    NRF_MESH_ASSERT_DEBUG(status == NRF_SUCCESS);
+    (void) status;
+}
+
+/** Add or remove the transition from the active list, depending on whether it needs updates. */
+static void engine_update(app_transition_t * p_transition)
+{
+    bool needs_updates = (p_transition->delay_pending || p_transition->stepping);
+
+    if (needs_updates && !p_transition->active)
+    {
+        p_transition->active = true;
+        p_transition->p_next = mp_active;
+        mp_active = p_transition;
+    }
+    else if (!needs_updates && p_transition->active)
+    {
+        for (app_transition_t ** pp_item = &mp_active; *pp_item != NULL; pp_item = &(*pp_item)->p_next)
+        {
+            if (*pp_item == p_transition)
+            {
+                *pp_item = p_transition->p_next;
+                break;
+            }
+        }
+        p_transition->active = false;
+    }
+
+    /* The engine reschedules itself at the end of each batch. */
+    if (!m_batch_active)
+    {
+        engine_schedule();
+    }
+}
+
+static uint32_t elapsed_ms_get(const app_transition_t * p_transition, uint64_t now)
+{
+    return MODEL_TIMER_PERIOD_MS_GET(now - p_transition->start_ticks);
+}
+
+static void progress_update(app_transition_t * p_transition, uint64_t now)
+{
+    uint32_t transition_time_ms = p_transition->ongoing_params.transition_time_ms;
+    uint32_t elapsed_ms = elapsed_ms_get(p_transition, now);
+
+    if (p_transition->ongoing_params.transition_type == APP_TRANSITION_TYPE_MOVE_SET ||
+        transition_time_ms == 0 || elapsed_ms >= transition_time_ms)
+    {
+        p_transition->progress = APP_TRANSITION_PROGRESS_MAX;
+    }
+    else
+    {
+        p_transition->progress = (uint32_t) (((uint64_t) elapsed_ms * APP_TRANSITION_PROGRESS_MAX) / transition_time_ms);
+    }
+}
+
 /**************************************************************************************************/
 /* Transition state machine */
 
@@ -141,6 +274,8 @@ static const char * m_state_lookup_table[] =
 };
 #endif  /* FSM_DEBUG */
 
+static uint8_t m_fsm_index[FSM_INDEX_SIZE(VA_NARGS(STATE_LIST), VA_NARGS(EVENT_LIST))];
+
 static const fsm_const_descriptor_t m_fsm_descriptor =
 {
     .transition_table = m_app_transition_fsm_transition_table,
@@ -148,6 +283,9 @@ static const fsm_const_descriptor_t m_fsm_descriptor =
     .initial_state = S_IDLE,
     .guard = app_transition_fsm_guard,
     .action = app_transition_fsm_action,
+    .p_index = m_fsm_index,
+    .state_count = VA_NARGS(STATE_LIST),
+    .event_count = VA_NARGS(EVENT_LIST),
 #if FSM_DEBUG
     .fsm_name = "app_trans",
     .action_lookup = m_action_lookup_table,
@@ -186,7 +324,9 @@ static void a_delay_start(void * p_data)
 {
     app_transition_t * p_transition = (app_transition_t *) p_data;
 
-    timer_sch_reschedule(&p_transition->delay_timer, timer_now() + MS_TO_US(p_transition->delay_ms));
+    p_transition->delay_end_ticks = clock_now() + APP_TIMER_TICKS(p_transition->delay_ms);
+    p_transition->delay_pending = true;
+    engine_update(p_transition);
 
     if (p_transition->delay_start_cb != NULL)
     {
@@ -204,8 +344,6 @@ static void a_transition_start(void * p_data)
     uint64_t transition_step_us;
     uint64_t min_transition_step_us;
 
-    // abort ongoing transition if there is any
-    model_timer_abort(&p_transition->timer);
     p_transition->ongoing_params = p_transition->requested_params;
     app_transition_params_t * p_params = &p_transition->ongoing_params;
 
@@ -221,22 +359,25 @@ static void a_transition_start(void * p_data)
         transition_step_us = min_transition_step_us;
     }
 
-    if (transition_step_us < MS_TO_US(MODEL_TIMER_PERIOD_MS_GET(MODEL_TIMER_TIMEOUT_MIN_TICKS)))
+    if (transition_step_us < MODEL_TIMER_PERIOD_US_GET(FRAME_TICKS))
     {
-        /* We cannot fire timer more frequently than MODEL_TIMER_TIMEOUT_MIN_TICKS, thus
-        increment present level in suitable steps. */
-        p_transition->timer.timeout_rtc_ticks = MODEL_TIMER_TIMEOUT_MIN_TICKS;
+        /* Transitions aren't updated more often than once per frame, thus increment present level
+        in suitable steps. */
+        p_transition->step_ticks = FRAME_TICKS;
     }
     else
     {
         /* Perform level transition using time steps corresponding to one step change. */
-        p_transition->timer.timeout_rtc_ticks = MODEL_TIMER_TICKS_GET_US(transition_step_us);
+        p_transition->step_ticks = MODEL_TIMER_TICKS_GET_US(transition_step_us);
     }
 
-    p_transition->timer.mode = MODEL_TIMER_MODE_REPEATED;
-    uint32_t status = model_timer_schedule(&p_transition->timer);
+    p_transition->start_ticks = clock_now();
+    p_transition->next_ticks = p_transition->start_ticks + p_transition->step_ticks;
+    p_transition->progress = 0;
+    p_transition->stepping = true;
+    engine_update(p_transition);
 
-    if ((NRF_SUCCESS == status) && p_transition->transition_start_cb)
+    if (p_transition->transition_start_cb)
     {
         p_transition->transition_start_cb(p_transition);
     }
@@ -246,6 +387,26 @@ static void a_transition_tick(void * p_data)
 {
     app_transition_t * p_transition = (app_transition_t *) p_data;
 
+    uint64_t now = clock_now();
+    uint64_t next_ticks = p_transition->next_ticks + p_transition->step_ticks;
+    if (next_ticks <= now)
+    {
+        /* Fell behind, skip the missed steps rather than catching up. */
+        next_ticks = now + p_transition->step_ticks;
+    }
+    if (p_transition->ongoing_params.transition_type != APP_TRANSITION_TYPE_MOVE_SET)
+    {
+        /* Make sure the last step lands on the end of the transition. */
+        uint64_t end_ticks = p_transition->start_ticks +
+                             MODEL_TIMER_TICKS_GET_MS(p_transition->ongoing_params.transition_time_ms);
+        if (next_ticks > end_ticks)
+        {
+            next_ticks = end_ticks;
+        }
+    }
+    p_transition->next_ticks = next_ticks;
+    engine_update(p_transition);
+
     if (p_transition->transition_tick_cb != NULL)
     {
         p_transition->transition_tick_cb(p_transition);
@@ -256,7 +417,9 @@ static void a_transition_complete(void * p_data)
 {
     app_transition_t * p_transition = (app_transition_t *) p_data;
 
-    model_timer_abort(&p_transition->timer);
+    p_transition->stepping = false;
+    p_transition->progress = APP_TRANSITION_PROGRESS_MAX;
+    engine_update(p_transition);
     app_transition_params_t * p_params = &p_transition->ongoing_params;
     p_params->transition_time_ms = 0;
 
@@ -272,8 +435,9 @@ static void a_abort(void * p_data)
 
     p_transition->delay_ms = 0;
     p_transition->ongoing_params.transition_time_ms = 0;
-    timer_sch_abort(&p_transition->delay_timer);
-    model_timer_abort(&p_transition->timer);
+    p_transition->delay_pending = false;
+    p_transition->stepping = false;
+    engine_update(p_transition);
 }
 
 static bool g_set_delay(void * p_data)
@@ -301,23 +465,45 @@ static bool g_transition_complete(void * p_data)
     app_transition_params_t * p_params = &p_transition->ongoing_params;
 
     return (p_params->transition_type != APP_TRANSITION_TYPE_MOVE_SET &&
-           (MODEL_TIMER_PERIOD_MS_GET(model_timer_elapsed_ticks_get(&p_transition->timer)) >= p_params->transition_time_ms));
-}
-
-static void delay_cb(timestamp_t timestamp, void * p_context)
-{
-    (void)timestamp;
-    app_transition_t * p_transition = (app_transition_t *) p_context;
-    p_transition->delay_ms = 0;
-
-    fsm_event_post(&p_transition->fsm, E_DELAY_EXPIRED, p_transition);
+           (elapsed_ms_get(p_transition, clock_now()) >= p_params->transition_time_ms));
 }
 
-static void transition_timer_cb(void * p_context)
+static void engine_timer_cb(void * p_context)
 {
-    app_transition_t * p_transition = (app_transition_t *) p_context;
+    (void) p_context;
+    uint64_t now = clock_now();
+    m_batch_active = true;
+
+    /* Transitions may be removed from the list by the events, so take the next one first.
+     * Transitions that are missed by the iteration are picked up in the next batch. */
+    app_transition_t * p_next;
+    for (app_transition_t * p_transition = mp_active; p_transition != NULL; p_transition = p_next)
+    {
+        p_next = p_transition->p_next;
+
+        if (p_transition->delay_pending && p_transition->delay_end_ticks <= now)
+        {
+            /* Starts the requested transition, replacing the ongoing one. */
+            p_transition->delay_pending = false;
+            p_transition->delay_ms = 0;
+            fsm_event_post(&p_transition->fsm, E_DELAY_EXPIRED, p_transition);
+        }
+        else if (p_transition->stepping && p_transition->next_ticks <= now)
+        {
+            progress_update(p_transition, now);
+            fsm_event_post(&p_transition->fsm, E_TIMEOUT, p_transition);
+        }
+        else
+        {
+            continue;
+        }
+
+        /* The events update the transition's deadlines, make sure it leaves the list if it's done. */
+        engine_update(p_transition);
+    }
 
-    fsm_event_post(&p_transition->fsm, E_TIMEOUT, p_transition);
+    m_batch_active = false;
+    engine_schedule();
 }
 
 /***** Interface functions *****/
@@ -338,14 +524,22 @@ uint32_t app_transition_remaining_time_get(app_transition_t * p_transition)
     NRF_MESH_ASSERT(p_transition != NULL);
 
     app_transition_params_t * p_params = &p_transition->ongoing_params;
-    return (p_params->transition_time_ms - MODEL_TIMER_PERIOD_MS_GET(model_timer_elapsed_ticks_get(&p_transition->timer)));
+    if (!p_transition->stepping)
+    {
+        return p_params->transition_time_ms;
+    }
+    return (p_params->transition_time_ms - elapsed_ms_get(p_transition, clock_now()));
 }
 
 uint32_t app_transition_elapsed_time_get(app_transition_t * p_transition)
 {
     NRF_MESH_ASSERT(p_transition != NULL);
 
-    return (MODEL_TIMER_PERIOD_MS_GET(model_timer_elapsed_ticks_get(&p_transition->timer)));
+    if (!p_transition->stepping)
+    {
+        return 0;
+    }
+    return elapsed_ms_get(p_transition, clock_now());
 }
 
 bool app_transition_time_complete_check(app_transition_t * p_transition)
@@ -358,16 +552,21 @@ bool app_transition_time_complete_check(app_transition_t * p_transition)
 
 uint32_t app_transition_init(app_transition_t * p_transition)
 {
-    uint32_t value;
+    uint32_t value = NRF_SUCCESS;
 
     NRF_MESH_ASSERT(p_transition != NULL);
 
-    p_transition->delay_timer.p_context = p_transition;
-    p_transition->delay_timer.cb = delay_cb;
+    if (!m_engine_timer_created)
+    {
+        value = app_timer_create(&m_engine_timer, APP_TIMER_MODE_SINGLE_SHOT, engine_timer_cb);
+        m_engine_timer_created = (value == NRF_SUCCESS);
+    }
 
-    p_transition->timer.p_context = p_transition;
-    p_transition->timer.cb = transition_timer_cb;
-    value =  model_timer_create(&p_transition->timer);
+    p_transition->delay_pending = false;
+    p_transition->stepping = false;
+    p_transition->active = false;
+    p_transition->p_next = NULL;
+    p_transition->progress = 0;
 
     fsm_init(&p_transition->fsm, &m_fsm_descriptor);
 
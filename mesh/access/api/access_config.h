@@ -533,6 +533,26 @@ uint32_t access_element_vendor_model_count_get(uint16_t element_index, uint8_t *
  */
 uint32_t access_element_models_get(uint16_t element_index, access_model_handle_t * p_models, uint16_t * p_count);
 
+/**
+ * Gets the revision of the device composition.
+ *
+ * The revision changes every time a model is added or an element location is changed, so that
+ * users can cache data derived from the composition, such as the Composition Data page.
+ *
+ * @returns The current composition revision.
+ */
+uint32_t access_composition_revision_get(void);
+
+/**
+ * Gets the revision of the model subscription lists and application key bindings.
+ *
+ * The revision changes every time the subscription list or the model state of any model is
+ * changed, so that users can cache subscription and application key lists.
+ *
+ * @returns The current model lists revision.
+ */
+uint32_t access_model_lists_revision_get(void);
+
 /** @} */
 
 /**
@@ -65,6 +65,7 @@
 #include "mesh_opt_access.h"
 #include "nrf_mesh_config_app.h"
 #include "mesh_config_entry.h"
+#include "packet_trace.h"
 
 typedef struct
 {
@@ -93,6 +94,13 @@ static uint8_t m_default_ttl = ACCESS_DEFAULT_TTL;
 /** Set of the global flags to keep track of the access layer changes.*/
 static local_access_status_t m_status;
 
+/** Revision of the element and model composition, see @ref access_composition_revision_get. */
+static uint32_t m_composition_revision;
+
+/** Revision of the model subscription lists and application key bindings, see
+ * @ref access_model_lists_revision_get. */
+static uint32_t m_model_lists_revision;
+
 /* ********** Static asserts ********** */
 
 NRF_MESH_STATIC_ASSERT(ACCESS_MODEL_COUNT > 0);
@@ -471,6 +479,9 @@ static uint32_t packet_alloc_and_tx(access_model_handle_t handle,
 
 static void access_state_clear(void)
 {
+    m_composition_revision++;
+    m_model_lists_revision++;
+
     memset(&m_model_pool[0], 0, sizeof(m_model_pool));
     memset(&m_element_pool[0], 0, sizeof(m_element_pool));
     memset(&m_subscription_list_pool[0], 0, sizeof(m_subscription_list_pool));
@@ -655,6 +666,7 @@ static uint32_t subscriptions_setter(mesh_config_entry_id_t id, const void * p_e
         {
             m_subscription_list_pool[idx].bitfield[i] = ~p_data->inverted_bitfield[i];
         }
+        m_model_lists_revision++;
 
         ACCESS_INTERNAL_STATE_INVALIDATED_CLR(m_subscription_list_pool[idx].internal_state);
         ACCESS_INTERNAL_STATE_REFRESHED_CLR(m_subscription_list_pool[idx].internal_state);
@@ -734,6 +746,7 @@ static uint32_t models_setter(mesh_config_entry_id_t id, const void * p_entry)
         }
 
         memcpy(&m_model_pool[idx].model_info, p_data, sizeof(access_model_state_data_t));
+        m_model_lists_revision++;
 
         ACCESS_INTERNAL_STATE_INVALIDATED_CLR(m_model_pool[idx].internal_state);
         ACCESS_INTERNAL_STATE_REFRESHED_CLR(m_model_pool[idx].internal_state);
@@ -792,6 +805,8 @@ MESH_CONFIG_FILE(m_access_file, MESH_OPT_ACCESS_FILE_ID, MESH_CONFIG_STRATEGY_CO
 
 static void model_store(access_model_handle_t handle)
 {
+    m_model_lists_revision++;
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_REFRESHED_SET(m_model_pool[handle].internal_state);
@@ -806,6 +821,8 @@ static void model_store(access_model_handle_t handle)
 
 static void element_store(uint16_t index)
 {
+    m_composition_revision++;
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_REFRESHED_SET(m_element_pool[index].internal_state);
@@ -820,6 +837,8 @@ static void element_store(uint16_t index)
 
 static void sublist_store(uint16_t index)
 {
+    m_model_lists_revision++;
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_REFRESHED_SET(m_subscription_list_pool[index].internal_state);
@@ -841,6 +860,8 @@ static void sublist_store(uint16_t index)
 
 static void sublist_invalidate(uint16_t index)
 {
+    m_model_lists_revision++;
+
     if (!m_status.is_restoring_ended)
     {
         ACCESS_INTERNAL_STATE_INVALIDATED_SET(m_subscription_list_pool[index].internal_state);
@@ -961,6 +982,7 @@ static void access_mesh_config_clear(void)
 uint32_t access_load_config_apply(void)
 {
     m_status.is_restoring_ended = 1;
+    m_model_lists_revision++;
 
     if (!!m_status.is_load_failed)
     {
@@ -1006,6 +1028,8 @@ uint32_t access_load_config_apply(void)
 /* ********** Private API ********** */
 void access_incoming_handle(const access_message_rx_t * p_message)
 {
+    PACKET_TRACE_RX_STAGE(PACKET_TRACE_STAGE_ACCESS);
+
     const nrf_mesh_address_t * p_dst = &p_message->meta_data.dst;
 
     if (nrf_mesh_is_address_rx(p_dst))
@@ -1137,6 +1161,7 @@ uint32_t access_model_add(const access_model_add_params_t * p_model_params,
         m_model_pool[*p_model_handle].model_info.publish_ttl = ACCESS_TTL_USE_DEFAULT;
         increment_model_count(p_model_params->element_index, p_model_params->model_id.company_id);
         ACCESS_INTERNAL_STATE_ALLOCATED_SET(m_model_pool[*p_model_handle].internal_state);
+        m_composition_revision++;
         model_store(*p_model_handle);
     }
 
@@ -1891,6 +1916,16 @@ uint32_t access_handle_get(uint16_t element_index,
     }
 }
 
+uint32_t access_composition_revision_get(void)
+{
+    return m_composition_revision;
+}
+
+uint32_t access_model_lists_revision_get(void)
+{
+    return m_model_lists_revision;
+}
+
 uint32_t access_element_models_get(uint16_t element_index, access_model_handle_t * p_models, uint16_t * p_count)
 {
     if (NULL == p_models || p_count == NULL)
@@ -71,6 +71,8 @@ typedef struct
         /** Number of times the packet should be transmitted on each channel. */
         uint8_t repeats;
     } config;
+    /** Packet trace ID, or 0 if the packet isn't traced. Only for internal use. */
+    uint16_t trace_id;
     /** Advertisement packet going on air. */
     packet_t packet __attribute__((aligned(WORD_SIZE)));
 } adv_packet_t;
@@ -97,6 +97,18 @@
 #define BEARER_ADV_INT_DEFAULT_MS 20
 #endif
 
+/**
+ * Maximum number of advertising packets sent back to back in a single radio session.
+ *
+ * Broadcasts that are queued at the same time, with the same radio configuration, access address
+ * and channels, are sent as one bearer action. All the packets are sent on a channel before the
+ * radio moves on to the next channel, without ramping the radio up between them. Each packet in
+ * the session uses 8 bytes of RAM. The default of 1 sends each packet in its own bearer action.
+ */
+#ifndef BROADCAST_PACK_COUNT_MAX
+#define BROADCAST_PACK_COUNT_MAX 1
+#endif
+
 /** Default scan interval */
 #ifndef BEARER_SCAN_INT_DEFAULT_MS
 #define BEARER_SCAN_INT_DEFAULT_MS 2000
@@ -112,6 +124,24 @@
 #define SCANNER_BUFFER_SIZE 512
 #endif
 
+/**
+ * Radio receive current in microamperes, used to estimate the charge spent by the scanner.
+ *
+ * The default is the nRF52832 receive current at 1 Mbit/s with the DC/DC converter enabled. Change
+ * it to match the chip and power supply of the device.
+ */
+#ifndef SCANNER_RX_CURRENT_UA
+#define SCANNER_RX_CURRENT_UA 5400
+#endif
+
+/**
+ * Traffic level, in received packets per second, at which the adaptive scanner uses a scan window
+ * halfway between its shortest and its longest window.
+ */
+#ifndef SCANNER_ADAPTIVE_HALF_RATE
+#define SCANNER_ADAPTIVE_HALF_RATE 10
+#endif
+
 /** Buffer size for the Instaburst RX module. */
 #ifndef INSTABURST_RX_BUFFER_SIZE
 #define INSTABURST_RX_BUFFER_SIZE   (1024)
@@ -151,6 +181,24 @@
 
 /** @} end of MESH_CONFIG_BEARER_EVENT */
 
+/**
+ * @defgroup MESH_CONFIG_TIMESLOT_PROFILER Timeslot profiler configuration
+ * @{
+ */
+
+/**
+ * Define "1" to enable the timeslot profiler.
+ *
+ * The profiler attributes the time of each radio timeslot to the scanner and the bearer actions,
+ * see @ref TIMESLOT_PROFILER. It adds a few microseconds of processing to every change of radio
+ * activity, and uses about 150 bytes of RAM.
+ */
+#ifndef TIMESLOT_PROFILER_ENABLE
+#define TIMESLOT_PROFILER_ENABLE 0
+#endif
+
+/** @} end of MESH_CONFIG_TIMESLOT_PROFILER */
+
 
 /** @} end of NRF_MESH_CONFIG_BEARER */
 
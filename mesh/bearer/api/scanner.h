@@ -77,6 +77,29 @@ typedef struct
     uint32_t out_of_memory;                 /**< Number of times the scanner has ran out of memory. */
 } scanner_stats_t;
 
+/** Adaptive scanning parameters, see @ref scanner_config_adaptive_set. */
+typedef struct
+{
+    uint32_t scan_interval_us;  /**< Time between the start of each scan window. */
+    uint32_t window_min_us;     /**< Shortest scan window, used when there's no traffic. */
+    uint32_t current_budget_ua; /**< Average radio receive current the scanner may use, in microamperes. */
+} scanner_adaptive_config_t;
+
+/**
+ * Scanner traffic report. The per channel fields are indexed by the position of the channel in the
+ * channel map, and are recorded since the channel map was last set.
+ */
+typedef struct
+{
+    uint32_t packets[SCANNER_CHANNELS_MAX];      /**< Number of received packets on each channel. */
+    uint32_t crc_failures[SCANNER_CHANNELS_MAX]; /**< Number of CRC failures on each channel. */
+    uint32_t scan_time_ms[SCANNER_CHANNELS_MAX]; /**< Scheduled scan time on each channel, in milliseconds. */
+    uint8_t  channel_count;                      /**< Number of channels in the channel map. */
+    uint32_t window_us;                          /**< Current scan window, in microseconds. */
+    uint32_t charge_mas;                         /**< Estimated radio receive charge, in mA*s. */
+    uint32_t packets_per_mas_x100;               /**< Received packets per mA*s of radio receive charge, multiplied by 100. */
+} scanner_traffic_report_t;
+
 /**
  * Scanner packet callback hook, called on every successfully received packet before committing it
  * to the buffer.
@@ -154,6 +177,16 @@ void scanner_packet_release(const scanner_packet_t * p_packet);
  */
 const scanner_stats_t * scanner_stats_get(void);
 
+/**
+ * Gets a report of the traffic caught by the scanner, and the charge spent catching it.
+ *
+ * The charge is estimated from the scheduled scan time and @ref SCANNER_RX_CURRENT_UA. Time where
+ * the scanner is preempted by other radio activity is included.
+ *
+ * @param[out]     p_report  Report structure to fill.
+ */
+void scanner_traffic_report_get(scanner_traffic_report_t * p_report);
+
 /**
  * Sets scanner radio mode (data rate and modulation).
  *
@@ -164,11 +197,34 @@ void scanner_config_radio_mode_set(radio_mode_t radio_mode);
 /**
  * Sets scanner timing parameters.
  *
+ * @note Turns off adaptive scanning, see @ref scanner_config_adaptive_set.
+ *
  * @param[in]      scan_interval_us  Scan interval duration.
  * @param[in]      scan_window_us    Scan window duration.
  */
 void scanner_config_scan_time_set(uint32_t scan_interval_us, uint32_t scan_window_us);
 
+/**
+ * Turns on adaptive scanning.
+ *
+ * In adaptive scanning, the scanner tracks the packets received and the CRC failures on each
+ * channel. Channels with more traffic and less noise get a larger share of the scan windows, and
+ * the scan window grows with the traffic, from @c window_min_us up to the longest window that fits
+ * in the current budget. If the budget covers the full receive current, the scanner scans
+ * continuously under heavy traffic.
+ *
+ * Adaptive scanning is turned off by @ref scanner_config_scan_time_set and
+ * @ref scanner_config_reset.
+ *
+ * @param[in]      p_config  Adaptive scanning parameters.
+ *
+ * @retval NRF_SUCCESS             Adaptive scanning was turned on.
+ * @retval NRF_ERROR_NULL          @p p_config was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM The scan interval or the shortest window is out of range, or the
+ *                                 current budget can't cover the shortest window.
+ */
+uint32_t scanner_config_adaptive_set(const scanner_adaptive_config_t * p_config);
+
 /**
  * Sets which radio channels are to be used by the scanner.
  *
@@ -0,0 +1,159 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TIMESLOT_PROFILER_H__
+#define TIMESLOT_PROFILER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_mesh_config_bearer.h"
+#include "timer.h"
+
+/**
+ * @defgroup TIMESLOT_PROFILER Timeslot profiler
+ * @ingroup MESH_BEARER
+ * Attributes the radio timeslot time to the activities of the bearer handler.
+ *
+ * Every microsecond between the start and the end of a SoftDevice timeslot is counted in one of the
+ * @ref timeslot_profiler_category_t categories. The profiler also counts extension failures and
+ * timeslots blocked or canceled by the SoftDevice, and keeps a histogram of the radio duty cycle
+ * of each timeslot. Use it to tune the scanner and advertiser parameters.
+ *
+ * The profiler is enabled with @ref TIMESLOT_PROFILER_ENABLE.
+ * @{
+ */
+
+/**
+ * Number of buckets in the duty cycle histogram. Each bucket covers an equal share of 0-100 %, and
+ * timeslots with 100 % duty cycle are counted in the last bucket.
+ */
+#define TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT 10
+
+/** Categories of timeslot time. */
+typedef enum
+{
+    TIMESLOT_PROFILER_CATEGORY_EXTEND,            /**< Extending the timeslot, before the radio is used. */
+    TIMESLOT_PROFILER_CATEGORY_IDLE,              /**< Nothing to do in the timeslot. */
+    TIMESLOT_PROFILER_CATEGORY_SCANNER,           /**< Scanning. */
+    TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER,      /**< Bearer actions without a type. */
+    TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST,  /**< Advertising packet transmissions. */
+    TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_TX, /**< Extended advertising packet transmissions. */
+    TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_RX, /**< Extended advertising packet reception. */
+    TIMESLOT_PROFILER_CATEGORY_ACTION_FLASH,      /**< Flash operations. */
+
+    /** @internal Number of categories. */
+    TIMESLOT_PROFILER_CATEGORY__LAST
+} timeslot_profiler_category_t;
+
+/** Timeslot profiler statistics. */
+typedef struct
+{
+    uint64_t time_us[TIMESLOT_PROFILER_CATEGORY__LAST]; /**< Time spent in each category, in microseconds. */
+    uint32_t timeslot_count;    /**< Number of timeslots. */
+    uint32_t extend_count;      /**< Number of extension attempts. */
+    uint32_t extend_fail_count; /**< Number of failed extension attempts. */
+    uint32_t blocked_count;     /**< Number of timeslot requests blocked by the SoftDevice. */
+    uint32_t canceled_count;    /**< Number of timeslots canceled by the SoftDevice before they started. */
+    /** Number of timeslots by the share of the timeslot the radio was used for scanning or actions. */
+    uint32_t duty_cycle[TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT];
+} timeslot_profiler_stats_t;
+
+#if TIMESLOT_PROFILER_ENABLE
+/** @internal Hook for the start of a timeslot. */
+#define TIMESLOT_PROFILER_TS_BEGIN()            timeslot_profiler_ts_begin(timer_now())
+/** @internal Hook for the end of a timeslot. */
+#define TIMESLOT_PROFILER_TS_END()              timeslot_profiler_ts_end(timer_now())
+/** @internal Hook for a change of activity in the timeslot. */
+#define TIMESLOT_PROFILER_SWITCH(CATEGORY)      timeslot_profiler_switch((CATEGORY), timer_now())
+/** @internal Hook for the result of a timeslot extension. */
+#define TIMESLOT_PROFILER_EXTEND_END(SUCCESS)   timeslot_profiler_extend_end(SUCCESS)
+/** @internal Hook for a blocked timeslot request. */
+#define TIMESLOT_PROFILER_BLOCKED()             timeslot_profiler_blocked()
+/** @internal Hook for a canceled timeslot request. */
+#define TIMESLOT_PROFILER_CANCELED()            timeslot_profiler_canceled()
+#else
+#define TIMESLOT_PROFILER_TS_BEGIN()
+#define TIMESLOT_PROFILER_TS_END()
+#define TIMESLOT_PROFILER_SWITCH(CATEGORY)
+#define TIMESLOT_PROFILER_EXTEND_END(SUCCESS)
+#define TIMESLOT_PROFILER_BLOCKED()
+#define TIMESLOT_PROFILER_CANCELED()
+#endif
+
+/**
+ * @internal
+ * @{
+ * Profiler hooks. Only to be called through the macros above, from the timeslot signal handler.
+ *
+ * The timestamps are device time (@ref timer_now()), not timeslot time: the hooks also run while the
+ * timeslot is being extended and after it has ended, where @ref ts_timer_now() only returns the end
+ * time of the previous timeslot.
+ */
+void timeslot_profiler_ts_begin(timestamp_t timestamp);
+void timeslot_profiler_ts_end(timestamp_t timestamp);
+void timeslot_profiler_switch(timeslot_profiler_category_t category, timestamp_t timestamp);
+void timeslot_profiler_extend_end(bool success);
+void timeslot_profiler_blocked(void);
+void timeslot_profiler_canceled(void);
+/** @} */
+
+/**
+ * Gets the timeslot profiler statistics.
+ *
+ * @note The time of an ongoing timeslot is included up to the last change of activity.
+ *
+ * @param[out] p_stats Statistics structure to fill.
+ *
+ * @retval NRF_SUCCESS             The statistics were stored in @p p_stats.
+ * @retval NRF_ERROR_NULL          @p p_stats was NULL.
+ * @retval NRF_ERROR_NOT_SUPPORTED The profiler is disabled, see @ref TIMESLOT_PROFILER_ENABLE.
+ */
+uint32_t timeslot_profiler_stats_get(timeslot_profiler_stats_t * p_stats);
+
+/**
+ * Clears the timeslot profiler statistics.
+ */
+void timeslot_profiler_clear(void);
+
+/**
+ * Writes the timeslot profiler statistics to the log.
+ */
+void timeslot_profiler_dump(void);
+
+/** @} */
+
+#endif /* TIMESLOT_PROFILER_H__ */
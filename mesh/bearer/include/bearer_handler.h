@@ -89,6 +89,25 @@ typedef void (*bearer_radio_irq_handler_t)(void* p_args);
  */
 typedef void (*bearer_timer_irq_handler_t)(void* p_args);
 
+/** Forward declaration of struct bearer_action */
+typedef struct bearer_action bearer_action_t;
+
+/**
+ * Action packing function.
+ *
+ * Called before the start of the action for each action that follows it in the queue, until it
+ * returns false. The action may take over the work of the next action, to execute both in a single
+ * radio session. If it does, it must extend its own @c duration_us to cover both, and the next
+ * action is removed from the queue without being started.
+ *
+ * @param[in] p_args Argument pointer, as specified by the caller.
+ * @param[in] p_next The next action in the queue.
+ * @param[in] max_duration_us Maximum duration of the action after packing.
+ *
+ * @returns Whether the next action was packed into this action.
+ */
+typedef bool (*bearer_pack_cb_t)(void* p_args, const bearer_action_t* p_next, ts_timestamp_t max_duration_us);
+
 /**
  * @}
  */
@@ -102,26 +121,38 @@ typedef struct
 } bearer_action_debug_t;
 #endif
 
+/** Bearer action types. */
+typedef enum
+{
+    BEARER_ACTION_TYPE_OTHER,      /**< Action without a specific type. */
+    BEARER_ACTION_TYPE_BROADCAST,  /**< Advertising packet transmission. */
+    BEARER_ACTION_TYPE_ADV_EXT_TX, /**< Extended advertising packet transmission. */
+    BEARER_ACTION_TYPE_ADV_EXT_RX, /**< Extended advertising packet reception. */
+    BEARER_ACTION_TYPE_FLASH,      /**< Flash operation. */
+} bearer_action_type_t;
+
 /**
  * Bearer action parameters. User owned structure that is used to communicate action entry points
  * and parameters. The action's start callback is called as soon as the action is ready for
  * execution, and the action is responsible for calling @ref bearer_handler_action_end() within its
  * set @c duration_us, starting at the @p start_time parameter in the start callback.
  */
-typedef struct
+struct bearer_action
 {
     bearer_start_cb_t          start_cb;          /**< Start of action-callback for the action. */
     bearer_radio_irq_handler_t radio_irq_handler; /**< Radio interrupt handler for the action. */
     bearer_timer_irq_handler_t timer_irq_handler; /**< Timer interrupt handler for the action. */
     ts_timestamp_t             duration_us;       /**< Upper limit on action execution time in microseconds. Must be lower than @ref BEARER_ACTION_DURATION_MAX_US.*/
     void*                      p_args;            /**< Arguments pointer provided to the callbacks. */
+    bearer_action_type_t       type;              /**< Type of action, only used for profiling. */
+    bearer_pack_cb_t           pack_cb;           /**< Packing function for the action, or NULL if the action can't be packed with others. */
 
 #ifdef BEARER_HANDLER_DEBUG
     bearer_action_debug_t      debug;
 #endif
 
     queue_elem_t               queue_elem;        /**< Linked list queue element, set and used by the module. */
-} bearer_action_t;
+};
 
 /** Callback type being called once the bearer handler has been stopped. */
 typedef void (*bearer_handler_stopped_cb_t)(void);
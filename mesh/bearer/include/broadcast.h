@@ -84,6 +84,13 @@ struct broadcast_params
     uint8_t channel_count;
 };
 
+/** Broadcast statistics. Recorded since boot. */
+typedef struct
+{
+    uint32_t packed_packets; /**< Number of packets sent back to back with another broadcast, instead of in their own bearer action. */
+    uint32_t rampups_saved;  /**< Number of radio ramp-ups saved by sending packets back to back. */
+} broadcast_stats_t;
+
 typedef struct
 {
     ts_timestamp_t prev_tx_complete_app_time_us; /**< Time spent in the TX complete call on the previous run. */
@@ -115,6 +122,13 @@ typedef struct
  */
 uint32_t broadcast_send(broadcast_t * p_broadcast);
 
+/**
+ * Returns statistics related to the broadcast module.
+ *
+ * @return Pointer to statistics structure.
+ */
+const broadcast_stats_t * broadcast_stats_get(void);
+
 /** @} */
 
 #endif /* BROADCAST_H__ */
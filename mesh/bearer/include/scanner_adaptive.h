@@ -0,0 +1,153 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SCANNER_ADAPTIVE_H__
+#define SCANNER_ADAPTIVE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scanner.h"
+#include "nrf_mesh_config_bearer.h"
+
+/**
+ * @internal
+ * @defgroup SCANNER_ADAPTIVE Adaptive scanning
+ * @ingroup SCANNER
+ * Traffic tracking and scan window selection for the scanner.
+ *
+ * Keeps a moving average of the received packets and CRC failures per second of scanning on each
+ * channel. The channels are picked by smooth weighted round-robin, weighted by their yield of valid
+ * packets. Every channel keeps a minimum share of the windows, so changes in traffic are noticed.
+ * The scan window grows with the yield of the best channel.
+ * @{
+ */
+
+/** Fixed point scaling of the traffic rates. */
+#define SCANNER_ADAPTIVE_RATE_SHIFT (8)
+
+/** Traffic state of a single channel. */
+typedef struct
+{
+    uint32_t packets;           /**< Number of received packets. */
+    uint32_t crc_failures;      /**< Number of CRC failures. */
+    uint32_t packets_seen;      /**< Value of @c packets at the end of the last window. */
+    uint32_t crc_failures_seen; /**< Value of @c crc_failures at the end of the last window. */
+    uint64_t scan_time_us;      /**< Total scan time. */
+    uint32_t yield;             /**< Average packets per second of scanning, fixed point. */
+    uint32_t noise;             /**< Average CRC failures per second of scanning, fixed point. */
+    int32_t  credit;            /**< Round-robin credit. */
+} scanner_adaptive_channel_t;
+
+/** Adaptive scanning state. */
+typedef struct
+{
+    scanner_adaptive_channel_t channels[SCANNER_CHANNELS_MAX]; /**< Channel states, in channel map order. */
+    uint8_t  channel_count; /**< Number of channels in the channel map. */
+    uint32_t window_min_us; /**< Shortest scan window. */
+    uint32_t window_max_us; /**< Longest scan window. */
+} scanner_adaptive_t;
+
+/**
+ * Initializes the adaptive scanning state, clearing all traffic history.
+ *
+ * @param[in,out] p_adaptive    State to initialize.
+ * @param[in]     channel_count Number of channels in the channel map.
+ */
+void scanner_adaptive_init(scanner_adaptive_t * p_adaptive, uint8_t channel_count);
+
+/**
+ * Sets the range of the scan window.
+ *
+ * @param[in,out] p_adaptive    Adaptive scanning state.
+ * @param[in]     window_min_us Shortest scan window.
+ * @param[in]     window_max_us Longest scan window.
+ */
+void scanner_adaptive_window_limits_set(scanner_adaptive_t * p_adaptive, uint32_t window_min_us, uint32_t window_max_us);
+
+/**
+ * Records the reception of a packet.
+ *
+ * @note Safe to call from a higher interrupt priority than the other functions.
+ *
+ * @param[in,out] p_adaptive    Adaptive scanning state.
+ * @param[in]     channel_index Index of the channel in the channel map.
+ * @param[in]     crc_ok        Whether the packet passed the CRC check.
+ */
+void scanner_adaptive_rx(scanner_adaptive_t * p_adaptive, uint8_t channel_index, bool crc_ok);
+
+/**
+ * Records the end of a scan window, and updates the traffic averages of the channel.
+ *
+ * @param[in,out] p_adaptive    Adaptive scanning state.
+ * @param[in]     channel_index Index of the channel the window was on.
+ * @param[in]     scan_time_us  Length of the window.
+ */
+void scanner_adaptive_window_end(scanner_adaptive_t * p_adaptive, uint8_t channel_index, uint32_t scan_time_us);
+
+/**
+ * Picks the channel for the next scan window.
+ *
+ * @param[in,out] p_adaptive Adaptive scanning state.
+ *
+ * @returns Index of the channel in the channel map.
+ */
+uint8_t scanner_adaptive_channel_next(scanner_adaptive_t * p_adaptive);
+
+/**
+ * Gets the length of the next scan window.
+ *
+ * @param[in] p_adaptive Adaptive scanning state.
+ *
+ * @returns Scan window length in microseconds.
+ */
+uint32_t scanner_adaptive_window_get(const scanner_adaptive_t * p_adaptive);
+
+/**
+ * Fills the traffic fields of a scanner report.
+ *
+ * @param[in]  p_adaptive    Adaptive scanning state.
+ * @param[in]  rx_current_ua Radio receive current in microamperes.
+ * @param[out] p_report      Report to fill. The @c window_us field is left untouched.
+ */
+void scanner_adaptive_report_get(const scanner_adaptive_t * p_adaptive,
+                                 uint32_t rx_current_ua,
+                                 scanner_traffic_report_t * p_report);
+
+/** @} */
+
+#endif /* SCANNER_ADAPTIVE_H__ */
@@ -444,7 +444,9 @@ void adv_ext_tx_instance_init(adv_ext_tx_t * p_tx, const adv_ext_tx_config_t * p
 {
     p_tx->config = *p_config;
     p_tx->bearer_action.p_args = p_tx;
+    p_tx->bearer_action.type = BEARER_ACTION_TYPE_ADV_EXT_TX;
     p_tx->bearer_action.start_cb = action_start;
+    p_tx->bearer_action.pack_cb = NULL;
     p_tx->bearer_action.radio_irq_handler = radio_irq_handler;
 
     p_tx->p_tx_event = NULL;
@@ -41,6 +41,7 @@
 #include "timer_scheduler.h"
 #include "rand.h"
 #include "toolchain.h"
+#include "packet_trace.h"
 #include "nrf_mesh_config_core.h"
 #include "nrf_mesh_assert.h"
 #include "nrf.h"
@@ -74,6 +75,7 @@ static void broadcast_complete_cb(broadcast_params_t * p_broadcast, timestamp_t
 {
     /* Find the owner of this broadcast */
     advertiser_t * p_adv = PARENT_BY_FIELD_GET(advertiser_t, broadcast.params, p_broadcast);
+    PACKET_TRACE_TX_STAGE(p_adv->p_packet->trace_id, PACKET_TRACE_STAGE_RADIO_TX, timestamp);
 
     if ((p_adv->p_packet->config.repeats == 0 ||
          p_adv->p_packet->config.repeats == ADVERTISER_REPEAT_INFINITE) &&
@@ -345,6 +347,7 @@ adv_packet_t * advertiser_packet_alloc(advertiser_t * p_adv, uint32_t adv_payloa
         p_adv_packet->packet.header.type = BLE_PACKET_TYPE_ADV_NONCONN_IND;
         set_adv_address(p_adv, &p_adv_packet->packet);
         p_adv_packet->token = NRF_MESH_INITIAL_TOKEN;
+        p_adv_packet->trace_id = 0;
         return p_adv_packet;
     }
     else
@@ -43,12 +43,22 @@
 #include "toolchain.h"
 #include "nrf.h"
 #include "scanner.h"
+#include "utils.h"
+#include "timeslot_profiler.h"
 #include "debug_pins.h"
 /*****************************************************************************
 * Local defines
 *****************************************************************************/
 /** Minimum time window required for the scanner to start. */
 #define BEARER_SCANNER_MIN_TIME_US              (500)
+
+/** Profiler category of a bearer action. */
+#define ACTION_PROFILER_CATEGORY(P_ACTION)      ((timeslot_profiler_category_t) (TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER + (P_ACTION)->type))
+
+NRF_MESH_STATIC_ASSERT(TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST - TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER == BEARER_ACTION_TYPE_BROADCAST);
+NRF_MESH_STATIC_ASSERT(TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_TX - TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER == BEARER_ACTION_TYPE_ADV_EXT_TX);
+NRF_MESH_STATIC_ASSERT(TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_RX - TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER == BEARER_ACTION_TYPE_ADV_EXT_RX);
+NRF_MESH_STATIC_ASSERT(TIMESLOT_PROFILER_CATEGORY_ACTION_FLASH - TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER == BEARER_ACTION_TYPE_FLASH);
 /*****************************************************************************
 * Static globals
 *****************************************************************************/
@@ -132,6 +142,7 @@ static void scanner_start(void)
         radio_irq_clear();
         DEBUG_PIN_BEARER_HANDLER_ON(DEBUG_PIN_BEARER_HANDLER_SCANNER);
         m_scanner_is_active = true;
+        TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_SCANNER);
         scanner_radio_start(action_timer_start());
     }
 }
@@ -145,6 +156,7 @@ static void scanner_stop(void)
         DEBUG_PIN_BEARER_HANDLER_ON(DEBUG_PIN_BEARER_HANDLER_SCANNER_STOP);
         scanner_radio_stop();
         m_scanner_is_active = false;
+        TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_IDLE);
         DEBUG_PIN_BEARER_HANDLER_OFF(DEBUG_PIN_BEARER_HANDLER_SCANNER_STOP);
     }
 }
@@ -165,6 +177,7 @@ static void end_handle(void)
 #endif
 
     DEBUG_PIN_BEARER_HANDLER_OFF(DEBUG_PIN_BEARER_HANDLER_ACTION);
+    TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_IDLE);
     mp_action = NULL;
     if (m_stopped)
     {
@@ -181,6 +194,7 @@ static void action_start(bearer_action_t* p_action)
     timeslot_state_lock(true);
     mp_action = p_action;
     radio_irq_clear();
+    TIMESLOT_PROFILER_SWITCH(ACTION_PROFILER_CATEGORY(p_action));
 
     const ts_timestamp_t time_now = action_timer_start();
     m_end_time = time_now + mp_action->duration_us;
@@ -202,6 +216,29 @@ static void action_start(bearer_action_t* p_action)
     }
 }
 
+/**
+ * Packs the actions at the front of the queue into the given action, for as long as the action
+ * accepts them.
+ */
+static void action_pack(bearer_action_t* p_action, ts_timestamp_t available_time)
+{
+    if (p_action->pack_cb == NULL)
+    {
+        return;
+    }
+
+    const ts_timestamp_t max_duration_us = MIN(available_time - BEARER_ACTION_POST_PROCESS_TIME_US,
+                                               BEARER_ACTION_DURATION_MAX_US);
+    const queue_elem_t* p_elem = queue_peek(&m_action_queue);
+    while (p_elem != NULL && p_action->pack_cb(p_action->p_args, p_elem->p_data, max_duration_us))
+    {
+        NRF_MESH_ASSERT(p_action->duration_us <= max_duration_us);
+        NRF_MESH_ASSERT(queue_pop(&m_action_queue) == p_elem);
+        ((bearer_action_t*) p_elem->p_data)->queue_elem.p_data = NULL;
+        p_elem = queue_peek(&m_action_queue);
+    }
+}
+
 static void action_switch(void)
 {
     if (!timeslot_end_is_pending())
@@ -228,6 +265,7 @@ static void action_switch(void)
             NRF_MESH_ASSERT(queue_pop(&m_action_queue) == p_elem);
             p_action->queue_elem.p_data = NULL;
 
+            action_pack(p_action, available_time);
             action_start(p_action);
         }
         else if (available_time > BEARER_SCANNER_MIN_TIME_US)
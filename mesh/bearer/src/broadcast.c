@@ -35,6 +35,8 @@
  * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "broadcast.h"
+
+#include <string.h>
 #include "radio_config.h"
 #include "packet.h"
 #include "debug_pins.h"
@@ -62,6 +64,8 @@
 #error "Device must be one of NRF51 or NRF52."
 #endif
 #define BROADCAST_TIMESLOT_EXTRA_BUFFER_US 50 /* Ask for 50 extra us to account for IRQ locks. */
+/** Time from the end of a packed packet until the radio starts sending the next one. */
+#define BROADCAST_PACKET_SWITCH_OVERHEAD_US (BROADCAST_RADIO_IRQ_OVERHEAD_US + BROADCAST_START_OVERHEAD_US)
 
 #define BROADCAST_SOFTWARE_OVERHEAD_US (BROADCAST_START_OVERHEAD_US + \
                                         BROADCAST_RADIO_IRQ_OVERHEAD_US + \
@@ -87,6 +91,12 @@ register" */
 static uint8_t m_next_channel_index;
 static timestamp_t m_action_start_time; /**< Start of the action (in device time, not timeslot time) */
 
+static broadcast_t * mp_pack[BROADCAST_PACK_COUNT_MAX]; /**< Broadcasts sent in the current action, starting with the action owner. */
+static timestamp_t m_pack_timestamps[BROADCAST_PACK_COUNT_MAX]; /**< Timestamps of the last transmission of each packed broadcast. */
+static uint8_t m_pack_count; /**< Number of broadcasts in @ref mp_pack. */
+static uint8_t m_pack_index; /**< Index of the broadcast being sent on the current channel. */
+static broadcast_stats_t m_stats;
+
 static void configure_timer_capture(void)
 {
     /* Capture the timestamp when the packet address has been sent, to use in reporting. */
@@ -100,13 +110,71 @@ static inline void configure_next_channel(const broadcast_params_t * p_params)
     radio_config_channel_set(p_params->p_channels[m_next_channel_index]);
 }
 
+/** Returns the END to DISABLE short if the first packet on a channel is also the last one. */
+static inline uint32_t first_packet_end_short(void)
+{
+    return (m_pack_count == 1) ? RADIO_SHORTS_END_DISABLE_Msk : 0;
+}
+
 static inline void prepare_last_tx(void)
 {
     NRF_RADIO->SHORTS = (RADIO_SHORTS_READY_START_Msk |
-                         RADIO_SHORTS_END_DISABLE_Msk);
+                         first_packet_end_short());
     mesh_pa_lna_setup_stop();
 }
 
+static void pack_start(broadcast_t * p_broadcast)
+{
+    if (m_pack_count == 0)
+    {
+        mp_pack[0] = p_broadcast;
+        m_pack_count = 1;
+    }
+    NRF_MESH_ASSERT(mp_pack[0] == p_broadcast);
+    m_pack_index = 0;
+}
+
+/** Restarts the pack on the channel the radio is ramping up on. */
+static inline void pack_channel_start(void)
+{
+    m_pack_index = 0;
+    NRF_RADIO->PACKETPTR = (uint32_t) mp_pack[0]->params.p_packet;
+    NRF_RADIO->SHORTS &= ~RADIO_SHORTS_END_DISABLE_Msk;
+}
+
+/**
+ * Sends the next packet in the pack on the current channel. The radio stays in TXIDLE between the
+ * packets, so it doesn't have to ramp up again.
+ */
+static void pack_packet_end(const broadcast_params_t * p_params)
+{
+    if (m_next_channel_index == p_params->channel_count)
+    {
+        m_pack_timestamps[m_pack_index] = m_action_start_time + BEARER_ACTION_TIMER->CC[BROADCAST_TIMER_INDEX_TIMESTAMP];
+    }
+
+    m_pack_index++;
+    if (m_pack_index < m_pack_count)
+    {
+        if (m_pack_index == m_pack_count - 1)
+        {
+            NRF_RADIO->SHORTS |= RADIO_SHORTS_END_DISABLE_Msk;
+        }
+        NRF_RADIO->PACKETPTR = (uint32_t) mp_pack[m_pack_index]->params.p_packet;
+        NRF_RADIO->TASKS_START = 1;
+    }
+}
+
+static bool params_are_compatible(const broadcast_params_t * p_a, const broadcast_params_t * p_b)
+{
+    return (p_a->radio_config.radio_mode == p_b->radio_config.radio_mode &&
+            p_a->radio_config.tx_power == p_b->radio_config.tx_power &&
+            p_a->radio_config.payload_maxlen == p_b->radio_config.payload_maxlen &&
+            p_a->access_address == p_b->access_address &&
+            p_a->channel_count == p_b->channel_count &&
+            memcmp(p_a->p_channels, p_b->p_channels, p_a->channel_count) == 0);
+}
+
 /* Start of the alloted time slice for the broadcast event */
 static void broadcast_start(ts_timestamp_t start_time, void* p_args)
 {
@@ -114,6 +182,7 @@ static void broadcast_start(ts_timestamp_t start_time, void* p_args)
     DEBUG_PIN_BROADCAST_ON(DEBUG_PIN_BROADCAST_ACTIVE);
     broadcast_t * p_broadcast = (broadcast_t *) p_args;
     configure_timer_capture();
+    pack_start(p_broadcast);
 
     radio_config_reset();
     radio_config_config(&p_broadcast->params.radio_config);
@@ -123,7 +192,8 @@ static void broadcast_start(ts_timestamp_t start_time, void* p_args)
     m_action_start_time = ts_timer_to_device_time(start_time);
     NRF_RADIO->PACKETPTR = (uint32_t) p_broadcast->params.p_packet;
     NRF_RADIO->EVENTS_DISABLED = 0;
-    NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk;
+    NRF_RADIO->EVENTS_END = 0;
+    NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk | ((m_pack_count > 1) ? RADIO_INTENSET_END_Msk : 0);
 
 
     /* To set the power amplifier timer, we capture the current timestamp and move it to start some
@@ -140,7 +210,7 @@ static void broadcast_start(ts_timestamp_t start_time, void* p_args)
     {
         /* Fly through DISABLED state right into TXRU after transmission ends */
         NRF_RADIO->SHORTS = RADIO_SHORTS_READY_START_Msk |
-                            RADIO_SHORTS_END_DISABLE_Msk |
+                            first_packet_end_short() |
                             RADIO_SHORTS_DISABLED_TXEN_Msk;
 
         /* Can configure the next channel now, as the radio makes the decision at TXEN. */
@@ -155,9 +225,8 @@ static void broadcast_start(ts_timestamp_t start_time, void* p_args)
     DEBUG_PIN_BROADCAST_OFF(DEBUG_PIN_BROADCAST_START);
 }
 
-static inline void tx_complete_notify_user(broadcast_t * p_broadcast)
+static inline void tx_complete_notify_user(broadcast_t * p_broadcast, timestamp_t tx_timestamp)
 {
-    const timestamp_t tx_timestamp = m_action_start_time + BEARER_ACTION_TIMER->CC[BROADCAST_TIMER_INDEX_TIMESTAMP];
     const ts_timestamp_t user_cb_time_start = ts_timer_now();
     p_broadcast->params.tx_complete_cb(&p_broadcast->params, tx_timestamp);
     const ts_timestamp_t user_cb_time_end = ts_timer_now();
@@ -166,12 +235,26 @@ static inline void tx_complete_notify_user(broadcast_t * p_broadcast)
 #endif
     NRF_MESH_ASSERT(TIMER_OLDER_THAN(user_cb_time_end, user_cb_time_start + USR_SOFTWARE_OVERHEAD_US));
 }
-static inline void end_action(broadcast_t * p_broadcast)
+
+static inline void tx_complete_notify_users(void)
+{
+    m_pack_timestamps[m_pack_count - 1] = m_action_start_time + BEARER_ACTION_TIMER->CC[BROADCAST_TIMER_INDEX_TIMESTAMP];
+    for (uint32_t i = 0; i < m_pack_count; i++)
+    {
+        tx_complete_notify_user(mp_pack[i], m_pack_timestamps[i]);
+    }
+}
+
+static inline void end_action(void)
 {
     DEBUG_PIN_BROADCAST_OFF(DEBUG_PIN_BROADCAST_ACTIVE);
     mesh_pa_lna_cleanup();
     bearer_handler_action_end();
-    p_broadcast->active = false;
+    for (uint32_t i = 0; i < m_pack_count; i++)
+    {
+        mp_pack[i]->active = false;
+    }
+    m_pack_count = 0;
 }
 
 static void radio_irq_handler(void* p_args)
@@ -180,7 +263,20 @@ static void radio_irq_handler(void* p_args)
 
     broadcast_t * p_broadcast = (broadcast_t *) p_args;
 
-    /* We set the interrupt to only trigger on the disabled-event */
+    /* The end-event only triggers an interrupt when several broadcasts are packed into the action. */
+    if (m_pack_count > 1 && NRF_RADIO->EVENTS_END)
+    {
+        NRF_RADIO->EVENTS_END = 0;
+        pack_packet_end(&p_broadcast->params);
+
+        if (!NRF_RADIO->EVENTS_DISABLED)
+        {
+            DEBUG_PIN_BROADCAST_OFF(DEBUG_PIN_BROADCAST_RADIO_EVT);
+            return;
+        }
+    }
+
+    /* Otherwise, we only get interrupts on the disabled-event */
     NRF_MESH_ASSERT(NRF_RADIO->EVENTS_DISABLED);
     NRF_RADIO->EVENTS_DISABLED = 0;
     m_next_channel_index++;
@@ -189,11 +285,16 @@ static void radio_irq_handler(void* p_args)
 
     if (m_next_channel_index > p_broadcast->params.channel_count)
     {
-        tx_complete_notify_user(p_broadcast);
-        end_action(p_broadcast);
+        tx_complete_notify_users();
+        end_action();
     }
     else
     {
+        if (m_pack_count > 1)
+        {
+            pack_channel_start();
+        }
+
         /* Configure the next channel to send on, or enable end event if this is the last channel. */
         if (m_next_channel_index < p_broadcast->params.channel_count)
         {
@@ -214,7 +315,7 @@ static void radio_irq_handler(void* p_args)
     DEBUG_PIN_BROADCAST_OFF(DEBUG_PIN_BROADCAST_RADIO_EVT);
 }
 
-static inline ts_timestamp_t time_required_to_send_us(const packet_t * p_packet, uint8_t channel_count, radio_mode_t radio_mode)
+static inline ts_timestamp_t packet_airtime_us(const packet_t * p_packet, radio_mode_t radio_mode)
 {
     static const uint8_t radio_mode_to_us_per_byte[RADIO_MODE_END] =  {8, 4, 32, 8
                                                             #ifdef NRF52_SERIES
@@ -228,13 +329,64 @@ static inline ts_timestamp_t time_required_to_send_us(const packet_t * p_packet,
         packet_length_in_bytes += RADIO_PREAMBLE_LENGTH_2MBIT_EXTRA_BYTES;
     }
 #endif
+    return packet_length_in_bytes * radio_mode_to_us_per_byte[radio_mode];
+}
+
+static inline ts_timestamp_t time_required_to_send_us(const packet_t * p_packet, uint8_t channel_count, radio_mode_t radio_mode)
+{
     uint32_t radio_time_per_channel = RADIO_RAMPUP_TIME +
-                                      (packet_length_in_bytes * radio_mode_to_us_per_byte[radio_mode]) +
+                                      packet_airtime_us(p_packet, radio_mode) +
                                       RADIO_DISABLE_TO_DISABLED_DELAY_US;
 
     return (BROADCAST_SOFTWARE_OVERHEAD_US + USR_SOFTWARE_OVERHEAD_US + radio_time_per_channel * channel_count);
 }
 
+/** Time added to an action by sending another packet back to back with its packets. */
+static inline ts_timestamp_t time_required_to_pack_us(const packet_t * p_packet, uint8_t channel_count, radio_mode_t radio_mode)
+{
+    uint32_t radio_time_per_channel = BROADCAST_PACKET_SWITCH_OVERHEAD_US +
+                                      packet_airtime_us(p_packet, radio_mode);
+
+    return (USR_SOFTWARE_OVERHEAD_US + radio_time_per_channel * channel_count);
+}
+
+static bool broadcast_pack(void * p_args, const bearer_action_t * p_next, ts_timestamp_t max_duration_us)
+{
+    broadcast_t * p_broadcast = (broadcast_t *) p_args;
+
+    if (p_next->pack_cb != broadcast_pack || m_pack_count == BROADCAST_PACK_COUNT_MAX)
+    {
+        return false;
+    }
+
+    broadcast_t * p_next_broadcast = (broadcast_t *) p_next->p_args;
+    if (!params_are_compatible(&p_broadcast->params, &p_next_broadcast->params))
+    {
+        return false;
+    }
+
+    ts_timestamp_t duration_us = p_broadcast->action.duration_us +
+                                 time_required_to_pack_us(p_next_broadcast->params.p_packet,
+                                                          p_next_broadcast->params.channel_count,
+                                                          p_next_broadcast->params.radio_config.radio_mode);
+    if (duration_us > max_duration_us)
+    {
+        return false;
+    }
+
+    if (m_pack_count == 0)
+    {
+        mp_pack[0] = p_broadcast;
+        m_pack_count = 1;
+    }
+    mp_pack[m_pack_count++] = p_next_broadcast;
+    p_broadcast->action.duration_us = duration_us;
+
+    m_stats.packed_packets++;
+    m_stats.rampups_saved += p_next_broadcast->params.channel_count;
+    return true;
+}
+
 uint32_t broadcast_send(broadcast_t * p_broadcast)
 {
     NRF_MESH_ASSERT(p_broadcast->params.tx_complete_cb != NULL);
@@ -250,7 +402,14 @@ uint32_t broadcast_send(broadcast_t * p_broadcast)
                                  p_broadcast->params.channel_count,
                                  p_broadcast->params.radio_config.radio_mode);
     p_broadcast->action.p_args = p_broadcast;
+    p_broadcast->action.type = BEARER_ACTION_TYPE_BROADCAST;
+    p_broadcast->action.pack_cb = (BROADCAST_PACK_COUNT_MAX > 1) ? broadcast_pack : NULL;
     p_broadcast->active = true;
     NRF_MESH_ASSERT(NRF_SUCCESS == bearer_handler_action_enqueue(&p_broadcast->action));
     return NRF_SUCCESS;
 }
+
+const broadcast_stats_t * broadcast_stats_get(void)
+{
+    return &m_stats;
+}
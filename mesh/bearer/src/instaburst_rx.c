@@ -455,7 +455,9 @@ void instaburst_rx_init(bearer_event_flag_callback_t packet_process_cb)
                        INSTABURST_RX_BUFFER_SIZE);
 
     m_instaburst.bearer_action.p_args = &m_instaburst;
+    m_instaburst.bearer_action.type = BEARER_ACTION_TYPE_ADV_EXT_RX;
     m_instaburst.bearer_action.start_cb = action_start;
+    m_instaburst.bearer_action.pack_cb = NULL;
     m_instaburst.bearer_action.radio_irq_handler = radio_irq_handler;
 
     m_instaburst.process_flag = bearer_event_flag_add(packet_process_cb);
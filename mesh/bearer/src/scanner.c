@@ -35,6 +35,7 @@
  * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "scanner.h"
+#include "scanner_adaptive.h"
 #include "timer_scheduler.h"
 #include "packet_buffer.h"
 #include "toolchain.h"
@@ -44,6 +45,7 @@
 #include "mesh_pa_lna_internal.h"
 #include "nrf_mesh_config_bearer.h"
 #include "bearer_handler.h"
+#include "perf_counter.h"
 
 #ifdef NRF52_SERIES
 #define LNA_SETUP_OVERHEAD_US 1
@@ -95,6 +97,9 @@ typedef struct
     packet_buffer_packet_t * p_buffer_packet;
     scanner_stats_t          stats;
     scanner_config_t         config;
+    scanner_adaptive_t       adaptive;
+    bool                     adaptive_enabled;
+    bool                     window_is_first;       /**< No scan window has been scheduled since the timers were started. */
     timer_event_t            timer_window_start;
     timer_event_t            timer_window_end;
     bearer_event_flag_t      nrf_mesh_process_flag;
@@ -146,6 +151,7 @@ static bool radio_set_packet(void)
     else
     {
         m_scanner.stats.out_of_memory++;
+        PERF_COUNTER_INC(PERF_COUNTER_SCANNER_DROP_NO_MEM);
     }
 
     m_scanner.waiting_for_memory = !got_packet;
@@ -243,13 +249,17 @@ static void radio_handle_end_event(void)
     bool successful_receive = false;
     scanner_packet_t * p_packet = (scanner_packet_t *) m_scanner.p_buffer_packet->packet;
 
+    scanner_adaptive_rx(&m_scanner.adaptive, m_scanner.channel_index, NRF_RADIO->CRCSTATUS);
+
     if (!NRF_RADIO->CRCSTATUS)
     {
         m_scanner.stats.crc_failures++;
+        PERF_COUNTER_INC(PERF_COUNTER_SCANNER_DROP_CRC);
     }
     else if (p_packet->packet.header.length > m_scanner.config.radio_config.payload_maxlen)
     {
         m_scanner.stats.length_out_of_bounds++;
+        PERF_COUNTER_INC(PERF_COUNTER_SCANNER_DROP_LENGTH);
     }
     else
     {
@@ -270,6 +280,7 @@ static void radio_handle_end_event(void)
         p_packet->metadata.adv_type = p_packet->packet.header.type;
 
         m_scanner.stats.successful_receives++;
+        PERF_COUNTER_INC(PERF_COUNTER_SCANNER_RX);
 
         if (m_scanner.rx_callback != NULL)
         {
@@ -457,15 +468,53 @@ static void scan_window_end(uint32_t timestamp, void * p_context)
     radio_trigger();
 }
 
+static void window_length_set(uint32_t timestamp, uint32_t scan_window_us)
+{
+    m_scanner.config.scan_window_us = scan_window_us;
+    if (continuous_scanning())
+    {
+        timer_sch_abort(&m_scanner.timer_window_end);
+    }
+    else
+    {
+        timer_sch_reschedule(&m_scanner.timer_window_end, timestamp + scan_window_us);
+    }
+}
+
+static void adaptive_window_start(uint32_t timestamp)
+{
+    uint8_t channel_index = scanner_adaptive_channel_next(&m_scanner.adaptive);
+    if (channel_index != m_scanner.channel_index || m_scanner.window_state == SCAN_WINDOW_STATE_OFF)
+    {
+        m_scanner.channel_index = channel_index;
+        m_scanner.window_state = SCAN_WINDOW_STATE_NEXT_CHANNEL;
+    }
+    window_length_set(timestamp, scanner_adaptive_window_get(&m_scanner.adaptive));
+}
+
 static void scan_window_start(uint32_t timestamp, void * p_context)
 {
-    channel_iterate();
+    if (!m_scanner.window_is_first)
+    {
+        scanner_adaptive_window_end(&m_scanner.adaptive, m_scanner.channel_index, m_scanner.config.scan_window_us);
+    }
+    m_scanner.window_is_first = false;
+
+    if (m_scanner.adaptive_enabled)
+    {
+        adaptive_window_start(timestamp);
+    }
+    else
+    {
+        channel_iterate();
+    }
     radio_trigger();
 }
 
 static void schedule_timers(void)
 {
     uint32_t time_now = timer_now();
+    m_scanner.window_is_first = true;
 
     if (continuous_scanning())
     {
@@ -573,6 +622,17 @@ const scanner_stats_t * scanner_stats_get(void)
     return &m_scanner.stats;
 }
 
+void scanner_traffic_report_get(scanner_traffic_report_t * p_report)
+{
+    NRF_MESH_ASSERT(p_report != NULL);
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    scanner_adaptive_report_get(&m_scanner.adaptive, SCANNER_RX_CURRENT_UA, p_report);
+    p_report->window_us = m_scanner.config.scan_window_us;
+    _ENABLE_IRQS(was_masked);
+}
+
 bool scanner_rx_pending(void)
 {
     return packet_buffer_can_pop(&m_scanner.packet_buffer);
@@ -588,11 +648,8 @@ void scanner_config_radio_mode_set(radio_mode_t radio_mode)
     m_scanner.is_radio_cfg_pending = true;
 }
 
-void scanner_config_scan_time_set(uint32_t scan_interval_us, uint32_t scan_window_us)
+static void scan_time_apply(uint32_t scan_interval_us, uint32_t scan_window_us)
 {
-    NRF_MESH_ASSERT(scan_interval_us >= scan_window_us);
-    NRF_MESH_ASSERT(scan_interval_us <= MS_TO_US(BEARER_SCAN_INT_MAX_MS));
-    NRF_MESH_ASSERT(scan_window_us >= MS_TO_US(BEARER_SCAN_WIN_MIN_MS));
     m_scanner.config.scan_interval_us = scan_interval_us;
     m_scanner.config.scan_window_us = scan_window_us;
     m_scanner.timer_window_end.interval = m_scanner.config.scan_interval_us;
@@ -603,6 +660,44 @@ void scanner_config_scan_time_set(uint32_t scan_interval_us, uint32_t scan_windo
     }
 }
 
+void scanner_config_scan_time_set(uint32_t scan_interval_us, uint32_t scan_window_us)
+{
+    NRF_MESH_ASSERT(scan_interval_us >= scan_window_us);
+    NRF_MESH_ASSERT(scan_interval_us <= MS_TO_US(BEARER_SCAN_INT_MAX_MS));
+    NRF_MESH_ASSERT(scan_window_us >= MS_TO_US(BEARER_SCAN_WIN_MIN_MS));
+    m_scanner.adaptive_enabled = false;
+    scan_time_apply(scan_interval_us, scan_window_us);
+}
+
+uint32_t scanner_config_adaptive_set(const scanner_adaptive_config_t * p_config)
+{
+    if (p_config == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (p_config->scan_interval_us > MS_TO_US(BEARER_SCAN_INT_MAX_MS) ||
+        p_config->window_min_us < MS_TO_US(BEARER_SCAN_WIN_MIN_MS) ||
+        p_config->window_min_us > p_config->scan_interval_us)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    /* The longest window is the share of the interval the radio can receive in within the budget. */
+    uint32_t window_max_us = (uint32_t) (((uint64_t) p_config->scan_interval_us *
+                                          MIN(p_config->current_budget_ua, SCANNER_RX_CURRENT_UA)) /
+                                         SCANNER_RX_CURRENT_UA);
+    if (window_max_us < p_config->window_min_us)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    scanner_adaptive_window_limits_set(&m_scanner.adaptive, p_config->window_min_us, window_max_us);
+    m_scanner.adaptive_enabled = true;
+    scan_time_apply(p_config->scan_interval_us, scanner_adaptive_window_get(&m_scanner.adaptive));
+    return NRF_SUCCESS;
+}
+
 static bool channels_are_valid(const uint8_t * p_channels, uint8_t channel_count)
 {
     uint8_t valid_channels[] = SCANNER_CHANNELS_DEFAULT;
@@ -633,6 +728,7 @@ void scanner_config_channels_set(const uint8_t * p_channels, uint8_t channel_cou
     memcpy(m_scanner.config.channels, p_channels, channel_count);
     m_scanner.channel_index = 0;
     m_scanner.config.channel_count = channel_count;
+    scanner_adaptive_init(&m_scanner.adaptive, channel_count);
 }
 
 /* The memset() in scanner_config_access_addresses_set() will not have the expected effect
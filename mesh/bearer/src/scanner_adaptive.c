@@ -0,0 +1,204 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "scanner_adaptive.h"
+
+#include <string.h>
+#include "nrf_mesh_assert.h"
+#include "utils.h"
+
+/*****************************************************************************
+* Local defines
+*****************************************************************************/
+/** Weight of the history in the traffic averages, the new sample gets the rest. */
+#define AVERAGE_HISTORY_WEIGHT  (3)
+#define AVERAGE_TOTAL_WEIGHT    (4)
+
+/** Round-robin weight every channel gets regardless of its traffic, 1 packet per second. */
+#define WEIGHT_MIN              (1UL << SCANNER_ADAPTIVE_RATE_SHIFT)
+/** Share of the total channel weight every channel gets regardless of its traffic. */
+#define WEIGHT_SHARE_DIVISOR    (8)
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static uint32_t rate_sample(uint32_t count, uint32_t scan_time_us)
+{
+    uint64_t sample = ((uint64_t) count * (1000000ULL << SCANNER_ADAPTIVE_RATE_SHIFT)) / scan_time_us;
+    return (uint32_t) MIN(sample, UINT32_MAX);
+}
+
+static uint32_t average_update(uint32_t average, uint32_t sample)
+{
+    return (uint32_t) (((uint64_t) average * AVERAGE_HISTORY_WEIGHT + sample) / AVERAGE_TOTAL_WEIGHT);
+}
+
+/** Yield of valid packets, discounted by the share of packets lost to noise. */
+static uint32_t effective_yield(const scanner_adaptive_channel_t * p_channel)
+{
+    uint64_t total = (uint64_t) p_channel->yield + p_channel->noise;
+    if (total == 0)
+    {
+        return 0;
+    }
+    return (uint32_t) (((uint64_t) p_channel->yield * p_channel->yield) / total);
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void scanner_adaptive_init(scanner_adaptive_t * p_adaptive, uint8_t channel_count)
+{
+    NRF_MESH_ASSERT(channel_count > 0 && channel_count <= SCANNER_CHANNELS_MAX);
+    uint32_t window_min_us = p_adaptive->window_min_us;
+    uint32_t window_max_us = p_adaptive->window_max_us;
+    memset(p_adaptive, 0, sizeof(scanner_adaptive_t));
+    p_adaptive->channel_count = channel_count;
+    p_adaptive->window_min_us = window_min_us;
+    p_adaptive->window_max_us = window_max_us;
+}
+
+void scanner_adaptive_window_limits_set(scanner_adaptive_t * p_adaptive, uint32_t window_min_us, uint32_t window_max_us)
+{
+    NRF_MESH_ASSERT(window_min_us <= window_max_us);
+    p_adaptive->window_min_us = window_min_us;
+    p_adaptive->window_max_us = window_max_us;
+}
+
+void scanner_adaptive_rx(scanner_adaptive_t * p_adaptive, uint8_t channel_index, bool crc_ok)
+{
+    NRF_MESH_ASSERT_DEBUG(channel_index < p_adaptive->channel_count);
+    if (crc_ok)
+    {
+        p_adaptive->channels[channel_index].packets++;
+    }
+    else
+    {
+        p_adaptive->channels[channel_index].crc_failures++;
+    }
+}
+
+void scanner_adaptive_window_end(scanner_adaptive_t * p_adaptive, uint8_t channel_index, uint32_t scan_time_us)
+{
+    NRF_MESH_ASSERT(channel_index < p_adaptive->channel_count);
+    scanner_adaptive_channel_t * p_channel = &p_adaptive->channels[channel_index];
+
+    /* The counters are only written from the radio interrupt, take a snapshot of them. */
+    uint32_t packets = p_channel->packets;
+    uint32_t crc_failures = p_channel->crc_failures;
+
+    if (scan_time_us > 0)
+    {
+        p_channel->yield = average_update(p_channel->yield, rate_sample(packets - p_channel->packets_seen, scan_time_us));
+        p_channel->noise = average_update(p_channel->noise, rate_sample(crc_failures - p_channel->crc_failures_seen, scan_time_us));
+        p_channel->scan_time_us += scan_time_us;
+    }
+
+    p_channel->packets_seen = packets;
+    p_channel->crc_failures_seen = crc_failures;
+}
+
+uint8_t scanner_adaptive_channel_next(scanner_adaptive_t * p_adaptive)
+{
+    uint32_t weights[SCANNER_CHANNELS_MAX];
+    uint32_t yield_sum = 0;
+    for (uint32_t i = 0; i < p_adaptive->channel_count; i++)
+    {
+        weights[i] = effective_yield(&p_adaptive->channels[i]);
+        yield_sum += weights[i];
+    }
+
+    /* Smooth weighted round-robin: every channel earns its weight in credit, and the richest
+     * channel pays the total weight for being picked. */
+    const uint32_t weight_floor = WEIGHT_MIN + yield_sum / WEIGHT_SHARE_DIVISOR;
+    int32_t weight_sum = 0;
+    uint8_t next = 0;
+    for (uint32_t i = 0; i < p_adaptive->channel_count; i++)
+    {
+        int32_t weight = (int32_t) MIN(weights[i] + weight_floor, INT32_MAX / SCANNER_CHANNELS_MAX);
+        p_adaptive->channels[i].credit += weight;
+        weight_sum += weight;
+        if (p_adaptive->channels[i].credit > p_adaptive->channels[next].credit)
+        {
+            next = i;
+        }
+    }
+    p_adaptive->channels[next].credit -= weight_sum;
+    return next;
+}
+
+uint32_t scanner_adaptive_window_get(const scanner_adaptive_t * p_adaptive)
+{
+    uint32_t best_yield = 0;
+    for (uint32_t i = 0; i < p_adaptive->channel_count; i++)
+    {
+        best_yield = MAX(best_yield, effective_yield(&p_adaptive->channels[i]));
+    }
+
+    const uint64_t half_yield = (uint64_t) SCANNER_ADAPTIVE_HALF_RATE << SCANNER_ADAPTIVE_RATE_SHIFT;
+    if (best_yield + half_yield == 0)
+    {
+        return p_adaptive->window_max_us;
+    }
+
+    const uint32_t range_us = p_adaptive->window_max_us - p_adaptive->window_min_us;
+    return p_adaptive->window_min_us + (uint32_t) (((uint64_t) range_us * best_yield) / (best_yield + half_yield));
+}
+
+void scanner_adaptive_report_get(const scanner_adaptive_t * p_adaptive,
+                                 uint32_t rx_current_ua,
+                                 scanner_traffic_report_t * p_report)
+{
+    uint64_t scan_time_us = 0;
+    uint64_t packets = 0;
+
+    p_report->channel_count = p_adaptive->channel_count;
+    for (uint32_t i = 0; i < SCANNER_CHANNELS_MAX; i++)
+    {
+        const scanner_adaptive_channel_t * p_channel = &p_adaptive->channels[i];
+        p_report->packets[i] = p_channel->packets;
+        p_report->crc_failures[i] = p_channel->crc_failures;
+        p_report->scan_time_ms[i] = (uint32_t) (p_channel->scan_time_us / 1000);
+        scan_time_us += p_channel->scan_time_us;
+        packets += p_channel->packets;
+    }
+
+    const uint64_t charge_ua_ms = (scan_time_us * rx_current_ua) / 1000;
+    p_report->charge_mas = (uint32_t) (charge_ua_ms / 1000000);
+    p_report->packets_per_mas_x100 = (charge_ua_ms == 0) ? 0 : (uint32_t) ((packets * 100000000ULL) / charge_ua_ms);
+}
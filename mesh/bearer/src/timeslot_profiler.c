@@ -0,0 +1,219 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timeslot_profiler.h"
+
+#include <string.h>
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "toolchain.h"
+#include "log.h"
+#include "utils.h"
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+#if TIMESLOT_PROFILER_ENABLE
+static timeslot_profiler_stats_t m_stats;
+static timeslot_profiler_category_t m_category; /**< Current category. */
+static timestamp_t m_category_start;            /**< Start time of the current category. */
+static timestamp_t m_ts_start;                  /**< Start time of the current timeslot. */
+static uint32_t m_ts_busy_us;                   /**< Radio time used in the current timeslot. */
+#endif
+
+#if TIMESLOT_PROFILER_ENABLE && NRF_MESH_LOG_ENABLE
+static const char * const m_category_names[] =
+{
+    [TIMESLOT_PROFILER_CATEGORY_EXTEND]            = "extend",
+    [TIMESLOT_PROFILER_CATEGORY_IDLE]              = "idle",
+    [TIMESLOT_PROFILER_CATEGORY_SCANNER]           = "scanner",
+    [TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER]      = "action other",
+    [TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST]  = "action broadcast",
+    [TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_TX] = "action adv ext tx",
+    [TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_RX] = "action adv ext rx",
+    [TIMESLOT_PROFILER_CATEGORY_ACTION_FLASH]      = "action flash",
+};
+NRF_MESH_STATIC_ASSERT(ARRAY_SIZE(m_category_names) == TIMESLOT_PROFILER_CATEGORY__LAST);
+#endif
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+#if TIMESLOT_PROFILER_ENABLE
+static inline bool category_uses_radio(timeslot_profiler_category_t category)
+{
+    return (category >= TIMESLOT_PROFILER_CATEGORY_SCANNER);
+}
+
+/** Attributes the time since the last change to the current category. */
+static void time_account(timestamp_t timestamp)
+{
+    uint32_t elapsed = timestamp - m_category_start;
+    m_stats.time_us[m_category] += elapsed;
+    if (category_uses_radio(m_category))
+    {
+        m_ts_busy_us += elapsed;
+    }
+    m_category_start = timestamp;
+}
+#endif
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void timeslot_profiler_ts_begin(timestamp_t timestamp)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    m_stats.timeslot_count++;
+    m_category = TIMESLOT_PROFILER_CATEGORY_EXTEND;
+    m_category_start = timestamp;
+    m_ts_start = timestamp;
+    m_ts_busy_us = 0;
+#endif
+}
+
+void timeslot_profiler_ts_end(timestamp_t timestamp)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    time_account(timestamp);
+
+    uint32_t length_us = timestamp - m_ts_start;
+    if (length_us > 0)
+    {
+        uint32_t bucket = ((uint64_t) m_ts_busy_us * TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT) / length_us;
+        m_stats.duty_cycle[MIN(bucket, TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT - 1)]++;
+    }
+#endif
+}
+
+void timeslot_profiler_switch(timeslot_profiler_category_t category, timestamp_t timestamp)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    NRF_MESH_ASSERT_DEBUG(category < TIMESLOT_PROFILER_CATEGORY__LAST);
+    time_account(timestamp);
+    m_category = category;
+#endif
+}
+
+void timeslot_profiler_extend_end(bool success)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    m_stats.extend_count++;
+    if (!success)
+    {
+        m_stats.extend_fail_count++;
+    }
+#endif
+}
+
+void timeslot_profiler_blocked(void)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    m_stats.blocked_count++;
+#endif
+}
+
+void timeslot_profiler_canceled(void)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    m_stats.canceled_count++;
+#endif
+}
+
+uint32_t timeslot_profiler_stats_get(timeslot_profiler_stats_t * p_stats)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    if (p_stats == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    *p_stats = m_stats;
+    _ENABLE_IRQS(was_masked);
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+void timeslot_profiler_clear(void)
+{
+#if TIMESLOT_PROFILER_ENABLE
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    memset(&m_stats, 0, sizeof(m_stats));
+    _ENABLE_IRQS(was_masked);
+#endif
+}
+
+void timeslot_profiler_dump(void)
+{
+#if TIMESLOT_PROFILER_ENABLE && NRF_MESH_LOG_ENABLE
+    timeslot_profiler_stats_t stats;
+    (void) timeslot_profiler_stats_get(&stats);
+
+    uint64_t total_us = 0;
+    for (uint32_t i = 0; i < TIMESLOT_PROFILER_CATEGORY__LAST; i++)
+    {
+        total_us += stats.time_us[i];
+    }
+
+    __LOG(LOG_SRC_BEARER, LOG_LEVEL_REPORT, "timeslots: %u, extensions: %u (%u failed), blocked: %u, canceled: %u\n",
+          stats.timeslot_count, stats.extend_count, stats.extend_fail_count, stats.blocked_count, stats.canceled_count);
+
+    for (uint32_t i = 0; i < TIMESLOT_PROFILER_CATEGORY__LAST; i++)
+    {
+        __LOG(LOG_SRC_BEARER, LOG_LEVEL_REPORT, "%s: %u ms (%u %%)\n",
+              m_category_names[i],
+              (uint32_t) (stats.time_us[i] / 1000),
+              (total_us == 0) ? 0 : (uint32_t) ((stats.time_us[i] * 100) / total_us));
+    }
+
+    for (uint32_t bucket = 0; bucket < TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT; bucket++)
+    {
+        if (stats.duty_cycle[bucket] != 0)
+        {
+            __LOG(LOG_SRC_BEARER, LOG_LEVEL_REPORT, "duty cycle [%u %%, %u %%): %u\n",
+                  (bucket * 100) / TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT,
+                  ((bucket + 1) * 100) / TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT,
+                  stats.duty_cycle[bucket]);
+        }
+    }
+#endif
+}
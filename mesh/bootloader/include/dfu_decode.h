@@ -0,0 +1,114 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DFU_DECODE_H__
+#define DFU_DECODE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Decoder for compressed and delta encoded firmware images.
+ *
+ * The encoded image is a sequence of commands, each starting with a header byte:
+ *
+ * - 0x00-0x7F: Literal. (header & 0x7F) + 1 bytes of firmware follow the header.
+ * - 0x80-0xBF: Match. Repeat (header & 0x3F) + 4 bytes of the decoded firmware, starting the number
+ *   of bytes back given by the following 2 byte little endian distance.
+ * - 0xC0-0xFF: Base copy. Copy ((header & 0x3F) << 8 | next byte) + 1 bytes from the firmware
+ *   currently on the device, starting at the 3 byte little endian offset that follows.
+ *
+ * Decoding stops once the decoded firmware has reached its full length, any data after that is
+ * padding. The decoder works on whatever prefix of the encoded image is available, and picks up
+ * where it left off when more of it arrives.
+ */
+
+#define DFU_DECODE_CMD_LITERAL          (0x00)
+#define DFU_DECODE_CMD_MATCH            (0x80)
+#define DFU_DECODE_CMD_BASE_COPY        (0xC0)
+
+#define DFU_DECODE_LITERAL_LEN_MAX      (0x80)
+#define DFU_DECODE_MATCH_LEN_MIN        (4)
+#define DFU_DECODE_MATCH_LEN_MAX        (0x3F + DFU_DECODE_MATCH_LEN_MIN)
+#define DFU_DECODE_MATCH_DISTANCE_MAX   (0xFFFF)
+#define DFU_DECODE_BASE_COPY_LEN_MAX    (0x4000)
+
+typedef struct
+{
+    const uint8_t* p_base;      /**< Firmware to copy unchanged parts from, or NULL. */
+    uint32_t base_length;       /**< Length of the base firmware. */
+    const uint8_t* p_output;    /**< Where the decoded firmware is stored. */
+    uint32_t output_length;     /**< Full length of the decoded firmware. */
+    uint8_t* p_buffer;          /**< Buffer for decoded firmware that hasn't been stored yet. */
+    uint32_t buffer_size;       /**< Size of the buffer. */
+    uint32_t input_pos;         /**< Position of the next byte to read from the encoded image. */
+    uint32_t output_pos;        /**< Number of decoded bytes. */
+    uint32_t stored;            /**< Number of decoded bytes that have been stored. */
+    uint32_t remaining;         /**< Bytes left of the current command. */
+    uint32_t source;            /**< Source position or distance of the current command. */
+    uint8_t cmd;                /**< Current command type. */
+} dfu_decode_t;
+
+void dfu_decode_init(dfu_decode_t* p_decode,
+        const uint8_t* p_base,
+        uint32_t base_length,
+        const uint8_t* p_output,
+        uint32_t output_length,
+        uint8_t* p_buffer,
+        uint32_t buffer_size);
+
+/**
+ * Decode the available part of the encoded image into the buffer.
+ *
+ * @param[in,out] p_decode     Decoder instance.
+ * @param[in]     p_input      Start of the encoded image.
+ * @param[in]     input_length Number of bytes of the encoded image that are available.
+ *
+ * @retval NRF_SUCCESS            Decoded as much as possible, until the input ran out or the buffer
+ *                                was filled.
+ * @retval NRF_ERROR_INVALID_DATA The encoded image refers to data outside the firmware.
+ */
+uint32_t dfu_decode_run(dfu_decode_t* p_decode, const uint8_t* p_input, uint32_t input_length);
+
+/** Get the number of decoded bytes in the buffer. */
+uint32_t dfu_decode_pending_get(const dfu_decode_t* p_decode);
+
+/** Mark the contents of the buffer as stored, and make it available for more decoding. */
+void dfu_decode_stored(dfu_decode_t* p_decode);
+
+bool dfu_decode_is_done(const dfu_decode_t* p_decode);
+
+#endif /* DFU_DECODE_H__ */
@@ -47,11 +47,16 @@
 #define DFU_PACKET_LEN_STATE_SD     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_state_t) - sizeof(fwid_union_t) + DFU_FWID_LEN_SD)
 #define DFU_PACKET_LEN_STATE_BL     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_state_t) - sizeof(fwid_union_t) + DFU_FWID_LEN_BL)
 #define DFU_PACKET_LEN_STATE_APP    (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_state_t) - sizeof(fwid_union_t) + DFU_FWID_LEN_APP)
-#define DFU_PACKET_LEN_START        (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_start_t))
+#define DFU_PACKET_LEN_START        (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_start_t) - sizeof(uint32_t))
+#define DFU_PACKET_LEN_START_ENCODED (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_start_t))
 #define DFU_PACKET_LEN_DATA         (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_t))
-#define DFU_PACKET_LEN_DATA_REQ     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_req_t))
+#define DFU_PACKET_LEN_DATA_REQ     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_req_t) - DFU_DATA_REQ_BITMAP_LEN)
+#define DFU_PACKET_LEN_DATA_REQ_RANGED (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_req_t))
 #define DFU_PACKET_LEN_DATA_RSP     (DFU_PACKET_LEN_OVERHEAD + sizeof(dfu_packet_data_rsp_t))
 
+/** Length of the missing segment bitmap in ranged data requests. Makes the request as long as a data packet. */
+#define DFU_DATA_REQ_BITMAP_LEN     (SEGMENT_LENGTH)
+
 #define DFU_PACKET_ADV_OVERHEAD     (1 /* adv_type */ + 2 /* UUID */) /* overhead inside adv data */
 #define DFU_PACKET_OVERHEAD         (MESH_PACKET_BLE_OVERHEAD + 1 + DFU_PACKET_ADV_OVERHEAD) /* dfu packet total overhead */
 
@@ -78,7 +83,8 @@ typedef struct __attribute((packed))
     fwid_union_t fwid;
 } dfu_packet_state_t;
 
-/** DFU start packet payload */
+/** DFU start packet payload. Transfers with the diff flag set are compressed or delta encoded, and
+ * have the length of the encoded firmware at the end of the packet. */
 typedef struct __attribute((packed))
 {
     uint16_t segment;
@@ -91,6 +97,7 @@ typedef struct __attribute((packed))
     uint8_t first       : 1;
     uint8_t last        : 1;
     uint8_t _rfu        : 4;
+    uint32_t encoded_length; /* in words */
 } dfu_packet_start_t;
 
 /** DFU data packet payload */
@@ -101,11 +108,13 @@ typedef struct __attribute((packed))
     uint8_t data[SEGMENT_LENGTH];
 } dfu_packet_data_t;
 
-/** DFU data request packet payload */
+/** DFU data request packet payload. The bitmap is only present in ranged requests, where bit n
+ * (LSB first) marks segment + 1 + n as missing too. */
 typedef struct __attribute((packed))
 {
     uint16_t segment;
     uint32_t transaction_id;
+    uint8_t missing_bitmap[DFU_DATA_REQ_BITMAP_LEN];
 } dfu_packet_data_req_t;
 
 /** DFU data response packet payload */
@@ -41,6 +41,12 @@
 #include <stdbool.h>
 #include "sha256.h"
 
+typedef struct
+{
+    uint16_t segments_lost;      /**< Segments that were skipped when receiving the transfer. */
+    uint16_t segments_recovered; /**< Skipped segments that were received later on. */
+} dfu_transfer_stats_t;
+
 void dfu_transfer_init(void);
 
 uint32_t dfu_transfer_start(
@@ -58,8 +64,18 @@ bool dfu_transfer_get_oldest_missing_entry(
         uint32_t** pp_entry,
         uint32_t* p_len);
 
+uint16_t dfu_transfer_missing_bitmap_get(uint32_t* p_start_addr, uint8_t* p_bitmap, uint16_t segment_count);
+
+uint32_t dfu_transfer_encoded_set(uint32_t encoded_size, const uint8_t* p_base, uint32_t base_length);
+
+bool dfu_transfer_is_finished(void);
+
+void dfu_transfer_sha256_stream_start(const sha256_context_t* p_hash_context);
+
 uint32_t dfu_transfer_sha256(sha256_context_t* p_hash_context);
 
+void dfu_transfer_stats_get(dfu_transfer_stats_t* p_stats);
+
 void dfu_transfer_end(void);
 
 void dfu_transfer_flash_write_complete(uint8_t* p_write_src);
@@ -101,6 +101,24 @@
 
 #define SEGMENT_LENGTH              (16)
 
+/** Largest area a DFU transfer can cover: everything between the MBR page and the bootloader info bank. */
+#define DFU_TRANSFER_SIZE_MAX       (BOOTLOADER_INFO_BANK_ADDRESS - PAGE_SIZE)
+
+/** Number of segments the DFU transfer can keep track of. Each segment takes one bit of RAM. */
+#ifndef DFU_TRANSFER_SEGMENT_COUNT_MAX
+#define DFU_TRANSFER_SEGMENT_COUNT_MAX (DFU_TRANSFER_SIZE_MAX / SEGMENT_LENGTH)
+#endif
+
+/** Size of the RAM buffer holding compressed or delta encoded firmware while it's being decoded.
+ * Limits the size of encoded transfers, set to 0 to disable them. */
+#ifndef DFU_ENCODED_STAGING_SIZE
+#ifdef NRF51
+#define DFU_ENCODED_STAGING_SIZE    (0)
+#else
+#define DFU_ENCODED_STAGING_SIZE    (16 * 1024)
+#endif
+#endif
+
 #define DFU_AUTHORITY_MAX           (0x07)
 
 #define DFU_FWID_LEN_APP            (10)
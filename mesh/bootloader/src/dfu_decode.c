@@ -0,0 +1,204 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "dfu_decode.h"
+#include "nrf_error.h"
+
+/*****************************************************************************
+* Local defines
+*****************************************************************************/
+#define CMD_NONE                (0xFF)
+
+#define LITERAL_HEADER_LEN      (1)
+#define MATCH_HEADER_LEN        (3)
+#define BASE_COPY_HEADER_LEN    (5)
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static uint8_t output_byte_get(const dfu_decode_t* p_decode, uint32_t pos)
+{
+    if (pos < p_decode->stored)
+    {
+        return p_decode->p_output[pos];
+    }
+    return p_decode->p_buffer[pos - p_decode->stored];
+}
+
+/** Parse the next command header, if all of it is available. */
+static uint32_t command_start(dfu_decode_t* p_decode, const uint8_t* p_input, uint32_t input_length, bool* p_started)
+{
+    const uint8_t* p_header = &p_input[p_decode->input_pos];
+    uint32_t available = input_length - p_decode->input_pos;
+    *p_started = false;
+
+    if (available < LITERAL_HEADER_LEN)
+    {
+        return NRF_SUCCESS;
+    }
+
+    uint8_t cmd = p_header[0] & DFU_DECODE_CMD_BASE_COPY;
+    if (cmd < DFU_DECODE_CMD_MATCH)
+    {
+        p_decode->cmd = DFU_DECODE_CMD_LITERAL;
+        p_decode->remaining = (p_header[0] & 0x7F) + 1;
+        p_decode->input_pos += LITERAL_HEADER_LEN;
+    }
+    else if (cmd == DFU_DECODE_CMD_MATCH)
+    {
+        if (available < MATCH_HEADER_LEN)
+        {
+            return NRF_SUCCESS;
+        }
+        p_decode->cmd = DFU_DECODE_CMD_MATCH;
+        p_decode->remaining = (p_header[0] & 0x3F) + DFU_DECODE_MATCH_LEN_MIN;
+        p_decode->source = p_header[1] | (p_header[2] << 8);
+        if (p_decode->source == 0 || p_decode->source > p_decode->output_pos)
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+        p_decode->input_pos += MATCH_HEADER_LEN;
+    }
+    else
+    {
+        if (available < BASE_COPY_HEADER_LEN)
+        {
+            return NRF_SUCCESS;
+        }
+        p_decode->cmd = DFU_DECODE_CMD_BASE_COPY;
+        p_decode->remaining = (((p_header[0] & 0x3F) << 8) | p_header[1]) + 1;
+        p_decode->source = p_header[2] | (p_header[3] << 8) | (p_header[4] << 16);
+        if (p_decode->p_base == NULL ||
+            p_decode->source + p_decode->remaining > p_decode->base_length)
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+        p_decode->input_pos += BASE_COPY_HEADER_LEN;
+    }
+
+    if (p_decode->output_pos + p_decode->remaining > p_decode->output_length)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+    *p_started = true;
+    return NRF_SUCCESS;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void dfu_decode_init(dfu_decode_t* p_decode,
+        const uint8_t* p_base,
+        uint32_t base_length,
+        const uint8_t* p_output,
+        uint32_t output_length,
+        uint8_t* p_buffer,
+        uint32_t buffer_size)
+{
+    memset(p_decode, 0, sizeof(dfu_decode_t));
+    p_decode->p_base = p_base;
+    p_decode->base_length = base_length;
+    p_decode->p_output = p_output;
+    p_decode->output_length = output_length;
+    p_decode->p_buffer = p_buffer;
+    p_decode->buffer_size = buffer_size;
+    p_decode->cmd = CMD_NONE;
+}
+
+uint32_t dfu_decode_run(dfu_decode_t* p_decode, const uint8_t* p_input, uint32_t input_length)
+{
+    while (p_decode->output_pos - p_decode->stored < p_decode->buffer_size)
+    {
+        if (p_decode->remaining == 0)
+        {
+            if (p_decode->output_pos == p_decode->output_length)
+            {
+                break;
+            }
+
+            bool started;
+            uint32_t status = command_start(p_decode, p_input, input_length, &started);
+            if (status != NRF_SUCCESS)
+            {
+                return status;
+            }
+            if (!started)
+            {
+                break;
+            }
+        }
+
+        uint8_t byte;
+        switch (p_decode->cmd)
+        {
+            case DFU_DECODE_CMD_LITERAL:
+                if (p_decode->input_pos >= input_length)
+                {
+                    return NRF_SUCCESS;
+                }
+                byte = p_input[p_decode->input_pos++];
+                break;
+            case DFU_DECODE_CMD_MATCH:
+                byte = output_byte_get(p_decode, p_decode->output_pos - p_decode->source);
+                break;
+            default:
+                byte = p_decode->p_base[p_decode->source++];
+                break;
+        }
+
+        p_decode->p_buffer[p_decode->output_pos - p_decode->stored] = byte;
+        p_decode->output_pos++;
+        p_decode->remaining--;
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t dfu_decode_pending_get(const dfu_decode_t* p_decode)
+{
+    return p_decode->output_pos - p_decode->stored;
+}
+
+void dfu_decode_stored(dfu_decode_t* p_decode)
+{
+    p_decode->stored = p_decode->output_pos;
+}
+
+bool dfu_decode_is_done(const dfu_decode_t* p_decode)
+{
+    return (p_decode->output_pos == p_decode->output_length);
+}
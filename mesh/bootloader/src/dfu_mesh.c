@@ -104,11 +104,14 @@ typedef struct
     uint32_t*       p_indicated_start_addr;
     uint32_t*       p_last_requested_entry;
     uint32_t        length;
+    uint32_t        encoded_length;
+    uint32_t        base_length;
     uint32_t        signature_length;
     uint8_t         signature[DFU_SIGNATURE_LEN];
     uint8_t         signature_bitmap;
     uint16_t        segments_remaining;
     uint16_t        segment_count;
+    uint16_t        requests_sent;
     fwid_union_t    target_fwid_union;
     bool            segment_is_valid_after_transfer;
     bool            flood;
@@ -224,14 +227,55 @@ static void get_info_pointers(void)
     }
 }
 
-static uint32_t segment_count_from_start_packet(dfu_packet_t* p_packet)
+/**
+ * Get the number of bytes of the current firmware that delta encoded transfers may copy from.
+ *
+ * The base ends at the bank, as the bank is erased and rewritten during the transfer, and at the end
+ * of the current firmware, so only programmed flash is read.
+ */
+static uint32_t base_length_get(const bl_info_segment_t* p_segment)
+{
+    if (m_transaction.p_bank_addr == m_transaction.p_start_addr)
+    {
+        /* Single banked transfers overwrite the base. */
+        return 0;
+    }
+
+    uint32_t start = (uint32_t) m_transaction.p_start_addr;
+    uint32_t end = p_segment->start + p_segment->length;
+    if ((uint32_t) m_transaction.p_bank_addr > start &&
+        (uint32_t) m_transaction.p_bank_addr < end)
+    {
+        end = (uint32_t) m_transaction.p_bank_addr;
+    }
+    if (start < p_segment->start || end <= start)
+    {
+        return 0;
+    }
+
+    /* The current firmware ends at the last programmed word. */
+    const uint32_t* p_word = (const uint32_t*) (end & ~(sizeof(uint32_t) - 1));
+    while ((uint32_t) p_word > start && *(p_word - 1) == 0xFFFFFFFF)
+    {
+        p_word--;
+    }
+    return (uint32_t) p_word - start;
+}
+
+static uint32_t segment_count_from_start_packet(dfu_packet_t* p_packet, uint16_t length)
 {
     uint32_t start_address = p_packet->payload.start.start_address;
     if (start_address == 0xFFFFFFFF)
     {
         start_address = 0; /* It'll be aligned. */
     }
-    uint32_t segment_count = ((p_packet->payload.start.length * 4) + (start_address & 0x0F) - 1) / 16 + 1;
+    /* Encoded transfers only send the encoded firmware. */
+    uint32_t transfer_length = p_packet->payload.start.length;
+    if (p_packet->payload.start.diff && length >= DFU_PACKET_LEN_START_ENCODED)
+    {
+        transfer_length = p_packet->payload.start.encoded_length;
+    }
+    uint32_t segment_count = ((transfer_length * 4) + (start_address & 0x0F) - 1) / 16 + 1;
 
     if (p_packet->payload.start.signature_length != 0)
     {
@@ -302,6 +346,32 @@ static uint32_t packet_tx_dynamic(dfu_packet_t* p_packet,
     return status;
 }
 
+/** Start a signature hash with the transaction parameters. The firmware itself is hashed after these. */
+static void hash_init(sha256_context_t* p_hash_context)
+{
+    sha256_init(p_hash_context);
+    sha256_update(p_hash_context, (uint8_t*) &m_transaction.type, 1);
+    sha256_update(p_hash_context, (uint8_t*) &m_transaction.p_indicated_start_addr, 4);
+    sha256_update(p_hash_context, (uint8_t*) &m_transaction.length, 4);
+    uint8_t padding = 0;
+    sha256_update(p_hash_context, &padding, 1);
+
+    switch (m_transaction.type)
+    {
+        case DFU_TYPE_APP:
+            sha256_update(p_hash_context, (uint8_t*) &m_transaction.target_fwid_union, DFU_FWID_LEN_APP);
+            break;
+        case DFU_TYPE_SD:
+            sha256_update(p_hash_context, (uint8_t*) &m_transaction.target_fwid_union, DFU_FWID_LEN_SD);
+            break;
+        case DFU_TYPE_BOOTLOADER:
+            sha256_update(p_hash_context, (uint8_t*) &m_transaction.target_fwid_union, DFU_FWID_LEN_BL);
+            break;
+        default:
+            break;
+    }
+}
+
 static bool signature_check(void)
 {
     __LOG("Verifying signature... ");
@@ -321,28 +391,7 @@ static bool signature_check(void)
 
     uint8_t hash[uECC_BYTES];
     sha256_context_t hash_context;
-    sha256_init(&hash_context);
-    sha256_update(&hash_context, (uint8_t*) &m_transaction.type, 1);
-    sha256_update(&hash_context, (uint8_t*) &m_transaction.p_indicated_start_addr, 4);
-    sha256_update(&hash_context, (uint8_t*) &m_transaction.length, 4);
-    uint8_t padding = 0;
-    sha256_update(&hash_context, &padding, 1);
-
-    switch (m_transaction.type)
-    {
-        case DFU_TYPE_APP:
-            sha256_update(&hash_context, (uint8_t*) &m_transaction.target_fwid_union, DFU_FWID_LEN_APP);
-            break;
-        case DFU_TYPE_SD:
-            sha256_update(&hash_context, (uint8_t*) &m_transaction.target_fwid_union, DFU_FWID_LEN_SD);
-            break;
-        case DFU_TYPE_BOOTLOADER:
-            sha256_update(&hash_context, (uint8_t*) &m_transaction.target_fwid_union, DFU_FWID_LEN_BL);
-            break;
-        default:
-            break;
-    }
-
+    hash_init(&hash_context);
     dfu_transfer_sha256(&hash_context);
 #if NORDIC_SDK_VERSION >= 11
     sha256_final(&hash_context, hash, false);
@@ -633,12 +682,33 @@ static void start_target(void)
     }
 
     __LOG("Transferring...\n");
-    if (dfu_transfer_start(
+    uint32_t status = dfu_transfer_start(
                 m_transaction.p_start_addr,
                 m_transaction.p_bank_addr,
                 m_transaction.length,
-                m_transaction.segment_is_valid_after_transfer) == NRF_SUCCESS)
+                m_transaction.segment_is_valid_after_transfer);
+    if (status == NRF_SUCCESS && m_transaction.encoded_length != 0)
     {
+        /* Delta encoded parts can only be copied from the current firmware if we're not
+         * overwriting it. */
+        const uint8_t* p_base = NULL;
+        if (m_transaction.p_bank_addr != m_transaction.p_start_addr)
+        {
+            p_base = (const uint8_t*) m_transaction.p_start_addr;
+        }
+        status = dfu_transfer_encoded_set(m_transaction.encoded_length, p_base, m_transaction.base_length);
+    }
+
+    if (status == NRF_SUCCESS)
+    {
+        if (m_transaction.signature_length != 0 && m_bl_info_pointers.p_ecdsa_public_key != NULL)
+        {
+            /* Hash the firmware as it comes in, to save time on the signature check at the end. */
+            sha256_context_t hash_context;
+            hash_init(&hash_context);
+            dfu_transfer_sha256_stream_start(&hash_context);
+        }
+
         bl_evt_t abort_evt;
         abort_evt.type = BL_EVT_TYPE_TX_ABORT;
         abort_evt.params.tx.abort.tx_slot = TX_SLOT_BEACON;
@@ -659,6 +729,11 @@ static void start_target(void)
 
 static void start_rampdown(void)
 {
+    dfu_transfer_stats_t stats;
+    dfu_transfer_stats_get(&stats);
+    __LOG("Recovery: %u segments lost, %u recovered, %u requests\n",
+          stats.segments_lost, stats.segments_recovered, m_transaction.requests_sent);
+
     bl_evt_t timer_evt;
     timer_evt.type = BL_EVT_TYPE_TIMER_SET;
     timer_evt.params.timer.set.delay_us = STATE_TIMEOUT_RAMPDOWN;
@@ -703,11 +778,28 @@ static void request_missing_data(uint16_t prev_segment)
         req_packet.payload.req_data.segment = ADDR_SEGMENT(p_req_entry, m_transaction.p_start_addr);
         req_packet.payload.req_data.transaction_id = m_transaction.transaction_id;
 
+        /* Ask for the other missing segments that follow in the same request, so that neighbors can
+         * serve them all at once. Leave out the ones that may still be on their way. */
+        uint32_t bitmap_segments = DFU_DATA_REQ_BITMAP_LEN * 8;
+        if (m_transaction.segment_count != prev_segment &&
+            bitmap_segments > (uint32_t) (prev_segment - 2 - req_packet.payload.req_data.segment))
+        {
+            bitmap_segments = prev_segment - 2 - req_packet.payload.req_data.segment;
+        }
+        uint16_t req_length = DFU_PACKET_LEN_DATA_REQ;
+        if (dfu_transfer_missing_bitmap_get(
+                    (uint32_t*) SEGMENT_ADDR(req_packet.payload.req_data.segment + 1, m_transaction.p_start_addr),
+                    req_packet.payload.req_data.missing_bitmap,
+                    bitmap_segments) > 0)
+        {
+            req_length = DFU_PACKET_LEN_DATA_REQ_RANGED;
+        }
+
         /* Use beacon slot */
         bl_evt_t tx_evt;
         tx_evt.type = BL_EVT_TYPE_TX_RADIO;
         tx_evt.params.tx.radio.p_dfu_packet = &req_packet;
-        tx_evt.params.tx.radio.length = DFU_PACKET_LEN_DATA_REQ;
+        tx_evt.params.tx.radio.length = req_length;
         tx_evt.params.tx.radio.interval_type = TX_INTERVAL_TYPE_REQ;
         tx_evt.params.tx.radio.tx_count = TX_REPEATS_REQ;
         tx_evt.params.tx.radio.tx_slot = TX_SLOT_BEACON;
@@ -716,12 +808,13 @@ static void request_missing_data(uint16_t prev_segment)
         {
             m_transaction.p_last_requested_entry = (uint32_t*) p_req_entry;
             m_data_req_segment = req_packet.payload.req_data.segment;
-            __LOG("TX REQ FOR 0x%x\n", m_data_req_segment);
+            m_transaction.requests_sent++;
+            __LOG("TX REQ FOR 0x%x%s\n", m_data_req_segment, (req_length == DFU_PACKET_LEN_DATA_REQ_RANGED) ? " (ranged)" : "");
         }
     }
 }
 /*************** Packet handlers ******************/
-static void target_rx_start(dfu_packet_t* p_packet, bool* p_do_relay)
+static void target_rx_start(dfu_packet_t* p_packet, uint16_t length, bool* p_do_relay)
 {
     bl_info_segment_t* p_segment = NULL;
     switch (m_transaction.type)
@@ -746,12 +839,13 @@ static void target_rx_start(dfu_packet_t* p_packet, bool* p_do_relay)
     {
         start_address = p_segment->start;
     }
-    uint32_t segment_count = segment_count_from_start_packet(p_packet);
+    uint32_t segment_count = segment_count_from_start_packet(p_packet, length);
 
     m_transaction.segments_remaining                = segment_count;
     m_transaction.segment_count                     = segment_count;
     m_transaction.p_start_addr                      = (uint32_t*) start_address;
     m_transaction.length                            = p_packet->payload.start.length * 4;
+    m_transaction.encoded_length                    = (p_packet->payload.start.diff ? p_packet->payload.start.encoded_length * 4 : 0);
     m_transaction.signature_length                  = p_packet->payload.start.signature_length;
     m_transaction.segment_is_valid_after_transfer   = p_packet->payload.start.last;
     m_transaction.p_last_requested_entry            = NULL;
@@ -805,12 +899,16 @@ static void target_rx_start(dfu_packet_t* p_packet, bool* p_do_relay)
         return;
     }
 
+    m_transaction.base_length = (m_transaction.encoded_length != 0) ? base_length_get(p_segment) : 0;
+
     __LOG("Set transaction parameters:\n");
     __LOG("\ttype:       %s\n", m_dfu_type_strs[(uint32_t) m_transaction.type]);
     __LOG("\tsegments:   %u\n", segment_count);
     __LOG("\tstart addr: 0x%x\n", start_address);
     __LOG("\tbank addr:  0x%x\n", m_transaction.p_bank_addr);
     __LOG("\tlength:     %u\n", m_transaction.length);
+    __LOG("\tencoded:    %u\n", m_transaction.encoded_length);
+    __LOG("\tbase:       %u\n", m_transaction.base_length);
     __LOG("\tsigned:     %s\n", m_transaction.signature_length > 0 ? "YES" : "NO");
 
     if ((uint32_t) m_transaction.p_start_addr >= p_segment->start &&
@@ -921,7 +1019,12 @@ static uint32_t handle_data_packet(dfu_packet_t* p_packet, uint16_t length)
             if (p_packet->payload.start.segment == 0)
             {
                 m_lost_start_edge = 0;
-                target_rx_start(p_packet, &do_relay);
+                if (p_packet->payload.start.diff && length < DFU_PACKET_LEN_START_ENCODED)
+                {
+                    /* Can't receive an encoded transfer without knowing its length. */
+                    return NRF_ERROR_INVALID_LENGTH;
+                }
+                target_rx_start(p_packet, length, &do_relay);
                 status = NRF_SUCCESS;
             }
             else
@@ -963,7 +1066,7 @@ static uint32_t handle_data_packet(dfu_packet_t* p_packet, uint16_t length)
         {
             if (p_packet->payload.data.segment == 0)
             {
-                m_transaction.segment_count = segment_count_from_start_packet(p_packet);
+                m_transaction.segment_count = segment_count_from_start_packet(p_packet, length);
             }
             SET_STATE(DFU_STATE_RELAY);
             tx_abort(TX_SLOT_BEACON);
@@ -980,7 +1083,7 @@ static uint32_t handle_data_packet(dfu_packet_t* p_packet, uint16_t length)
         case DFU_STATE_RELAY:
             if (p_packet->payload.data.segment == 0)
             {
-                m_transaction.segment_count = segment_count_from_start_packet(p_packet);
+                m_transaction.segment_count = segment_count_from_start_packet(p_packet, length);
             }
             send_progress_event(p_packet->payload.data.segment, m_transaction.segment_count);
             do_relay = true;
@@ -1130,7 +1233,57 @@ static uint32_t handle_fwid_packet(dfu_packet_t* p_packet)
     return status;
 }
 
-static uint32_t handle_data_req_packet(dfu_packet_t* p_packet)
+/** Respond to a request for a single segment, unless we've done so recently. */
+static uint32_t data_req_serve(uint16_t segment, uint32_t transaction_id)
+{
+    uint32_t status;
+    req_cache_entry_t* p_req_entry = NULL;
+    /* check that we haven't served this request recently. */
+    for (uint32_t i = 0; i < REQ_CACHE_SIZE; ++i)
+    {
+        if (m_req_cache[i].segment == segment)
+        {
+            if (m_req_cache[i].rx_count++ < REQ_RX_COUNT_RETRY)
+            {
+                return NRF_SUCCESS;
+            }
+            p_req_entry = &m_req_cache[i];
+            break;
+        }
+    }
+    /* serve request */
+    dfu_packet_t dfu_rsp;
+    if (
+        dfu_transfer_has_entry(
+            (uint32_t*) SEGMENT_ADDR(segment, m_transaction.p_start_addr),
+            dfu_rsp.payload.rsp_data.data, SEGMENT_LENGTH)
+       )
+    {
+        dfu_rsp.packet_type = DFU_PACKET_TYPE_DATA_RSP;
+        dfu_rsp.payload.rsp_data.segment = segment;
+        dfu_rsp.payload.rsp_data.transaction_id = transaction_id;
+
+        status = packet_tx_dynamic(&dfu_rsp, DFU_PACKET_LEN_DATA_RSP, TX_INTERVAL_TYPE_RSP, TX_REPEATS_RSP);
+    }
+    else
+    {
+        status = NRF_ERROR_NOT_FOUND;
+    }
+
+    /* log our attempt at responding */
+    if (status == NRF_SUCCESS && !p_req_entry)
+    {
+        p_req_entry = &m_req_cache[(m_req_index++) & (REQ_CACHE_SIZE - 1)];
+        p_req_entry->segment = segment;
+    }
+    if (p_req_entry)
+    {
+        p_req_entry->rx_count = 0;
+    }
+    return status;
+}
+
+static uint32_t handle_data_req_packet(dfu_packet_t* p_packet, uint16_t length)
 {
     uint32_t status;
     if (p_packet->payload.data.transaction_id == m_transaction.transaction_id)
@@ -1145,59 +1298,38 @@ static uint32_t handle_data_req_packet(dfu_packet_t* p_packet)
             }
             else
             {
-                status = relay_packet(p_packet, DFU_PACKET_LEN_DATA_REQ);
+                status = relay_packet(p_packet, length);
 
 #if RBC_MESH_SERIAL
                 bl_evt_t tx_evt;
                 tx_evt.type = BL_EVT_TYPE_TX_SERIAL;
                 tx_evt.params.tx.serial.p_dfu_packet = p_packet;
-                tx_evt.params.tx.serial.length = DFU_PACKET_LEN_DATA_REQ;
+                tx_evt.params.tx.serial.length = length;
                 bootloader_evt_send(&tx_evt);
 #endif
             }
         }
         else /* In transfer */
         {
-            req_cache_entry_t* p_req_entry = NULL;
-            /* check that we haven't served this request recently. */
-            for (uint32_t i = 0; i < REQ_CACHE_SIZE; ++i)
+            status = data_req_serve(p_packet->payload.req_data.segment, p_packet->payload.req_data.transaction_id);
+
+            /* Serve the rest of a ranged request with the TX slots we have left, the requester
+             * will ask again for what we didn't get to. */
+            if (length >= DFU_PACKET_LEN_DATA_REQ_RANGED)
             {
-                if (m_req_cache[i].segment == p_packet->payload.req_data.segment)
+                uint32_t rsp_slots = (m_tx_slots > 2) ? (m_tx_slots - 2) : 0;
+                for (uint32_t i = 0; i < DFU_DATA_REQ_BITMAP_LEN * 8 && rsp_slots > 0; ++i)
                 {
-                    if (m_req_cache[i].rx_count++ < REQ_RX_COUNT_RETRY)
+                    if (p_packet->payload.req_data.missing_bitmap[i / 8] & (1 << (i % 8)))
                     {
-                        return NRF_SUCCESS;
+                        uint16_t segment = p_packet->payload.req_data.segment + 1 + i;
+                        if (data_req_serve(segment, p_packet->payload.req_data.transaction_id) == NRF_SUCCESS)
+                        {
+                            rsp_slots--;
+                        }
                     }
-                    p_req_entry = &m_req_cache[i];
-                    break;
                 }
             }
-            /* serve request */
-            dfu_packet_t dfu_rsp;
-            if (
-                dfu_transfer_has_entry(
-                    (uint32_t*) SEGMENT_ADDR(p_packet->payload.req_data.segment, m_transaction.p_start_addr),
-                    dfu_rsp.payload.rsp_data.data, SEGMENT_LENGTH)
-               )
-            {
-                dfu_rsp.packet_type = DFU_PACKET_TYPE_DATA_RSP;
-                dfu_rsp.payload.rsp_data.segment = p_packet->payload.req_data.segment;
-                dfu_rsp.payload.rsp_data.transaction_id = p_packet->payload.req_data.transaction_id;
-
-                status = packet_tx_dynamic(&dfu_rsp, DFU_PACKET_LEN_DATA_RSP, TX_INTERVAL_TYPE_RSP, TX_REPEATS_RSP);
-            }
-            else
-            {
-                status = NRF_ERROR_NOT_FOUND;
-            }
-
-            /* log our attempt at responding */
-            if (status == NRF_SUCCESS && !p_req_entry)
-            {
-                p_req_entry = &m_req_cache[(m_req_index++) & (REQ_CACHE_SIZE - 1)];
-                p_req_entry->segment = p_packet->payload.req_data.segment;
-            }
-            p_req_entry->rx_count = 0;
         }
     }
     else
@@ -1351,7 +1483,7 @@ uint32_t dfu_mesh_rx(dfu_packet_t* p_packet, uint16_t length, bool from_serial)
             break;
 
         case DFU_PACKET_TYPE_DATA_REQ:
-            status = handle_data_req_packet(p_packet);
+            status = handle_data_req_packet(p_packet, length);
             break;
 
         case DFU_PACKET_TYPE_DATA_RSP:
@@ -1385,7 +1517,12 @@ void dfu_mesh_timeout(void)
             break;
 
         case DFU_STATE_VALIDATE:
-            if (signature_check())
+            if (!dfu_transfer_is_finished())
+            {
+                /* Still decoding the last part of the firmware. */
+                start_rampdown();
+            }
+            else if (signature_check())
             {
                 dfu_mesh_finalize();
             }
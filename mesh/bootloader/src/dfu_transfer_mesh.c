@@ -45,19 +45,26 @@
 #include "nrf_mbr.h"
 #include "rtt_log.h"
 #include "dfu_util.h"
+#include "dfu_decode.h"
 
 /*****************************************************************************
 * Local defines
 *****************************************************************************/
 #define INVALID_SEGMENT_INDEX   (0xFFFF)
-#define MISSING_BITFIELD_WIDTH  (64ULL)
+#define BITMAP_WORD_WIDTH       (32)
+#define BITMAP_WORDS            ((DFU_TRANSFER_SEGMENT_COUNT_MAX + BITMAP_WORD_WIDTH - 1) / BITMAP_WORD_WIDTH)
+/** Decoded firmware is written to flash in blocks of this size. */
+#define DECODE_BLOCK_SIZE       (64)
+
+/* Segment indexes are 16 bit, with the top value reserved. */
+#if DFU_TRANSFER_SEGMENT_COUNT_MAX >= INVALID_SEGMENT_INDEX
+#error "DFU_TRANSFER_SEGMENT_COUNT_MAX must be less than INVALID_SEGMENT_INDEX"
+#endif
 
 /*****************************************************************************
 * Local typedefs
 *****************************************************************************/
 
-typedef uint64_t bitfield_t;
-
 typedef struct
 {
     uint32_t*       p_start_addr;
@@ -65,16 +72,32 @@ typedef struct
     uint16_t        segment_count;
     bool            final_transfer;
     uint32_t        size;
-    bitfield_t      missing_segments;
     uint8_t         write_buffer[SEGMENT_LENGTH];
     uint16_t        segment_max;
     uint16_t        segment_prev;
+    dfu_transfer_stats_t stats;
+    bool            hash_streaming;
+    uint32_t        hashed_length;
+    sha256_context_t hash_context;
+    bool            encoded;
+    uint32_t        encoded_size;
+    bool            decode_writing;
 } dfu_transfer_t;
 
 /*****************************************************************************
 * Static globals
 *****************************************************************************/
 static dfu_transfer_t m_transfer;
+/** Bit n is set when segment n + 1 has been received. Covers the whole transfer, so that lost
+ * segments can be requested no matter how long ago they were missed. */
+static uint32_t m_received_segments[BITMAP_WORDS];
+
+#if DFU_ENCODED_STAGING_SIZE
+/** Encoded transfers are received here, and decoded into the bank as soon as they're contiguous. */
+static uint8_t m_encoded_staging[DFU_ENCODED_STAGING_SIZE];
+static uint32_t m_decode_buffer[DECODE_BLOCK_SIZE / WORD_SIZE];
+static dfu_decode_t m_decode;
+#endif
 
 /*****************************************************************************
 * Static functions
@@ -86,17 +109,146 @@ static void transfer_abort(dfu_end_t end_reason)
     send_end_evt(end_reason);
 }
 
+static bool segment_is_received(uint16_t segment)
+{
+    uint32_t index = segment - 1;
+    return !!(m_received_segments[index / BITMAP_WORD_WIDTH] & (1UL << (index % BITMAP_WORD_WIDTH)));
+}
+
 static bool segment_is_missing(uint16_t segment)
 {
     if (segment > m_transfer.segment_max)
     {
         return true;
     }
-    if (m_transfer.segment_max - segment > MISSING_BITFIELD_WIDTH)
+    if (segment == 0)
     {
         return false;
     }
-    return !!((1ULL << (m_transfer.segment_max - segment)) & m_transfer.missing_segments);
+    return !segment_is_received(segment);
+}
+
+/** Find the first missing segment starting at @p segment, or return 0 if there are none. */
+static uint16_t missing_segment_find(uint16_t segment)
+{
+    while (segment < m_transfer.segment_max)
+    {
+        uint32_t index = segment - 1;
+        if (m_received_segments[index / BITMAP_WORD_WIDTH] == 0xFFFFFFFF)
+        {
+            /* Skip the rest of the word */
+            segment += BITMAP_WORD_WIDTH - (index % BITMAP_WORD_WIDTH);
+        }
+        else if (!segment_is_received(segment))
+        {
+            return segment;
+        }
+        else
+        {
+            segment++;
+        }
+    }
+    return 0;
+}
+
+/** Hash the segments that have arrived in order since the last time. */
+static void hash_frontier_advance(void)
+{
+    if (!m_transfer.hash_streaming)
+    {
+        return;
+    }
+
+    uint32_t length = 0;
+#if DFU_ENCODED_STAGING_SIZE
+    if (m_transfer.encoded)
+    {
+        /* The decoder writes the bank in order. */
+        length = m_decode.stored - m_transfer.hashed_length;
+    }
+    else
+#endif
+    {
+        for (uint16_t segment = m_transfer.hashed_length / SEGMENT_LENGTH + 1;
+             segment <= m_transfer.segment_max && segment_is_received(segment) &&
+             m_transfer.hashed_length + length < m_transfer.size;
+             segment++)
+        {
+            length += SEGMENT_LENGTH;
+        }
+    }
+
+    if (m_transfer.hashed_length + length > m_transfer.size)
+    {
+        length = m_transfer.size - m_transfer.hashed_length;
+    }
+
+    if (length > 0)
+    {
+        sha256_update(&m_transfer.hash_context,
+                      (uint8_t*) m_transfer.p_bank_addr + m_transfer.hashed_length,
+                      length);
+        m_transfer.hashed_length += length;
+    }
+}
+
+#if DFU_ENCODED_STAGING_SIZE
+/** Decode as much of the received firmware as possible, and write it to the bank. */
+static void decode_advance(void)
+{
+    while (!m_transfer.decode_writing)
+    {
+        /* Everything up to the first gap can be decoded. */
+        uint16_t first_missing = missing_segment_find(1);
+        uint32_t input_length = (first_missing == 0) ? m_transfer.segment_max * SEGMENT_LENGTH
+                                                     : (first_missing - 1) * SEGMENT_LENGTH;
+        if (input_length > m_transfer.encoded_size)
+        {
+            input_length = m_transfer.encoded_size;
+        }
+
+        if (dfu_decode_run(&m_decode, m_encoded_staging, input_length) != NRF_SUCCESS)
+        {
+            transfer_abort(DFU_END_ERROR_INVALID_TRANSFER);
+            return;
+        }
+
+        uint32_t pending = dfu_decode_pending_get(&m_decode);
+        if (pending < DECODE_BLOCK_SIZE && !dfu_decode_is_done(&m_decode))
+        {
+            if (input_length == m_transfer.encoded_size)
+            {
+                /* The encoded firmware ended before the decoded firmware was complete. */
+                transfer_abort(DFU_END_ERROR_INVALID_TRANSFER);
+            }
+            return;
+        }
+        if (pending == 0)
+        {
+            return;
+        }
+
+        uint32_t write_length = (pending + WORD_SIZE - 1) & ~(WORD_SIZE - 1);
+        memset((uint8_t*) m_decode_buffer + pending, 0xFF, write_length - pending);
+        m_transfer.decode_writing = true;
+        if (flash_write((uint8_t*) m_transfer.p_bank_addr + m_decode.stored,
+                        m_decode_buffer,
+                        write_length) != NRF_SUCCESS)
+        {
+            transfer_abort(DFU_END_ERROR_NO_MEM);
+            return;
+        }
+    }
+}
+#endif
+
+static uint16_t addr_segment_get(uint32_t* p_addr)
+{
+    if (p_addr < m_transfer.p_start_addr)
+    {
+        return 1;
+    }
+    return ADDR_SEGMENT(p_addr, m_transfer.p_start_addr);
 }
 
 /*****************************************************************************
@@ -105,6 +257,7 @@ static bool segment_is_missing(uint16_t segment)
 void dfu_transfer_init(void)
 {
     memset(&m_transfer, 0, sizeof(dfu_transfer_t));
+    memset(m_received_segments, 0, sizeof(m_received_segments));
     m_transfer.segment_max = INVALID_SEGMENT_INDEX;
 }
 
@@ -115,7 +268,7 @@ uint32_t dfu_transfer_start(
         bool final_transfer)
 {
     dfu_transfer_init();
-    uint16_t segment_count = (((size + (uint32_t) p_start_addr) & 0xFFFFFFF0) - ((uint32_t) p_start_addr & 0xFFFFFFF0)) / 16;
+    uint32_t segment_count = (((size + (uint32_t) p_start_addr) & 0xFFFFFFF0) - ((uint32_t) p_start_addr & 0xFFFFFFF0)) / 16;
 
     if (PAGE_OFFSET(p_start_addr) != 0 ||
         PAGE_OFFSET(p_bank_addr) != 0)
@@ -123,6 +276,11 @@ uint32_t dfu_transfer_start(
         return NRF_ERROR_INVALID_ADDR;
     }
 
+    if (segment_count >= DFU_TRANSFER_SEGMENT_COUNT_MAX)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
     if (p_bank_addr == NULL)
     {
         m_transfer.p_bank_addr = p_start_addr;
@@ -140,7 +298,6 @@ uint32_t dfu_transfer_start(
     m_transfer.segment_count = segment_count;
     m_transfer.final_transfer = final_transfer;
     m_transfer.size = size;
-    m_transfer.missing_segments = 0;
     m_transfer.segment_prev = INVALID_SEGMENT_INDEX;
     m_transfer.segment_max = 0;
     return NRF_SUCCESS;
@@ -152,10 +309,11 @@ uint32_t dfu_transfer_data(uint32_t p_addr, uint8_t* p_data, uint16_t length)
     {
         return NRF_ERROR_INVALID_STATE;
     }
+    uint32_t transfer_size = (m_transfer.encoded ? m_transfer.encoded_size : m_transfer.size);
     /* Data block must be segment-aligned. */
     if ((p_addr & (SEGMENT_LENGTH - 1)) != 0 ||
             p_addr          < (uint32_t) m_transfer.p_start_addr ||
-            p_addr + length > (uint32_t) m_transfer.p_start_addr + m_transfer.size)
+            p_addr + length > (uint32_t) m_transfer.p_start_addr + transfer_size)
     {
         return NRF_ERROR_INVALID_ADDR;
     }
@@ -175,29 +333,32 @@ uint32_t dfu_transfer_data(uint32_t p_addr, uint8_t* p_data, uint16_t length)
         return NRF_ERROR_INVALID_STATE;
     }
 
+    if (segment > DFU_TRANSFER_SEGMENT_COUNT_MAX)
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
     if (segment > m_transfer.segment_max)
     {
-        /* Ensure that we don't shift out any set bits: Mask the shift on the
-         * MSB side (ie only look at the part that will overflow), and check
-         * whether there are any bits set in that section. */
-        uint16_t segment_offset = segment - m_transfer.segment_max;
-        bitfield_t shift_mask = (1ULL << segment_offset) - 1ULL;
-        if (m_transfer.missing_segments & (shift_mask << (MISSING_BITFIELD_WIDTH - segment_offset)))
-        {
-            transfer_abort(DFU_END_ERROR_PACKET_LOSS);
-            return NRF_ERROR_NOT_FOUND;
-        }
-        /* Offset the bitfield to match the new segment_max, and set all bits
-         * that we skipped to 1, as they're considered missing. */
-        m_transfer.missing_segments = (m_transfer.missing_segments << segment_offset) | shift_mask;
-        m_transfer.missing_segments &= ~1ULL; /* The newest segment isn't missing. */
+        /* All segments we skipped are considered missing. */
+        m_transfer.stats.segments_lost += segment - m_transfer.segment_max - 1;
         m_transfer.segment_max = segment;
     }
     else
     {
-        uint16_t segment_offset = m_transfer.segment_max - segment;
-        m_transfer.missing_segments &= ~(1 << segment_offset);
+        m_transfer.stats.segments_recovered++;
     }
+    m_received_segments[(segment - 1) / BITMAP_WORD_WIDTH] |= (1UL << ((segment - 1) % BITMAP_WORD_WIDTH));
+
+#if DFU_ENCODED_STAGING_SIZE
+    if (m_transfer.encoded)
+    {
+        memcpy(&m_encoded_staging[p_addr - (uint32_t) m_transfer.p_start_addr], p_data, length);
+        decode_advance();
+        /* The decoder aborts the transfer if the encoded firmware is invalid. */
+        return (m_transfer.segment_max == INVALID_SEGMENT_INDEX) ? NRF_ERROR_INVALID_DATA : NRF_SUCCESS;
+    }
+#endif
 
     m_transfer.segment_prev = segment;
     memcpy(m_transfer.write_buffer, p_data, length);
@@ -229,6 +390,12 @@ bool dfu_transfer_has_entry(uint32_t* p_addr, uint8_t* p_out_buffer, uint16_t le
         if (p_out_buffer && len)
         {
             uint32_t* p_storage_addr = (uint32_t*) SEGMENT_ADDR(segment, m_transfer.p_bank_addr);
+#if DFU_ENCODED_STAGING_SIZE
+            if (m_transfer.encoded)
+            {
+                p_storage_addr = (uint32_t*) &m_encoded_staging[(segment - 1) * SEGMENT_LENGTH];
+            }
+#endif
             memcpy(p_out_buffer, p_storage_addr, len);
         }
         return true;
@@ -245,21 +412,87 @@ bool dfu_transfer_get_oldest_missing_entry(
     {
         return false;
     }
-    for (int32_t i = 63; i >= 0; i--)
+    uint16_t segment = missing_segment_find(addr_segment_get(p_start_addr));
+    if (segment == 0)
     {
-        if (m_transfer.missing_segments & (1ULL << i))
-        {
-            uint16_t segment = m_transfer.segment_max - i;
-            uint32_t addr = SEGMENT_ADDR(segment, m_transfer.p_start_addr);
-            if (addr >= (uint32_t) p_start_addr)
-            {
-                *pp_entry = (uint32_t*) addr;
-                *p_len = SEGMENT_LENGTH;
-                return true;
-            }
-        }
+        return false;
+    }
+    *pp_entry = (uint32_t*) SEGMENT_ADDR(segment, m_transfer.p_start_addr);
+    *p_len = SEGMENT_LENGTH;
+    return true;
+}
+
+uint16_t dfu_transfer_missing_bitmap_get(uint32_t* p_start_addr, uint8_t* p_bitmap, uint16_t segment_count)
+{
+    memset(p_bitmap, 0, (segment_count + 7) / 8);
+    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    {
+        return 0;
+    }
+
+    uint16_t first_segment = addr_segment_get(p_start_addr);
+    uint16_t missing_count = 0;
+    for (uint16_t segment = missing_segment_find(first_segment);
+         segment != 0 && segment - first_segment < segment_count;
+         segment = missing_segment_find(segment + 1))
+    {
+        uint16_t bit = segment - first_segment;
+        p_bitmap[bit / 8] |= (1 << (bit % 8));
+        missing_count++;
+    }
+    return missing_count;
+}
+
+uint32_t dfu_transfer_encoded_set(uint32_t encoded_size, const uint8_t* p_base, uint32_t base_length)
+{
+    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+#if DFU_ENCODED_STAGING_SIZE
+    if (encoded_size > DFU_ENCODED_STAGING_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+    m_transfer.encoded = true;
+    m_transfer.encoded_size = encoded_size;
+    dfu_decode_init(&m_decode,
+                    p_base,
+                    base_length,
+                    (const uint8_t*) m_transfer.p_bank_addr,
+                    m_transfer.size,
+                    (uint8_t*) m_decode_buffer,
+                    DECODE_BLOCK_SIZE);
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+bool dfu_transfer_is_finished(void)
+{
+    if (m_transfer.segment_max == INVALID_SEGMENT_INDEX)
+    {
+        return true;
+    }
+#if DFU_ENCODED_STAGING_SIZE
+    if (m_transfer.encoded)
+    {
+        return (dfu_decode_is_done(&m_decode) && !m_transfer.decode_writing);
+    }
+#endif
+    return (m_transfer.segment_prev == INVALID_SEGMENT_INDEX);
+}
+
+void dfu_transfer_sha256_stream_start(const sha256_context_t* p_hash_context)
+{
+    if (m_transfer.segment_max != INVALID_SEGMENT_INDEX)
+    {
+        m_transfer.hash_context = *p_hash_context;
+        m_transfer.hashed_length = 0;
+        m_transfer.hash_streaming = true;
+        hash_frontier_advance();
     }
-    return false;
 }
 
 uint32_t dfu_transfer_sha256(sha256_context_t* p_hash_context)
@@ -268,11 +501,29 @@ uint32_t dfu_transfer_sha256(sha256_context_t* p_hash_context)
     {
         return NRF_ERROR_INVALID_STATE;
     }
+
+    if (m_transfer.hash_streaming)
+    {
+        /* Most of the bank has been hashed already, only the part after the first gap is left. */
+        uint32_t status = sha256_update(&m_transfer.hash_context,
+                                        (uint8_t*) m_transfer.p_bank_addr + m_transfer.hashed_length,
+                                        m_transfer.size - m_transfer.hashed_length);
+        m_transfer.hashed_length = m_transfer.size;
+        m_transfer.hash_streaming = false;
+        *p_hash_context = m_transfer.hash_context;
+        return status;
+    }
+
     return sha256_update(p_hash_context,
                   (uint8_t*) m_transfer.p_bank_addr,
                   m_transfer.size);
 }
 
+void dfu_transfer_stats_get(dfu_transfer_stats_t* p_stats)
+{
+    *p_stats = m_transfer.stats;
+}
+
 void dfu_transfer_end(void)
 {
     dfu_transfer_init();
@@ -283,6 +534,17 @@ void dfu_transfer_flash_write_complete(uint8_t* p_write_src)
     if (p_write_src == m_transfer.write_buffer)
     {
         m_transfer.segment_prev = INVALID_SEGMENT_INDEX;
+        /* All received segments are in flash now. */
+        hash_frontier_advance();
+    }
+#if DFU_ENCODED_STAGING_SIZE
+    else if (m_transfer.decode_writing && p_write_src == (uint8_t*) m_decode_buffer)
+    {
+        m_transfer.decode_writing = false;
+        dfu_decode_stored(&m_decode);
+        hash_frontier_advance();
+        decode_advance();
     }
+#endif
 }
 
@@ -78,6 +78,13 @@
 
 #define FLASH_MANAGER_ENTRY_LEN_OVERHEAD (sizeof(fm_header_t) / WORD_SIZE) /**< Overhead in each entry's len field for the header. */
 
+/** Number of bytes an entry with the given data length takes up in a batch, including the header. */
+#define FLASH_MANAGER_BATCH_ENTRY_SIZE(DATA_LENGTH) (sizeof(fm_header_t) + ALIGN_VAL((DATA_LENGTH), WORD_SIZE))
+
+/** Largest number of bytes of entries in a single batch. All entries in a batch go on the same page,
+ * leaving room for the seal after them. */
+#define FLASH_MANAGER_BATCH_MAX_SIZE (FLASH_MANAGER_DATA_PER_PAGE - sizeof(fm_header_t))
+
 /** @} */
 
 /**
@@ -207,6 +214,8 @@ typedef struct
     uint32_t                               page_count;             /**< Number of pages in the area. */
     uint32_t                               min_available_space;    /**< Number of bytes that should always be left available during normal operation.
                                                                         Once the manager has this many bytes or less left, it'll start defragmentation. */
+    uint32_t                               incremental_defrag_threshold; /**< Number of invalid bytes at which the manager starts defragmenting its area
+                                                                        one page at a time while the action queue is idle, or 0 to only defragment when full. */
     flash_manager_write_complete_cb_t      write_complete_cb;      /**< Callback called after every completed write action, or @c NULL. */
     flash_manager_invalidate_complete_cb_t invalidate_complete_cb; /**< Callback called after every completed entry invalidation, or @c NULL. */
     flash_manager_remove_complete_cb_t     remove_complete_cb;     /**< Callback called after the manager has been successfully removed. */
@@ -215,9 +224,10 @@ typedef struct
 /** Internal flash manager state, managed and used internally. */
 typedef struct
 {
-    fm_state_t state;          /**< State of the manager. */
-    uint32_t invalid_bytes;    /**< Bytes invalidated in the area. */
-    const fm_entry_t * p_seal; /**< Pointer to the seal entry. */
+    fm_state_t state;                /**< State of the manager. */
+    uint32_t invalid_bytes;          /**< Bytes invalidated in the area. */
+    const fm_entry_t * p_seal;       /**< Pointer to the seal entry. */
+    queue_elem_t defrag_queue_elem;  /**< Element in the incremental defrag queue. */
 } flash_manager_internal_state_t;
 
 struct flash_manager
@@ -241,6 +251,19 @@ typedef struct
     void * p_args; /**< Arguments pointer, set by the user and returned in the callback. */
 } fm_mem_listener_t;
 
+/**
+ * Batch of entries that are written to flash together.
+ *
+ * @see flash_manager_batch_begin
+ */
+typedef struct
+{
+    flash_manager_t * p_manager; /**< Flash manager the batch is written to. */
+    void * p_action;             /**< @internal Reserved action buffer, should not be altered by the user. */
+    uint32_t length;             /**< Number of bytes of entries in the batch, including headers. */
+    uint32_t max_length;         /**< Number of bytes reserved for entries in the batch. */
+} fm_batch_t;
+
 /** Action returned from the read callback, determining whether to continue the iteration. */
 typedef enum
 {
@@ -449,6 +472,66 @@ uint32_t flash_manager_entry_invalidate(flash_manager_t * p_manager, fm_handle_t
  */
 void flash_manager_entry_release(fm_entry_t * p_entry);
 
+/**
+ * Start a batch of entry writes.
+ *
+ * A batch collects several entries that are written to flash in a single operation, placed back to
+ * back on the same page and followed by a single seal, instead of one write and seal per entry. Once
+ * the entries are written, the entries they replace are invalidated, and the manager's
+ * write complete callback is called once for each entry in the batch.
+ *
+ * Reserves @p max_length bytes in the process queue. Like entries allocated with
+ * @ref flash_manager_entry_alloc, the batch has to be committed or released before any other
+ * entries can be allocated.
+ *
+ * @note A batch is not atomic. If the device loses power while the batch is written, any entry that
+ * was fully written is kept, and the rest are left with their old values.
+ *
+ * @param[out] p_batch Batch to start.
+ * @param[in] p_manager Flash manager to operate on.
+ * @param[in] max_length Number of bytes to reserve for entries, including their headers. Use
+ * @ref FLASH_MANAGER_BATCH_ENTRY_SIZE to get the size of each entry. Cannot be larger than
+ * @ref FLASH_MANAGER_BATCH_MAX_SIZE.
+ *
+ * @retval NRF_SUCCESS The batch was started.
+ * @retval NRF_ERROR_INVALID_STATE The flash manager hasn't been added.
+ * @retval NRF_ERROR_NO_MEM There's not enough space available in the process queue.
+ */
+uint32_t flash_manager_batch_begin(fm_batch_t * p_batch, flash_manager_t * p_manager, uint32_t max_length);
+
+/**
+ * Append an entry to a batch.
+ *
+ * @note Each handle can only be appended once per batch.
+ *
+ * @param[in,out] p_batch Batch started with @ref flash_manager_batch_begin.
+ * @param[in] handle Entry handle.
+ * @param[in] data_length Wanted length of the entry in bytes, excluding the header. Cannot be
+ * longer than @ref FLASH_MANAGER_ENTRY_MAX_SIZE.
+ *
+ * @returns A pointer to the entry in the batch, whose data should be filled before the batch is
+ * committed. The header is prefilled, and shouldn't be altered.
+ * @returns @c NULL if there's not enough space left in the batch.
+ */
+fm_entry_t * flash_manager_batch_entry_append(fm_batch_t * p_batch, fm_handle_t handle, uint32_t data_length);
+
+/**
+ * Commit the given batch for flashing.
+ *
+ * Any unused space in the batch is returned to the process queue. Committing an empty batch
+ * releases it.
+ *
+ * @param[in,out] p_batch Batch started with @ref flash_manager_batch_begin.
+ */
+void flash_manager_batch_commit(fm_batch_t * p_batch);
+
+/**
+ * Release a batch that won't be committed after all.
+ *
+ * @param[in,out] p_batch Batch started with @ref flash_manager_batch_begin.
+ */
+void flash_manager_batch_release(fm_batch_t * p_batch);
+
 /**
  * Register a call back to be notified once memory has been made available in the internal buffer.
  * This can be used to recover from @c NRF_ERROR_NO_MEM errors from the @ref
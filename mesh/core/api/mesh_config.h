@@ -57,6 +57,15 @@ typedef enum
     MESH_CONFIG_LOAD_FAILURE_INVALID_ID /**< The loaded ID was unknown to the configuration. */
 } mesh_config_load_failure_t;
 
+/** Mesh config storage statistics, counted since initialization. */
+typedef struct
+{
+    uint32_t changes;        /**< Number of changes to persistently stored entries. */
+    uint32_t coalesced;      /**< Number of changes merged with an earlier change that was not yet stored. */
+    uint32_t backend_writes; /**< Number of store and erase requests passed to the storage backend. */
+    uint32_t flash_bytes;    /**< Number of bytes requested written to flash, including record headers. */
+} mesh_config_stats_t;
+
 /**
  * Initialize the configuration module.
  */
@@ -119,6 +128,15 @@ uint32_t mesh_config_power_down_time_get(void);
  */
 void mesh_config_file_clear(uint16_t file_id);
 
+/**
+ * Get the storage statistics.
+ *
+ * The average flash usage per configuration change is @c flash_bytes / @c changes.
+ *
+ * @param[out] p_stats Statistics structure to fill.
+ */
+void mesh_config_stats_get(mesh_config_stats_t * p_stats);
+
 /** @} */
 
 #endif /* MESH_CONFIG_H__ */
@@ -87,6 +87,14 @@
 #define MESH_LPN_POLL_SEPARATION_INTERVAL_MS 50
 #endif
 
+/**
+ * Default shortest poll interval of the adaptive poll policy, see mesh_lpn_adaptive_poll_set().
+ * Set to 0 to poll at the fixed poll interval by default.
+ */
+#ifndef MESH_LPN_ADAPTIVE_POLL_MIN_INTERVAL_MS
+#define MESH_LPN_ADAPTIVE_POLL_MIN_INTERVAL_MS 0
+#endif
+
 
 /** Parameters of the Friend node Criteria field. */
 typedef struct
@@ -131,6 +139,27 @@ typedef struct
     friend_criteria_t friend_criteria;
 } mesh_lpn_friend_request_t;
 
+/** Low Power node polling statistics. */
+typedef struct
+{
+    /** Number of Friend Polls sent, including retries. */
+    uint32_t poll_count;
+    /** Number of messages received from the Friend node, including Friend Updates. */
+    uint32_t rx_count;
+    /** Number of poll sessions where the Friend Queue was empty. */
+    uint32_t empty_session_count;
+    /** Number of poll sessions that delivered messages from the Friend Queue. */
+    uint32_t data_session_count;
+    /**
+     * Sum of the poll intervals preceding the sessions that delivered messages. Divided by @ref
+     * data_session_count, this is the average upper bound of the time the first message of a
+     * session waited in the Friend Queue.
+     */
+    uint64_t data_wait_ms;
+    /** Total time spent scanning for responses from the Friend node. */
+    uint64_t scan_time_us;
+} mesh_lpn_stats_t;
+
 /** Initialize the Low Power node. */
 void mesh_lpn_init(void);
 
@@ -230,6 +259,38 @@ uint32_t mesh_lpn_friend_poll(uint32_t delay_ms);
  */
 uint32_t mesh_lpn_poll_interval_set(uint32_t poll_interval_ms);
 
+/**
+ * Set the shortest poll interval of the adaptive poll policy.
+ *
+ * By default, the LPN empties the Friend Queue once every poll interval. With the adaptive poll
+ * policy, the LPN polls again after @p min_interval_ms when a poll session delivered messages, and
+ * doubles the interval after every session that found the Friend Queue empty, up to the poll
+ * interval set with mesh_lpn_poll_interval_set(). This keeps the latency low when traffic comes in
+ * bursts, without polling an empty Friend Queue often when the network is idle.
+ *
+ * The default value is @ref MESH_LPN_ADAPTIVE_POLL_MIN_INTERVAL_MS. The new value is used after
+ * the next poll session.
+ *
+ * @param[in] min_interval_ms Shortest poll interval, or 0 to always poll at the fixed poll interval.
+ *
+ * @retval NRF_SUCCESS             Successfully set the shortest poll interval.
+ * @retval NRF_ERROR_INVALID_PARAM The interval is shorter than @ref MESH_LPN_POLL_SEPARATION_INTERVAL_MS.
+ */
+uint32_t mesh_lpn_adaptive_poll_set(uint32_t min_interval_ms);
+
+/**
+ * Get the polling statistics of the LPN.
+ *
+ * The statistics can be used to compare the radio-on time and message latency of different poll
+ * intervals and poll policies.
+ *
+ * @param[out] p_stats Statistics structure to fill.
+ */
+void mesh_lpn_stats_get(mesh_lpn_stats_t * p_stats);
+
+/** Clear the polling statistics of the LPN. */
+void mesh_lpn_stats_clear(void);
+
 /**
  * Terminate the active friendship.
  *
@@ -63,6 +63,41 @@
 #define PERSISTENT_STORAGE 1
 #endif
 
+/**
+ * Number of changed mesh config entries that can wait for storage at the same time.
+ *
+ * Changed entries are passed to the storage backend in the order they were changed, and repeated
+ * changes to an entry that is still waiting are written only once. If more entries change while
+ * the backend is busy, mesh config falls back to searching all entries for changes until it has
+ * caught up.
+ */
+#ifndef MESH_CONFIG_DIRTY_QUEUE_SIZE
+#define MESH_CONFIG_DIRTY_QUEUE_SIZE 32
+#endif
+
+/**
+ * Number of bytes of the flash manager pool to reserve for writing several changed mesh config
+ * entries of the same file together.
+ *
+ * Entries that are passed to the flash manager at the same time are written in one flash operation
+ * with a single seal. Must be word aligned. Set to 0 to write every entry separately.
+ */
+#ifndef MESH_CONFIG_BATCH_SIZE
+#define MESH_CONFIG_BATCH_SIZE (FLASH_MANAGER_POOL_SIZE / 2)
+#endif
+
+/**
+ * Share of a mesh config file's flash area, in percent, that can be taken up by invalidated entries
+ * before the area is defragmented in the background.
+ *
+ * The background defrag rewrites a single page at a time while the flash manager is idle, so that
+ * writes rarely have to wait for the full defrag that runs when the area is out of space. Set to 0
+ * to only defragment the area when it's full.
+ */
+#ifndef MESH_CONFIG_INCREMENTAL_DEFRAG_PERCENT
+#define MESH_CONFIG_INCREMENTAL_DEFRAG_PERCENT 0
+#endif
+
 /**
  * Define to "1" if the uECC libray is linked to the mesh stack.
  */
@@ -192,8 +227,39 @@
 #define INTERNAL_EVENT_BUFFER_SIZE 32
 #endif
 
+/**
+ * Define "1" to enable packet lifecycle tracing.
+ *
+ * Records the time each packet passes through the layers of the stack, see @ref PACKET_TRACE.
+ */
+#ifndef PACKET_TRACE_ENABLE
+#define PACKET_TRACE_ENABLE 0
+#endif
+
+/** Number of records in the packet trace buffer. Must be a power of two. Each record uses 8 bytes of RAM. */
+#ifndef PACKET_TRACE_BUFFER_SIZE
+#define PACKET_TRACE_BUFFER_SIZE 128
+#endif
+
 /** @} end of MESH_CONFIG_INTERNAL */
 
+/**
+ * @defgroup MESH_CONFIG_PERF_COUNTER Performance counter configuration
+ * @{
+ */
+
+/**
+ * Define "1" to enable the performance counter registry.
+ *
+ * Each counter update is a single increment of a RAM variable, and the registry uses about 250
+ * bytes of RAM. The counters are read through the @ref PERF_COUNTER API or the serial interface.
+ */
+#ifndef PERF_COUNTER_ENABLE
+#define PERF_COUNTER_ENABLE 0
+#endif
+
+/** @} end of MESH_CONFIG_PERF_COUNTER */
+
 /**
  * @defgroup MESH_CONFIG_LOG Log module configuration
  * @{
@@ -228,6 +294,29 @@
 #endif
 #endif
 
+/**
+ * Enable deferred binary logging.
+ *
+ * Instead of formatting the messages at the call site, @ref __LOG and @ref __LOG_XB store an
+ * identifier of the call site, a timestamp and the raw arguments in a RAM buffer. The buffer is
+ * drained by @ref log_deferred_process or @ref log_deferred_read, and the messages are formatted
+ * on the host by `tools/log_decoder/log_decoder.py` using the ELF file of the firmware. The log
+ * callback is not called for messages logged through the macros in this mode.
+ */
+#ifndef LOG_DEFERRED_ENABLE
+#define LOG_DEFERRED_ENABLE 0
+#endif
+
+/** Size of the deferred log buffer in bytes. Must be a power of two. */
+#ifndef LOG_DEFERRED_BUFFER_SIZE
+#define LOG_DEFERRED_BUFFER_SIZE 2048
+#endif
+
+/** RTT channel used by @ref log_deferred_process. */
+#ifndef LOG_DEFERRED_RTT_CHANNEL
+#define LOG_DEFERRED_RTT_CHANNEL 0
+#endif
+
 /** @} end of MESH_CONFIG_LOG */
 
 /**
@@ -289,6 +378,18 @@
 #define NETWORK_SEQNUM_FLASH_BLOCK_THRESHOLD 64
 #endif
 
+/**
+ * Number of authenticated secure network beacons to remember.
+ *
+ * Neighbors repeat the same secure network beacon for every subnet until the IV index or the flags
+ * change. A received beacon that is identical to one already authenticated with the same beacon
+ * key is accepted without calculating the AES-CMAC again. Each entry uses 28 bytes of RAM.
+ * Set to 0 to authenticate every received beacon.
+ */
+#ifndef NET_BEACON_AUTH_CACHE_SIZE
+#define NET_BEACON_AUTH_CACHE_SIZE 4
+#endif
+
 /** @} end of MESH_CONFIG_NETWORK */
 
 /**
@@ -315,6 +416,25 @@
 #endif
 
 /** @} end of MESH_CONFIG_TRANSPORT */
+
+/**
+ * @defgroup MESH_CONFIG_HEARTBEAT Heartbeat configuration
+ * @{
+ */
+
+/**
+ * Number of heartbeat sources tracked by the heartbeat collector, see @ref HEARTBEAT_COLLECTOR.
+ *
+ * The collector keeps hop counts, RSSI and the time of the last heartbeat for every source it
+ * hears from, independently of the heartbeat subscription state. Must be a power of two. Each
+ * source uses 16 bytes of RAM. Set to 0 to disable the collector.
+ */
+#ifndef HEARTBEAT_COLLECTOR_SIZE
+#define HEARTBEAT_COLLECTOR_SIZE (0)
+#endif
+
+/** @} end of MESH_CONFIG_HEARTBEAT */
+
 /**
  * @defgroup MESH_CONFIG_PACMAN Packet manager configuration
  *
@@ -559,6 +679,21 @@
 #define MESH_FRIEND_QUEUE_SIZE 35
 #endif
 
+/** Encrypt relayed packets in the Friend Queue ahead of time.
+ *
+ * When enabled, the Friend encrypts and obfuscates relayed packets with the friendship credentials
+ * as they are committed to the Friend Queue, so responding to a Friend Poll only hands the
+ * finished network PDU to the bearer. This keeps the response time low when several Low Power
+ * nodes poll close together, at the cost of 36 bytes of extra RAM per Friend Queue
+ * entry.
+ *
+ * @note Friend Update messages and packets originated by this device are always encrypted when
+ * they are sent, as their contents or sequence numbers are not known until then.
+ */
+#ifndef MESH_FRIEND_QUEUE_PREENCRYPT
+#define MESH_FRIEND_QUEUE_PREENCRYPT 0
+#endif
+
 /** @} end of MESH_CONFIG_FRIENDSHIP */
 
 /** @} end of NRF_MESH_CONFIG_CORE */
@@ -0,0 +1,189 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PERF_COUNTER_H__
+#define PERF_COUNTER_H__
+
+#include <stdint.h>
+#include "nrf_mesh_config_core.h"
+
+/**
+ * @defgroup PERF_COUNTER Performance counters
+ * @ingroup NRF_MESH
+ * Stack-wide registry of packet, crypto and queue statistics.
+ *
+ * The stack counts packets in, out and dropped per layer and reason, the number of crypto
+ * operations, and keeps histograms of queue depths and timer lateness. Counter updates are plain
+ * increments of RAM variables, and can be left enabled in production builds. The registry can be
+ * disabled with @ref PERF_COUNTER_ENABLE.
+ *
+ * The counters are not protected against concurrent updates. An update of a counter can be lost if
+ * it's interrupted by an update of the same counter from a higher interrupt priority.
+ *
+ * The counter and histogram identifiers are exposed over the serial interface. New identifiers
+ * must be added at the end of their lists.
+ * @{
+ */
+
+/** Number of buckets in a histogram. */
+#define PERF_HISTOGRAM_BUCKET_COUNT 16
+
+/** Performance counter identifiers. */
+typedef enum
+{
+    PERF_COUNTER_SCANNER_RX,                  /**< Packets received by the scanner. */
+    PERF_COUNTER_SCANNER_DROP_CRC,            /**< Packets dropped by the scanner due to CRC failure. */
+    PERF_COUNTER_SCANNER_DROP_LENGTH,         /**< Packets dropped by the scanner due to invalid length. */
+    PERF_COUNTER_SCANNER_DROP_NO_MEM,         /**< Times the scanner ran out of packet buffer memory. */
+    PERF_COUNTER_NET_RX,                      /**< Network PDUs passed to the network layer. */
+    PERF_COUNTER_NET_RX_DROP_LENGTH,          /**< Network PDUs dropped due to invalid length. */
+    PERF_COUNTER_NET_RX_DROP_CACHE,           /**< Network PDUs found in the network message cache. */
+    PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED, /**< Network PDUs no network key could authenticate. */
+    PERF_COUNTER_NET_RX_DROP_INVALID,         /**< Authenticated network PDUs dropped due to invalid header fields. */
+    PERF_COUNTER_NET_TX,                      /**< Network PDUs sent, including relayed PDUs. */
+    PERF_COUNTER_NET_RELAY,                   /**< Network PDUs relayed by this device. */
+    PERF_COUNTER_NET_RELAY_DROP_NO_MEM,       /**< Network PDUs not relayed due to lack of memory. */
+    PERF_COUNTER_TRS_RX,                      /**< PDUs passed to the transport layer. */
+    PERF_COUNTER_TRS_RX_DROP_REPLAY,          /**< Transport PDUs dropped by the replay protection. */
+    PERF_COUNTER_TRS_RX_DROP_UNKNOWN_ADDRESS, /**< Transport PDUs dropped as they're not addressed to this device. */
+    PERF_COUNTER_TRS_RX_DROP_DECRYPT,         /**< Upper transport PDUs no application or device key could decrypt. */
+    PERF_COUNTER_CRYPTO_AES_ECB,              /**< AES-ECB operations. */
+    PERF_COUNTER_CRYPTO_AES_CMAC,             /**< AES-CMAC operations. */
+    PERF_COUNTER_CRYPTO_CCM_ENCRYPT,          /**< AES-CCM encryptions. */
+    PERF_COUNTER_CRYPTO_CCM_DECRYPT,          /**< AES-CCM decryptions. */
+    PERF_COUNTER_CRYPTO_CCM_MIC_FAIL,         /**< AES-CCM decryptions that failed authentication. */
+
+    /** @internal Number of counters. */
+    PERF_COUNTER__LAST
+} perf_counter_id_t;
+
+/** Performance histogram identifiers. */
+typedef enum
+{
+    PERF_HISTOGRAM_TIMER_LATENESS_US,        /**< Time from the scheduled timeout to the timer callback, in microseconds. */
+    PERF_HISTOGRAM_TIMER_QUEUE_DEPTH,        /**< Number of scheduled timers, sampled when a timer is added. */
+    PERF_HISTOGRAM_BEARER_EVENT_QUEUE_DEPTH, /**< Number of pending bearer events, sampled when an event is posted. */
+
+    /** @internal Number of histograms. */
+    PERF_HISTOGRAM__LAST
+} perf_histogram_id_t;
+
+/**
+ * Histogram with logarithmic buckets.
+ *
+ * Bucket 0 counts samples with the value 0, and bucket @c n counts samples in the range
+ * <tt>[2^(n-1), 2^n)</tt>. The last bucket also counts all larger samples.
+ */
+typedef struct
+{
+    uint32_t buckets[PERF_HISTOGRAM_BUCKET_COUNT]; /**< Number of samples in each bucket. */
+    uint32_t max;                                  /**< Largest sample value. */
+} perf_histogram_t;
+
+#if PERF_COUNTER_ENABLE
+/** @internal Counter values. Only to be accessed through the macros and functions in this module. */
+extern uint32_t g_perf_counters[PERF_COUNTER__LAST];
+
+/**
+ * Increments a performance counter.
+ *
+ * @param[in] ID Counter to increment, see @ref perf_counter_id_t.
+ */
+#define PERF_COUNTER_INC(ID) do { g_perf_counters[(ID)]++; } while (0)
+
+/**
+ * Records a sample in a performance histogram.
+ *
+ * @param[in] ID    Histogram to record the sample in, see @ref perf_histogram_id_t.
+ * @param[in] VALUE Sample value.
+ */
+#define PERF_HISTOGRAM_RECORD(ID, VALUE) perf_histogram_record((ID), (VALUE))
+#else
+#define PERF_COUNTER_INC(ID)
+#define PERF_HISTOGRAM_RECORD(ID, VALUE)
+#endif
+
+/**
+ * Records a sample in a performance histogram.
+ *
+ * @note Use @ref PERF_HISTOGRAM_RECORD, which is removed when the registry is disabled.
+ *
+ * @param[in] id    Histogram to record the sample in.
+ * @param[in] value Sample value.
+ */
+void perf_histogram_record(perf_histogram_id_t id, uint32_t value);
+
+/**
+ * Gets a range of counter values.
+ *
+ * @param[in]  first    First counter to get.
+ * @param[in]  count    Number of counters to get.
+ * @param[out] p_values Array of at least @p count values to fill.
+ *
+ * @retval NRF_SUCCESS             The counter values were stored in @p p_values.
+ * @retval NRF_ERROR_NULL          @p p_values was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM The range exceeds the number of counters.
+ * @retval NRF_ERROR_NOT_SUPPORTED The registry is disabled, see @ref PERF_COUNTER_ENABLE.
+ */
+uint32_t perf_counters_get(uint32_t first, uint32_t count, uint32_t * p_values);
+
+/**
+ * Gets a histogram.
+ *
+ * @param[in]  id          Histogram to get.
+ * @param[out] p_histogram Histogram structure to fill.
+ *
+ * @retval NRF_SUCCESS             The histogram was stored in @p p_histogram.
+ * @retval NRF_ERROR_NULL          @p p_histogram was NULL.
+ * @retval NRF_ERROR_INVALID_PARAM Unknown histogram.
+ * @retval NRF_ERROR_NOT_SUPPORTED The registry is disabled, see @ref PERF_COUNTER_ENABLE.
+ */
+uint32_t perf_histogram_get(perf_histogram_id_t id, perf_histogram_t * p_histogram);
+
+/**
+ * Clears all counters and histograms.
+ */
+void perf_counter_clear(void);
+
+/**
+ * Writes all non-zero counters and histogram buckets to the log.
+ */
+void perf_counter_dump(void);
+
+/** @} */
+
+#endif /* PERF_COUNTER_H__ */
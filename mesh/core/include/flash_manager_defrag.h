@@ -89,6 +89,18 @@ const flash_manager_page_t * flash_manager_defrag_page_get(void);
  */
 void flash_manager_defrag(const flash_manager_t * p_manager);
 
+/**
+ * Defrag the first page of the given flash manager that has invalid entries.
+ *
+ * The procedure ends after rewriting a single page, unless the page ends up holding all the
+ * remaining entries in the area, in which case the rest of the area is cleaned up as well.
+ *
+ * @warning    The p_manager must be complete with valid entries and in state @ref FM_STATE_DEFRAG.
+ *
+ * @param[in]  p_manager  The flash manager instance to defrag.
+ */
+void flash_manager_defrag_incremental(const flash_manager_t * p_manager);
+
 /**
  * Get a pointer to the flash page being used as a recovery area.
  *
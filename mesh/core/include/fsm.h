@@ -160,6 +160,18 @@ typedef struct
 #define FSM_STATE_FLAG      0x80
 
 
+/**@brief   Size of the state/event dispatch index of an FSM.
+ *
+ * @details The index holds the position of the first transition for every pair of state and
+ *          event, plus one row for the "any state" transitions, so that posting an event does
+ *          not have to search the transition table.
+ *
+ * @param[in]   STATE_COUNT Number of states of the FSM.
+ * @param[in]   EVENT_COUNT Number of events of the FSM.
+ */
+#define FSM_INDEX_SIZE(STATE_COUNT, EVENT_COUNT)  (((STATE_COUNT) + 1) * (EVENT_COUNT))
+
+
 /**@brief   Prototype of a user-defined FSM guard condition function.
  *
  * @details     User shall implement a single FSM guard condition function, which will
@@ -208,6 +220,20 @@ typedef struct
      */
     fsm_action_t             action;
 
+    /** Pointer to a buffer of @ref FSM_INDEX_SIZE bytes for the state/event dispatch index,
+     *  which is built by @ref fsm_init. Several FSMs using this descriptor share the index.
+     *  If NULL, the transition table is searched on every event.
+     */
+    uint8_t *                p_index;
+
+    /** Number of states, all state IDs shall be less than this. Only used with @p p_index.
+     */
+    uint8_t                  state_count;
+
+    /** Number of events, all event IDs shall be less than this. Only used with @p p_index.
+     */
+    uint8_t                  event_count;
+
 #if FSM_DEBUG
     /** Pointer to the string with fsm name.
      */
@@ -255,6 +281,9 @@ typedef struct
 
 
 /**@brief   Initializes specific FSM.
+ *
+ * @details If the constant descriptor has a dispatch index buffer, the index is (re)built
+ *          from the transition table.
  *
  * @param[in]   p_fsm       Pointer to FSM descriptor to initialize.
  * @param[in]   p_fsm_const Pointer to constant FSM descriptor with transition table, etc.
@@ -72,6 +72,10 @@
  * the current and the originating nodes, and generates
  * an @ref NRF_MESH_EVT_HB_MESSAGE_RECEIVED event for the user application.
  *
+ * When @ref HEARTBEAT_COLLECTOR_SIZE is nonzero, every received heartbeat message is also passed
+ * to the @ref HEARTBEAT_COLLECTOR, which tracks many sources at once, independently of the
+ * Heartbeat Subscription state.
+ *
  * # Sending heartbeat messages
  * Heartbeat messages can be sent periodically by configuring the Heartbeat Publication state.
  * Heartbeat messages can also be triggered if the state of the node's
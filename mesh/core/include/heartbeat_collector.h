@@ -0,0 +1,136 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef HEARTBEAT_COLLECTOR_H__
+#define HEARTBEAT_COLLECTOR_H__
+
+#include <stdint.h>
+
+#include "nrf_mesh.h"
+#include "nrf_mesh_events.h"
+#include "nrf_mesh_config_core.h"
+#include "timer.h"
+
+/**
+ * @defgroup HEARTBEAT_COLLECTOR Heartbeat collector
+ * @ingroup HEARTBEAT
+ * Passive heartbeat statistics for many sources at once.
+ *
+ * The Heartbeat Subscription state only tracks a single source, so monitoring a network with it
+ * means reconfiguring the subscription for each node in turn. The collector instead keeps a table
+ * of every source it receives heartbeats from, with the hop counts, RSSI and time of the last
+ * heartbeat. It's fed by the heartbeat module with every heartbeat message the transport layer
+ * delivers, regardless of the subscription state.
+ *
+ * The table is an open addressing hash table on the source address, with
+ * @ref HEARTBEAT_COLLECTOR_SIZE entries. When it is full, heartbeats from new sources are dropped
+ * until the table is cleared with @ref heartbeat_collector_clear.
+ * @{
+ */
+
+/** RSSI value used for heartbeats that weren't received over the advertising bearer. */
+#define HEARTBEAT_COLLECTOR_RSSI_INVALID (INT8_MAX)
+
+/** Heartbeat statistics for a single source. */
+typedef struct
+{
+    uint16_t src;          /**< Source address of the heartbeats. */
+    uint16_t count;        /**< Number of heartbeats received. Stops counting at 0xFFFF. */
+    uint16_t features;     /**< Features state in the last heartbeat. */
+    uint8_t hops;          /**< Hop count of the last heartbeat. */
+    uint8_t min_hops;      /**< Lowest hop count received. */
+    uint8_t max_hops;      /**< Highest hop count received. */
+    int8_t rssi;           /**< RSSI of the last heartbeat, or @ref HEARTBEAT_COLLECTOR_RSSI_INVALID. */
+    timestamp_t last_seen; /**< Time of the last heartbeat, in device local time. */
+} heartbeat_collector_entry_t;
+
+/**
+ * Adds a received heartbeat to the collector.
+ *
+ * @param[in] p_hb_message  Parsed heartbeat message.
+ * @param[in] p_rx_metadata Metadata of the (last segment of the) heartbeat message.
+ */
+void heartbeat_collector_process(const nrf_mesh_evt_hb_message_t * p_hb_message,
+                                 const nrf_mesh_rx_metadata_t * p_rx_metadata);
+
+/**
+ * Gets the statistics for a single source.
+ *
+ * @param[in]  src     Source address to look up.
+ * @param[out] p_entry Statistics for @p src.
+ *
+ * @retval NRF_SUCCESS         The entry was copied to @p p_entry.
+ * @retval NRF_ERROR_NOT_FOUND No heartbeats have been received from @p src.
+ */
+uint32_t heartbeat_collector_get(uint16_t src, heartbeat_collector_entry_t * p_entry);
+
+/**
+ * Gets the statistics for a batch of sources.
+ *
+ * Iterates through the table from @p p_index, and copies up to @p p_count entries. Start with
+ * index 0, and keep calling with the returned index until it reaches @ref HEARTBEAT_COLLECTOR_SIZE
+ * to read out the full table. The entries are in table order, not in address order.
+ *
+ * @param[in,out] p_index   Table index to start at. Returns the index to continue from.
+ * @param[out]    p_entries Array to copy the entries to.
+ * @param[in,out] p_count   Size of @p p_entries. Returns the number of entries copied.
+ */
+void heartbeat_collector_entries_get(uint16_t * p_index,
+                                     heartbeat_collector_entry_t * p_entries,
+                                     uint16_t * p_count);
+
+/**
+ * Gets the number of sources in the table.
+ *
+ * @returns The number of sources heartbeats have been received from since the last clear.
+ */
+uint16_t heartbeat_collector_source_count_get(void);
+
+/**
+ * Gets the number of heartbeats dropped because the table was full.
+ *
+ * @returns The number of dropped heartbeats since the last clear.
+ */
+uint32_t heartbeat_collector_dropped_get(void);
+
+/** Removes all sources from the table. */
+void heartbeat_collector_clear(void);
+
+/** @} */
+
+#endif /* HEARTBEAT_COLLECTOR_H__ */
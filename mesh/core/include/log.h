@@ -68,6 +68,9 @@
  *   [Python Log Viewer](https://pythonhosted.org/logview).
  * * **Standard output**: Provides output to `stdout` when running on host. This is
  *   used when `log_callback_stdout` is passed to `__LOG_INIT()`.
+ * * **Deferred binary logging**: messages are stored unformatted in a RAM buffer and formatted on
+ *   the host by `tools/log_decoder/log_decoder.py`. This is used when @ref LOG_DEFERRED_ENABLE is
+ *   set, and takes the formatting cost off the device.
  * @{
  */
 
@@ -243,6 +246,115 @@ void __attribute((format(printf, 5, 6))) log_printf(
 void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line, uint32_t timestamp,
     const char * format, va_list arguments);
 
+#if LOG_DEFERRED_ENABLE
+/**
+ * @defgroup LOG_DEFERRED Deferred binary logging
+ * Stores log messages unformatted, for formatting on the host.
+ *
+ * Every @ref __LOG and @ref __LOG_XB call places a constant @ref log_deferred_meta_t in flash
+ * describing the call site. When the message is logged, the address of this structure, a timestamp
+ * and the raw arguments are stored as a record in a ring buffer. The host decoder looks up the
+ * structure and its strings in the ELF file of the firmware to reconstruct the message.
+ *
+ * Records consist of little endian 32-bit words:
+ * - A header, with the number of words that follow in bits 0-7, the number of records dropped
+ *   before this one due to a full buffer in bits 8-23 (saturating), and @ref LOG_DEFERRED_SYNC in
+ *   bits 24-31.
+ * - The address of the call site's @ref log_deferred_meta_t.
+ * - The timestamp, see @ref log_timestamp_get.
+ * - For @ref LOG_DEFERRED_TYPE_PRINTF records, one word for each argument.
+ * - For @ref LOG_DEFERRED_TYPE_ARRAY records, the address of the message string, the array
+ *   length in bytes and the array contents, padded to a whole number of words.
+ *
+ * Every argument is stored as a 32-bit word. Floating point and 64-bit arguments are not supported,
+ * and @c %s arguments are only decoded if they point to constant strings in the firmware image.
+ * @{
+ */
+
+/** Sync byte in the header of every deferred log record. */
+#define LOG_DEFERRED_SYNC (0xA5)
+/** Maximum number of arguments to a deferred log message. */
+#define LOG_DEFERRED_ARGS_MAX (16)
+
+/** Deferred log record types. */
+typedef enum
+{
+    LOG_DEFERRED_TYPE_PRINTF, /**< The record holds the arguments to a format string. */
+    LOG_DEFERRED_TYPE_ARRAY   /**< The record holds a message and a byte array. */
+} log_deferred_type_t;
+
+/** Constant description of a log call site. */
+typedef struct
+{
+    const char * p_filename; /**< Source file of the call. */
+    const char * p_format;   /**< Format string, or NULL for @ref LOG_DEFERRED_TYPE_ARRAY records. */
+    uint16_t line;           /**< Source line of the call. */
+    uint8_t level;           /**< Log level of the message. */
+    uint8_t type;            /**< Record type, see @ref log_deferred_type_t. */
+} log_deferred_meta_t;
+
+/**
+ * Stores a formatted message in the deferred log.
+ *
+ * @note Use @ref __LOG, which fills in the call site description and argument count.
+ *
+ * @param[in] p_meta    Call site description.
+ * @param[in] timestamp Timestamp for when the log function was called.
+ * @param[in] arg_count Number of 32-bit arguments that follow.
+ */
+void log_deferred_write(const log_deferred_meta_t * p_meta, uint32_t timestamp, uint32_t arg_count, ...);
+
+/**
+ * Stores an array message in the deferred log.
+ *
+ * @note Use @ref __LOG_XB, which fills in the call site description.
+ *
+ * @param[in] p_meta    Call site description.
+ * @param[in] timestamp Timestamp for when the log function was called.
+ * @param[in] p_msg     Message string.
+ * @param[in] p_array   Array to log.
+ * @param[in] length    Length of the array, truncated to @ref LOG_ARRAY_LEN_MAX.
+ */
+void log_deferred_write_array(const log_deferred_meta_t * p_meta, uint32_t timestamp,
+    const char * p_msg, const uint8_t * p_array, uint32_t length);
+
+/**
+ * Reads raw deferred log data, removing it from the log buffer.
+ *
+ * The data is a byte stream of records, and a record may be split across reads.
+ *
+ * @param[out] p_buffer Buffer to copy the log data to.
+ * @param[in]  length   Size of @p p_buffer.
+ *
+ * @returns The number of bytes copied to @p p_buffer.
+ */
+uint32_t log_deferred_read(uint8_t * p_buffer, uint32_t length);
+
+#if (LOG_ENABLE_RTT && !defined(HOST))
+/**
+ * Writes pending deferred log data to RTT channel @ref LOG_DEFERRED_RTT_CHANNEL.
+ *
+ * Call this from the main loop. Data that doesn't fit in the RTT buffer is kept until the next call.
+ */
+void log_deferred_process(void);
+#endif
+
+/** @internal Counts up to @ref LOG_DEFERRED_ARGS_MAX macro arguments. */
+#define LOG_DEFERRED_NARGS(...) LOG_DEFERRED_NARGS_(_, ##__VA_ARGS__, \
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_DEFERRED_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+
+/** @internal Stores a formatted message in the deferred log. */
+#define LOG_DEFERRED_WRITE(level, format, ...)                                                              \
+    do                                                                                                      \
+    {                                                                                                       \
+        static const log_deferred_meta_t log_meta = {__FILE__, format, __LINE__, level, LOG_DEFERRED_TYPE_PRINTF}; \
+        log_deferred_write(&log_meta, log_timestamp_get(), LOG_DEFERRED_NARGS(__VA_ARGS__), ##__VA_ARGS__); \
+    } while (0)
+
+/** @} */
+#endif /* LOG_DEFERRED_ENABLE */
+
 /**
  * Initializes the logging framework.
  * @param[in] msk      Log mask
@@ -257,11 +369,19 @@ void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line, uin
  * @param[in] level  Log level
  * @param[in] ...    Arguments passed on to the callback (similar to @c printf)
  */
+#if LOG_DEFERRED_ENABLE
+#define __LOG(source, level, ...)                                       \
+    if ((source & g_log_dbg_msk) && level <= g_log_dbg_lvl)             \
+    {                                                                   \
+        LOG_DEFERRED_WRITE(level, __VA_ARGS__);                         \
+    }
+#else
 #define __LOG(source, level, ...)                                       \
     if ((source & g_log_dbg_msk) && level <= g_log_dbg_lvl)             \
     {                                                                   \
         log_printf(level, __FILENAME__, __LINE__, log_timestamp_get(), __VA_ARGS__); \
     }
+#endif
 
 /**
  * Prints an array with a message.
@@ -271,6 +391,14 @@ void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line, uin
  * @param[in] array  Pointer to array
  * @param[in] len    Length of array (in bytes)
  */
+#if LOG_DEFERRED_ENABLE
+#define __LOG_XB(source, level, msg, array, array_len)                      \
+    if ((source & g_log_dbg_msk) && (level <= g_log_dbg_lvl))               \
+    {                                                                       \
+        static const log_deferred_meta_t log_meta = {__FILE__, NULL, __LINE__, level, LOG_DEFERRED_TYPE_ARRAY}; \
+        log_deferred_write_array(&log_meta, log_timestamp_get(), msg, (const uint8_t *) (array), array_len); \
+    }
+#else
 #define __LOG_XB(source, level, msg, array, array_len)                      \
     if ((source & g_log_dbg_msk) && (level <= g_log_dbg_lvl))               \
     {                                                                       \
@@ -287,6 +415,7 @@ void log_vprintf(uint32_t dbg_level, const char * p_filename, uint16_t line, uin
         array_text[_array_len * 2] = 0;                                     \
         log_printf(level, __FILENAME__, __LINE__, log_timestamp_get(), "%s: %s\n", msg, array_text); \
     }
+#endif
 
 #else
 #define __LOG_INIT(...)
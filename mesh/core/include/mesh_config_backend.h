@@ -126,6 +126,19 @@ void mesh_config_backend_init(const mesh_config_entry_params_t * p_entries,
  */
 uint32_t mesh_config_backend_store(mesh_config_entry_id_t id, const uint8_t * p_entry, uint32_t entry_len);
 
+/**
+ * Starts a batch of store requests.
+ *
+ * Entries stored until @ref mesh_config_backend_batch_end is called may be collected and written
+ * together. Erase requests end the collection of the entries stored before them.
+ */
+void mesh_config_backend_batch_begin(void);
+
+/**
+ * Ends a batch of store requests, and passes all collected entries on for storage.
+ */
+void mesh_config_backend_batch_end(void);
+
 /**
  * Erases a single entry.
  *
@@ -179,6 +192,15 @@ void mesh_config_backend_read_all(mesh_config_backend_iterate_cb_t cb);
  */
 uint32_t mesh_config_backend_power_down_time_get(void);
 
+/**
+ * Gets the number of bytes the backend has requested written to the storage medium.
+ *
+ * Includes the record headers and padding added by the backend.
+ *
+ * @returns The number of bytes requested written since initialization.
+ */
+uint32_t mesh_config_backend_bytes_written_get(void);
+
 /**
  * Cleans the file content.
  * The backend passes a @ref MESH_CONFIG_BACKEND_EVT_TYPE_FILE_CLEAN_COMPLETE event to the event handler
@@ -83,6 +83,16 @@ uint32_t mesh_config_backend_file_create(mesh_config_backend_file_t * p_file);
  */
 uint32_t mesh_config_backend_record_write(mesh_config_backend_file_t * p_file, const uint8_t * p_data, uint32_t length);
 
+/**
+ * Starts collecting the written records, so records of the same file can be written together.
+ */
+void mesh_config_backend_records_batch_begin(void);
+
+/**
+ * Stops collecting the written records, and schedules all collected records to be written.
+ */
+void mesh_config_backend_records_batch_end(void);
+
 /**
  * Removes the record from the file.
  *
@@ -0,0 +1,90 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MESH_LPN_POLL_POLICY_H__
+#define MESH_LPN_POLL_POLICY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @internal
+ * @defgroup MESH_LPN_POLL_POLICY LPN poll policy
+ * @ingroup MESH_LPN
+ * Picks the interval between the Friend Poll sessions of the Low Power node.
+ *
+ * With a fixed poll interval, the LPN either polls an empty Friend Queue often, or leaves messages
+ * waiting in the queue for a long time when traffic comes in bursts. The adaptive policy polls
+ * again after a short interval when the last session delivered data, and doubles the interval
+ * after each session that found the queue empty. The interval never exceeds the configured poll
+ * interval, which keeps the LPN within the PollTimeout.
+ * @{
+ */
+
+/** Poll policy state. */
+typedef struct
+{
+    /** Shortest poll interval, used after a session that delivered data. 0 disables the adaptive policy. */
+    uint32_t min_interval_ms;
+    /** Current poll interval. */
+    uint32_t interval_ms;
+} mesh_lpn_poll_policy_t;
+
+/**
+ * Resets the poll policy for a new friendship.
+ *
+ * @param[in,out] p_policy        Poll policy to reset.
+ * @param[in]     min_interval_ms Shortest poll interval. 0 makes the policy always use the maximum interval.
+ * @param[in]     interval_ms     Interval to start at.
+ */
+void mesh_lpn_poll_policy_reset(mesh_lpn_poll_policy_t * p_policy, uint32_t min_interval_ms, uint32_t interval_ms);
+
+/**
+ * Gets the interval until the next poll session.
+ *
+ * @param[in,out] p_policy        Poll policy.
+ * @param[in]     had_data        Whether the session that just finished delivered any messages.
+ * @param[in]     max_interval_ms Longest allowed poll interval.
+ *
+ * @returns The number of milliseconds until the next poll session.
+ */
+uint32_t mesh_lpn_poll_policy_next(mesh_lpn_poll_policy_t * p_policy, bool had_data, uint32_t max_interval_ms);
+
+/** @} */
+
+#endif /* MESH_LPN_POLL_POLICY_H__ */
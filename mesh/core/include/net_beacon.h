@@ -59,6 +59,13 @@
  */
 #define NET_BEACON_CMAC_SIZE 8
 
+/** Statistics for the secure network beacon authentication cache. */
+typedef struct
+{
+    uint32_t hits;   /**< Number of received beacons accepted without calculating the CMAC. */
+    uint32_t misses; /**< Number of received beacons that required a CMAC calculation. */
+} net_beacon_auth_cache_stats_t;
+
 /**
  * Initializes the network beacon module.
  */
@@ -112,6 +119,15 @@ uint32_t net_beacon_build(const nrf_mesh_beacon_secmat_t * p_beacon_secmat,
  */
 void net_beacon_packet_in(const uint8_t * p_beacon_data, uint8_t data_length, const nrf_mesh_rx_metadata_t * p_meta);
 
+/**
+ * Gets the statistics of the secure network beacon authentication cache.
+ *
+ * @see NET_BEACON_AUTH_CACHE_SIZE
+ *
+ * @param[out] p_stats Statistics structure to fill.
+ */
+void net_beacon_auth_cache_stats_get(net_beacon_auth_cache_stats_t * p_stats);
+
 /**
  * Get the network beacon flag representation of the given key refresh phase.
  *
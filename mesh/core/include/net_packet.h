@@ -89,6 +89,8 @@ typedef struct
  *                                    packet is decrypted into.
  *
  * @retval NRF_SUCCESS The packet was successfully decrypted.
+ * @retval NRF_ERROR_INVALID_LENGTH The packet length is invalid for the packet kind.
+ * @retval NRF_ERROR_INVALID_STATE The packet is already in the network message cache.
  * @retval NRF_ERROR_NOT_FOUND Couldn't find a network key to decrypt the packet.
  */
 uint32_t net_packet_decrypt(network_packet_metadata_t * p_net_metadata,
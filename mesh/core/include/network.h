@@ -132,6 +132,40 @@ void network_packet_send(const network_tx_packet_buffer_t * p_buffer);
  */
 void network_packet_discard(const network_tx_packet_buffer_t * p_buffer);
 
+/**
+ * Encrypts and obfuscates a relayed network packet into a buffer owned by the caller, to be sent
+ * later with @ref network_packet_encrypted_send.
+ *
+ * The header fields are taken from the metadata as-is, and no sequence number is allocated.
+ *
+ * @param[in,out] p_metadata   Network metadata for the packet.
+ * @param[in]     p_payload    Transport PDU to encrypt.
+ * @param[in]     payload_len  Length of the transport PDU.
+ * @param[out]    p_net_packet Buffer to encrypt the network packet into. Must be at least
+ *                             @ref PACKET_MESH_NET_MAX_SIZE bytes long.
+ */
+void network_packet_encrypt(network_packet_metadata_t * p_metadata,
+                            const uint8_t * p_payload,
+                            uint32_t payload_len,
+                            uint8_t * p_net_packet);
+
+/**
+ * Sends a network packet encrypted by @ref network_packet_encrypt.
+ *
+ * The packet is copied to the bearers as-is, bypassing the encryption in
+ * @ref network_packet_send. Only packets with the @ref CORE_TX_ROLE_RELAY role can be sent this
+ * way, as their sequence number is part of the encrypted packet.
+ *
+ * @param[in] p_buffer     Network packet buffer with the user data of the packet. The payload
+ *                         pointer is ignored.
+ * @param[in] p_net_packet Encrypted network packet.
+ *
+ * @retval NRF_SUCCESS The packet was sent successfully.
+ * @retval NRF_ERROR_NO_MEM There wasn't enough buffer space to allocate the packet.
+ */
+uint32_t network_packet_encrypted_send(const network_tx_packet_buffer_t * p_buffer,
+                                       const uint8_t * p_net_packet);
+
 /**
  * Function for processing incoming packets. Will attempt to decrypt the packet before passing it to
  * transport, along with extracted metadata.
@@ -144,6 +178,7 @@ void network_packet_discard(const network_tx_packet_buffer_t * p_buffer);
  *
  * @retval NRF_SUCCESS The packet was successfully processed.
  * @retval NRF_ERROR_INVALID_ADDR The destination address is not valid.
+ * @retval NRF_ERROR_INVALID_STATE The packet is already in the network message cache.
  * @retval NRF_ERROR_NOT_FOUND    The packet could not be decrypted.
  */
 uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, const nrf_mesh_rx_metadata_t * p_rx_metadata);
@@ -0,0 +1,163 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PACKET_TRACE_H__
+#define PACKET_TRACE_H__
+
+#include <stdint.h>
+#include "nrf_mesh_config_core.h"
+#include "timer.h"
+
+/**
+ * @defgroup PACKET_TRACE Packet lifecycle tracing
+ * @ingroup INTERNAL_EVT
+ * Records the time each packet passes through the stages of the stack.
+ *
+ * Received packets get an ID when the scanner hands them to the stack, and outgoing packets get an
+ * ID when they're allocated on the advertising bearer. Each stage a packet passes through is stored as
+ * a @ref packet_trace_record_t in a ring buffer, which can be read out as a compact binary stream
+ * with @ref packet_trace_read. The per-layer latency of a packet is the difference between the
+ * timestamps of its records.
+ *
+ * Received packets are processed synchronously, so the stages on the RX path are recorded against
+ * the packet currently being processed. Outgoing packets carry their ID in the advertiser packet.
+ * When a packet is allocated while processing a received packet, for instance when relaying, a
+ * @ref PACKET_TRACE_STAGE_TX_ORIGIN record links the two.
+ *
+ * The module is enabled with @ref PACKET_TRACE_ENABLE.
+ * @{
+ */
+
+/** Packet lifecycle stages. */
+typedef enum
+{
+    PACKET_TRACE_STAGE_SCANNER_RX,    /**< Packet received by the radio. */
+    PACKET_TRACE_STAGE_FILTER,        /**< Packet matched the mesh AD type filter and is passed to the network layer. */
+    PACKET_TRACE_STAGE_NET_DECRYPT,   /**< Network PDU decrypted and authenticated. */
+    PACKET_TRACE_STAGE_TRANSPORT,     /**< PDU passed to the transport layer. */
+    PACKET_TRACE_STAGE_ACCESS,        /**< Access message dispatched to the models. */
+    PACKET_TRACE_STAGE_CORE_TX_ALLOC, /**< Outgoing packet allocated. */
+    PACKET_TRACE_STAGE_TX_ORIGIN,     /**< Outgoing packet caused by a received packet. The value is the ID of the received packet. */
+    PACKET_TRACE_STAGE_ADV_QUEUE,     /**< Outgoing packet queued in the advertiser. */
+    PACKET_TRACE_STAGE_RADIO_TX,      /**< Outgoing packet transmitted on all channels. Recorded for every repeat. */
+
+    /** @internal Number of stages. */
+    PACKET_TRACE_STAGE__LAST
+} packet_trace_stage_t;
+
+/** Packet trace record. */
+typedef struct
+{
+    uint32_t value; /**< Timestamp of the stage in microseconds, or the value described for the stage. */
+    uint16_t id;    /**< Packet ID. IDs are assigned sequentially, skipping 0. */
+    uint8_t stage;  /**< Stage, see @ref packet_trace_stage_t. */
+    uint8_t _rfu;   /**< Reserved for future use. */
+} packet_trace_record_t;
+
+/**
+ * Starts tracing a received packet.
+ *
+ * Records the @ref PACKET_TRACE_STAGE_SCANNER_RX stage, and makes the packet the current RX packet
+ * until @ref packet_trace_rx_end is called.
+ *
+ * @param[in] rx_timestamp Time the packet was received by the radio.
+ */
+void packet_trace_rx_begin(timestamp_t rx_timestamp);
+
+/** Ends the processing of the current RX packet. */
+void packet_trace_rx_end(void);
+
+/**
+ * Records a stage for the current RX packet, if any.
+ *
+ * @param[in] stage Stage the packet reached.
+ */
+void packet_trace_rx_stage(packet_trace_stage_t stage);
+
+/**
+ * Starts tracing an outgoing packet, and records the @ref PACKET_TRACE_STAGE_CORE_TX_ALLOC stage.
+ *
+ * @returns The ID of the outgoing packet.
+ */
+uint16_t packet_trace_tx_begin(void);
+
+/**
+ * Records a stage for an outgoing packet.
+ *
+ * @param[in] id        ID of the packet, as returned by @ref packet_trace_tx_begin. Ignored if 0.
+ * @param[in] stage     Stage the packet reached.
+ * @param[in] timestamp Time of the stage.
+ */
+void packet_trace_tx_stage(uint16_t id, packet_trace_stage_t stage, timestamp_t timestamp);
+
+/**
+ * Reads trace records, removing them from the buffer.
+ *
+ * @param[out] p_records Array to copy the records to.
+ * @param[in]  max_count Size of @p p_records.
+ *
+ * @returns The number of records copied to @p p_records.
+ */
+uint32_t packet_trace_read(packet_trace_record_t * p_records, uint32_t max_count);
+
+/**
+ * Gets the number of records dropped due to a full buffer.
+ *
+ * @returns The number of records dropped since the module was last reset.
+ */
+uint32_t packet_trace_dropped_get(void);
+
+/** Drops all records and resets the packet IDs. */
+void packet_trace_reset(void);
+
+#if PACKET_TRACE_ENABLE
+#define PACKET_TRACE_RX_BEGIN(RX_TIMESTAMP)         packet_trace_rx_begin(RX_TIMESTAMP)
+#define PACKET_TRACE_RX_END()                       packet_trace_rx_end()
+#define PACKET_TRACE_RX_STAGE(STAGE)                packet_trace_rx_stage(STAGE)
+#define PACKET_TRACE_TX_BEGIN()                     packet_trace_tx_begin()
+#define PACKET_TRACE_TX_STAGE(ID, STAGE, TIMESTAMP) packet_trace_tx_stage(ID, STAGE, TIMESTAMP)
+#else
+#define PACKET_TRACE_RX_BEGIN(RX_TIMESTAMP)
+#define PACKET_TRACE_RX_END()
+#define PACKET_TRACE_RX_STAGE(STAGE)
+#define PACKET_TRACE_TX_BEGIN()                     (0)
+#define PACKET_TRACE_TX_STAGE(ID, STAGE, TIMESTAMP)
+#endif
+
+/** @} */
+
+#endif /* PACKET_TRACE_H__ */
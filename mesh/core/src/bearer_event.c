@@ -47,6 +47,7 @@
 #include "nrf.h"
 #include "nrf_soc.h"
 #include "nrf_mesh_config_bearer.h"
+#include "perf_counter.h"
 #include "nrf_nvic.h"
 
 #if BEARER_EVENT_USE_SWI0
@@ -182,6 +183,7 @@ static uint32_t evt_push(const bearer_event_t* p_evt)
 {
     if (fifo_push(&m_bearer_event_fifo, p_evt) == NRF_SUCCESS)
     {
+        PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_BEARER_EVENT_QUEUE_DEPTH, fifo_get_len(&m_bearer_event_fifo));
         trigger_event_handler();
         return NRF_SUCCESS;
     }
@@ -42,6 +42,7 @@
 #include "mesh_opt_core.h"
 #include "mesh_config_entry.h"
 #include "app_util_platform.h"
+#include "packet_trace.h"
 
 typedef struct
 {
@@ -102,6 +103,7 @@ static core_tx_alloc_result_t packet_alloc(core_tx_bearer_t * p_bearer, const co
     {
         m_current_alloc.p_packet->token          = p_params->token;
         m_current_alloc.p_packet->config.repeats = m_bearer_roles[p_params->role].adv_tx_count;
+        m_current_alloc.p_packet->trace_id       = PACKET_TRACE_TX_BEGIN();
         m_current_alloc.role                     = p_params->role;
 
         return CORE_TX_ALLOC_SUCCESS;
@@ -119,6 +121,7 @@ static void packet_send(core_tx_bearer_t * p_bearer, const uint8_t * p_packet, u
     p_ad_data->length         = BLE_AD_DATA_OVERHEAD + packet_length;
     memcpy(p_ad_data->data, p_packet, packet_length);
 
+    PACKET_TRACE_TX_STAGE(m_current_alloc.p_packet->trace_id, PACKET_TRACE_STAGE_ADV_QUEUE, timer_now());
     advertiser_packet_send(&m_bearer_roles[m_current_alloc.role].advertiser,
                            m_current_alloc.p_packet);
     m_current_alloc.p_packet = NULL;
@@ -47,6 +47,7 @@
 #include "ccm_soft.h"
 #include "utils.h"
 #include "nrf_mesh_assert.h"
+#include "perf_counter.h"
 
 #define ENC_K2_SALT_INPUT { 's', 'm', 'k', '2' }
 #define ENC_K2_NID_MASK   0x7F
@@ -74,21 +75,29 @@ void enc_aes_encrypt(const uint8_t * p_key, const uint8_t * p_plaintext, uint8_t
     memcpy(aes_data.cleartext, p_plaintext, NRF_MESH_KEY_SIZE);
     aes_encrypt(&aes_data);
     memcpy(p_result, aes_data.ciphertext, NRF_MESH_KEY_SIZE);
+    PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_AES_ECB);
 }
 
 void enc_aes_cmac(const uint8_t * p_key, const uint8_t * p_data, uint16_t data_len, uint8_t * p_result)
 {
     aes_cmac(p_key, p_data, data_len, p_result);
+    PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_AES_CMAC);
 }
 
 void enc_aes_ccm_encrypt(ccm_soft_data_t * const p_ccm_data)
 {
     ccm_soft_encrypt(p_ccm_data);
+    PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_CCM_ENCRYPT);
 }
 
 void enc_aes_ccm_decrypt(ccm_soft_data_t * const p_ccm_data, bool * const p_mic_passed)
 {
     ccm_soft_decrypt(p_ccm_data, p_mic_passed);
+    PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_CCM_DECRYPT);
+    if (!*p_mic_passed)
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_CCM_MIC_FAIL);
+    }
 }
 
 
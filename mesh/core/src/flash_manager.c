@@ -52,6 +52,7 @@
 #define ACTION_BUFFER_SIZE_NO_PARAMS     (offsetof(action_t, params))
 #define ACTION_BUFFER_SIZE_ENTRY_NO_DATA (offsetof(action_t, params.entry_data.entry.data))
 #define ACTION_BUFFER_SIZE_METADATA      (offsetof(action_t, params.metadata) + sizeof(flash_manager_metadata_t))
+#define ACTION_BUFFER_SIZE_BATCH_NO_DATA (offsetof(action_t, params.batch.entries))
 #define ACTION_QUEUE_BUFFER_LENGTH       (sizeof(packet_buffer_packet_t) + FLASH_MANAGER_POOL_SIZE)
 
 NRF_MESH_STATIC_ASSERT(HEADER_LEN == WORD_SIZE);
@@ -61,6 +62,7 @@ NRF_MESH_STATIC_ASSERT(IS_WORD_ALIGNED(sizeof(flash_manager_metadata_t)));
 typedef enum
 {
     ACTION_TYPE_REPLACE, /**< Replace an existing entry, or create a new. */
+    ACTION_TYPE_REPLACE_BATCH, /**< Replace or create several entries in a single write. */
     ACTION_TYPE_INVALIDATE, /**< Invalidate an existing entry. */
     ACTION_TYPE_BUILD_METADATA, /**< Build page metadata. */
     ACTION_TYPE_RECOVER_SEAL, /**< Recover seal at end of entries. */
@@ -90,6 +92,12 @@ typedef struct
             const fm_entry_t * p_target; /**< Pointer to target entry in flash. Used to pass the location to the user. */
             fm_entry_t         entry;    /**< Entry data to write. */
         } entry_data;
+        struct
+        {
+            const fm_entry_t * p_target;  /**< Pointer to the first entry of the batch in flash. */
+            uint32_t           length;    /**< Length of all entries in the batch in bytes. */
+            uint32_t           entries[]; /**< Entries to write, packed back to back. */
+        } batch;
         flash_manager_metadata_t metadata; /**< Metadata to write. */
     } params;
 } action_t;
@@ -116,6 +124,10 @@ static uint16_t              m_token; /**< Token dealt by mesh flash that marks
 static queue_t               m_memory_listener_queue;
 
 static flash_manager_queue_empty_cb_t m_queue_empty_cb;
+/** Managers that have passed their incremental defrag threshold, to be defragmented one at a time once the action queue is empty. */
+static queue_t               m_incremental_defrag_queue;
+/** Whether the ongoing defrag is an incremental defrag. */
+static bool                  m_incremental_defrag;
 /******************************************************************************
 * Static functions
 ******************************************************************************/
@@ -346,35 +358,77 @@ static uint32_t recover_seal(flash_manager_t * p_manager)
     return NRF_SUCCESS;
 }
 
-/** If the last entry is a duplicate of another entry, we should invalidate its duplicate, as it
- * got a power loss before doing the final step of invalidating in a replace action.
+/** If the last entry is a duplicate of another entry, we got a power loss before doing the final
+ * step of invalidating in a replace action. Batch writes invalidate the old copy of their last entry
+ * last, so they might also have left duplicates of the other entries in the batch behind, as can a
+ * batch that got cut off before it was sealed. Invalidate the old copies of the entries of the last
+ * batch in these cases.
  */
 static uint32_t invalidate_duplicate_of_last_entry(flash_manager_t * p_manager)
 {
     NRF_MESH_ASSERT_DEBUG(!flash_manager_defragging(p_manager));
     uint32_t status = NRF_SUCCESS;
     /* get the last entry before the seal */
-    const fm_entry_t * p_entry = get_first_entry(p_manager->config.p_area);
+    const fm_entry_t * p_first = get_first_entry(p_manager->config.p_area);
+    const fm_entry_t * p_entry = p_first;
     if (p_manager->internal.p_seal <= p_entry)
     {
         /* there is no entry before the seal */
         return status;
     }
+
+    /* A batch is never longer than FLASH_MANAGER_BATCH_MAX_SIZE, and its seal either follows it
+     * directly or, if the batch fills the rest of its page, sits right after the next page's
+     * metadata. The last batch starts at the first entry within that distance from the seal. */
+    const fm_entry_t * p_batch_limit = (const fm_entry_t *) ((const uint8_t *) p_manager->internal.p_seal -
+                                                             (FLASH_MANAGER_BATCH_MAX_SIZE +
+                                                              sizeof(flash_manager_metadata_t)));
+    const fm_entry_t * p_last_batch = (p_entry >= p_batch_limit) ? p_entry : NULL;
     const fm_entry_t * p_next = get_next_entry(p_entry);
     while (p_next != p_manager->internal.p_seal)
     {
         p_entry = p_next;
         p_next  = get_next_entry(p_next);
+        if (p_last_batch == NULL && p_entry >= p_batch_limit)
+        {
+            p_last_batch = p_entry;
+        }
+    }
+
+    /* The seal is still pointing to the last entry if it's being recovered. */
+    bool interrupted = (p_manager->internal.p_seal->header.handle != HANDLE_SEAL);
+
+    if (!interrupted)
+    {
+        if (!handle_represents_data(p_entry->header.handle))
+        {
+            return status;
+        }
+
+        const fm_entry_t * p_duplicate = entry_get(p_first, p_entry, p_entry->header.handle);
+        if (p_duplicate == NULL || p_duplicate == p_entry)
+        {
+            return status;
+        }
     }
 
-    if (handle_represents_data(p_entry->header.handle))
+    if (p_last_batch == NULL)
     {
-        const fm_entry_t * p_duplicate =
-            entry_get(get_first_entry(p_manager->config.p_area), p_entry, p_entry->header.handle);
+        p_last_batch = p_entry;
+    }
 
-        if (p_duplicate != NULL && p_duplicate != p_entry)
+    for (p_entry = p_last_batch;
+         p_entry != p_manager->internal.p_seal && status == NRF_SUCCESS;
+         p_entry = get_next_entry(p_entry))
+    {
+        if (handle_represents_data(p_entry->header.handle))
         {
-            status = flash_manager_entry_invalidate(p_manager, p_duplicate->header.handle);
+            const fm_entry_t * p_older = entry_get(p_first, p_entry, p_entry->header.handle);
+            if (p_older != NULL && p_older < p_entry)
+            {
+                /* Invalidation removes the first entry with the handle, which is the old one. */
+                status = flash_manager_entry_invalidate(p_manager, p_entry->header.handle);
+            }
         }
     }
     return status;
@@ -410,6 +464,10 @@ static bool validate_result(const action_t * p_action)
             return (memcmp(p_action->params.entry_data.p_target,
                            &p_action->params.entry_data.entry,
                            entry_length) == 0);
+        case ACTION_TYPE_REPLACE_BATCH:
+            return (memcmp(p_action->params.batch.p_target,
+                           p_action->params.batch.entries,
+                           p_action->params.batch.length) == 0);
         case ACTION_TYPE_INVALIDATE:
             return (p_action->params.entry_data.p_target->header.handle ==
                     FLASH_MANAGER_HANDLE_INVALID);
@@ -443,6 +501,85 @@ static void free_packet_buffer(packet_buffer_packet_t * p_packet_buffer)
     }
 }
 
+static void end_action_batch(action_t * p_action, fm_result_t result)
+{
+    flash_manager_t * p_manager = p_action->p_manager;
+
+    /* Report every entry in the batch separately, so that the users don't have to know about batches. */
+    const fm_entry_t * p_entry = (result == FM_RESULT_SUCCESS) ?
+                                     p_action->params.batch.p_target :
+                                     (const fm_entry_t *) p_action->params.batch.entries;
+    const fm_entry_t * p_end = (const fm_entry_t *) ((const uint8_t *) p_entry + p_action->params.batch.length);
+    const fm_entry_t * p_last = NULL;
+
+    for (; p_entry < p_end; p_entry += p_entry->header.len_words)
+    {
+        if (p_manager->config.write_complete_cb != NULL)
+        {
+            p_manager->config.write_complete_cb(p_manager, p_entry, result);
+        }
+        p_last = p_entry;
+    }
+
+    if (result == FM_RESULT_SUCCESS)
+    {
+        /* Need to reset the seal */
+        p_manager->internal.p_seal = get_next_entry(p_last);
+        NRF_MESH_ASSERT(p_manager->internal.p_seal->header.handle == HANDLE_SEAL);
+    }
+}
+
+static void incremental_defrag_check(flash_manager_t * p_manager)
+{
+    if (p_manager->config.incremental_defrag_threshold != 0 &&
+        p_manager->internal.invalid_bytes >= p_manager->config.incremental_defrag_threshold &&
+        p_manager->internal.defrag_queue_elem.p_data == NULL)
+    {
+        p_manager->internal.defrag_queue_elem.p_data = p_manager;
+        queue_push(&m_incremental_defrag_queue, &p_manager->internal.defrag_queue_elem);
+    }
+}
+
+static void incremental_defrag_cancel(flash_manager_t * p_manager)
+{
+    if (p_manager->internal.defrag_queue_elem.p_data == NULL)
+    {
+        return;
+    }
+
+    QUEUE_FOREACH(&m_incremental_defrag_queue, it)
+    {
+        if (*it.pp_elem == &p_manager->internal.defrag_queue_elem)
+        {
+            queue_iterator_elem_remove(&it);
+            break;
+        }
+    }
+    p_manager->internal.defrag_queue_elem.p_data = NULL;
+}
+
+static bool incremental_defrag_start(void)
+{
+    queue_elem_t * p_elem;
+    while ((p_elem = queue_pop(&m_incremental_defrag_queue)) != NULL)
+    {
+        flash_manager_t * p_manager = (flash_manager_t *) p_elem->p_data;
+        p_elem->p_data = NULL;
+
+        if (p_manager->internal.state == FM_STATE_READY &&
+            p_manager->internal.invalid_bytes >= p_manager->config.incremental_defrag_threshold)
+        {
+            m_state = FM_STATE_DEFRAG;
+            m_incremental_defrag = true;
+            p_manager->internal.state = FM_STATE_DEFRAG;
+            flash_manager_defrag_incremental(p_manager);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 static void end_action(action_t * p_action, fm_result_t result, const fm_entry_t * p_entry)
 {
     if (result == FM_RESULT_SUCCESS && !validate_result(p_action))
@@ -466,12 +603,18 @@ static void end_action(action_t * p_action, fm_result_t result, const fm_entry_t
                 p_manager->internal.p_seal = get_next_entry(p_action->params.entry_data.p_target);
                 NRF_MESH_ASSERT(p_manager->internal.p_seal->header.handle == HANDLE_SEAL);
             }
+            incremental_defrag_check(p_manager);
             if (p_manager->config.write_complete_cb != NULL)
             {
                 p_manager->config.write_complete_cb(p_manager, p_entry, result);
             }
             break;
+        case ACTION_TYPE_REPLACE_BATCH:
+            incremental_defrag_check(p_manager);
+            end_action_batch(p_action, result);
+            break;
         case ACTION_TYPE_INVALIDATE:
+            incremental_defrag_check(p_manager);
             if (p_manager->config.invalidate_complete_cb != NULL)
             {
                 p_manager->config.invalidate_complete_cb(p_manager,
@@ -494,6 +637,8 @@ static void end_action(action_t * p_action, fm_result_t result, const fm_entry_t
                 p_manager->internal.state = FM_STATE_UNINITIALIZED;
             }
 
+            incremental_defrag_cancel(p_manager);
+
             if (p_manager->config.remove_complete_cb != NULL)
             {
                 p_manager->config.remove_complete_cb(p_manager);
@@ -509,6 +654,7 @@ static void end_action(action_t * p_action, fm_result_t result, const fm_entry_t
 static bool defrag_required(action_t * p_next_action)
 {
     if (p_next_action->action == ACTION_TYPE_REPLACE ||
+        p_next_action->action == ACTION_TYPE_REPLACE_BATCH ||
         p_next_action->action == ACTION_TYPE_INVALIDATE)
     {
         int remaining_space = get_remaining_free_space(p_next_action->p_manager);
@@ -518,6 +664,10 @@ static bool defrag_required(action_t * p_next_action)
         {
             required_space = p_next_action->params.entry_data.entry.header.len_words * WORD_SIZE;
         }
+        else if (p_next_action->action == ACTION_TYPE_REPLACE_BATCH)
+        {
+            required_space = p_next_action->params.batch.length;
+        }
         else
         {
             required_space = 0;
@@ -534,62 +684,83 @@ static bool defrag_required(action_t * p_next_action)
 /******************************************************************************
 * Action execution
 ******************************************************************************/
-static fm_result_t execute_action_replace(action_t * p_action)
+/**
+ * Find room for @p length bytes of entries and the seal after the current seal, padding the current
+ * page if the entries don't fit in it.
+ */
+static fm_result_t entry_space_get(flash_manager_t * p_manager,
+                                   uint32_t length,
+                                   const fm_entry_t ** pp_new_entry,
+                                   const fm_entry_t ** pp_new_seal)
 {
-    const fm_entry_t * p_old_entry = entry_get(get_first_entry(p_action->p_manager->config.p_area),
-                                               get_area_end(p_action->p_manager->config.p_area),
-                                               p_action->params.entry_data.entry.header.handle);
-
     /* If we were defragging during a power loss, we won't be recovering the seal at the end, as we
      * won't know which manager we're dealing with. */
-    if (p_action->p_manager->internal.p_seal == NULL)
+    if (p_manager->internal.p_seal == NULL)
     {
-        p_action->p_manager->internal.p_seal =
-            entry_get(get_first_entry(p_action->p_manager->config.p_area),
-                      get_area_end(p_action->p_manager->config.p_area),
+        p_manager->internal.p_seal =
+            entry_get(get_first_entry(p_manager->config.p_area),
+                      get_area_end(p_manager->config.p_area),
                       HANDLE_SEAL);
     }
 
     const flash_manager_page_t * p_next_page =
-        (const flash_manager_page_t *) (PAGE_START_ALIGN(p_action->p_manager->internal.p_seal) + PAGE_SIZE);
-    const fm_entry_t * p_new_seal = NULL;
-    const fm_entry_t * p_new_entry = NULL;
+        (const flash_manager_page_t *) (PAGE_START_ALIGN(p_manager->internal.p_seal) + PAGE_SIZE);
 
-    uint32_t remaining_space = ((uint32_t) p_next_page - (uint32_t) p_action->p_manager->internal.p_seal);
+    uint32_t remaining_space = ((uint32_t) p_next_page - (uint32_t) p_manager->internal.p_seal);
 
-    if (remaining_space > (p_action->params.entry_data.entry.header.len_words * WORD_SIZE))
+    if (remaining_space > length)
     {
         /* The entry and the seal can fit right after the previous entry. */
-        p_new_entry = p_action->p_manager->internal.p_seal;
-        p_new_seal = &p_action->p_manager->internal.p_seal[p_action->params.entry_data.entry.header.len_words];
+        *pp_new_entry = p_manager->internal.p_seal;
+        *pp_new_seal = &p_manager->internal.p_seal[length / WORD_SIZE];
     }
     else
     {
-        if (p_next_page == get_area_end(p_action->p_manager->config.p_area))
+        if (p_next_page == get_area_end(p_manager->config.p_area))
         {
             /* No room for the packet */
             return FM_RESULT_ERROR_AREA_FULL;
         }
 
-        if (remaining_space == (p_action->params.entry_data.entry.header.len_words * WORD_SIZE))
+        if (remaining_space == length)
         {
             /* The entry can fills the page completely. Flash the seal on the next page */
-            p_new_entry = p_action->p_manager->internal.p_seal;
-            p_new_seal = get_first_entry(p_next_page);
+            *pp_new_entry = p_manager->internal.p_seal;
+            *pp_new_seal = get_first_entry(p_next_page);
         }
         else
         {
             /* The entry can't fit in the current page. Pad the page, and place the
              * entry and seal on the next. */
-            NRF_MESH_ERROR_CHECK(flash(p_action->p_manager->internal.p_seal,
+            NRF_MESH_ERROR_CHECK(flash(p_manager->internal.p_seal,
                         &PADDING_HEADER,
                         sizeof(PADDING_HEADER),
                         NULL));
 
-            p_new_entry = get_first_entry(p_next_page);
-            p_new_seal = p_new_entry + p_action->params.entry_data.entry.header.len_words;
+            *pp_new_entry = get_first_entry(p_next_page);
+            *pp_new_seal = *pp_new_entry + length / WORD_SIZE;
         }
     }
+    return FM_RESULT_SUCCESS;
+}
+
+static fm_result_t execute_action_replace(action_t * p_action)
+{
+    const fm_entry_t * p_old_entry = entry_get(get_first_entry(p_action->p_manager->config.p_area),
+                                               get_area_end(p_action->p_manager->config.p_area),
+                                               p_action->params.entry_data.entry.header.handle);
+
+    const fm_entry_t * p_new_seal = NULL;
+    const fm_entry_t * p_new_entry = NULL;
+
+    fm_result_t result = entry_space_get(p_action->p_manager,
+                                         p_action->params.entry_data.entry.header.len_words * WORD_SIZE,
+                                         &p_new_entry,
+                                         &p_new_seal);
+    if (result != FM_RESULT_SUCCESS)
+    {
+        return result;
+    }
 
     /* Flash the data */
     NRF_MESH_ERROR_CHECK(flash(p_new_entry,
@@ -617,6 +788,94 @@ static fm_result_t execute_action_replace(action_t * p_action)
     return FM_RESULT_SUCCESS;
 }
 
+/**
+ * Move the last entry in the batch that replaces an existing entry to the end of the batch.
+ *
+ * The old copy of the last entry is invalidated last. If the device loses power before all old
+ * copies are invalidated, the last entry is left with a duplicate, which makes
+ * @ref flash_manager_add look for other duplicates.
+ */
+static void batch_entries_order(action_t * p_action, const fm_entry_t * p_first, const fm_entry_t * p_seal)
+{
+    uint8_t * p_start = (uint8_t *) p_action->params.batch.entries;
+    uint8_t * p_end = p_start + p_action->params.batch.length;
+    fm_entry_t * p_replacing = NULL;
+
+    for (fm_entry_t * p_entry = (fm_entry_t *) p_start;
+         (uint8_t *) p_entry < p_end;
+         p_entry += p_entry->header.len_words)
+    {
+        if (entry_get(p_first, p_seal, p_entry->header.handle) != NULL)
+        {
+            p_replacing = p_entry;
+        }
+    }
+
+    if (p_replacing == NULL)
+    {
+        return;
+    }
+
+    uint32_t entry_size = p_replacing->header.len_words * WORD_SIZE;
+    uint8_t * p_next = (uint8_t *) p_replacing + entry_size;
+    if (p_next != p_end)
+    {
+        uint32_t entry_copy[(sizeof(fm_header_t) + ALIGN_VAL(FLASH_MANAGER_ENTRY_MAX_SIZE, WORD_SIZE)) / WORD_SIZE];
+        memcpy(entry_copy, p_replacing, entry_size);
+        memmove(p_replacing, p_next, (uint32_t) (p_end - p_next));
+        memcpy(p_end - entry_size, entry_copy, entry_size);
+    }
+}
+
+static fm_result_t execute_action_replace_batch(action_t * p_action)
+{
+    flash_manager_t * p_manager = p_action->p_manager;
+    const fm_entry_t * p_first = get_first_entry(p_manager->config.p_area);
+    const fm_entry_t * p_new_seal = NULL;
+    const fm_entry_t * p_new_entry = NULL;
+
+    fm_result_t result = entry_space_get(p_manager, p_action->params.batch.length, &p_new_entry, &p_new_seal);
+    if (result != FM_RESULT_SUCCESS)
+    {
+        return result;
+    }
+
+    /* Old copies of the entries all come before the current seal. Don't look further, the
+     * new entries may already be written there. */
+    const fm_entry_t * p_old_seal = p_manager->internal.p_seal;
+    batch_entries_order(p_action, p_first, p_old_seal);
+
+    /* Flash all entries in one go, and seal them. */
+    NRF_MESH_ERROR_CHECK(flash(p_new_entry,
+                p_action->params.batch.entries,
+                p_action->params.batch.length,
+                NULL));
+    NRF_MESH_ERROR_CHECK(flash(p_new_seal,
+                &SEAL_HEADER,
+                sizeof(SEAL_HEADER),
+                &m_token));
+
+    const fm_entry_t * p_end = (const fm_entry_t *) ((const uint8_t *) p_action->params.batch.entries +
+                                                     p_action->params.batch.length);
+    for (const fm_entry_t * p_entry = (const fm_entry_t *) p_action->params.batch.entries;
+         p_entry < p_end;
+         p_entry += p_entry->header.len_words)
+    {
+        const fm_entry_t * p_old_entry = entry_get(p_first, p_old_seal, p_entry->header.handle);
+        if (p_old_entry != NULL)
+        {
+            p_manager->internal.invalid_bytes += p_old_entry->header.len_words * WORD_SIZE;
+            NRF_MESH_ERROR_CHECK(flash(p_old_entry,
+                        &INVALID_HEADER,
+                        sizeof(INVALID_HEADER),
+                        &m_token));
+        }
+    }
+
+    p_action->params.batch.p_target = p_new_entry;
+    return FM_RESULT_SUCCESS;
+}
+
 static fm_result_t execute_action_invalidate(action_t * p_action)
 {
     const fm_entry_t * p_old_entry = entry_get(get_first_entry(p_action->p_manager->config.p_area),
@@ -705,6 +964,8 @@ static fm_result_t execute_action(action_t * p_action)
     {
         case ACTION_TYPE_REPLACE:
             return execute_action_replace(p_action);
+        case ACTION_TYPE_REPLACE_BATCH:
+            return execute_action_replace_batch(p_action);
         case ACTION_TYPE_INVALIDATE:
             return execute_action_invalidate(p_action);
         case ACTION_TYPE_BUILD_METADATA:
@@ -733,6 +994,13 @@ static bool process_action_queue(void)
                 if (packet_buffer_pop(&m_action_queue,
                                       &p_buffer) != NRF_SUCCESS)
                 {
+                    /* Use the idle time to reclaim space, so that the next writes won't have to
+                     * wait for a full defrag. */
+                    if (incremental_defrag_start())
+                    {
+                        return true;
+                    }
+
                     if (m_queue_empty_cb)
                     {
                         m_queue_empty_cb();
@@ -804,6 +1072,8 @@ void flash_manager_init(void)
     m_processing_flag = bearer_event_flag_add(process_action_queue);
     m_action_state = ACTION_STATE_IDLE;
     m_token = 0;
+    queue_init(&m_incremental_defrag_queue);
+    m_incremental_defrag = false;
     queue_init(&m_memory_listener_queue);
 
     if (flash_manager_defrag_init())
@@ -830,6 +1100,7 @@ uint32_t flash_manager_add(flash_manager_t * p_manager,
     memcpy(&p_manager->config, p_config, sizeof(flash_manager_config_t));
     p_manager->internal.p_seal = NULL;
     p_manager->internal.invalid_bytes = 0;
+    p_manager->internal.defrag_queue_elem.p_data = NULL;
 
     if (flash_area_is_valid(p_manager))
     {
@@ -1120,6 +1391,98 @@ void flash_manager_entry_release(fm_entry_t * p_entry)
 
 }
 
+uint32_t flash_manager_batch_begin(fm_batch_t * p_batch, flash_manager_t * p_manager, uint32_t max_length)
+{
+    NRF_MESH_ASSERT(p_batch != NULL);
+    NRF_MESH_ASSERT(p_manager != NULL);
+    NRF_MESH_ASSERT(IS_WORD_ALIGNED(max_length));
+    NRF_MESH_ASSERT(max_length > 0 && max_length <= FLASH_MANAGER_BATCH_MAX_SIZE);
+
+    if (p_manager->internal.state == FM_STATE_UNINITIALIZED)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    action_t * p_action = reserve_action_buffer(ACTION_BUFFER_SIZE_BATCH_NO_DATA + max_length);
+    if (p_action == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_action->action = ACTION_TYPE_REPLACE_BATCH;
+    p_action->p_manager = p_manager;
+    p_action->params.batch.length = 0;
+
+    p_batch->p_manager = p_manager;
+    p_batch->p_action = p_action;
+    p_batch->length = 0;
+    p_batch->max_length = max_length;
+    return NRF_SUCCESS;
+}
+
+fm_entry_t * flash_manager_batch_entry_append(fm_batch_t * p_batch, fm_handle_t handle, uint32_t data_length)
+{
+    NRF_MESH_ASSERT(p_batch != NULL && p_batch->p_action != NULL);
+    NRF_MESH_ASSERT(handle_represents_data(handle));
+    NRF_MESH_ASSERT(data_length <= FLASH_MANAGER_ENTRY_MAX_SIZE);
+
+    action_t * p_action = p_batch->p_action;
+    uint32_t entry_length = FLASH_MANAGER_BATCH_ENTRY_SIZE(data_length);
+    if (p_batch->length + entry_length > p_batch->max_length)
+    {
+        return NULL;
+    }
+
+    /* Each handle can only be written once per batch, as the old copies are looked up by handle. */
+    const fm_entry_t * p_end = (const fm_entry_t *) ((const uint8_t *) p_action->params.batch.entries + p_batch->length);
+    for (const fm_entry_t * p_it = (const fm_entry_t *) p_action->params.batch.entries;
+         p_it < p_end;
+         p_it += p_it->header.len_words)
+    {
+        NRF_MESH_ASSERT(p_it->header.handle != handle);
+    }
+
+    fm_entry_t * p_entry = (fm_entry_t *) p_end;
+    p_entry->header.handle = handle;
+    p_entry->header.len_words = entry_length / WORD_SIZE;
+
+    /* Write 1s to last word (if any) to avoid padding with random data if data_length is not already aligned */
+    if (p_entry->header.len_words > 1)
+    {
+        p_entry->data[p_entry->header.len_words - 2] = UINT32_MAX;
+    }
+
+    p_batch->length += entry_length;
+    return p_entry;
+}
+
+void flash_manager_batch_commit(fm_batch_t * p_batch)
+{
+    NRF_MESH_ASSERT(p_batch != NULL && p_batch->p_action != NULL);
+
+    if (p_batch->length == 0)
+    {
+        flash_manager_batch_release(p_batch);
+        return;
+    }
+
+    action_t * p_action = p_batch->p_action;
+    p_action->params.batch.length = p_batch->length;
+    packet_buffer_commit(&m_action_queue,
+                         get_packet_buffer(p_action),
+                         ACTION_BUFFER_SIZE_BATCH_NO_DATA + p_batch->length);
+    p_batch->p_action = NULL;
+    schedule_processing();
+}
+
+void flash_manager_batch_release(fm_batch_t * p_batch)
+{
+    NRF_MESH_ASSERT(p_batch != NULL && p_batch->p_action != NULL);
+
+    free_packet_buffer(get_packet_buffer(p_batch->p_action));
+    p_batch->p_action = NULL;
+}
+
 void flash_manager_mem_listener_register(fm_mem_listener_t * p_listener)
 {
     NRF_MESH_ASSERT(p_listener != NULL);
@@ -1151,8 +1514,18 @@ void flash_manager_on_defrag_end(flash_manager_t * p_manager)
         }
 
         p_manager->internal.state = FM_STATE_READY;
-        p_manager->internal.invalid_bytes = 0;
+        if (m_incremental_defrag)
+        {
+            /* Only part of the area got defragmented, carry on the next time the queue is idle. */
+            p_manager->internal.invalid_bytes = get_invalid_bytes(p_manager->config.p_area, p_manager->config.page_count);
+            incremental_defrag_check(p_manager);
+        }
+        else
+        {
+            p_manager->internal.invalid_bytes = 0;
+        }
     }
+    m_incremental_defrag = false;
     m_state = FM_STATE_READY;
     mesh_flash_user_callback_set(MESH_FLASH_USER_MESH, flash_op_ended_callback);
     schedule_processing();
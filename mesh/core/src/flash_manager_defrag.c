@@ -72,6 +72,13 @@
  * 10. Post process: Cleanup our state, and move on to the next page. If there are no more pages to
  *    backup, we erase the defrag start pointer from the recovery area, and end the procedure.
  *
+ * The flash manager may also run the procedure incrementally, to reclaim space in the background
+ * without blocking its action queue for the duration of a full defrag. An incremental defrag ends
+ * in the post process step after the first page that was rewritten, as long as there are entries
+ * left in the following pages. The area is consistent between any two pages of the procedure, so
+ * the next incremental defrag just picks up at the first page that still has invalid entries. If
+ * the power fails in the middle of an incremental defrag, it's resumed as a full defrag.
+ *
  * Each procedure step is implemented as a single function that returns whether the procedure
  * should continue, attempt to re-run the step, finish or restart. This allows us to resume the
  * procedure in a clean way if any of the flash functions were to run out of queue space, which is
@@ -124,6 +131,7 @@ typedef struct
     const fm_entry_t * p_dst; /**< Next destination in recovery page. */
     bool wait_for_idle;       /**< Flag, that when set makes the procedure wait for all flash operations to end before proceeding. */
     bool found_all_entries;   /**< Whether we've ran through all entries in the original area. */
+    bool incremental;         /**< Whether to stop after the first page that was rewritten. */
 } defrag_t;
 
 /** Single chunk of entries. */
@@ -439,7 +447,11 @@ static procedure_action_t seal_storage_page(void)
 
 static procedure_action_t post_process(void)
 {
-    if (m_defrag.p_storage_page == get_last_page(m_defrag.p_storage_page))
+    /* An incremental defrag only rewrites a single page, unless this page took the last of the
+     * entries. The pages after it must then be processed too, to get rid of the duplicates of the
+     * entries we moved. */
+    if (m_defrag.p_storage_page == get_last_page(m_defrag.p_storage_page) ||
+        (m_defrag.incremental && !m_defrag.found_all_entries))
     {
         /* Invalidate area pointer */
         static const uint32_t * p_null_ptr = NULL;
@@ -557,6 +569,25 @@ static void on_flash_op_end(mesh_flash_user_t user, const flash_operation_t * p_
     }
 }
 
+static void defrag_start(const flash_manager_t * p_manager, bool incremental)
+{
+    NRF_MESH_ASSERT(m_defrag.state == DEFRAG_STATE_IDLE);
+    NRF_MESH_ASSERT(p_manager->internal.state == FM_STATE_DEFRAG);
+
+    m_defrag.p_manager = p_manager;
+    m_defrag.p_storage_page = p_manager->config.p_area;
+    m_defrag.step = 0;
+    m_defrag.wait_for_idle = false;
+    m_defrag.state = DEFRAG_STATE_PROCESSING;
+    m_defrag.found_all_entries = false;
+    m_defrag.incremental = incremental;
+
+    mesh_flash_user_callback_set(FLASH_MANAGER_FLASH_USER, on_flash_op_end);
+
+    execute_procedure_step();
+    __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_FM_DEFRAG, 0, 0, NULL);
+}
+
 /**
  * Checks if a defrag was interrupted by a power cycle, and continues where it left off.
  *
@@ -571,6 +602,7 @@ static bool recover_defrag_progress(void)
         m_defrag.p_storage_page = mp_recovery_area->p_storage_page;
         m_defrag.wait_for_idle = false;
         m_defrag.found_all_entries = false;
+        m_defrag.incremental = false;
         m_defrag.state = DEFRAG_STATE_PROCESSING;
         m_defrag.p_manager = NULL; /* Can't know which manager this is. */
         jump_to_step(DEFRAG_RECOVER_STEP);
@@ -632,20 +664,12 @@ bool flash_manager_defrag_is_running(void)
 
 void flash_manager_defrag(const flash_manager_t * p_manager)
 {
-    NRF_MESH_ASSERT(m_defrag.state == DEFRAG_STATE_IDLE);
-    NRF_MESH_ASSERT(p_manager->internal.state == FM_STATE_DEFRAG);
-
-    m_defrag.p_manager = p_manager;
-    m_defrag.p_storage_page = p_manager->config.p_area;
-    m_defrag.step = 0;
-    m_defrag.wait_for_idle = false;
-    m_defrag.state = DEFRAG_STATE_PROCESSING;
-    m_defrag.found_all_entries = false;
-
-    mesh_flash_user_callback_set(FLASH_MANAGER_FLASH_USER, on_flash_op_end);
+    defrag_start(p_manager, false);
+}
 
-    execute_procedure_step();
-    __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_FM_DEFRAG, 0, 0, NULL);
+void flash_manager_defrag_incremental(const flash_manager_t * p_manager)
+{
+    defrag_start(p_manager, true);
 }
 
 const void * flash_manager_defrag_recovery_page_get(void)
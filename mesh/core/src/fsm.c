@@ -46,10 +46,19 @@
 #define FSM_INVALID_INDEX   0xFF
 
 static void fsm_any_state_find(fsm_t * p_fsm);
+static void fsm_index_build(const fsm_const_descriptor_t * p_fsm_const);
+static bool fsm_block_transitions_try(fsm_t * p_fsm,
+                                      fsm_event_id_t event_id,
+                                      void * p_data,
+                                      uint32_t first_table_idx);
 static bool fsm_event_post_try(fsm_t * p_fsm,
                                fsm_event_id_t event_id,
                                void * p_data,
                                uint8_t start_table_idx);
+static bool fsm_event_post_indexed_try(fsm_t * p_fsm,
+                                       fsm_event_id_t event_id,
+                                       void * p_data,
+                                       uint32_t index_row);
 static bool fsm_transition_perform_try(fsm_t * p_fsm,
                                        const fsm_transition_t * p_transition,
                                        void * p_data);
@@ -96,41 +105,86 @@ static void fsm_any_state_find(fsm_t * p_fsm)
 }
 
 
-static bool fsm_event_post_try(fsm_t * p_fsm,
-                               fsm_event_id_t event_id,
-                               void * p_data,
-                               uint8_t start_table_idx)
+static void fsm_index_build(const fsm_const_descriptor_t * p_fsm_const)
 {
-    const fsm_const_descriptor_t * p_fsm_const;
-    const fsm_transition_t * p_transition_table;
-    const fsm_transition_t * p_transition_table_end;
-    const fsm_transition_t * p_transition;
-    fsm_state_id_t           current_state;
+    const fsm_transition_t * p_transition_table = p_fsm_const->transition_table;
+    uint8_t * p_index = p_fsm_const->p_index;
+    uint32_t row;
+    uint32_t i;
 
-    current_state = p_fsm->current_state;
-    p_fsm_const = p_fsm->fsm_const_desc;
-    p_transition_table = p_fsm_const->transition_table;
-    p_transition_table_end = p_transition_table + p_fsm_const->transitions_count;
+    NRF_MESH_ASSERT(p_fsm_const->transitions_count < FSM_INVALID_INDEX);
+    NRF_MESH_ASSERT(p_fsm_const->event_count > 0);
+    NRF_MESH_ASSERT(p_fsm_const->initial_state < p_fsm_const->state_count);
 
-    if (start_table_idx == 0 && p_fsm->any_state_transitions_index != 0)
+    // verify that every state and event of the table fits in the index.
+    for (i = 0; i < p_fsm_const->transitions_count; i++)
     {
-        // look for the beginning of the current state's transitions
-        for (p_transition = p_transition_table; p_transition < p_transition_table_end; p_transition++)
+        if (p_transition_table[i].event_id & FSM_STATE_FLAG)
+        {
+            NRF_MESH_ASSERT(p_transition_table[i].event_id == FSM_ANY_STATE ||
+                            (p_transition_table[i].event_id ^ FSM_STATE_FLAG) < p_fsm_const->state_count);
+        }
+        else
+        {
+            NRF_MESH_ASSERT(p_transition_table[i].event_id < p_fsm_const->event_count);
+            NRF_MESH_ASSERT(p_transition_table[i].new_state_id == FSM_SAME_STATE ||
+                            p_transition_table[i].new_state_id < p_fsm_const->state_count);
+        }
+    }
+
+    // one row per state, followed by the row of the "any state declaration block".
+    // Each item is written once with its final value, so the index stays valid for other
+    // instances sharing the descriptor while it is being rebuilt.
+    for (row = 0; row <= p_fsm_const->state_count; row++)
+    {
+        fsm_event_id_t state_declaration = (row == p_fsm_const->state_count) ?
+                                           FSM_ANY_STATE : (fsm_event_id_t) (row | FSM_STATE_FLAG);
+        uint32_t block_idx;
+
+        for (block_idx = 0; block_idx < p_fsm_const->transitions_count; block_idx++)
         {
-            if ((p_transition->event_id ^ FSM_STATE_FLAG) == current_state)
+            if (p_transition_table[block_idx].event_id == state_declaration)
             {
                 break;
             }
         }
+
+        for (fsm_event_id_t event_id = 0; event_id < p_fsm_const->event_count; event_id++)
+        {
+            uint8_t first_idx = FSM_INVALID_INDEX;
+
+            for (i = block_idx + 1; i < p_fsm_const->transitions_count; i++)
+            {
+                if (p_transition_table[i].event_id == event_id)
+                {
+                    first_idx = i;
+                    break;
+                }
+                else if (p_transition_table[i].event_id & FSM_STATE_FLAG)
+                {
+                    break;
+                }
+            }
+
+            p_index[row * p_fsm_const->event_count + event_id] = first_idx;
+        }
     }
-    else
-    {
-        p_transition = p_transition_table + start_table_idx;
-    }
+}
 
-    // continue lookup - look for the occurred event in the current state's transitions
-    for (p_transition++; p_transition < p_transition_table_end; p_transition++)
+
+static bool fsm_block_transitions_try(fsm_t * p_fsm,
+                                      fsm_event_id_t event_id,
+                                      void * p_data,
+                                      uint32_t first_table_idx)
+{
+    const fsm_const_descriptor_t * p_fsm_const = p_fsm->fsm_const_desc;
+    const fsm_transition_t * p_transition;
+
+    // look for the occurred event in the transitions of this block
+    for (uint32_t i = first_table_idx; i < p_fsm_const->transitions_count; i++)
     {
+        p_transition = &p_fsm_const->transition_table[i];
+
         // check this transition is for the given event
         if (p_transition->event_id == event_id)
         {
@@ -150,6 +204,54 @@ static bool fsm_event_post_try(fsm_t * p_fsm,
 }
 
 
+static bool fsm_event_post_try(fsm_t * p_fsm,
+                               fsm_event_id_t event_id,
+                               void * p_data,
+                               uint8_t start_table_idx)
+{
+    const fsm_const_descriptor_t * p_fsm_const;
+    const fsm_transition_t * p_transition_table;
+    uint32_t                 block_idx;
+    fsm_state_id_t           current_state;
+
+    current_state = p_fsm->current_state;
+    p_fsm_const = p_fsm->fsm_const_desc;
+    p_transition_table = p_fsm_const->transition_table;
+
+    if (start_table_idx == 0 && p_fsm->any_state_transitions_index != 0)
+    {
+        // look for the beginning of the current state's transitions
+        for (block_idx = 0; block_idx < p_fsm_const->transitions_count; block_idx++)
+        {
+            if ((p_transition_table[block_idx].event_id ^ FSM_STATE_FLAG) == current_state)
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        block_idx = start_table_idx;
+    }
+
+    // continue lookup - look for the occurred event in the current state's transitions
+    return fsm_block_transitions_try(p_fsm, event_id, p_data, block_idx + 1);
+}
+
+
+static bool fsm_event_post_indexed_try(fsm_t * p_fsm,
+                                       fsm_event_id_t event_id,
+                                       void * p_data,
+                                       uint32_t index_row)
+{
+    const fsm_const_descriptor_t * p_fsm_const = p_fsm->fsm_const_desc;
+    uint8_t first_idx = p_fsm_const->p_index[index_row * p_fsm_const->event_count + event_id];
+
+    return (first_idx != FSM_INVALID_INDEX &&
+            fsm_block_transitions_try(p_fsm, event_id, p_data, first_idx));
+}
+
+
 static bool fsm_transition_perform_try(fsm_t * p_fsm,
                                        const fsm_transition_t * p_transition,
                                        void * p_data)
@@ -229,6 +331,11 @@ void fsm_init(fsm_t * p_fsm, const fsm_const_descriptor_t * p_fsm_const)
 #endif
 
     fsm_any_state_find(p_fsm);
+
+    if (p_fsm_const->p_index != NULL)
+    {
+        fsm_index_build(p_fsm_const);
+    }
 }
 
 void fsm_event_post(fsm_t * p_fsm, fsm_event_id_t event_id, void * p_data)
@@ -241,7 +348,17 @@ void fsm_event_post(fsm_t * p_fsm, fsm_event_id_t event_id, void * p_data)
 
     p_fsm->recursion_protection++;
 
-    if (!fsm_event_post_try(p_fsm, event_id, p_data, 0))
+    if (p_fsm->fsm_const_desc->p_index != NULL)
+    {
+        NRF_MESH_ASSERT(event_id < p_fsm->fsm_const_desc->event_count);
+
+        if (!fsm_event_post_indexed_try(p_fsm, event_id, p_data, p_fsm->current_state))
+        {
+            (void) fsm_event_post_indexed_try(p_fsm, event_id, p_data,
+                                              p_fsm->fsm_const_desc->state_count);
+        }
+    }
+    else if (!fsm_event_post_try(p_fsm, event_id, p_data, 0))
     {
         if (p_fsm->any_state_transitions_index != FSM_INVALID_INDEX)
         {
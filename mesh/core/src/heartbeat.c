@@ -35,6 +35,7 @@
  * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "heartbeat.h"
+#include "heartbeat_collector.h"
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -157,13 +158,33 @@ static void heartbeat_opcode_handle(const transport_control_packet_t * p_control
                                     const nrf_mesh_rx_metadata_t *     p_rx_metadata)
 {
     if ((p_control_packet->opcode != TRANSPORT_CONTROL_OPCODE_HEARTBEAT) ||
-        (p_control_packet->src != m_heartbeat_subscription.src) ||
-        (p_control_packet->dst.value != m_heartbeat_subscription.dst) ||
         (p_control_packet->data_len != PACKET_MESH_TRS_CONTROL_HEARTBEAT_SIZE))
     {
         return;
     }
 
+    nrf_mesh_evt_t evt;
+    evt.type = NRF_MESH_EVT_HB_MESSAGE_RECEIVED;
+    evt.params.hb_message.init_ttl =
+        packet_mesh_trs_control_heartbeat_init_ttl_get(p_control_packet->p_data);
+    evt.params.hb_message.hops =
+        packet_mesh_trs_control_heartbeat_init_ttl_get(p_control_packet->p_data) -
+        p_control_packet->ttl + 1;
+    evt.params.hb_message.features =
+        packet_mesh_trs_control_heartbeat_features_get(p_control_packet->p_data) &
+        HEARTBEAT_TRIGGER_TYPE_RFU_MASK;
+    evt.params.hb_message.src = p_control_packet->src;
+
+#if HEARTBEAT_COLLECTOR_SIZE > 0
+    heartbeat_collector_process(&evt.params.hb_message, p_rx_metadata);
+#endif
+
+    if ((p_control_packet->src != m_heartbeat_subscription.src) ||
+        (p_control_packet->dst.value != m_heartbeat_subscription.dst))
+    {
+        return;
+    }
+
     if (m_heartbeat_subscription.period > 0)
     {
         // @tagMeshSp section 3.6.7.3:
@@ -173,18 +194,6 @@ static void heartbeat_opcode_handle(const transport_control_packet_t * p_control
             m_heartbeat_subscription.count++;
         }
 
-        nrf_mesh_evt_t evt;
-        evt.type = NRF_MESH_EVT_HB_MESSAGE_RECEIVED;
-        evt.params.hb_message.init_ttl =
-            packet_mesh_trs_control_heartbeat_init_ttl_get(p_control_packet->p_data);
-        evt.params.hb_message.hops =
-            packet_mesh_trs_control_heartbeat_init_ttl_get(p_control_packet->p_data) -
-            p_control_packet->ttl + 1;
-        evt.params.hb_message.features =
-            packet_mesh_trs_control_heartbeat_features_get(p_control_packet->p_data) &
-            HEARTBEAT_TRIGGER_TYPE_RFU_MASK;
-        evt.params.hb_message.src = p_control_packet->src;
-
         if (evt.params.hb_message.hops < m_heartbeat_subscription.min_hops)
         {
             m_heartbeat_subscription.min_hops = evt.params.hb_message.hops;
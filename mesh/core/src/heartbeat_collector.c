@@ -0,0 +1,216 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heartbeat_collector.h"
+
+#include <string.h>
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "utils.h"
+
+#if HEARTBEAT_COLLECTOR_SIZE > 0
+
+/* The source hash is masked rather than divided, so the table size must be a power of two. */
+NRF_MESH_STATIC_ASSERT(IS_POWER_OF_2(HEARTBEAT_COLLECTOR_SIZE));
+NRF_MESH_STATIC_ASSERT(HEARTBEAT_COLLECTOR_SIZE <= UINT16_MAX);
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+/** Source table. Unused entries have the source address @ref NRF_MESH_ADDR_UNASSIGNED. */
+static heartbeat_collector_entry_t m_entries[HEARTBEAT_COLLECTOR_SIZE];
+static uint16_t m_source_count;
+static uint32_t m_dropped;
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static inline uint32_t src_hash(uint16_t src)
+{
+    /* Unicast addresses are usually allocated in sequence, with a stride of the element count of
+     * each node. Spread them with a multiplicative hash so the probe sequences stay short. */
+    return (((uint32_t) src * 2654435761u) >> 16) & (HEARTBEAT_COLLECTOR_SIZE - 1);
+}
+
+/**
+ * Finds the entry for the given source, or the unused entry it should go in.
+ *
+ * @returns The entry for @p src, the first free entry in its probe sequence, or NULL if the table
+ * is full and doesn't contain @p src.
+ */
+static heartbeat_collector_entry_t * entry_find(uint16_t src)
+{
+    uint32_t index = src_hash(src);
+    for (uint32_t i = 0; i < HEARTBEAT_COLLECTOR_SIZE; ++i)
+    {
+        heartbeat_collector_entry_t * p_entry = &m_entries[index];
+        if (p_entry->src == src || p_entry->src == NRF_MESH_ADDR_UNASSIGNED)
+        {
+            return p_entry;
+        }
+        index = (index + 1) & (HEARTBEAT_COLLECTOR_SIZE - 1);
+    }
+    return NULL;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void heartbeat_collector_process(const nrf_mesh_evt_hb_message_t * p_hb_message,
+                                 const nrf_mesh_rx_metadata_t * p_rx_metadata)
+{
+    NRF_MESH_ASSERT(p_hb_message != NULL && p_rx_metadata != NULL);
+
+    /* The transport layer only accepts unicast sources, but the unassigned address marks unused
+     * entries in the table, so make sure it never gets in. */
+    if (p_hb_message->src == NRF_MESH_ADDR_UNASSIGNED)
+    {
+        return;
+    }
+
+    heartbeat_collector_entry_t * p_entry = entry_find(p_hb_message->src);
+    if (p_entry == NULL)
+    {
+        m_dropped++;
+        return;
+    }
+
+    if (p_entry->src == NRF_MESH_ADDR_UNASSIGNED)
+    {
+        p_entry->src = p_hb_message->src;
+        p_entry->count = 0;
+        p_entry->min_hops = p_hb_message->hops;
+        p_entry->max_hops = p_hb_message->hops;
+        m_source_count++;
+    }
+
+    if (p_entry->count < UINT16_MAX)
+    {
+        p_entry->count++;
+    }
+
+    p_entry->features = p_hb_message->features;
+    p_entry->hops = p_hb_message->hops;
+    p_entry->min_hops = MIN(p_entry->min_hops, p_hb_message->hops);
+    p_entry->max_hops = MAX(p_entry->max_hops, p_hb_message->hops);
+
+    switch (p_rx_metadata->source)
+    {
+        case NRF_MESH_RX_SOURCE_SCANNER:
+            p_entry->rssi = p_rx_metadata->params.scanner.rssi;
+            p_entry->last_seen = p_rx_metadata->params.scanner.timestamp;
+            break;
+        case NRF_MESH_RX_SOURCE_INSTABURST:
+            p_entry->rssi = p_rx_metadata->params.instaburst.rssi;
+            p_entry->last_seen = p_rx_metadata->params.instaburst.timestamp;
+            break;
+        case NRF_MESH_RX_SOURCE_GATT:
+            p_entry->rssi = HEARTBEAT_COLLECTOR_RSSI_INVALID;
+            p_entry->last_seen = p_rx_metadata->params.gatt.timestamp;
+            break;
+        default:
+            p_entry->rssi = HEARTBEAT_COLLECTOR_RSSI_INVALID;
+            p_entry->last_seen = timer_now();
+            break;
+    }
+}
+
+uint32_t heartbeat_collector_get(uint16_t src, heartbeat_collector_entry_t * p_entry)
+{
+    NRF_MESH_ASSERT(p_entry != NULL);
+
+    const heartbeat_collector_entry_t * p_found = NULL;
+    if (src != NRF_MESH_ADDR_UNASSIGNED)
+    {
+        p_found = entry_find(src);
+    }
+
+    if (p_found == NULL || p_found->src == NRF_MESH_ADDR_UNASSIGNED)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *p_entry = *p_found;
+    return NRF_SUCCESS;
+}
+
+void heartbeat_collector_entries_get(uint16_t * p_index,
+                                     heartbeat_collector_entry_t * p_entries,
+                                     uint16_t * p_count)
+{
+    NRF_MESH_ASSERT(p_index != NULL && p_count != NULL);
+    NRF_MESH_ASSERT(p_entries != NULL || *p_count == 0);
+
+    uint32_t index = *p_index;
+    uint16_t count = 0;
+    for (; index < HEARTBEAT_COLLECTOR_SIZE && count < *p_count; ++index)
+    {
+        if (m_entries[index].src != NRF_MESH_ADDR_UNASSIGNED)
+        {
+            p_entries[count++] = m_entries[index];
+        }
+    }
+
+    /* Skip the trailing free entries, so the caller can tell that there's nothing left. */
+    while (index < HEARTBEAT_COLLECTOR_SIZE && m_entries[index].src == NRF_MESH_ADDR_UNASSIGNED)
+    {
+        index++;
+    }
+
+    *p_index = index;
+    *p_count = count;
+}
+
+uint16_t heartbeat_collector_source_count_get(void)
+{
+    return m_source_count;
+}
+
+uint32_t heartbeat_collector_dropped_get(void)
+{
+    return m_dropped;
+}
+
+void heartbeat_collector_clear(void)
+{
+    memset(m_entries, 0, sizeof(m_entries));
+    m_source_count = 0;
+    m_dropped = 0;
+}
+
+#endif /* HEARTBEAT_COLLECTOR_SIZE > 0 */
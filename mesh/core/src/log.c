@@ -37,8 +37,12 @@
 
 #include <stdarg.h>
 #include <stdint.h>
+#include <string.h>
 #include <nrf_error.h>
 #include "log.h"
+#include "toolchain.h"
+#include "utils.h"
+#include "nrf_mesh_assert.h"
 #if defined(HOST)
 #include <stdio.h>
 #endif
@@ -83,6 +87,131 @@ void log_callback_stdout(uint32_t dbg_level, const char * p_filename, uint16_t l
 }
 #endif
 
+#if LOG_DEFERRED_ENABLE
+/** Maximum size of a deferred log record, in words. */
+#define LOG_DEFERRED_RECORD_WORDS_MAX (3 + MAX(LOG_DEFERRED_ARGS_MAX, 2 + (LOG_ARRAY_LEN_MAX + 3) / 4))
+/** Size of the chunks written to RTT by log_deferred_process(). */
+#define LOG_DEFERRED_RTT_CHUNK_SIZE (64)
+
+NRF_MESH_STATIC_ASSERT(IS_POWER_OF_2(LOG_DEFERRED_BUFFER_SIZE));
+NRF_MESH_STATIC_ASSERT(LOG_DEFERRED_BUFFER_SIZE >= LOG_DEFERRED_RECORD_WORDS_MAX * sizeof(uint32_t));
+NRF_MESH_STATIC_ASSERT(LOG_DEFERRED_RECORD_WORDS_MAX <= UINT8_MAX);
+
+static uint8_t m_deferred_buffer[LOG_DEFERRED_BUFFER_SIZE];
+/* Free running byte indices into the deferred log buffer. */
+static uint32_t m_deferred_head;
+static uint32_t m_deferred_tail;
+static uint32_t m_deferred_dropped;
+
+static void deferred_record_commit(uint32_t * p_record, uint32_t word_count)
+{
+    uint32_t size = word_count * sizeof(uint32_t);
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    if (LOG_DEFERRED_BUFFER_SIZE - (m_deferred_head - m_deferred_tail) < size)
+    {
+        m_deferred_dropped++;
+    }
+    else
+    {
+        p_record[0] = ((uint32_t) LOG_DEFERRED_SYNC << 24) |
+                      (MIN(m_deferred_dropped, UINT16_MAX) << 8) |
+                      (word_count - 1);
+        m_deferred_dropped = 0;
+
+        uint32_t index = m_deferred_head & (LOG_DEFERRED_BUFFER_SIZE - 1);
+        uint32_t first = MIN(size, LOG_DEFERRED_BUFFER_SIZE - index);
+        memcpy(&m_deferred_buffer[index], p_record, first);
+        memcpy(&m_deferred_buffer[0], (const uint8_t *) p_record + first, size - first);
+        m_deferred_head += size;
+    }
+    _ENABLE_IRQS(was_masked);
+}
+
+/* Only called from the context draining the log, so the data can't be consumed between peek and consume. */
+static uint32_t deferred_peek(uint8_t * p_buffer, uint32_t length)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    uint32_t count = MIN(length, m_deferred_head - m_deferred_tail);
+    uint32_t index = m_deferred_tail & (LOG_DEFERRED_BUFFER_SIZE - 1);
+    uint32_t first = MIN(count, LOG_DEFERRED_BUFFER_SIZE - index);
+    memcpy(p_buffer, &m_deferred_buffer[index], first);
+    memcpy(p_buffer + first, &m_deferred_buffer[0], count - first);
+    _ENABLE_IRQS(was_masked);
+    return count;
+}
+
+static void deferred_consume(uint32_t length)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    m_deferred_tail += length;
+    _ENABLE_IRQS(was_masked);
+}
+
+void log_deferred_write(const log_deferred_meta_t * p_meta, uint32_t timestamp, uint32_t arg_count, ...)
+{
+    uint32_t record[3 + LOG_DEFERRED_ARGS_MAX];
+    arg_count = MIN(arg_count, LOG_DEFERRED_ARGS_MAX);
+
+    record[1] = (uint32_t) (uintptr_t) p_meta;
+    record[2] = timestamp;
+
+    va_list arguments; /*lint -save -esym(530,arguments) Symbol arguments not initialized. */
+    va_start(arguments, arg_count);
+    for (uint32_t i = 0; i < arg_count; i++)
+    {
+        record[3 + i] = va_arg(arguments, uint32_t);
+    }
+    va_end(arguments); /*lint -restore */
+
+    deferred_record_commit(record, 3 + arg_count);
+}
+
+void log_deferred_write_array(const log_deferred_meta_t * p_meta, uint32_t timestamp,
+    const char * p_msg, const uint8_t * p_array, uint32_t length)
+{
+    uint32_t record[LOG_DEFERRED_RECORD_WORDS_MAX];
+    length = MIN(length, LOG_ARRAY_LEN_MAX);
+    uint32_t array_words = (length + 3) / 4;
+
+    record[1] = (uint32_t) (uintptr_t) p_meta;
+    record[2] = timestamp;
+    record[3] = (uint32_t) (uintptr_t) p_msg;
+    record[4] = length;
+    memset(&record[5], 0, array_words * sizeof(uint32_t));
+    memcpy(&record[5], p_array, length);
+
+    deferred_record_commit(record, 5 + array_words);
+}
+
+uint32_t log_deferred_read(uint8_t * p_buffer, uint32_t length)
+{
+    uint32_t count = deferred_peek(p_buffer, length);
+    deferred_consume(count);
+    return count;
+}
+
+#if (LOG_ENABLE_RTT && !defined(HOST))
+void log_deferred_process(void)
+{
+    uint8_t chunk[LOG_DEFERRED_RTT_CHUNK_SIZE];
+    uint32_t length;
+    while ((length = deferred_peek(chunk, sizeof(chunk))) > 0)
+    {
+        uint32_t written = SEGGER_RTT_Write(LOG_DEFERRED_RTT_CHANNEL, chunk, length);
+        deferred_consume(written);
+        if (written < length)
+        {
+            break;
+        }
+    }
+}
+#endif
+#endif /* LOG_DEFERRED_ENABLE */
+
 void log_init(uint32_t mask, uint32_t level, log_callback_t callback)
 {
     g_log_dbg_msk = mask;
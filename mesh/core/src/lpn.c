@@ -36,8 +36,11 @@
  */
 
 #include "mesh_lpn.h"
+
+#include <string.h>
 #include "mesh_friendship_types.h"
 #include "mesh_lpn_internal.h"
+#include "mesh_lpn_poll_policy.h"
 
 #include "fsm.h"
 #include "fsm_assistant.h"
@@ -46,6 +49,7 @@
 #include "transport.h"
 #include "packet_mesh.h"
 #include "long_timer.h"
+#include "timer.h"
 #include "utils.h"
 #include "event.h"
 #include "nrf_mesh_assert.h"
@@ -61,6 +65,9 @@
 
 #define TIMER_JITTER_US (280)
 
+NRF_MESH_STATIC_ASSERT(MESH_LPN_ADAPTIVE_POLL_MIN_INTERVAL_MS == 0 ||
+                       MESH_LPN_ADAPTIVE_POLL_MIN_INTERVAL_MS >= MESH_LPN_POLL_SEPARATION_INTERVAL_MS);
+
 #define FRIEND_REQUEST_RSSI_FACTOR_PACK(PKT, VAL) packet_mesh_trs_control_friend_request_rssi_factor_set(PKT, VAL)
 #define FRIEND_REQUEST_RX_WINDOW_FACTOR_PACK(PKT, VAL) packet_mesh_trs_control_friend_request_receive_window_factor_set(PKT, VAL)
 #define FRIEND_REQUEST_MIN_QUEUE_SIZE_LOG_PACK(PKT, VAL) packet_mesh_trs_control_friend_request_min_queue_size_log_set(PKT, VAL)
@@ -177,6 +184,13 @@ typedef struct
     uint8_t             frndreq_attempts_count;
     long_timer_t        timeout_scheduler;
     transport_control_packet_t * p_subman_data;
+    mesh_lpn_poll_policy_t poll_policy;
+    uint32_t            adaptive_poll_min_interval_ms;
+    /** Number of messages received from the Friend since the last poll session finished. */
+    uint32_t            session_rx_count;
+    bool                is_scanning;
+    timestamp_t         scan_start;
+    mesh_lpn_stats_t    stats;
 } lpn_t;
 
 typedef void (* lpn_fsm_action_t)(void *);
@@ -202,6 +216,8 @@ static void transmit_and_reschedule(const transport_control_packet_t * p_packet,
                                     uint32_t receive_delay_ms,
                                     uint32_t receive_window_ms);
 static void event_send(const nrf_mesh_evt_t * p_evt);
+static void scan_start(void);
+static void scan_stop(void);
 
 static const fsm_transition_t m_lpn_fsm_transition_table[] =
 {
@@ -253,6 +269,8 @@ static const char * m_state_lookup_table[] =
 };
 #endif  /* FSM_DEBUG */
 
+static uint8_t m_lpn_fsm_index[FSM_INDEX_SIZE(VA_NARGS(STATE_LIST), VA_NARGS(EVENT_LIST))];
+
 static const fsm_const_descriptor_t m_lpn_fsm_descriptor =
 {
     .transition_table = m_lpn_fsm_transition_table,
@@ -260,6 +278,9 @@ static const fsm_const_descriptor_t m_lpn_fsm_descriptor =
     .initial_state = S_IDLE,
     .guard = lpn_fsm_guard,
     .action = lpn_fsm_action,
+    .p_index = m_lpn_fsm_index,
+    .state_count = VA_NARGS(STATE_LIST),
+    .event_count = VA_NARGS(EVENT_LIST),
 #if FSM_DEBUG
     .fsm_name = "lpn_fsm",
     .action_lookup = m_action_lookup_table,
@@ -384,6 +405,8 @@ static void a_friend_poll_send(void * p_data)
     control_packet.pdu[0] = 0; // set padding to zero
     FRIEND_POLL_FSN_PACK(&control_packet, m_lpn.fsn);
 
+    m_lpn.stats.poll_count++;
+
     transmit_and_reschedule(&friend_poll, NRF_MESH_FRIEND_POLL_TOKEN, m_lpn.receive_delay_ms, m_lpn.receive_window_ms);
 }
 
@@ -426,6 +449,7 @@ static void a_friend_clear_send(void * p_data)
         return;
     }
 
+    scan_stop();
 #if !MESH_FEATURE_LPN_ACT_AS_REGULAR_NODE_OUT_OF_FRIENDSHIP
     scanner_disable();
 #endif
@@ -480,6 +504,8 @@ static void a_friendship_established_notify(void * p_data)
     nrf_mesh_evt_friendship_established_t * p_establish = &evt.params.friendship_established;
 
     m_lpn.is_in_friendship = true;
+    m_lpn.session_rx_count = 0;
+    mesh_lpn_poll_policy_reset(&m_lpn.poll_policy, m_lpn.adaptive_poll_min_interval_ms, m_lpn.poll_interval_ms);
 
     // schedule the first poll after friendship establishing
     // entry point to the regular polling
@@ -517,9 +543,23 @@ static void a_polling_finished_notify(void * p_data)
     evt.type = NRF_MESH_EVT_LPN_FRIEND_POLL_COMPLETE;
     event_send(&evt);
 
+    /* The session always ends with a Friend Update, anything before it came from the Friend Queue. */
+    bool had_data = (m_lpn.session_rx_count > 1);
+    if (had_data)
+    {
+        m_lpn.stats.data_session_count++;
+        m_lpn.stats.data_wait_ms += m_lpn.delay_ms;
+    }
+    else
+    {
+        m_lpn.stats.empty_session_count++;
+    }
+    m_lpn.session_rx_count = 0;
+
     // lpn fulfilled session with friend completely
     // schedule the next session and go to sleep
-    NRF_MESH_ERROR_CHECK(mesh_lpn_friend_poll(m_lpn.poll_interval_ms));
+    NRF_MESH_ERROR_CHECK(mesh_lpn_friend_poll(
+        mesh_lpn_poll_policy_next(&m_lpn.poll_policy, had_data, m_lpn.poll_interval_ms)));
 }
 
 static void a_offer_received_notify(void * p_data)
@@ -663,6 +703,7 @@ static void receive_delay_handle(void * p_context)
      */
 
     scanner_enable();
+    scan_start();
     lt_schedule(&m_lpn.timeout_scheduler, timeout_handle, NULL, ((uint32_t) p_context) + TIMESLOT_SHORTEST_START_TIME_US);
 }
 
@@ -670,6 +711,7 @@ static void timeout_handle(void * p_context)
 {
     (void)p_context;
 
+    scan_stop();
     scanner_disable();
     fsm_event_post(&m_lpn_fsm, E_TIMEOUT, NULL);
 }
@@ -715,6 +757,21 @@ static void transmit_and_reschedule(const transport_control_packet_t * p_packet,
     }
 }
 
+static void scan_start(void)
+{
+    m_lpn.is_scanning = true;
+    m_lpn.scan_start = timer_now();
+}
+
+static void scan_stop(void)
+{
+    if (m_lpn.is_scanning)
+    {
+        m_lpn.is_scanning = false;
+        m_lpn.stats.scan_time_us += timer_now() - m_lpn.scan_start;
+    }
+}
+
 static void event_send(const nrf_mesh_evt_t * p_evt)
 {
 #if MESH_FEATURE_LPN_ACT_AS_REGULAR_NODE_OUT_OF_FRIENDSHIP
@@ -805,6 +862,7 @@ void mesh_lpn_init(void)
                                                                ARRAY_SIZE(m_incoming_command_handler)));
     mesh_lpn_subman_init();
     m_lpn.friend_address = NRF_MESH_ADDR_UNASSIGNED;
+    m_lpn.adaptive_poll_min_interval_ms = MESH_LPN_ADAPTIVE_POLL_MIN_INTERVAL_MS;
     m_lpn.lpn_be_flag = bearer_event_flag_add(lpn_task_process);
 }
 
@@ -938,6 +996,30 @@ uint32_t mesh_lpn_poll_interval_set(uint32_t poll_interval_ms)
     return NRF_SUCCESS;
 }
 
+uint32_t mesh_lpn_adaptive_poll_set(uint32_t min_interval_ms)
+{
+    if (min_interval_ms != 0 && min_interval_ms < MESH_LPN_POLL_SEPARATION_INTERVAL_MS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    m_lpn.adaptive_poll_min_interval_ms = min_interval_ms;
+    m_lpn.poll_policy.min_interval_ms = min_interval_ms;
+
+    return NRF_SUCCESS;
+}
+
+void mesh_lpn_stats_get(mesh_lpn_stats_t * p_stats)
+{
+    NRF_MESH_ASSERT(p_stats != NULL);
+    *p_stats = m_lpn.stats;
+}
+
+void mesh_lpn_stats_clear(void)
+{
+    memset(&m_lpn.stats, 0, sizeof(m_lpn.stats));
+}
+
 uint32_t mesh_lpn_friendship_terminate(void)
 {
     if (!mesh_lpn_is_in_friendship())
@@ -964,8 +1046,12 @@ void mesh_lpn_rx_notify(const network_packet_metadata_t * p_net_metadata)
         return;
     }
 
+    scan_stop();
     scanner_disable();
 
+    m_lpn.stats.rx_count++;
+    m_lpn.session_rx_count++;
+
     if (m_lpn.p_subman_data == NULL)
     {
         m_lpn.fsn++;
@@ -69,6 +69,23 @@ static bool m_emergency_action;
 /* Counter of entities that are in progress with hw part. */
 static uint32_t m_entry_in_progress_cnt;
 static uint32_t m_file_in_progress_cnt;
+static mesh_config_stats_t m_stats;
+
+#if PERSISTENT_STORAGE
+/* Continuously stored entries waiting to be passed to the backend, in the order they were changed.
+ * An entry is in the queue as long as its DIRTY flag is set. */
+static struct
+{
+    struct
+    {
+        const mesh_config_entry_params_t * p_params;
+        uint16_t index;
+    } items[MESH_CONFIG_DIRTY_QUEUE_SIZE];
+    uint32_t count;
+    /* Some dirty entries didn't fit in the queue, and must be found by scanning all entries. */
+    bool overflow;
+} m_dirty_queue;
+#endif
 
 /* This is architectural hook because dsm entries with the same id can have differed size.
  * Otherwise, these entries will be interpreted as invalid length entries.
@@ -138,14 +155,98 @@ static void listeners_notify(const mesh_config_entry_params_t * p_params,
     }
 }
 
-static void dirty_entries_process(void)
-{
 #if PERSISTENT_STORAGE
-    if (m_file_in_progress_cnt != 0)
-    { /* the file metadata might not be ready till the current moment. */
-        return;
+static const mesh_config_entry_params_t * dirty_queue_params_get(uint32_t i)
+{
+    return m_dirty_queue.items[i].p_params;
+}
+
+static mesh_config_entry_flags_t * dirty_queue_flags_get(uint32_t i)
+{
+    return &m_dirty_queue.items[i].p_params->p_state[m_dirty_queue.items[i].index];
+}
+
+static void dirty_queue_push(const mesh_config_entry_params_t * p_params, uint32_t index)
+{
+    if (m_dirty_queue.count < ARRAY_SIZE(m_dirty_queue.items))
+    {
+        m_dirty_queue.items[m_dirty_queue.count].p_params = p_params;
+        m_dirty_queue.items[m_dirty_queue.count].index = (uint16_t) index;
+        m_dirty_queue.count++;
+    }
+    else
+    {
+        m_dirty_queue.overflow = true;
+    }
+}
+
+/* Removes the entries that are no longer dirty from the queue, keeping the order of the rest. */
+static void dirty_queue_compact(void)
+{
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < m_dirty_queue.count; ++i)
+    {
+        if (*dirty_queue_flags_get(i) & MESH_CONFIG_ENTRY_FLAG_DIRTY)
+        {
+            m_dirty_queue.items[kept++] = m_dirty_queue.items[i];
+        }
+    }
+    m_dirty_queue.count = kept;
+}
+
+/**
+ * Passes a dirty entry to the backend.
+ *
+ * @returns Whether the backend accepted the request. If not, processing should back off to allow
+ * the backend to free up some resources.
+ */
+static bool dirty_entry_store(const mesh_config_entry_params_t * p_params, uint32_t index)
+{
+    mesh_config_entry_id_t id = *p_params->p_id;
+    id.record += index;
+    uint32_t status;
+
+    if (p_params->p_state[index] & MESH_CONFIG_ENTRY_FLAG_ACTIVE)
+    {
+        /* The backend has to make a copy, as the buffer is on stack! */
+        uint8_t buf[MESH_CONFIG_ENTRY_MAX_SIZE] __attribute__((aligned(WORD_SIZE)));
+
+        p_params->callbacks.getter(id, buf);
+
+        status = mesh_config_backend_store(id, buf, p_params->entry_size);
+    }
+    else
+    {
+        status = mesh_config_backend_erase(id);
     }
 
+    switch (status)
+    {
+        case NRF_SUCCESS:
+            m_entry_in_progress_cnt++;
+            m_stats.backend_writes++;
+            p_params->p_state[index] &= (mesh_config_entry_flags_t)~MESH_CONFIG_ENTRY_FLAG_DIRTY;
+            p_params->p_state[index] |= MESH_CONFIG_ENTRY_FLAG_BUSY;
+            return true;
+        case NRF_ERROR_NOT_FOUND:
+            /* This can only happen with mesh_config_backend_erase() on not written yet entry. */
+            p_params->p_state[index] &= (mesh_config_entry_flags_t)~MESH_CONFIG_ENTRY_FLAG_DIRTY;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Searches all entries for dirty ones, and rebuilds the dirty queue from the continuously stored
+ * entries that are left dirty. Only used on emergency actions, and when the queue has overflowed. */
+static void dirty_entries_scan(void)
+{
+    bool back_off = false;
+
+    m_dirty_queue.count = 0;
+    m_dirty_queue.overflow = false;
+
+    mesh_config_backend_batch_begin();
     FOR_EACH_ENTRY(p_params)
     {
         const mesh_config_file_params_t * p_file = file_params_find(p_params->p_id->file);
@@ -155,47 +256,85 @@ static void dirty_entries_process(void)
         {
             for (uint32_t j = 0; j < p_params->max_count; ++j)
             {
+                if (!(p_params->p_state[j] & MESH_CONFIG_ENTRY_FLAG_DIRTY))
+                {
+                    continue;
+                }
+
+                if (!back_off && !(p_params->p_state[j] & MESH_CONFIG_ENTRY_FLAG_BUSY))
+                {
+                    back_off = !dirty_entry_store(p_params, j);
+                }
+
                 if ((p_params->p_state[j] & MESH_CONFIG_ENTRY_FLAG_DIRTY) &&
-                   !(p_params->p_state[j] & MESH_CONFIG_ENTRY_FLAG_BUSY))
+                    p_file->strategy == MESH_CONFIG_STRATEGY_CONTINUOUS)
                 {
-                    mesh_config_entry_id_t id = *p_params->p_id;
-                    id.record += j;
-                    uint32_t status;
-
-                    if (p_params->p_state[j] & MESH_CONFIG_ENTRY_FLAG_ACTIVE)
-                    {
-                        /* The backend has to make a copy, as the buffer is on stack! */
-                        uint8_t buf[MESH_CONFIG_ENTRY_MAX_SIZE] __attribute__((aligned(WORD_SIZE)));
-
-                        p_params->callbacks.getter(id, buf);
-
-                        status = mesh_config_backend_store(id, buf, p_params->entry_size);
-                    }
-                    else
-                    {
-                        status = mesh_config_backend_erase(id);
-                    }
-
-                    switch (status)
-                    {
-                        case NRF_SUCCESS:
-                            m_entry_in_progress_cnt++;
-                            p_params->p_state[j] &= (mesh_config_entry_flags_t)~MESH_CONFIG_ENTRY_FLAG_DIRTY;
-                            p_params->p_state[j] |= MESH_CONFIG_ENTRY_FLAG_BUSY;
-                            break;
-                        case NRF_ERROR_NOT_FOUND:
-                            /* This can only happen with mesh_config_backend_erase() on not written yet entry. */
-                            p_params->p_state[j] &= (mesh_config_entry_flags_t)~MESH_CONFIG_ENTRY_FLAG_DIRTY;
-                            break;
-                        default:
-                            /* Back off if the backend call fails, to allow it to free up some resources */
-                            return;
-                    }
+                    dirty_queue_push(p_params, j);
                 }
             }
         }
     }
+    mesh_config_backend_batch_end();
+}
+#endif
+
+static void dirty_entries_process(void)
+{
+#if PERSISTENT_STORAGE
+    if (m_file_in_progress_cnt != 0)
+    { /* the file metadata might not be ready till the current moment. */
+        return;
+    }
+
+    if (m_emergency_action || m_dirty_queue.overflow)
+    {
+        dirty_entries_scan();
+        return;
+    }
+
+    mesh_config_backend_batch_begin();
+    for (uint32_t i = 0; i < m_dirty_queue.count; ++i)
+    {
+        mesh_config_entry_flags_t * p_flags = dirty_queue_flags_get(i);
+        if ((*p_flags & MESH_CONFIG_ENTRY_FLAG_DIRTY) && !(*p_flags & MESH_CONFIG_ENTRY_FLAG_BUSY))
+        {
+            if (!dirty_entry_store(dirty_queue_params_get(i), m_dirty_queue.items[i].index))
+            {
+                /* Back off if the backend call fails, to allow it to free up some resources */
+                break;
+            }
+        }
+    }
+    mesh_config_backend_batch_end();
+
+    dirty_queue_compact();
+#endif
+}
+
+/* Marks the entry as changed. Repeated changes before the entry is passed to the backend are
+ * coalesced into a single backend request. */
+static void entry_dirty_mark(const mesh_config_entry_params_t * p_params, mesh_config_entry_id_t id)
+{
+    const mesh_config_file_params_t * p_file = file_params_find(p_params->p_id->file);
+    NRF_MESH_ASSERT(p_file != NULL);
+    mesh_config_entry_flags_t * p_flags = entry_flags_get(p_params, id);
+
+    if (p_file->strategy != MESH_CONFIG_STRATEGY_NON_PERSISTENT)
+    {
+        m_stats.changes++;
+        if (*p_flags & MESH_CONFIG_ENTRY_FLAG_DIRTY)
+        {
+            m_stats.coalesced++;
+        }
+#if PERSISTENT_STORAGE
+        else if (p_file->strategy == MESH_CONFIG_STRATEGY_CONTINUOUS)
+        {
+            dirty_queue_push(p_params, id.record - p_params->p_id->record);
+        }
 #endif
+    }
+
+    *p_flags |= MESH_CONFIG_ENTRY_FLAG_DIRTY;
 }
 
 static uint32_t entry_store(const mesh_config_entry_params_t * p_params, mesh_config_entry_id_t id, const void * p_entry)
@@ -203,10 +342,8 @@ static uint32_t entry_store(const mesh_config_entry_params_t * p_params, mesh_co
     uint32_t status = p_params->callbacks.setter(id, p_entry);
     if (status == NRF_SUCCESS)
     {
-        mesh_config_entry_flags_t * p_flags = entry_flags_get(p_params, id);
-        *p_flags |= (mesh_config_entry_flags_t)(MESH_CONFIG_ENTRY_FLAG_DIRTY | MESH_CONFIG_ENTRY_FLAG_ACTIVE);
-        const mesh_config_file_params_t * p_file = file_params_find(p_params->p_id->file);
-        NRF_MESH_ASSERT(p_file != NULL);
+        *entry_flags_get(p_params, id) |= MESH_CONFIG_ENTRY_FLAG_ACTIVE;
+        entry_dirty_mark(p_params, id);
         dirty_entries_process();
         listeners_notify(p_params, MESH_CONFIG_CHANGE_REASON_SET, id, p_entry);
     }
@@ -345,6 +482,11 @@ void mesh_config_init(void)
 {
     m_entry_in_progress_cnt = 0;
     m_file_in_progress_cnt = 0;
+    memset(&m_stats, 0, sizeof(m_stats));
+#if PERSISTENT_STORAGE
+    m_dirty_queue.count = 0;
+    m_dirty_queue.overflow = false;
+#endif
 
     entry_validation();
 #if PERSISTENT_STORAGE
@@ -444,7 +586,7 @@ uint32_t mesh_config_entry_delete(mesh_config_entry_id_t id)
         if (*p_flags & MESH_CONFIG_ENTRY_FLAG_ACTIVE)
         {
             *p_flags &= (mesh_config_entry_flags_t)~MESH_CONFIG_ENTRY_FLAG_ACTIVE; /* no longer active */
-            *p_flags |= MESH_CONFIG_ENTRY_FLAG_DIRTY;
+            entry_dirty_mark(p_params, id);
 
             if (p_params->callbacks.deleter)
             {
@@ -500,6 +642,8 @@ void mesh_config_file_clear(uint16_t file_id)
     }
 
 #if PERSISTENT_STORAGE
+    dirty_queue_compact();
+
     if (p_file->strategy != MESH_CONFIG_STRATEGY_NON_PERSISTENT)
     {
         m_file_in_progress_cnt++;
@@ -520,3 +664,12 @@ void mesh_config_clear(void)
         }
     }
 }
+
+void mesh_config_stats_get(mesh_config_stats_t * p_stats)
+{
+    NRF_MESH_ASSERT(p_stats != NULL);
+    *p_stats = m_stats;
+#if PERSISTENT_STORAGE
+    p_stats->flash_bytes = mesh_config_backend_bytes_written_get();
+#endif
+}
@@ -42,6 +42,7 @@
 static const mesh_config_file_params_t * mp_files;
 static uint32_t m_file_count;
 static uint32_t m_power_down_time_us;
+static uint32_t m_bytes_written;
 
 static void dummy_event(const mesh_config_backend_evt_t * p_evt)
 {
@@ -96,6 +97,7 @@ void mesh_config_backend_init(const mesh_config_entry_params_t * p_entries,
     NRF_MESH_ASSERT(file_count > 0ul);
 
     m_power_down_time_us = 0;
+    m_bytes_written = 0;
 
     mp_files = p_files;
     m_file_count = file_count;
@@ -136,7 +138,22 @@ uint32_t mesh_config_backend_store(mesh_config_entry_id_t id, const uint8_t * p_
 
     p_file->p_backend_data->curr_pos = id.record;
 
-    return mesh_config_backend_record_write(p_file->p_backend_data, p_entry, entry_len);
+    uint32_t status = mesh_config_backend_record_write(p_file->p_backend_data, p_entry, entry_len);
+    if (status == NRF_SUCCESS)
+    {
+        m_bytes_written += mesh_config_record_size_calculate((uint16_t) entry_len);
+    }
+    return status;
+}
+
+void mesh_config_backend_batch_begin(void)
+{
+    mesh_config_backend_records_batch_begin();
+}
+
+void mesh_config_backend_batch_end(void)
+{
+    mesh_config_backend_records_batch_end();
 }
 
 uint32_t mesh_config_backend_erase(mesh_config_entry_id_t id)
@@ -147,7 +164,13 @@ uint32_t mesh_config_backend_erase(mesh_config_entry_id_t id)
 
     p_file->p_backend_data->curr_pos = id.record;
 
-    return mesh_config_backend_record_erase(p_file->p_backend_data);
+    uint32_t status = mesh_config_backend_record_erase(p_file->p_backend_data);
+    if (status == NRF_SUCCESS)
+    {
+        /* Erasing is done by writing an empty record. */
+        m_bytes_written += mesh_config_record_size_calculate(0);
+    }
+    return status;
 }
 
 uint32_t mesh_config_backend_read(mesh_config_entry_id_t id, uint8_t * p_entry, uint32_t * p_entry_len)
@@ -181,3 +204,8 @@ uint32_t mesh_config_backend_power_down_time_get(void)
 {
     return m_power_down_time_us;
 }
+
+uint32_t mesh_config_backend_bytes_written_get(void)
+{
+    return m_bytes_written;
+}
@@ -78,6 +78,12 @@ typedef struct
 
 static mesh_config_backend_evt_cb_t m_evt_cb;
 static uint8_t m_allocated_page_count;
+NRF_MESH_STATIC_ASSERT((MESH_CONFIG_BATCH_SIZE % WORD_SIZE) == 0 &&
+                       MESH_CONFIG_BATCH_SIZE <= FLASH_MANAGER_BATCH_MAX_SIZE);
+
+static bool m_batching;
+static fm_batch_t m_batch;
+static flash_manager_t * mp_batch_manager; /**< Manager of the open batch, or NULL if there's none. */
 
 static void file_remove(mesh_config_backend_file_t * p_file);
 static void file_restore(mesh_config_backend_file_t * p_file);
@@ -202,6 +208,11 @@ static void file_remove(mesh_config_backend_file_t * p_file)
     }
 }
 
+static uint32_t incremental_defrag_threshold_get(uint32_t page_count)
+{
+    return (page_count * FLASH_MANAGER_DATA_PER_PAGE * MESH_CONFIG_INCREMENTAL_DEFRAG_PERCENT) / 100;
+}
+
 static void file_restore(mesh_config_backend_file_t * p_file)
 {
     flash_manager_t * p_manager = &p_file->glue_data.flash_manager;
@@ -211,6 +222,7 @@ static void file_restore(mesh_config_backend_file_t * p_file)
         .invalidate_complete_cb = invalidate_complete_cb,
         .remove_complete_cb = remove_complete_cb,
         .min_available_space = p_file->size,
+        .incremental_defrag_threshold = incremental_defrag_threshold_get(p_manager->config.page_count),
         .p_area = p_manager->config.p_area,
         .page_count = p_manager->config.page_count
     };
@@ -236,6 +248,8 @@ void mesh_config_backend_glue_init(mesh_config_backend_evt_cb_t evt_cb)
 {
     m_allocated_page_count = 0;
     m_evt_cb = evt_cb;
+    m_batching = false;
+    mp_batch_manager = NULL;
 
     flash_manager_init();
     flash_manager_action_queue_empty_cb_set(flash_stable_cb);
@@ -318,6 +332,7 @@ uint32_t mesh_config_backend_file_create(mesh_config_backend_file_t * p_file)
         .invalidate_complete_cb = invalidate_complete_cb,
         .remove_complete_cb = remove_complete_cb,
         .min_available_space = p_file->size,
+        .incremental_defrag_threshold = incremental_defrag_threshold_get(page_count),
         .p_area = p_area,
         .page_count = page_count
     };
@@ -332,9 +347,69 @@ void mesh_config_backend_file_clean(mesh_config_backend_file_t * p_file)
     file_remove(p_file);
 }
 
+static void batch_commit(void)
+{
+    if (mp_batch_manager != NULL)
+    {
+        flash_manager_batch_commit(&m_batch);
+        mp_batch_manager = NULL;
+    }
+}
+
+/* Appends the entry to the open batch of the manager, starting a new batch if needed. */
+static fm_entry_t * batch_entry_append(flash_manager_t * p_manager, fm_handle_t handle, uint32_t length)
+{
+    if (mp_batch_manager == p_manager)
+    {
+        fm_entry_t * p_entry = flash_manager_batch_entry_append(&m_batch, handle, length);
+        if (p_entry != NULL)
+        {
+            return p_entry;
+        }
+    }
+    batch_commit();
+
+    if (flash_manager_batch_begin(&m_batch, p_manager, MESH_CONFIG_BATCH_SIZE) != NRF_SUCCESS)
+    {
+        return NULL;
+    }
+    mp_batch_manager = p_manager;
+
+    fm_entry_t * p_entry = flash_manager_batch_entry_append(&m_batch, handle, length);
+    if (p_entry == NULL)
+    {
+        /* Releases the empty batch. */
+        batch_commit();
+    }
+    return p_entry;
+}
+
+void mesh_config_backend_records_batch_begin(void)
+{
+    m_batching = (MESH_CONFIG_BATCH_SIZE > 0);
+}
+
+void mesh_config_backend_records_batch_end(void)
+{
+    batch_commit();
+    m_batching = false;
+}
+
 uint32_t mesh_config_backend_record_write(mesh_config_backend_file_t * p_file, const uint8_t * p_data, uint32_t length)
 {
-    fm_entry_t * p_new_entry = flash_manager_entry_alloc(&p_file->glue_data.flash_manager, p_file->curr_pos, length);
+    flash_manager_t * p_manager = &p_file->glue_data.flash_manager;
+
+    if (m_batching)
+    {
+        fm_entry_t * p_batch_entry = batch_entry_append(p_manager, p_file->curr_pos, length);
+        if (p_batch_entry != NULL)
+        {
+            memcpy(p_batch_entry->data, p_data, length);
+            return NRF_SUCCESS;
+        }
+    }
+
+    fm_entry_t * p_new_entry = flash_manager_entry_alloc(p_manager, p_file->curr_pos, length);
 
     if (p_new_entry == NULL)
     {
@@ -357,6 +432,8 @@ uint32_t mesh_config_backend_record_erase(mesh_config_backend_file_t * p_file)
         return NRF_ERROR_NOT_FOUND;
     }
 
+    /* The open batch has to be committed before the flash manager can take any other requests. */
+    batch_commit();
     return flash_manager_entry_invalidate(&p_file->glue_data.flash_manager, p_file->curr_pos);
 }
 
@@ -251,9 +251,11 @@ static flash_operation_t* flash_op_action_prepare(flash_user_t * p_user)
     if (p_op != NULL)
     {
         p_user->action.start_cb = flash_op_start;
+        p_user->action.pack_cb = NULL;
         p_user->action.radio_irq_handler = NULL;
         p_user->action.duration_us = flash_op_duration(p_op, p_user->processed_bytes);
         p_user->action.p_args = p_user;
+        p_user->action.type = BEARER_ACTION_TYPE_FLASH;
         p_user->active = true;
     }
 
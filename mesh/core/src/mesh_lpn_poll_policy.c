@@ -0,0 +1,73 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mesh_lpn_poll_policy.h"
+
+#include "nrf_mesh_assert.h"
+#include "utils.h"
+
+void mesh_lpn_poll_policy_reset(mesh_lpn_poll_policy_t * p_policy, uint32_t min_interval_ms, uint32_t interval_ms)
+{
+    NRF_MESH_ASSERT(p_policy != NULL);
+
+    p_policy->min_interval_ms = min_interval_ms;
+    p_policy->interval_ms = interval_ms;
+}
+
+uint32_t mesh_lpn_poll_policy_next(mesh_lpn_poll_policy_t * p_policy, bool had_data, uint32_t max_interval_ms)
+{
+    NRF_MESH_ASSERT(p_policy != NULL);
+
+    if (p_policy->min_interval_ms == 0 || p_policy->min_interval_ms >= max_interval_ms)
+    {
+        p_policy->interval_ms = max_interval_ms;
+    }
+    else if (had_data)
+    {
+        p_policy->interval_ms = p_policy->min_interval_ms;
+    }
+    else
+    {
+        /* Exponential backoff, without overflowing on long intervals. */
+        p_policy->interval_ms = (p_policy->interval_ms > max_interval_ms / 2) ?
+                                max_interval_ms :
+                                MAX(p_policy->interval_ms * 2, p_policy->min_interval_ms);
+    }
+
+    return p_policy->interval_ms;
+}
@@ -105,6 +105,13 @@ typedef struct __attribute((packed))
 } net_beacon_t;
 /*lint -align_max(pop) */
 
+/** Secure network beacon that has been authenticated with the given beacon security material. */
+typedef struct
+{
+    const nrf_mesh_beacon_secmat_t * p_secmat; /**< Security material the beacon was authenticated with. */
+    net_beacon_t beacon;                       /**< Authenticated beacon. */
+} beacon_auth_cache_entry_t;
+
 NRF_MESH_STATIC_ASSERT(NET_BEACON_BUFFER_SIZE == sizeof(net_beacon_t) + BEACON_PACKET_OVERHEAD);
 
 /*****************************************************************************
@@ -116,6 +123,11 @@ static bool          m_enabled;                        /**< Secure network beaco
 static advertiser_t  m_adv;
 static uint8_t       m_adv_buf[ADVERTISER_PACKET_BUFFER_PACKET_MAXLEN] __attribute((aligned(WORD_SIZE)));
 static const nrf_mesh_beacon_info_t * mp_beacon_info;
+#if NET_BEACON_AUTH_CACHE_SIZE > 0
+static beacon_auth_cache_entry_t m_auth_cache[NET_BEACON_AUTH_CACHE_SIZE];
+static uint32_t m_auth_cache_next; /**< Index of the entry to replace next. */
+#endif
+static net_beacon_auth_cache_stats_t m_auth_cache_stats;
 
 /*****************************************************************************
 * Static functions
@@ -137,9 +149,59 @@ static void make_network_beacon_cmac(const net_beacon_t* p_beacon, const nrf_mes
     memcpy(p_cmac, temp, NET_BEACON_CMAC_SIZE);
 }
 
+static void auth_cache_clear(void)
+{
+#if NET_BEACON_AUTH_CACHE_SIZE > 0
+    memset(m_auth_cache, 0, sizeof(m_auth_cache));
+    m_auth_cache_next = 0;
+#endif
+    memset(&m_auth_cache_stats, 0, sizeof(m_auth_cache_stats));
+}
+
+/**
+ * Looks up a beacon in the authentication cache.
+ *
+ * The network ID is derived from the same network key as the beacon key, so an entry is only
+ * trusted as long as the security material still has the network ID of the cached beacon. The
+ * caller checks this before the lookup.
+ *
+ * @param[in] p_beacon_secmat Network beacon security material.
+ * @param[in] p_packet_in     Packet to look up.
+ *
+ * @return true  If the packet has already been authenticated with the given security material.
+ * @return false Otherwise.
+ */
+static bool auth_cache_hit(const nrf_mesh_beacon_secmat_t * p_beacon_secmat,
+                           const net_beacon_t * p_packet_in)
+{
+#if NET_BEACON_AUTH_CACHE_SIZE > 0
+    for (uint32_t i = 0; i < NET_BEACON_AUTH_CACHE_SIZE; i++)
+    {
+        if (m_auth_cache[i].p_secmat == p_beacon_secmat &&
+            memcmp(&m_auth_cache[i].beacon, p_packet_in, sizeof(net_beacon_t)) == 0)
+        {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+static void auth_cache_add(const nrf_mesh_beacon_secmat_t * p_beacon_secmat,
+                           const net_beacon_t * p_packet_in)
+{
+#if NET_BEACON_AUTH_CACHE_SIZE > 0
+    m_auth_cache[m_auth_cache_next].p_secmat = p_beacon_secmat;
+    memcpy(&m_auth_cache[m_auth_cache_next].beacon, p_packet_in, sizeof(net_beacon_t));
+    m_auth_cache_next = (m_auth_cache_next + 1) % NET_BEACON_AUTH_CACHE_SIZE;
+#endif
+}
+
 /**
  * Validates a beacon packet's CMAC value.
  *
+ * Beacons found in the authentication cache are accepted without calculating the CMAC.
+ *
  * @param[in] p_beacon_secmat Network beacon security material.
  * @param[in] p_packet_in     Packet to be validated.
  *
@@ -151,10 +213,24 @@ static bool is_valid_beacon_pkt(const nrf_mesh_beacon_secmat_t * p_beacon_secmat
 {
     if (memcmp(p_beacon_secmat->net_id, p_packet_in->payload.network_id, NRF_MESH_NETID_SIZE) == 0)
     {
+        if (auth_cache_hit(p_beacon_secmat, p_packet_in))
+        {
+            m_auth_cache_stats.hits++;
+            return true;
+        }
+
+        m_auth_cache_stats.misses++;
+
         uint8_t cmac[NET_BEACON_CMAC_SIZE];
         make_network_beacon_cmac(p_packet_in, p_beacon_secmat, cmac);
 
-        return memcmp(cmac, p_packet_in->cmac, NET_BEACON_CMAC_SIZE) == 0;
+        if (memcmp(cmac, p_packet_in->cmac, NET_BEACON_CMAC_SIZE) != 0)
+        {
+            return false;
+        }
+
+        auth_cache_add(p_beacon_secmat, p_packet_in);
+        return true;
     }
     else
     {
@@ -340,6 +416,7 @@ void net_beacon_init(void)
 {
     /* Start the beacon in enabled state: */
     mp_beacon_info = NULL;
+    auth_cache_clear();
 
     m_tx_timer.interval  = SEC_TO_US(NRF_MESH_BEACON_SECURE_NET_BCAST_INTERVAL_SECONDS);
     m_tx_timer.cb        = beacon_tx_timeout;
@@ -469,3 +546,9 @@ void net_beacon_packet_in(const uint8_t * p_beacon_data, uint8_t data_length, co
         }
     }
 }
+
+void net_beacon_auth_cache_stats_get(net_beacon_auth_cache_stats_t * p_stats)
+{
+    NRF_MESH_ASSERT(p_stats != NULL);
+    *p_stats = m_auth_cache_stats;
+}
@@ -105,13 +105,11 @@ static inline enc_nonce_t nonce_type_get(net_packet_kind_t packet_kind)
  *
  * @param[in] p_net_metadata Metadata to check for.
  * @param[in] net_packet_len Length of the network packet.
- * @param[in] p_net_packet Pointer to the network packet, used for logging.
  *
  * @returns Whether the metadata represents a potentially valid header.
  */
 static inline bool deobfuscated_header_is_valid(const network_packet_metadata_t * p_net_metadata,
-                                                uint32_t net_packet_len,
-                                                const packet_mesh_net_packet_t * p_net_packet)
+                                                uint32_t net_packet_len)
 {
     /* If the source address isn't a unicast address, this packet won't be valid, and we can skip it
      * without decrypting, saving us an average of 50% of all failing decryptions.  */
@@ -125,17 +123,6 @@ static inline bool deobfuscated_header_is_valid(const network_packet_metadata_t
         return false;
     }
 
-    /* We check the message cache now, as we'll either have the right deobfuscation, and the
-     * src+seq won't change after decryption, or we'll have the wrong deobfuscation, and most likely
-     * pass the cache check, but abandon it after decryption. In the unlikely event of a wrongly
-     * deobfuscated src+seq matching an existing src+seq in the message cache, we'll wrongly abandon
-     * the packet here, but since the decryption would have failed anyway, it doesn't matter. */
-    if (msg_cache_entry_exists(p_net_metadata->src, p_net_metadata->internal.sequence_number))
-    {
-        __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED, PACKET_DROPPED_NETWORK_CACHE, net_packet_len, p_net_packet);
-        return false;
-    }
-
     return true;
 }
 
@@ -183,12 +170,19 @@ static void deobfuscated_header_fields_get(network_packet_metadata_t * p_net_met
     p_net_metadata->src                      = packet_mesh_net_src_get(p_net_deobfuscated_packet);
 }
 
-static bool try_decrypt(network_packet_metadata_t * p_net_metadata,
-                        uint32_t net_packet_len,
-                        const packet_mesh_net_packet_t * p_net_encrypted_packet,
-                        packet_mesh_net_packet_t * p_net_decrypted_packet,
-                        const nrf_mesh_network_secmat_t * p_secmat,
-                        net_packet_kind_t packet_kind)
+/**
+ * Deobfuscates and decrypts a network packet with the given security material.
+ *
+ * @retval NRF_SUCCESS The packet was authenticated with @p p_secmat.
+ * @retval NRF_ERROR_INVALID_STATE The deobfuscated packet is already in the message cache.
+ * @retval NRF_ERROR_NOT_FOUND The packet couldn't be authenticated with @p p_secmat.
+ */
+static uint32_t try_decrypt(network_packet_metadata_t * p_net_metadata,
+                            uint32_t net_packet_len,
+                            const packet_mesh_net_packet_t * p_net_encrypted_packet,
+                            packet_mesh_net_packet_t * p_net_decrypted_packet,
+                            const nrf_mesh_network_secmat_t * p_secmat,
+                            net_packet_kind_t packet_kind)
 {
     bool authenticated = false;
     uint8_t nonce[CCM_NONCE_LENGTH];
@@ -207,28 +201,41 @@ static bool try_decrypt(network_packet_metadata_t * p_net_metadata,
 
     deobfuscated_header_fields_get(p_net_metadata, p_net_decrypted_packet);
 
-    if (deobfuscated_header_is_valid(p_net_metadata, net_packet_len, p_net_decrypted_packet))
+    if (!deobfuscated_header_is_valid(p_net_metadata, net_packet_len))
     {
-        ccm_params.mic_len = net_packet_mic_size_get(p_net_metadata->control_packet);
-        ccm_params.m_len   = (net_packet_len
-                                - NET_PACKET_ENCRYPTION_START_OFFSET
-                                - ccm_params.mic_len);
-        ccm_params.p_mic   = (uint8_t *) ccm_params.p_m + ccm_params.m_len;
+        return NRF_ERROR_NOT_FOUND;
+    }
 
-        /* Create a nonce for use when authenticating the packet from the de-obfuscated header: */
-        enc_nonce_generate(p_net_metadata, nonce_type_get(packet_kind), 0, nonce);
+    /* We check the message cache now, as we'll either have the right deobfuscation, and the
+     * src+seq won't change after decryption, or we'll have the wrong deobfuscation, and most likely
+     * pass the cache check, but abandon it after decryption. In the unlikely event of a wrongly
+     * deobfuscated src+seq matching an existing src+seq in the message cache, we'll wrongly abandon
+     * the packet here, but since the decryption would have failed anyway, it doesn't matter. */
+    if (msg_cache_entry_exists(p_net_metadata->src, p_net_metadata->internal.sequence_number))
+    {
+        __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED, PACKET_DROPPED_NETWORK_CACHE, net_packet_len, p_net_decrypted_packet);
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    ccm_params.mic_len = net_packet_mic_size_get(p_net_metadata->control_packet);
+    ccm_params.m_len   = (net_packet_len
+                            - NET_PACKET_ENCRYPTION_START_OFFSET
+                            - ccm_params.mic_len);
+    ccm_params.p_mic   = (uint8_t *) ccm_params.p_m + ccm_params.m_len;
 
-        ccm_params.p_key = p_net_metadata->p_security_material->encryption_key;
-        enc_aes_ccm_decrypt(&ccm_params, &authenticated);
+    /* Create a nonce for use when authenticating the packet from the de-obfuscated header: */
+    enc_nonce_generate(p_net_metadata, nonce_type_get(packet_kind), 0, nonce);
 
-        if (authenticated)
-        {
-            p_net_metadata->dst.value = packet_mesh_net_dst_get(p_net_decrypted_packet);
-            p_net_metadata->dst.type = nrf_mesh_address_type_get(p_net_metadata->dst.value);
-            __LOG_XB(LOG_SRC_NETWORK, LOG_LEVEL_INFO, "Unencrypted data: ", ccm_params.p_out, ccm_params.m_len);
-        }
+    ccm_params.p_key = p_net_metadata->p_security_material->encryption_key;
+    enc_aes_ccm_decrypt(&ccm_params, &authenticated);
+
+    if (authenticated)
+    {
+        p_net_metadata->dst.value = packet_mesh_net_dst_get(p_net_decrypted_packet);
+        p_net_metadata->dst.type = nrf_mesh_address_type_get(p_net_metadata->dst.value);
+        __LOG_XB(LOG_SRC_NETWORK, LOG_LEVEL_INFO, "Unencrypted data: ", ccm_params.p_out, ccm_params.m_len);
     }
-    return authenticated;
+    return (authenticated ? NRF_SUCCESS : NRF_ERROR_NOT_FOUND);
 }
 /*****************************************************************************
 * Interface functions
@@ -259,25 +266,31 @@ uint32_t net_packet_decrypt(network_packet_metadata_t * p_net_metadata,
     p_net_metadata->p_security_material = NULL;
     uint8_t nid = packet_mesh_net_nid_get(p_net_encrypted_packet);
 
+    uint32_t status = NRF_ERROR_NOT_FOUND;
     const nrf_mesh_network_secmat_t * p_secmat[2] = { NULL, NULL };
     do {
         nrf_mesh_net_secmat_next_get(nid, &p_secmat[0], &p_secmat[1]);
 
         for (uint32_t i = 0; i < ARRAY_SIZE(p_secmat) && p_secmat[i] != NULL; i++)
         {
-            if (try_decrypt(p_net_metadata,
-                            net_packet_len,
-                            p_net_encrypted_packet,
-                            p_net_decrypted_packet,
-                            p_secmat[i],
-                            packet_kind))
+            uint32_t key_status = try_decrypt(p_net_metadata,
+                                              net_packet_len,
+                                              p_net_encrypted_packet,
+                                              p_net_decrypted_packet,
+                                              p_secmat[i],
+                                              packet_kind);
+            if (key_status == NRF_SUCCESS)
             {
                 return NRF_SUCCESS;
             }
+            else if (key_status == NRF_ERROR_INVALID_STATE)
+            {
+                status = NRF_ERROR_INVALID_STATE;
+            }
         }
     } while (p_secmat[0] != NULL);
 
-    return NRF_ERROR_NOT_FOUND;
+    return status;
 }
 
 void net_packet_encrypt(network_packet_metadata_t * p_net_metadata,
@@ -61,6 +61,8 @@
 #include "heartbeat.h"
 #include "enc.h"
 #include "log.h"
+#include "perf_counter.h"
+#include "packet_trace.h"
 #if MESH_FEATURE_GATT_PROXY_ENABLED
 #include "proxy.h"
 #endif
@@ -165,10 +167,12 @@ static uint32_t packet_relay(network_packet_metadata_t *    p_net_metadata,
     {
         memcpy(buffer.p_payload, p_net_payload, payload_len);
         network_packet_send(&buffer);
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RELAY);
         __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_RELAYED, 0, payload_len, p_net_payload);
     }
     else
     {
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RELAY_DROP_NO_MEM);
         __LOG(LOG_SRC_NETWORK, LOG_LEVEL_WARN, "Unable to allocate memory for relay packet.\n");
     }
 
@@ -306,6 +310,7 @@ void network_packet_send(const network_tx_packet_buffer_t * p_buffer)
 
     core_tx_packet_send();
 
+    PERF_COUNTER_INC(PERF_COUNTER_NET_TX);
     __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_NET_PACKET_QUEUED_TX, 0, p_buffer->user_data.payload_len, p_buffer->p_payload);
 }
 
@@ -317,6 +322,57 @@ void network_packet_discard(const network_tx_packet_buffer_t * p_buffer)
     core_tx_packet_discard();
 }
 
+void network_packet_encrypt(network_packet_metadata_t * p_metadata,
+                            const uint8_t * p_payload,
+                            uint32_t payload_len,
+                            uint8_t * p_net_packet)
+{
+    NRF_MESH_ASSERT(p_metadata != NULL);
+    NRF_MESH_ASSERT(p_metadata->p_security_material != NULL);
+    NRF_MESH_ASSERT(p_payload != NULL);
+    NRF_MESH_ASSERT(p_net_packet != NULL);
+    NRF_MESH_ASSERT(m_core_tx_buffer_size_get(p_metadata, payload_len) <= PACKET_MESH_NET_MAX_SIZE);
+
+    packet_mesh_net_packet_t * p_packet = (packet_mesh_net_packet_t *) p_net_packet;
+    net_packet_header_set(p_packet, p_metadata);
+    memcpy(&p_packet->pdu[PACKET_MESH_NET_PDU_OFFSET], p_payload, payload_len);
+    net_packet_encrypt(p_metadata, payload_len, p_packet, NET_PACKET_KIND_TRANSPORT);
+}
+
+uint32_t network_packet_encrypted_send(const network_tx_packet_buffer_t * p_buffer,
+                                       const uint8_t * p_net_packet)
+{
+    NRF_MESH_ASSERT(p_buffer != NULL);
+    NRF_MESH_ASSERT(p_net_packet != NULL);
+    NRF_MESH_ASSERT(p_buffer->user_data.p_metadata != NULL);
+    NRF_MESH_ASSERT(p_buffer->user_data.role == CORE_TX_ROLE_RELAY);
+    NRF_MESH_ASSERT(p_buffer->user_data.bearer_selector != CORE_TX_BEARER_TYPE_INVALID);
+
+    const core_tx_alloc_params_t alloc_params =
+    {
+        .role            = p_buffer->user_data.role,
+        .net_packet_len  = m_core_tx_buffer_size_get(p_buffer->user_data.p_metadata,
+                                                     p_buffer->user_data.payload_len), /*lint !e446 Side effect in initializer */
+        .p_metadata      = p_buffer->user_data.p_metadata,
+        .token           = p_buffer->user_data.token,
+        .bearer_selector = p_buffer->user_data.bearer_selector,
+    };
+
+    uint8_t * p_packet;
+    if (core_tx_packet_alloc(&alloc_params, &p_packet) == 0)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    memcpy(p_packet, p_net_packet, alloc_params.net_packet_len);
+    core_tx_packet_send();
+
+    PERF_COUNTER_INC(PERF_COUNTER_NET_TX);
+    __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_NET_PACKET_QUEUED_TX, 0, p_buffer->user_data.payload_len,
+                          &p_packet[PACKET_MESH_NET_PDU_OFFSET]);
+    return NRF_SUCCESS;
+}
+
 uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, const nrf_mesh_rx_metadata_t * p_rx_metadata)
 {
     if (p_packet == NULL)
@@ -327,6 +383,8 @@ uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, co
     const packet_mesh_net_packet_t * p_net_packet = (const packet_mesh_net_packet_t *) p_packet;
     uint32_t status = NRF_SUCCESS;
 
+    PERF_COUNTER_INC(PERF_COUNTER_NET_RX);
+
     /* Create a target buffer to decrypt into, don't have to allocate a new packet. */
     packet_mesh_net_packet_t net_decrypted_packet;
 
@@ -346,6 +404,7 @@ uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, co
     {
         __LOG_XB(LOG_SRC_NETWORK, LOG_LEVEL_DBG1, "Net RX (unenc)", &net_decrypted_packet.pdu[0], net_packet_len);
         NRF_MESH_ASSERT(net_metadata.p_security_material != NULL);
+        PACKET_TRACE_RX_STAGE(PACKET_TRACE_STAGE_NET_DECRYPT);
 
 #if MESH_FEATURE_GATT_PROXY_ENABLED
         proxy_net_packet_processed(&net_metadata, p_rx_metadata);
@@ -395,6 +454,22 @@ uint32_t network_packet_in(const uint8_t * p_packet, uint32_t net_packet_len, co
         }
 
     }
+    else if (status == NRF_ERROR_INVALID_LENGTH)
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RX_DROP_LENGTH);
+    }
+    else if (status == NRF_ERROR_INVALID_STATE)
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RX_DROP_CACHE);
+    }
+    else if (status == NRF_SUCCESS)
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RX_DROP_INVALID);
+    }
+    else
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED);
+    }
     return status;
 }
 
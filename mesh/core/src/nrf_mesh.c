@@ -81,6 +81,7 @@
 #include "mesh_config.h"
 #include "mesh_opt.h"
 #include "ad_type_filter.h"
+#include "packet_trace.h"
 
 #if MESH_FEATURE_GATT_PROXY_ENABLED
 #include "proxy.h"
@@ -111,6 +112,7 @@ static void packet_in(const uint8_t * p_packet,
                       uint32_t ad_packet_length,
                       const nrf_mesh_rx_metadata_t * p_metadata)
 {
+    PACKET_TRACE_RX_STAGE(PACKET_TRACE_STAGE_FILTER);
     uint32_t status = network_packet_in(p_packet, ad_packet_length, p_metadata);
     if (status != NRF_SUCCESS)
     {
@@ -139,6 +141,8 @@ static bool scanner_packet_process_cb(void)
 
     if (p_scanner_packet != NULL)
     {
+        PACKET_TRACE_RX_BEGIN(p_scanner_packet->metadata.timestamp);
+
         nrf_mesh_rx_metadata_t metadata;
 
         metadata.source = NRF_MESH_RX_SOURCE_SCANNER;
@@ -174,6 +178,7 @@ static bool scanner_packet_process_cb(void)
             m_rx_cb(&rx_data);
         }
 
+        PACKET_TRACE_RX_END();
         scanner_packet_release(p_scanner_packet);
     }
 
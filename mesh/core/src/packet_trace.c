@@ -0,0 +1,174 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "packet_trace.h"
+
+#include <string.h>
+#include "nrf_mesh_assert.h"
+#include "toolchain.h"
+#include "utils.h"
+
+#if PACKET_TRACE_ENABLE
+
+NRF_MESH_STATIC_ASSERT(IS_POWER_OF_2(PACKET_TRACE_BUFFER_SIZE));
+NRF_MESH_STATIC_ASSERT(sizeof(packet_trace_record_t) == 8);
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+static packet_trace_record_t m_records[PACKET_TRACE_BUFFER_SIZE];
+/* Free running indices into m_records. */
+static uint32_t m_head;
+static uint32_t m_tail;
+static uint32_t m_dropped;
+
+static uint16_t m_next_id = 1;
+static uint16_t m_current_rx_id;
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static void record_add(uint16_t id, packet_trace_stage_t stage, uint32_t value)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    if (m_head - m_tail == PACKET_TRACE_BUFFER_SIZE)
+    {
+        m_dropped++;
+    }
+    else
+    {
+        packet_trace_record_t * p_record = &m_records[m_head & (PACKET_TRACE_BUFFER_SIZE - 1)];
+        p_record->value = value;
+        p_record->id = id;
+        p_record->stage = stage;
+        p_record->_rfu = 0;
+        m_head++;
+    }
+    _ENABLE_IRQS(was_masked);
+}
+
+static uint16_t id_alloc(void)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    uint16_t id = m_next_id++;
+    if (m_next_id == 0)
+    {
+        m_next_id = 1;
+    }
+    _ENABLE_IRQS(was_masked);
+    return id;
+}
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void packet_trace_rx_begin(timestamp_t rx_timestamp)
+{
+    m_current_rx_id = id_alloc();
+    record_add(m_current_rx_id, PACKET_TRACE_STAGE_SCANNER_RX, rx_timestamp);
+}
+
+void packet_trace_rx_end(void)
+{
+    m_current_rx_id = 0;
+}
+
+void packet_trace_rx_stage(packet_trace_stage_t stage)
+{
+    NRF_MESH_ASSERT_DEBUG(stage < PACKET_TRACE_STAGE__LAST);
+    if (m_current_rx_id != 0)
+    {
+        record_add(m_current_rx_id, stage, timer_now());
+    }
+}
+
+uint16_t packet_trace_tx_begin(void)
+{
+    uint16_t id = id_alloc();
+    record_add(id, PACKET_TRACE_STAGE_CORE_TX_ALLOC, timer_now());
+    if (m_current_rx_id != 0)
+    {
+        record_add(id, PACKET_TRACE_STAGE_TX_ORIGIN, m_current_rx_id);
+    }
+    return id;
+}
+
+void packet_trace_tx_stage(uint16_t id, packet_trace_stage_t stage, timestamp_t timestamp)
+{
+    NRF_MESH_ASSERT_DEBUG(stage < PACKET_TRACE_STAGE__LAST);
+    if (id != 0)
+    {
+        record_add(id, stage, timestamp);
+    }
+}
+
+uint32_t packet_trace_read(packet_trace_record_t * p_records, uint32_t max_count)
+{
+    NRF_MESH_ASSERT(p_records != NULL || max_count == 0);
+
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    uint32_t count = MIN(max_count, m_head - m_tail);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p_records[i] = m_records[(m_tail + i) & (PACKET_TRACE_BUFFER_SIZE - 1)];
+    }
+    m_tail += count;
+    _ENABLE_IRQS(was_masked);
+    return count;
+}
+
+uint32_t packet_trace_dropped_get(void)
+{
+    return m_dropped;
+}
+
+void packet_trace_reset(void)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    m_head = 0;
+    m_tail = 0;
+    m_dropped = 0;
+    m_next_id = 1;
+    m_current_rx_id = 0;
+    _ENABLE_IRQS(was_masked);
+}
+
+#endif /* PACKET_TRACE_ENABLE */
@@ -0,0 +1,199 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf_counter.h"
+
+#include <string.h>
+#include "nrf_error.h"
+#include "nrf_mesh_assert.h"
+#include "log.h"
+#include "utils.h"
+#include "nordic_common.h"
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+#if PERF_COUNTER_ENABLE
+uint32_t g_perf_counters[PERF_COUNTER__LAST];
+static perf_histogram_t m_histograms[PERF_HISTOGRAM__LAST];
+#endif
+
+#if NRF_MESH_LOG_ENABLE
+static const char * const m_counter_names[] =
+{
+    [PERF_COUNTER_SCANNER_RX]                  = "scanner rx",
+    [PERF_COUNTER_SCANNER_DROP_CRC]            = "scanner drop crc",
+    [PERF_COUNTER_SCANNER_DROP_LENGTH]         = "scanner drop length",
+    [PERF_COUNTER_SCANNER_DROP_NO_MEM]         = "scanner drop no mem",
+    [PERF_COUNTER_NET_RX]                      = "net rx",
+    [PERF_COUNTER_NET_RX_DROP_LENGTH]          = "net rx drop length",
+    [PERF_COUNTER_NET_RX_DROP_CACHE]           = "net rx drop cache",
+    [PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED] = "net rx drop unauthenticated",
+    [PERF_COUNTER_NET_RX_DROP_INVALID]         = "net rx drop invalid",
+    [PERF_COUNTER_NET_TX]                      = "net tx",
+    [PERF_COUNTER_NET_RELAY]                   = "net relay",
+    [PERF_COUNTER_NET_RELAY_DROP_NO_MEM]       = "net relay drop no mem",
+    [PERF_COUNTER_TRS_RX]                      = "trs rx",
+    [PERF_COUNTER_TRS_RX_DROP_REPLAY]          = "trs rx drop replay",
+    [PERF_COUNTER_TRS_RX_DROP_UNKNOWN_ADDRESS] = "trs rx drop unknown address",
+    [PERF_COUNTER_TRS_RX_DROP_DECRYPT]         = "trs rx drop decrypt",
+    [PERF_COUNTER_CRYPTO_AES_ECB]              = "crypto aes ecb",
+    [PERF_COUNTER_CRYPTO_AES_CMAC]             = "crypto aes cmac",
+    [PERF_COUNTER_CRYPTO_CCM_ENCRYPT]          = "crypto ccm encrypt",
+    [PERF_COUNTER_CRYPTO_CCM_DECRYPT]          = "crypto ccm decrypt",
+    [PERF_COUNTER_CRYPTO_CCM_MIC_FAIL]         = "crypto ccm mic fail",
+};
+NRF_MESH_STATIC_ASSERT(ARRAY_SIZE(m_counter_names) == PERF_COUNTER__LAST);
+
+static const char * const m_histogram_names[] =
+{
+    [PERF_HISTOGRAM_TIMER_LATENESS_US]        = "timer lateness us",
+    [PERF_HISTOGRAM_TIMER_QUEUE_DEPTH]        = "timer queue depth",
+    [PERF_HISTOGRAM_BEARER_EVENT_QUEUE_DEPTH] = "bearer event queue depth",
+};
+NRF_MESH_STATIC_ASSERT(ARRAY_SIZE(m_histogram_names) == PERF_HISTOGRAM__LAST);
+#endif
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void perf_histogram_record(perf_histogram_id_t id, uint32_t value)
+{
+#if PERF_COUNTER_ENABLE
+    NRF_MESH_ASSERT_DEBUG(id < PERF_HISTOGRAM__LAST);
+
+    uint32_t bucket = (value == 0) ? 0 : MIN(log2_get(value) + 1, PERF_HISTOGRAM_BUCKET_COUNT - 1);
+    m_histograms[id].buckets[bucket]++;
+    if (value > m_histograms[id].max)
+    {
+        m_histograms[id].max = value;
+    }
+#endif
+}
+
+uint32_t perf_counters_get(uint32_t first, uint32_t count, uint32_t * p_values)
+{
+#if PERF_COUNTER_ENABLE
+    if (p_values == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (first > PERF_COUNTER__LAST || count > PERF_COUNTER__LAST - first)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memcpy(p_values, &g_perf_counters[first], count * sizeof(uint32_t));
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+uint32_t perf_histogram_get(perf_histogram_id_t id, perf_histogram_t * p_histogram)
+{
+#if PERF_COUNTER_ENABLE
+    if (p_histogram == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (id >= PERF_HISTOGRAM__LAST)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    *p_histogram = m_histograms[id];
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+void perf_counter_clear(void)
+{
+#if PERF_COUNTER_ENABLE
+    memset(g_perf_counters, 0, sizeof(g_perf_counters));
+    memset(m_histograms, 0, sizeof(m_histograms));
+#endif
+}
+
+void perf_counter_dump(void)
+{
+#if PERF_COUNTER_ENABLE && NRF_MESH_LOG_ENABLE
+    for (uint32_t i = 0; i < PERF_COUNTER__LAST; i++)
+    {
+        if (g_perf_counters[i] != 0)
+        {
+            __LOG(LOG_SRC_CORE, LOG_LEVEL_REPORT, "%s: %u\n", m_counter_names[i], g_perf_counters[i]);
+        }
+    }
+
+    for (uint32_t i = 0; i < PERF_HISTOGRAM__LAST; i++)
+    {
+        for (uint32_t bucket = 0; bucket < PERF_HISTOGRAM_BUCKET_COUNT; bucket++)
+        {
+            if (m_histograms[i].buckets[bucket] == 0)
+            {
+                continue;
+            }
+
+            if (bucket == PERF_HISTOGRAM_BUCKET_COUNT - 1)
+            {
+                __LOG(LOG_SRC_CORE, LOG_LEVEL_REPORT, "%s [%u, ...): %u\n",
+                      m_histogram_names[i],
+                      (1u << (bucket - 1)),
+                      m_histograms[i].buckets[bucket]);
+            }
+            else
+            {
+                __LOG(LOG_SRC_CORE, LOG_LEVEL_REPORT, "%s [%u, %u): %u\n",
+                      m_histogram_names[i],
+                      (bucket == 0) ? 0 : (1u << (bucket - 1)),
+                      (1u << bucket),
+                      m_histograms[i].buckets[bucket]);
+            }
+        }
+
+        if (m_histograms[i].max != 0)
+        {
+            __LOG(LOG_SRC_CORE, LOG_LEVEL_REPORT, "%s max: %u\n", m_histogram_names[i], m_histograms[i].max);
+        }
+    }
+#endif
+}
@@ -40,6 +40,7 @@
 #include "nrf_mesh_assert.h"
 #include "bearer_event.h"
 #include "toolchain.h"
+#include "perf_counter.h"
 
 /** Time in us to regard as immediate when firing several timers at once */
 #define TIMER_MARGIN    (100)
@@ -90,6 +91,7 @@ static void add_evt(timer_event_t* p_evt)
 
     NRF_MESH_ASSERT(++m_scheduler.event_count > 0);
     p_evt->state = TIMER_EVENT_STATE_ADDED;
+    PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, m_scheduler.event_count);
 }
 
 static void remove_evt(timer_event_t * p_evt)
@@ -134,6 +136,10 @@ static void fire_timers(timestamp_t time_now)
         NRF_MESH_ASSERT(p_evt->cb != NULL);
         p_evt->state = TIMER_EVENT_STATE_IN_CALLBACK;
 
+        /* Timers within the margin are fired early, and count as on time. */
+        PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_LATENESS_US,
+                              TIMER_OLDER_THAN(p_evt->timestamp, time_now) ? TIMER_DIFF(time_now, p_evt->timestamp) : 0);
+
         p_evt->cb(time_now, p_evt->p_context);
 
         /* Re-sample the time to avoid lagging behind after long running timer callbacks. */
@@ -46,6 +46,7 @@
 #include "nrf_mesh_assert.h"
 #include "toolchain.h"
 #include "bearer_handler.h"
+#include "timeslot_profiler.h"
 #include "debug_pins.h"
 #include "event.h"
 
@@ -183,6 +184,7 @@ static void on_ts_begin(timeslot_t* p_timeslot)
 
     p_timeslot->in_progress = true;
     m_ts_count++;
+    TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_IDLE);
 
     /* Notify listeners */
     ts_timer_on_ts_begin();
@@ -203,6 +205,7 @@ static void on_ts_end(timeslot_t* p_timeslot)
         ts_timer_on_ts_end(get_end_time(p_timeslot));
         p_timeslot->in_progress = false;
     }
+    TIMESLOT_PROFILER_TS_END();
 
     m_state_lock = false;
     DEBUG_PIN_TIMESLOT_OFF(DEBUG_PIN_TS_IN_TIMESLOT);
@@ -241,6 +244,7 @@ static void handle_forced_command(timeslot_t* p_timeslot)
 static void handle_signal_start(timeslot_t* p_timeslot)
 {
     DEBUG_PIN_TIMESLOT_ON(DEBUG_PIN_TS_IN_TIMESLOT);
+    TIMESLOT_PROFILER_TS_BEGIN();
     p_timeslot->extend_count = 0;
     p_timeslot->successful_extensions = 0;
 
@@ -287,6 +291,7 @@ static void handle_extend_end(timeslot_t* p_timeslot, bool success)
         DEBUG_PIN_TIMESLOT_OFF(DEBUG_PIN_TS_EXTEND_SUCCEEDED);
     }
     p_timeslot->extend_count++;
+    TIMESLOT_PROFILER_EXTEND_END(success);
 
     /* Cut the extension time in half. */
     p_timeslot->signal_ret_param.callback_action = NRF_RADIO_SIGNAL_CALLBACK_ACTION_EXTEND;
@@ -417,12 +422,14 @@ void timeslot_sd_event_handler(uint32_t evt)
 
         /* Try to re-order a short one timeslot to avoid the block */
         case NRF_EVT_RADIO_BLOCKED:
+            TIMESLOT_PROFILER_BLOCKED();
             radio_request_params_reset();
             m_radio_request_earliest.params.earliest.length_us = TIMESLOT_BASE_LENGTH_SHORT_US;
             NRF_MESH_ASSERT(sd_radio_request(&m_radio_request_earliest) == NRF_SUCCESS);
             break;
         /* The softdevice revoked our timeslot before it started. Request a new one. */
         case NRF_EVT_RADIO_CANCELED:
+            TIMESLOT_PROFILER_CANCELED();
             NRF_MESH_ASSERT(sd_radio_request(&m_radio_request_earliest) == NRF_SUCCESS);
             break;
         default:
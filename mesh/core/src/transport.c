@@ -53,6 +53,8 @@
 #include "net_state.h"
 #include "replay_cache.h"
 #include "internal_event.h"
+#include "perf_counter.h"
+#include "packet_trace.h"
 #include "timer_scheduler.h"
 #include "bearer_event.h"
 #include "toolchain.h"
@@ -859,6 +861,7 @@ static trs_sar_ctx_t * sar_rx_ctx_get(const transport_packet_metadata_t * p_meta
         }
         else
         {
+            PERF_COUNTER_INC(PERF_COUNTER_TRS_RX_DROP_REPLAY);
             __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED,
                                   PACKET_DROPPED_REPLAY_CACHE,
                                   sizeof(uint32_t),
@@ -1791,6 +1794,7 @@ static void upper_transport_access_packet_in(const uint8_t * p_upper_trs_packet,
     else
     {
         __LOG(LOG_SRC_TRANSPORT, LOG_LEVEL_DBG2, "Could not decrypt transport layer data.\n");
+        PERF_COUNTER_INC(PERF_COUNTER_TRS_RX_DROP_DECRYPT);
 
         __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED,
                                 (p_metadata->type.access.using_app_key ? PACKET_DROPPED_INVALID_APPKEY
@@ -1936,6 +1940,9 @@ uint32_t transport_packet_in(const packet_mesh_trs_packet_t * p_packet,
         return NRF_ERROR_NULL;
     }
 
+    PERF_COUNTER_INC(PERF_COUNTER_TRS_RX);
+    PACKET_TRACE_RX_STAGE(PACKET_TRACE_STAGE_TRANSPORT);
+
     transport_packet_metadata_t trs_metadata;
     status = transport_metadata_build(p_packet, trs_packet_len, p_net_metadata, p_rx_metadata, &trs_metadata);
     if (status != NRF_SUCCESS)
@@ -1983,6 +1990,7 @@ uint32_t transport_packet_in(const packet_mesh_trs_packet_t * p_packet,
         /* Continue processing if the packet is for the friendship device. */
         if (trs_metadata.receivers == TRANSPORT_PACKET_RECEIVER_NONE)
         {
+            PERF_COUNTER_INC(PERF_COUNTER_TRS_RX_DROP_REPLAY);
             __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED,
                                   PACKET_DROPPED_REPLAY_CACHE,
                                   sizeof(uint32_t),
@@ -1994,6 +2002,7 @@ uint32_t transport_packet_in(const packet_mesh_trs_packet_t * p_packet,
 
     if (trs_metadata.receivers == TRANSPORT_PACKET_RECEIVER_NONE)
     {
+        PERF_COUNTER_INC(PERF_COUNTER_TRS_RX_DROP_UNKNOWN_ADDRESS);
         __INTERNAL_EVENT_PUSH(INTERNAL_EVENT_PACKET_DROPPED,
                               PACKET_DROPPED_UNKNOWN_ADDRESS,
                               trs_packet_len,
@@ -65,6 +65,18 @@
 #define NRF_MESH_DFU_DATA_TRANSFER_TIMEOUT_US           (600000000UL)
 #endif
 
+/**
+ * Number of copies of each relayed data packet that must be heard from neighbours between
+ * transmits for the neighbourhood to be considered dense.
+ *
+ * In dense neighbourhoods, relays skip a data packet transmit as soon as one neighbour has sent it,
+ * spread their transmits over a longer window, and stop relaying packets their neighbours keep
+ * covering. In sparse neighbourhoods, data packets are repeated once more than normal.
+ */
+#ifndef NRF_MESH_DFU_RELAY_DENSITY_DENSE
+#define NRF_MESH_DFU_RELAY_DENSITY_DENSE                (3)
+#endif
+
 /** @} end of NRF_MESH_CONFIG_DFU */
 
 #endif  /* NRF_MESH_CONFIG_DFU_H__ */
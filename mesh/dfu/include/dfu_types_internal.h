@@ -95,10 +95,14 @@ typedef struct bl_cmd bl_cmd_t; /**< Forward declaration of @c bl_cmd_t from bl_
 #define DFU_PACKET_LEN_READY_APP    (2 + 1 + 1 + 4 + DFU_FWID_LEN_APP)
 /** START packet packet length */
 #define DFU_PACKET_LEN_START        (2 + 2 + 4 + 4 + 4 + 2 + 1)
+/** Encoded START packet packet length */
+#define DFU_PACKET_LEN_START_ENCODED (2 + 2 + 4 + 4 + 4 + 2 + 1 + 4)
 /** DATA packet packet length */
 #define DFU_PACKET_LEN_DATA         (2 + 2 + 4 + SEGMENT_LENGTH)
 /** DATA REQUEST packet packet length */
 #define DFU_PACKET_LEN_DATA_REQ     (2 + 2 + 4)
+/** Ranged DATA REQUEST packet packet length */
+#define DFU_PACKET_LEN_DATA_REQ_RANGED (2 + 2 + 4 + SEGMENT_LENGTH)
 /** DATA RESPONSE packet packet length */
 #define DFU_PACKET_LEN_DATA_RSP     (2 + 2 + 4 + SEGMENT_LENGTH)
 /** RELAY REQUEST packet packet length */
@@ -168,11 +172,12 @@ typedef struct __attribute((packed))
             uint32_t start_address;                              /**< Start address of the transfer, or 0xFFFFFFFF if unknown. */
             uint32_t length;                                     /**< Length of transfer, in words. */
             uint16_t signature_length;                           /**< Length of signature in bytes. */
-            uint8_t diff        : 1;                             /**< Whether this transfer is a diff. */
+            uint8_t diff        : 1;                             /**< Whether this transfer is compressed or delta encoded. */
             uint8_t single_bank : 1;                             /**< Whether this transfer should be done in a single bank configuration. */
             uint8_t first       : 1;                             /**< Whether this transfer is the first in a set of transfers. */
             uint8_t last        : 1;                             /**< Whether this transfer is the last in a set of transfers. */
             uint8_t _rfu        : 4;                             /**< Reserved for future usage. */
+            uint32_t encoded_length;                             /**< Length of the encoded transfer, in words. Only present if diff is set. */
         } start;
         /** Data packet parameters. */
         struct __attribute((packed))
@@ -186,6 +191,7 @@ typedef struct __attribute((packed))
         {
             uint16_t segment;                                    /**< Segment ID being requested. */
             uint32_t transaction_id;                             /**< Transaction ID the request is done for. */
+            uint8_t missing_bitmap[NRF_MESH_DFU_SEGMENT_LENGTH]; /**< Ranged requests only: bit n marks segment + 1 + n as missing too. */
         } req_data;
         /** Data response packet parameters. */
         struct __attribute((packed))
@@ -69,11 +69,22 @@ NRF_MESH_STATIC_ASSERT(NRF_MESH_DFU_ROLE__LAST      <= UINT8_MAX);
 #define MAX_NUMBER_INTERRUPTS               (32)        /**< Maximum number of interrupts available. */
 
 #define DFU_TX_REDUNDANCY_MAX               (2)         /**< Max number of observed retransmits before a transmit is regarded redundant. */
+#define DFU_TX_REDUNDANCY_DENSE             (1)         /**< Max number of observed retransmits before a transmit is regarded redundant in dense neighbourhoods. */
+#define DFU_TX_SUPPRESSED_MAX               (2)         /**< Number of transmits in a row found redundant before a data packet is no longer relayed. */
+#define DFU_TX_REPEATS_SPARSE_EXTRA         (1)         /**< Extra repeats of data packets in sparse neighbourhoods. */
+#define DFU_DENSITY_SCALE                   (16)        /**< Fixed point scale of the neighbourhood density estimate. */
+#define DFU_DENSITY_WEIGHT_SHIFT            (3)         /**< Weight of each new sample in the density estimate, as a power of two. */
 #define DFU_TX_INTERVAL_EXPONENTIAL_US      (100000)    /**< Time between the first two transmits in exponential packets. */
 #define DFU_TX_INTERVAL_REGULAR_US          (100000)    /**< Time between transmits for fast regular transmits. */
 #define DFU_TX_INTERVAL_REGULAR_SLOW_US     (10000000)  /**< Time between transmits for slow regular transmits. */
 #define DFU_TX_DELAY_RANDOMIZATION_MASK_US  (0xFFFF)    /**< Maximum variation in TX time offsets. */
+#define DFU_TX_DELAY_RANDOMIZATION_DENSE_US (90000)     /**< Maximum variation in TX time offsets in dense neighbourhoods. */
 #define DFU_TX_TIMER_MARGIN_US              (1000)      /**< Time margin for a timeout to be considered instant. */
+
+/* The offset is redrawn for every transmit, and must stay shorter than the interval to keep the transmits in order. */
+NRF_MESH_STATIC_ASSERT(DFU_TX_DELAY_RANDOMIZATION_MASK_US < DFU_TX_INTERVAL_REGULAR_US);
+NRF_MESH_STATIC_ASSERT(DFU_TX_DELAY_RANDOMIZATION_DENSE_US < DFU_TX_INTERVAL_REGULAR_US);
+NRF_MESH_STATIC_ASSERT(DFU_TX_DELAY_RANDOMIZATION_DENSE_US < DFU_TX_INTERVAL_EXPONENTIAL_US);
 /*****************************************************************************
 * Local typedefs
 *****************************************************************************/
@@ -83,7 +94,7 @@ NRF_MESH_STATIC_ASSERT(NRF_MESH_DFU_ROLE__LAST      <= UINT8_MAX);
 typedef struct
 {
     uint32_t order_time;                    /**< Timestamp when the packet was first ordered. */
-    uint16_t tx_randomization_offset_us;    /**< Randomized time deviation from the normal for the next transmission. */
+    uint32_t tx_randomization_offset_us;    /**< Randomized time deviation from the normal for the next transmission. */
     bl_radio_interval_type_t interval_type; /**< Type of interval for this periodic transmit. */
     nrf_mesh_dfu_packet_t dfu_packet;       /**< DFU packet being sent on this slot. */
     uint8_t dfu_packet_len;                 /**< Length of the DFU packet. */
@@ -94,6 +105,8 @@ typedef struct
      * the packet is received @ref DFU_TX_REDUNDANCY_MAX times since the
      * previous transmit. */
     uint8_t rx_count;
+    /** Number of transmits in a row that have been skipped because of @p rx_count. */
+    uint8_t suppressed_count;
 } dfu_tx_t;
 
 /** Internal transfer state structure */
@@ -120,6 +133,11 @@ static dfu_transfer_state_internal_t m_transfer_state;         /**< State of the
 static packet_t                      m_adv_packet;             /**< Advertisement packet used when sending. */
 static broadcast_t                   m_broadcast;              /**< Broadcast instance used to transmit the advertisement packet. */
 static const uint8_t                 m_adv_channels[] = NRF_MESH_ADV_CHAN_DEFAULT;
+/** Average number of copies of each relayed data packet heard from neighbours between our own
+ * transmits, in 1/@ref DFU_DENSITY_SCALE. Starts out at one copy, which is neither sparse nor dense. */
+static uint16_t                      m_relay_density;
+static uint32_t                      m_relay_tx_count;         /**< Data packets relayed in the current transfer. */
+static uint32_t                      m_relay_suppressed_count; /**< Data packet relays skipped in the current transfer. */
 /*****************************************************************************
 * Static functions
 *****************************************************************************/
@@ -139,6 +157,13 @@ AD_LISTENER(m_dfu_ad_listener) = {
 
 static void reset_transfer_state(void)
 {
+    if (m_relay_tx_count != 0 || m_relay_suppressed_count != 0)
+    {
+        __LOG(LOG_SRC_DFU, LOG_LEVEL_INFO, "Relayed %u data packets, suppressed %u, density %u/%u\n",
+              m_relay_tx_count, m_relay_suppressed_count, m_relay_density, DFU_DENSITY_SCALE);
+    }
+    m_relay_tx_count = 0;
+    m_relay_suppressed_count = 0;
     timer_sch_abort(&m_timer_evt);
     m_transfer_state.role = NRF_MESH_DFU_ROLE_NONE;
     m_transfer_state.segment_count = 0;
@@ -177,6 +202,37 @@ static inline bool tx_slot_in_use(dfu_tx_t* p_tx)
     return (p_tx->repeats != 0);
 }
 
+static inline bool tx_slot_is_data(const dfu_tx_t* p_tx)
+{
+    return (p_tx->dfu_packet.packet_type == DFU_PACKET_TYPE_DATA &&
+            p_tx->dfu_packet.payload.data.segment > 0);
+}
+
+static inline bool relay_is_dense(void)
+{
+    return (m_relay_density >= NRF_MESH_DFU_RELAY_DENSITY_DENSE * DFU_DENSITY_SCALE);
+}
+
+static inline bool relay_is_sparse(void)
+{
+    return (m_relay_density < DFU_DENSITY_SCALE / 2);
+}
+
+static void relay_density_update(uint8_t rx_count)
+{
+    m_relay_density = m_relay_density - (m_relay_density >> DFU_DENSITY_WEIGHT_SHIFT) +
+                      ((rx_count * DFU_DENSITY_SCALE) >> DFU_DENSITY_WEIGHT_SHIFT);
+}
+
+/**
+ * Check whether a transmit is redundant, because enough neighbours have already sent the same
+ * packet since our last transmit. The more neighbours we hear, the fewer copies it takes.
+ */
+static bool tx_is_redundant(const dfu_tx_t* p_tx)
+{
+    return (p_tx->rx_count >= (relay_is_dense() ? DFU_TX_REDUNDANCY_DENSE : DFU_TX_REDUNDANCY_MAX));
+}
+
 static uint32_t get_curr_fwid(nrf_mesh_dfu_type_t type, nrf_mesh_fwid_t* p_fwid)
 {
     switch (type)
@@ -271,9 +327,14 @@ static bool transmit_dfu_packet(const nrf_mesh_dfu_packet_t * p_dfu_packet, uint
     return true;
 }
 
-static inline uint16_t tx_randomization_offset_get(void)
+/**
+ * Get a random delay for the next transmit. Dense neighbourhoods spread their transmits over a
+ * longer window, so each node gets a better chance to hear the others before it transmits.
+ */
+static inline uint32_t tx_randomization_offset_get(void)
 {
-    return (uint16_t) rand_prng_get(&m_prng) & DFU_TX_DELAY_RANDOMIZATION_MASK_US;
+    uint32_t random = rand_prng_get(&m_prng);
+    return (relay_is_dense() ? (random % DFU_TX_DELAY_RANDOMIZATION_DENSE_US) : (random & DFU_TX_DELAY_RANDOMIZATION_MASK_US));
 }
 
 static void tx_timeout_handled(dfu_tx_t * p_tx)
@@ -295,16 +356,38 @@ static void tx_timeout(uint32_t timestamp, void* p_context)
             uint32_t timeout = next_tx_timeout(&m_tx_slots[i]);
             if (TIMER_OLDER_THAN(timeout, (timestamp + DFU_TX_TIMER_MARGIN_US)))
             {
-                if (m_tx_slots[i].rx_count >= DFU_TX_REDUNDANCY_MAX)
+                bool is_data = tx_slot_is_data(&m_tx_slots[i]);
+                if (is_data)
+                {
+                    relay_density_update(m_tx_slots[i].rx_count);
+                }
+
+                if (tx_is_redundant(&m_tx_slots[i]))
                 {
                     /* We've seen this handle on air multiple times, skip this transmit. */
                     tx_timeout_handled(&m_tx_slots[i]);
+                    if (is_data)
+                    {
+                        m_relay_suppressed_count++;
+                        m_tx_slots[i].suppressed_count++;
+                        if (m_tx_slots[i].suppressed_count >= DFU_TX_SUPPRESSED_MAX &&
+                            m_tx_slots[i].repeats != BL_IF_TX_REPEATS_INF)
+                        {
+                            /* Our neighbours are covering this packet, don't wait for the remaining repeats. */
+                            m_tx_slots[i].tx_count = m_tx_slots[i].repeats;
+                        }
+                    }
                 }
                 else
                 {
                     if (transmit_dfu_packet(&m_tx_slots[i].dfu_packet, m_tx_slots[i].dfu_packet_len))
                     {
                         tx_timeout_handled(&m_tx_slots[i]);
+                        m_tx_slots[i].suppressed_count = 0;
+                        if (is_data)
+                        {
+                            m_relay_tx_count++;
+                        }
                     }
                 }
                 m_tx_slots[i].rx_count = 0;
@@ -573,12 +656,19 @@ static uint32_t dfu_evt_handler(const bl_evt_t* p_evt)
                 p_tx_slot->interval_type = p_evt->params.tx.radio.interval_type;
                 p_tx_slot->tx_count = 0;
                 p_tx_slot->rx_count = 0;
+                p_tx_slot->suppressed_count = 0;
                 p_tx_slot->tx_randomization_offset_us = 0;
-                p_tx_slot->order_time = time_now + DFU_TX_TIMER_MARGIN_US + (rand_prng_get(&m_prng) & DFU_TX_DELAY_RANDOMIZATION_MASK_US);
+                p_tx_slot->order_time = time_now + DFU_TX_TIMER_MARGIN_US + tx_randomization_offset_get();
                 p_tx_slot->dfu_packet_len = p_evt->params.tx.radio.length;
                 memcpy(&p_tx_slot->dfu_packet, p_evt->params.tx.radio.p_dfu_packet, p_evt->params.tx.radio.length);
 
                 p_tx_slot->repeats = p_evt->params.tx.radio.tx_count;
+                if (tx_slot_is_data(p_tx_slot) && relay_is_sparse() &&
+                    p_tx_slot->repeats < BL_IF_TX_REPEATS_INF - DFU_TX_REPEATS_SPARSE_EXTRA)
+                {
+                    /* Few neighbours to pick up the packet if we miss a receiver, send it a few more times. */
+                    p_tx_slot->repeats += DFU_TX_REPEATS_SPARSE_EXTRA;
+                }
 
                 /* Fire away */
                 if (m_tx_timer_evt.state == TIMER_EVENT_STATE_UNUSED || TIMER_OLDER_THAN(p_tx_slot->order_time, m_tx_timer_evt.timestamp))
@@ -697,6 +787,7 @@ uint32_t nrf_mesh_dfu_init(void)
 #endif
 
     rand_prng_seed(&m_prng);
+    m_relay_density = DFU_DENSITY_SCALE;
 
     m_timer_evt.cb           = timer_timeout;
     m_timer_evt.interval     = 0;
@@ -70,6 +70,14 @@ typedef struct
 
     /** Packet buffer itself. */
     packet_mesh_trs_packet_t packet;
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+    /** Network packet encrypted ahead of time. */
+    struct
+    {
+        const nrf_mesh_network_secmat_t * p_secmat; /**< Security material the packet was encrypted with, or NULL if it isn't encrypted. */
+        uint8_t pdu[PACKET_MESH_NET_MAX_SIZE];      /**< Encrypted network packet. */
+    } encrypted;
+#endif
     /** Queue node used for keeping track of the packet. */
     queue_elem_t queue_elem;
 } friend_packet_t;
@@ -187,6 +195,32 @@ void friend_queue_sar_complete(friend_queue_t * p_queue, uint16_t src, bool succ
  */
 bool friend_queue_sar_exists(friend_queue_t * p_queue, uint16_t src, uint64_t seqauth);
 
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+/**
+ * Gets the oldest committed packet that can be encrypted ahead of time, but isn't encrypted with
+ * the given security material yet.
+ *
+ * Only relayed packets can be encrypted ahead of time. Friend Update messages are skipped, as
+ * their MD flag is set when they are sent.
+ *
+ * @note The returned packet pointer is only valid until the next friend queue API call.
+ *
+ * @param[in,out] p_queue  Queue to search.
+ * @param[in]     p_secmat Security material the packets should be encrypted with.
+ *
+ * @returns Pointer to a packet that should be encrypted, or NULL if all packets are up to date.
+ */
+friend_packet_t * friend_queue_packet_to_encrypt_get(friend_queue_t * p_queue,
+                                                     const nrf_mesh_network_secmat_t * p_secmat);
+
+/**
+ * Marks all packets in the Friend Queue as not encrypted.
+ *
+ * @param[in,out] p_queue Queue to invalidate.
+ */
+void friend_queue_encrypted_invalidate(friend_queue_t * p_queue);
+#endif
+
 /**
  * Checks whether the Friend Queue is empty.
  *
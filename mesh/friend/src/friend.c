@@ -553,6 +553,46 @@ static void friend_update_tx(friendship_t * p_friendship,
                MS_TO_US(p_friendship->friendship.receive_delay_ms)));
 }
 
+static void relay_metadata_get(const friend_packet_t * p_packet,
+                               const nrf_mesh_network_secmat_t * p_secmat,
+                               network_packet_metadata_t * p_net_metadata)
+{
+    p_net_metadata->dst.type = nrf_mesh_address_type_get(p_packet->net_metadata.dst);
+    p_net_metadata->dst.value = p_packet->net_metadata.dst;
+    p_net_metadata->src = p_packet->net_metadata.src;
+    p_net_metadata->ttl = p_packet->net_metadata.ttl > 0 ? p_packet->net_metadata.ttl - 1 : 0;
+    p_net_metadata->control_packet = p_packet->net_metadata.control_packet;
+    p_net_metadata->internal.sequence_number = p_packet->net_metadata.seqnum;
+    p_net_metadata->internal.iv_index = p_packet->net_metadata.iv_index;
+    p_net_metadata->p_security_material = p_secmat;
+}
+
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+/**
+ * Encrypts the relayed packets in the queue with the current friendship credentials, so that
+ * responding to a Friend Poll doesn't have to wait for the encryption.
+ */
+static void queue_preencrypt(friendship_t * p_friendship)
+{
+    const nrf_mesh_network_secmat_t * p_friend_secmat = NULL;
+    nrf_mesh_friendship_secmat_get(p_friendship->friendship.lpn.src,
+                                   &p_friend_secmat);
+    if (p_friend_secmat == NULL)
+    {
+        return;
+    }
+
+    friend_packet_t * p_packet;
+    while ((p_packet = friend_queue_packet_to_encrypt_get(&p_friendship->queue, p_friend_secmat)) != NULL)
+    {
+        network_packet_metadata_t net_metadata;
+        relay_metadata_get(p_packet, p_friend_secmat, &net_metadata);
+        network_packet_encrypt(&net_metadata, p_packet->packet.pdu, p_packet->length, p_packet->encrypted.pdu);
+        p_packet->encrypted.p_secmat = p_friend_secmat;
+    }
+}
+#endif
+
 static void friend_relay(friendship_t * p_friendship,
                          const friend_packet_t * p_packet,
                          const nrf_mesh_rx_metadata_t * p_rx_metadata)
@@ -563,15 +603,7 @@ static void friend_relay(friendship_t * p_friendship,
 
     network_tx_packet_buffer_t net_buf;
     network_packet_metadata_t net_metadata;
-
-    net_metadata.dst.type = nrf_mesh_address_type_get(p_packet->net_metadata.dst);
-    net_metadata.dst.value = p_packet->net_metadata.dst;
-    net_metadata.src = p_packet->net_metadata.src;
-    net_metadata.ttl = p_packet->net_metadata.ttl > 0 ? p_packet->net_metadata.ttl - 1 : 0;
-    net_metadata.control_packet = p_packet->net_metadata.control_packet;
-    net_metadata.internal.sequence_number = p_packet->net_metadata.seqnum;
-    net_metadata.internal.iv_index = p_packet->net_metadata.iv_index;
-    net_metadata.p_security_material = p_friend_secmat;
+    relay_metadata_get(p_packet, p_friend_secmat, &net_metadata);
 
     net_buf.user_data.p_metadata = &net_metadata;
     net_buf.user_data.token = p_friendship->bearer.token;
@@ -579,20 +611,34 @@ static void friend_relay(friendship_t * p_friendship,
     net_buf.user_data.bearer_selector = CORE_TX_BEARER_TYPE_FRIEND;
     net_buf.user_data.role = p_packet->role;
 
-    if (packet_mesh_trs_control_opcode_get(&p_packet->packet) == TRANSPORT_CONTROL_OPCODE_FRIEND_UPDATE)
+    uint32_t status;
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+    if (p_friend_secmat != NULL && p_packet->encrypted.p_secmat == p_friend_secmat)
     {
-        /* The queue may have gotten additional packets since we pushed the update.
-         * We always keep the ongoing packet in the queue until receive Friend Poll with changed fsn. */
-        packet_mesh_trs_control_friend_update_md_set(
-            (packet_mesh_trs_control_packet_t*) &p_packet->packet.pdu[PACKET_MESH_TRS_UNSEG_PDU_OFFSET],
-            friend_queue_packet_counter_get(&p_friendship->queue) > 1 ? FRIEND_QUEUE_IS_NOT_EMPTY : FRIEND_QUEUE_IS_EMPTY);
+        status = network_packet_encrypted_send(&net_buf, p_packet->encrypted.pdu);
+    }
+    else
+#endif
+    {
+        if (packet_mesh_trs_control_opcode_get(&p_packet->packet) == TRANSPORT_CONTROL_OPCODE_FRIEND_UPDATE)
+        {
+            /* The queue may have gotten additional packets since we pushed the update.
+             * We always keep the ongoing packet in the queue until receive Friend Poll with changed fsn. */
+            packet_mesh_trs_control_friend_update_md_set(
+                (packet_mesh_trs_control_packet_t*) &p_packet->packet.pdu[PACKET_MESH_TRS_UNSEG_PDU_OFFSET],
+                friend_queue_packet_counter_get(&p_friendship->queue) > 1 ? FRIEND_QUEUE_IS_NOT_EMPTY : FRIEND_QUEUE_IS_EMPTY);
+        }
+
+        status = network_packet_alloc(&net_buf);
+        if (status == NRF_SUCCESS)
+        {
+            memcpy(net_buf.p_payload, p_packet->packet.pdu, p_packet->length);
+            network_packet_send(&net_buf);
+        }
     }
 
-    uint32_t status = network_packet_alloc(&net_buf);
     if (status == NRF_SUCCESS)
     {
-        memcpy(net_buf.p_payload, p_packet->packet.pdu, p_packet->length);
-        network_packet_send(&net_buf);
         core_tx_friend_schedule(&p_friendship->bearer,
                                 (p_rx_metadata->params.scanner.timestamp +
                                  MS_TO_US(p_friendship->friendship.receive_delay_ms)));
@@ -1224,11 +1270,21 @@ static void key_refresh_handle(const nrf_mesh_evt_key_refresh_notification_t * p
             continue;
         }
 
-        if (is_subnet_of_friend(&m_friend.friends[i], nrf_mesh_net_secmat_from_index_get(p_evt->subnet_index)) &&
-            p_evt->phase == NRF_MESH_KEY_REFRESH_PHASE_2)
+        if (!is_subnet_of_friend(&m_friend.friends[i], nrf_mesh_net_secmat_from_index_get(p_evt->subnet_index)))
+        {
+            continue;
+        }
+
+        if (p_evt->phase == NRF_MESH_KEY_REFRESH_PHASE_2)
         {
             friend_update_enqueue(&m_friend.friends[i]);
         }
+
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+        /* The friendship credentials may have been replaced in place: */
+        friend_queue_encrypted_invalidate(&m_friend.friends[i].queue);
+        queue_preencrypt(&m_friend.friends[i]);
+#endif
     }
 }
 
@@ -1443,6 +1499,9 @@ void friend_packet_in(const packet_mesh_trs_packet_t * p_packet,
                                      length,
                                      p_metadata,
                                      role);
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+            queue_preencrypt(p_friendship);
+#endif
         }
     }
 }
@@ -1497,6 +1556,12 @@ void friend_sar_complete(uint16_t src, uint32_t seqzero, bool success)
         if (m_friend.friends[i].state == FRIEND_STATE_ESTABLISHED)
         {
             friend_queue_sar_complete(&m_friend.friends[i].queue, src, success);
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+            if (success)
+            {
+                queue_preencrypt(&m_friend.friends[i]);
+            }
+#endif
         }
     }
 }
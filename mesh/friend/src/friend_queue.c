@@ -200,6 +200,15 @@ static bool is_segmented(const packet_mesh_trs_packet_t * p_packet)
     return packet_mesh_trs_common_seg_get(p_packet);
 }
 
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+static bool is_preencryptable(const friend_packet_t * p_packet)
+{
+    return (p_packet->role == CORE_TX_ROLE_RELAY &&
+            !(p_packet->net_metadata.control_packet &&
+              packet_mesh_trs_control_opcode_get(&p_packet->packet) == TRANSPORT_CONTROL_OPCODE_FRIEND_UPDATE));
+}
+#endif
+
 static uint64_t get_seqauth(const friend_packet_t *p_packet)
 {
     uint16_t seqzero = packet_mesh_trs_seg_seqzero_get(&p_packet->packet);
@@ -287,6 +296,9 @@ void friend_queue_packet_push(friend_queue_t * p_queue,
     p_friend_packet->net_metadata.iv_index       = p_metadata->net.internal.iv_index;
     p_friend_packet->role = role;
     p_friend_packet->length = length;
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+    p_friend_packet->encrypted.p_secmat = NULL;
+#endif
     NRF_MESH_ASSERT_DEBUG(length <= sizeof(p_friend_packet->packet));
     memcpy(&p_friend_packet->packet, p_packet, length);
 
@@ -347,6 +359,32 @@ bool friend_queue_sar_exists(friend_queue_t * p_queue, uint16_t src, uint64_t se
     return false;
 }
 
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+friend_packet_t * friend_queue_packet_to_encrypt_get(friend_queue_t * p_queue,
+                                                     const nrf_mesh_network_secmat_t * p_secmat)
+{
+    QUEUE_FOREACH(&p_queue->committed_packets, it)
+    {
+        friend_packet_t * p_queue_packet = packet_from_queue_elem(*it.pp_elem);
+
+        if (p_queue_packet->encrypted.p_secmat != p_secmat && is_preencryptable(p_queue_packet))
+        {
+            return p_queue_packet;
+        }
+    }
+
+    return NULL;
+}
+
+void friend_queue_encrypted_invalidate(friend_queue_t * p_queue)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(p_queue->buffer); ++i)
+    {
+        p_queue->buffer[i].encrypted.p_secmat = NULL;
+    }
+}
+#endif
+
 bool friend_queue_is_empty(const friend_queue_t * p_queue)
 {
     return (queue_peek(&p_queue->committed_packets) == NULL);
@@ -99,8 +99,31 @@
 #define NRF_MESH_PROV_BEARER_ADV_TX_BUFFER_SIZE  128
 #endif
 
+/**
+ * Number of buckets in the PB-ADV link ID lookup table. Must be a power of two.
+ *
+ * Every incoming PB-ADV packet is matched against the active links by its link ID. Provisioners
+ * running many concurrent PB-ADV links should set this to around the number of links they keep
+ * open at once, to keep the lookup short.
+ */
+#ifndef NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE
+#define NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE  8
+#endif
+
 /** @} end of NRF_MESH_CONFIG_PROV_BEARER */
 
+/**
+ * Number of pre-generated keypairs kept by @ref nrf_mesh_prov_generate_keys.
+ *
+ * Generating a P-256 keypair takes a long time on-device. Devices that start many provisioning
+ * sessions back to back can keep a pool of keypairs that is refilled in the background, taking
+ * key generation off the critical path of each session. Each keypair uses 96 bytes of RAM.
+ * Set to 0 to generate keypairs on request.
+ */
+#ifndef NRF_MESH_PROV_KEYPOOL_SIZE
+#define NRF_MESH_PROV_KEYPOOL_SIZE 0
+#endif
+
 /**
  * @defgroup MESH_CONFIG_PROVISIONEE Provisionee configuration
  * @{
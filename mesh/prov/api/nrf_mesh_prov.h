@@ -73,6 +73,20 @@ NRF_MESH_STATIC_ASSERT(BITFIELD_BLOCK_COUNT(NRF_MESH_PROV_BEARER_COUNT) == 1);
 
 /** @} */
 
+/**
+ * @addtogroup NRF_MESH_PROV_TYPES
+ * @{
+ */
+
+/** Keypair pool statistics, see @ref nrf_mesh_prov_generate_keys. */
+typedef struct
+{
+    uint32_t hits;   /**< Number of keypairs taken from the pool. */
+    uint32_t misses; /**< Number of keypairs generated on request, because the pool was empty. */
+} nrf_mesh_prov_keypool_stats_t;
+
+/** @} */
+
 /**
  * @addtogroup NRF_MESH_PROV_TYPES
  * @{
@@ -124,6 +138,9 @@ struct nrf_mesh_prov_ctx
  * @warning If calling this function the first time, it is required that the @c p_ctx is zero
  * initialized. Any further calls require that @c p_ctx is left untouched.
  *
+ * If @ref NRF_MESH_PROV_KEYPOOL_SIZE is non-zero, this also starts filling the keypair pool used by
+ * @ref nrf_mesh_prov_generate_keys.
+ *
  * @param[in,out]  p_ctx            Pointer to the provisioning context structure to initialize.
  * @param[in]      p_public_key     Pointer to the node's public key. The public key is 64 bytes long.
  * @param[in]      p_private_key    Pointer to the node's private key. The private key is 32 bytes long.
@@ -189,6 +206,11 @@ uint32_t nrf_mesh_prov_listen_stop(nrf_mesh_prov_ctx_t * p_ctx);
 /**
  * Generates a valid keypair for use with the provisioning cryptography.
  *
+ * If @ref NRF_MESH_PROV_KEYPOOL_SIZE is non-zero, the keypair is taken from a pool of keypairs
+ * generated in the background, and the pool is refilled after the call. Every call returns a
+ * keypair that has not been handed out before, so call this before every provisioning session
+ * to use a fresh keypair for each one. The pool is first filled after @ref nrf_mesh_prov_init.
+ *
  * @param[out] p_public  Pointer to where the generated public key is stored.
  * @param[out] p_private Pointer to where the generated private key is stored.
  *
@@ -196,6 +218,33 @@ uint32_t nrf_mesh_prov_listen_stop(nrf_mesh_prov_ctx_t * p_ctx);
  */
 uint32_t nrf_mesh_prov_generate_keys(uint8_t * p_public, uint8_t * p_private);
 
+/**
+ * Gets the keypair pool statistics.
+ *
+ * @param[out] p_stats Pointer to where the statistics should be stored.
+ */
+void nrf_mesh_prov_keypool_stats_get(nrf_mesh_prov_keypool_stats_t * p_stats);
+
+/**
+ * Sets the elliptic curve backend used for key generation and ECDH in the provisioning protocol.
+ *
+ * By default, the stack uses the bundled micro-ecc library. Devices with a faster implementation
+ * of P-256 (e.g. a hardware accelerator or an implementation with precomputed tables) can plug it
+ * in here. The backend is used for all following provisioning sessions, and should be set while
+ * no provisioning session is active. The host benchmark in mesh/test/benchmark compares backends
+ * against micro-ecc.
+ *
+ * @note The backend is not used when ECDH offloading is enabled, see
+ *       @ref NRF_MESH_OPT_PROV_ECDH_OFFLOADING.
+ *
+ * @param[in] p_backend Pointer to a statically allocated backend, or NULL to restore the default
+ *                      backend.
+ *
+ * @retval NRF_SUCCESS             The backend was set.
+ * @retval NRF_ERROR_INVALID_PARAM One or more of the backend functions were NULL.
+ */
+uint32_t nrf_mesh_prov_ecc_backend_set(const nrf_mesh_prov_ecc_backend_t * p_backend);
+
 /**
  * Provisions a device.
  *
@@ -80,7 +80,7 @@ typedef struct prov_bearer_adv
     nrf_mesh_tx_token_t        last_token;          /**< Token of the last packet sent to the advertiser. */
     bool                       queue_empty_pending; /**< Flag indicating whether a queue empty event is pending. */
     prov_bearer_t              prov_bearer;
-    struct prov_bearer_adv *   p_next;              /**< Pointer to the next active PB-ADV link. */
+    struct prov_bearer_adv *   p_next;              /**< Pointer to the next active PB-ADV link in the same link ID bucket. */
 } nrf_mesh_prov_bearer_adv_t;
 
 /**
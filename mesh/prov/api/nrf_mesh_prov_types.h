@@ -302,6 +302,47 @@ typedef enum
     NRF_MESH_PROV_ROLE_PROVISIONEE  /**< The device will act as a provisionee, receiving provisioning data. */
 } nrf_mesh_prov_role_t;
 
+/**
+ * Elliptic curve backend used for the provisioning cryptography.
+ *
+ * All keys are in the raw big-endian format used by the Public Key PDU: the public key is the
+ * X and Y coordinates of the point, @ref NRF_MESH_PROV_PUBKEY_SIZE bytes in total, and the private
+ * key and shared secret are @ref NRF_MESH_PROV_PRIVKEY_SIZE and @ref NRF_MESH_PROV_ECDHSECRET_SIZE
+ * bytes long.
+ */
+typedef struct
+{
+    /**
+     * Generates a P-256 keypair.
+     *
+     * @param[out] p_public  Public key output.
+     * @param[out] p_private Private key output.
+     *
+     * @retval NRF_SUCCESS        The keypair was generated.
+     * @retval NRF_ERROR_INTERNAL The keypair could not be generated.
+     */
+    uint32_t (*keys_generate)(uint8_t * p_public, uint8_t * p_private);
+    /**
+     * Calculates the ECDH shared secret.
+     *
+     * @param[in]  p_peer_public Public key of the peer, already validated with @p public_key_is_valid.
+     * @param[in]  p_private     Private key of this device.
+     * @param[out] p_shared      Shared secret output.
+     *
+     * @retval NRF_SUCCESS        The shared secret was calculated.
+     * @retval NRF_ERROR_INTERNAL The shared secret could not be calculated.
+     */
+    uint32_t (*shared_secret_calculate)(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared);
+    /**
+     * Checks that a public key is a point on the P-256 curve.
+     *
+     * @param[in] p_public Public key to check.
+     *
+     * @returns Whether the public key is valid.
+     */
+    bool (*public_key_is_valid)(const uint8_t * p_public);
+} nrf_mesh_prov_ecc_backend_t;
+
 /**
  * Common provisioning context forward declaration.
  * @ingroup NRF_MESH_PROV_TYPES
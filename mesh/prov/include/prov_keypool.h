@@ -0,0 +1,87 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROV_KEYPOOL_H__
+#define PROV_KEYPOOL_H__
+
+#include <stdint.h>
+#include "nrf_mesh_prov.h"
+
+/**
+ * @defgroup PROV_KEYPOOL Provisioning keypair pool
+ * @ingroup MESH_PROV
+ * Keeps a pool of pre-generated P-256 keypairs, so that starting a provisioning session does not
+ * have to wait for key generation.
+ *
+ * The pool is filled one keypair at a time from the bearer event context, starting at
+ * @ref prov_keypool_init, and refilled every time it is drawn from. Its depth is set with
+ * @ref NRF_MESH_PROV_KEYPOOL_SIZE. With a depth of 0, every request generates a new keypair
+ * directly.
+ * @{
+ */
+
+/**
+ * Starts filling the pool in the background.
+ *
+ * Can be called more than once. Must be called after the bearer event module has been
+ * initialized.
+ */
+void prov_keypool_init(void);
+
+/**
+ * Gets a fresh keypair, from the pool if one is available.
+ *
+ * A keypair is only handed out once. If the pool is empty, a new keypair is generated directly.
+ *
+ * @param[out] p_public  Pointer to where the public key should be stored.
+ * @param[out] p_private Pointer to where the private key should be stored.
+ *
+ * @returns The return values of @ref prov_utils_keys_generate if the pool was empty, otherwise
+ *          @c NRF_SUCCESS.
+ */
+uint32_t prov_keypool_keys_get(uint8_t * p_public, uint8_t * p_private);
+
+/**
+ * Gets the pool statistics.
+ *
+ * @param[out] p_stats Pointer to where the statistics should be stored.
+ */
+void prov_keypool_stats_get(nrf_mesh_prov_keypool_stats_t * p_stats);
+
+/** @} */
+
+#endif /* PROV_KEYPOOL_H__ */
@@ -105,6 +105,16 @@ void prov_utils_authentication_values_derive(const nrf_mesh_prov_ctx_t * p_ctx,
         uint8_t * p_confirmation,
         uint8_t * p_random);
 
+/**
+ * Sets the elliptic curve backend used by the provisioning cryptography.
+ *
+ * @param[in] p_backend Pointer to the backend to use, or NULL to use the default micro-ecc backend.
+ *
+ * @retval NRF_SUCCESS             The backend was set.
+ * @retval NRF_ERROR_INVALID_PARAM One or more of the backend functions were NULL.
+ */
+uint32_t prov_utils_ecc_backend_set(const nrf_mesh_prov_ecc_backend_t * p_backend);
+
 /**
  * Generates a private/public keypair for the device.
  *
@@ -113,8 +123,8 @@ void prov_utils_authentication_values_derive(const nrf_mesh_prov_ctx_t * p_ctx,
  *
  * @retval NRF_SUCCESS             The keys were successfully generated.
  * @retval NRF_ERROR_INTERNAL      An error occured while generating the keys.
- * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without uECC support,
- *                                 making the required functionality unavailable.
+ * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without uECC support and no other
+ *                                 backend is set, making the required functionality unavailable.
  */
 uint32_t prov_utils_keys_generate(uint8_t * p_public, uint8_t * p_private);
 
@@ -140,8 +150,8 @@ void prov_utils_derive_keys(const nrf_mesh_prov_ctx_t * p_ctx,
  * @retval NRF_SUCCESS             The shared secret was successfully derived.
  * @retval NRF_ERROR_INTERNAL      The shared secret could not be calculated; this is likely to happen if the public
  *                                 key received from the peer node is not valid.
- * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without uECC support,
- *                                 making the required functionality unavailable.
+ * @retval NRF_ERROR_NOT_SUPPORTED The mesh stack was compiled without uECC support and no other
+ *                                 backend is set, making the required functionality unavailable.
  */
 uint32_t prov_utils_calculate_shared_secret(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_shared_secret);
 
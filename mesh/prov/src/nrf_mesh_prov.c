@@ -47,6 +47,7 @@
 #include "prov_provisioner.h"
 #include "prov_beacon.h"
 #include "prov_utils.h"
+#include "prov_keypool.h"
 #include "provisioning.h"
 #include "utils.h"
 #include "list.h"
@@ -103,6 +104,7 @@ uint32_t nrf_mesh_prov_init(nrf_mesh_prov_ctx_t *            p_ctx,
         p_ctx->p_public_key  = p_public_key;
         p_ctx->p_private_key = p_private_key;
         memcpy(&p_ctx->capabilities, p_caps, sizeof(nrf_mesh_prov_oob_caps_t));
+        prov_keypool_init();
         return NRF_SUCCESS;
     }
 }
@@ -146,7 +148,17 @@ uint32_t nrf_mesh_prov_bearer_add(nrf_mesh_prov_ctx_t * p_ctx, prov_bearer_t * p
 
 uint32_t nrf_mesh_prov_generate_keys(uint8_t * p_public, uint8_t * p_private)
 {
-    return prov_utils_keys_generate(p_public, p_private);
+    return prov_keypool_keys_get(p_public, p_private);
+}
+
+void nrf_mesh_prov_keypool_stats_get(nrf_mesh_prov_keypool_stats_t * p_stats)
+{
+    prov_keypool_stats_get(p_stats);
+}
+
+uint32_t nrf_mesh_prov_ecc_backend_set(const nrf_mesh_prov_ecc_backend_t * p_backend)
+{
+    return prov_utils_ecc_backend_set(p_backend);
 }
 
 uint32_t nrf_mesh_prov_listen(nrf_mesh_prov_ctx_t *       p_ctx,
@@ -159,6 +159,8 @@ static const char * m_state_lookup_table[] =
 };
 #endif  /* FSM_DEBUG */
 
+static uint8_t m_pb_gatt_fsm_index[FSM_INDEX_SIZE(VA_NARGS(STATE_LIST), VA_NARGS(EVENT_LIST))];
+
 static const fsm_const_descriptor_t m_pb_gatt_fsm_descriptor =
 {
     .transition_table = m_pb_gatt_fsm_transition_table,
@@ -166,6 +168,9 @@ static const fsm_const_descriptor_t m_pb_gatt_fsm_descriptor =
     .initial_state = S_IDLE,
     .guard = pb_gatt_fsm_guard,
     .action = pb_gatt_fsm_action,
+    .p_index = m_pb_gatt_fsm_index,
+    .state_count = VA_NARGS(STATE_LIST),
+    .event_count = VA_NARGS(EVENT_LIST),
 #if FSM_DEBUG
     .fsm_name = "PB-GATT bearer",
     .action_lookup = m_action_lookup_table,
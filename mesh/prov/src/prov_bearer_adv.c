@@ -162,6 +162,10 @@ NRF_MESH_STATIC_ASSERT(PROV_BEARER_ADV_PACKET_CONTINUATION_PAYLOAD_MAXLEN == 23)
 #define PB_ADV_TRANSACTION_NUMBER_PROVISIONER_START  (0x00) /**< Initial value of provisioner transaction number. */
 #define PB_ADV_TRANSACTION_NUMBER_PROVISIONEE_START  (0x80) /**< Initial value of provisionee transaction number. */
 #define PB_ADV_TRANSACTION_NUMBER_ROLLOVER_MASK      (0x7f) /**< Mask applied when rolling over transaction numbers. */
+
+/* The link ID hash is masked rather than divided, so the bucket count must be a power of two. */
+NRF_MESH_STATIC_ASSERT(NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE > 0 &&
+                       (NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE & (NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE - 1)) == 0);
 /*****************************************************************************
 * Local type declarations
 *****************************************************************************/
@@ -220,7 +224,8 @@ NRF_MESH_STATIC_ASSERT(PROV_BEARER_ADV_UNACKED_REPEAT_COUNT >= 3);
 /*****************************************************************************
 * Static globals
 *****************************************************************************/
-static nrf_mesh_prov_bearer_adv_t * mp_bearer_head; /**< Head of adv bearer linked list */
+/** Active adv bearers, hashed on link ID. Each bucket is a singly linked list through @c p_next. */
+static nrf_mesh_prov_bearer_adv_t * mp_bearer_buckets[NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE];
 static bearer_event_flag_t m_async_process_flag = BEARER_EVENT_FLAG_INVALID; /**< Flag to enable asynchronous processing. */
 /*****************************************************************************
 * Static functions
@@ -290,18 +295,26 @@ static void link_timeout_cb(timestamp_t timestamp, void * p_context)
     p_bearer->p_interface->link_close(p_bearer, NRF_MESH_PROV_LINK_CLOSE_REASON_TIMEOUT);
 }
 
+/** Get the bucket index of the given link ID. Link IDs are random, so folding the halves is enough. */
+static inline uint32_t link_id_bucket_get(uint32_t link_id)
+{
+    return (link_id ^ (link_id >> 16)) & (NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE - 1);
+}
+
 static nrf_mesh_prov_bearer_adv_t * get_bearer_from_state(prov_bearer_adv_state_t state)
 {
     uint32_t was_masked;
     _DISABLE_IRQS(was_masked);
-    nrf_mesh_prov_bearer_adv_t * p_pb_adv = mp_bearer_head;
-    while (p_pb_adv != NULL)
+    nrf_mesh_prov_bearer_adv_t * p_pb_adv = NULL;
+    for (uint32_t i = 0; i < NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE && p_pb_adv == NULL; ++i)
     {
-        if (p_pb_adv->state == state)
+        for (p_pb_adv = mp_bearer_buckets[i]; p_pb_adv != NULL; p_pb_adv = p_pb_adv->p_next)
         {
-            break;
+            if (p_pb_adv->state == state)
+            {
+                break;
+            }
         }
-        p_pb_adv = p_pb_adv->p_next;
     }
     _ENABLE_IRQS(was_masked);
     return p_pb_adv;
@@ -311,7 +324,7 @@ static nrf_mesh_prov_bearer_adv_t * get_bearer_from_link_id(uint32_t link_id)
 {
     uint32_t was_masked;
     _DISABLE_IRQS(was_masked);
-    nrf_mesh_prov_bearer_adv_t * p_pb_adv = mp_bearer_head;
+    nrf_mesh_prov_bearer_adv_t * p_pb_adv = mp_bearer_buckets[link_id_bucket_get(link_id)];
     while (p_pb_adv != NULL)
     {
         if (p_pb_adv->link_id == link_id)
@@ -392,14 +405,17 @@ static void init_bearer_structure(nrf_mesh_prov_bearer_adv_t * p_pb_adv, uint32_
 /**
  * Add a bearer instance to the active bearer list.
  *
+ * The bearer is put in the bucket of its current link ID, so the link ID must be set before
+ * calling this function, and changed through @ref active_bearer_link_id_set afterwards.
  */
 static void add_active_bearer(nrf_mesh_prov_bearer_adv_t * p_pb_adv)
 {
     uint32_t was_masked;
     _DISABLE_IRQS(was_masked);
 
-    p_pb_adv->p_next = mp_bearer_head;
-    mp_bearer_head = p_pb_adv;
+    nrf_mesh_prov_bearer_adv_t ** pp_head = &mp_bearer_buckets[link_id_bucket_get(p_pb_adv->link_id)];
+    p_pb_adv->p_next = *pp_head;
+    *pp_head = p_pb_adv;
 
     _ENABLE_IRQS(was_masked);
 
@@ -414,17 +430,18 @@ static void add_active_bearer(nrf_mesh_prov_bearer_adv_t * p_pb_adv)
  */
 static void remove_active_bearer(const nrf_mesh_prov_bearer_adv_t * p_pb_adv)
 {
-    NRF_MESH_ASSERT(mp_bearer_head != NULL);
+    nrf_mesh_prov_bearer_adv_t ** pp_head = &mp_bearer_buckets[link_id_bucket_get(p_pb_adv->link_id)];
+    NRF_MESH_ASSERT(*pp_head != NULL);
     uint32_t was_masked;
     _DISABLE_IRQS(was_masked);
 
-    if (p_pb_adv == mp_bearer_head)
+    if (p_pb_adv == *pp_head)
     {
-        mp_bearer_head = p_pb_adv->p_next;
+        *pp_head = p_pb_adv->p_next;
     }
     else
     {
-        nrf_mesh_prov_bearer_adv_t * p_prev = mp_bearer_head;
+        nrf_mesh_prov_bearer_adv_t * p_prev = *pp_head;
         while (p_prev->p_next != p_pb_adv)
         {
             /* This should never happen, otherwise it indicates an internal error. */
@@ -438,6 +455,17 @@ static void remove_active_bearer(const nrf_mesh_prov_bearer_adv_t * p_pb_adv)
     _ENABLE_IRQS(was_masked);
 }
 
+/** Change the link ID of an active bearer, moving it to the matching bucket. */
+static void active_bearer_link_id_set(nrf_mesh_prov_bearer_adv_t * p_pb_adv, uint32_t link_id)
+{
+    uint32_t was_masked;
+    _DISABLE_IRQS(was_masked);
+    remove_active_bearer(p_pb_adv);
+    p_pb_adv->link_id = link_id;
+    add_active_bearer(p_pb_adv);
+    _ENABLE_IRQS(was_masked);
+}
+
 /**** Packet sending ****/
 
 static void send_unprov_beacon(nrf_mesh_prov_bearer_adv_t * p_pb_adv, const char * URI, uint16_t oob_info)
@@ -855,7 +883,7 @@ static void handle_control_packet(nrf_mesh_prov_bearer_adv_t * p_pb_adv, pb_adv_
                 {
                     if (p_pb_adv->state == PROV_BEARER_ADV_STATE_LISTEN)
                     {
-                        p_pb_adv->link_id = BE2LE32(p_packet->link_id);
+                        active_bearer_link_id_set(p_pb_adv, BE2LE32(p_packet->link_id));
 
                         /* Start using short advertisement interval */
                         reset_adv_int(p_pb_adv);
@@ -873,7 +901,7 @@ static void handle_control_packet(nrf_mesh_prov_bearer_adv_t * p_pb_adv, pb_adv_
                         }
                         else
                         {
-                            p_pb_adv->link_id = 0;
+                            active_bearer_link_id_set(p_pb_adv, 0);
                         }
                     }
                     else if (p_pb_adv->state == PROV_BEARER_ADV_STATE_LINK_OPEN &&
@@ -1018,14 +1046,19 @@ static void tx_complete_cb(advertiser_t * p_adv, nrf_mesh_tx_token_t token, time
 
 static bool async_process(void)
 {
-    for (nrf_mesh_prov_bearer_adv_t *p_pb_adv = mp_bearer_head;
-         p_pb_adv != NULL;
-         p_pb_adv = p_pb_adv->p_next)
+    for (uint32_t i = 0; i < NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE; ++i)
     {
-        if (p_pb_adv->queue_empty_pending)
+        nrf_mesh_prov_bearer_adv_t * p_pb_adv = mp_bearer_buckets[i];
+        while (p_pb_adv != NULL)
         {
-            p_pb_adv->queue_empty_pending = false;
-            queue_empty_cb(p_pb_adv);
+            /* The queue empty callback may close the link and unlink the bearer. */
+            nrf_mesh_prov_bearer_adv_t * p_next = p_pb_adv->p_next;
+            if (p_pb_adv->queue_empty_pending)
+            {
+                p_pb_adv->queue_empty_pending = false;
+                queue_empty_cb(p_pb_adv);
+            }
+            p_pb_adv = p_next;
         }
     }
     return true;
@@ -0,0 +1,143 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "prov_keypool.h"
+
+#include "nrf_mesh_config_prov.h"
+#include "nrf_mesh_assert.h"
+#include "prov_utils.h"
+#include "bearer_event.h"
+#include "log.h"
+
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+
+typedef struct
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+} keypair_t;
+
+static keypair_t m_pool[NRF_MESH_PROV_KEYPOOL_SIZE];
+/** Number of valid keypairs at the start of @ref m_pool. */
+static uint32_t m_count;
+static bearer_event_flag_t m_fill_flag = BEARER_EVENT_FLAG_INVALID;
+
+#endif /* NRF_MESH_PROV_KEYPOOL_SIZE > 0 */
+
+static nrf_mesh_prov_keypool_stats_t m_stats;
+
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+
+/* Generates one keypair per call, so that other bearer events get to run between each one. */
+static bool pool_fill(void)
+{
+    if (m_count < NRF_MESH_PROV_KEYPOOL_SIZE)
+    {
+        keypair_t keypair;
+        if (prov_utils_keys_generate(keypair.public_key, keypair.private_key) != NRF_SUCCESS)
+        {
+            /* Try again the next time the pool is drawn from. */
+            return true;
+        }
+
+        m_pool[m_count] = keypair;
+        m_count++;
+        memset(&keypair, 0, sizeof(keypair));
+    }
+
+    return (m_count == NRF_MESH_PROV_KEYPOOL_SIZE);
+}
+
+static void pool_fill_start(void)
+{
+    if (m_fill_flag == BEARER_EVENT_FLAG_INVALID)
+    {
+        m_fill_flag = bearer_event_flag_add(pool_fill);
+    }
+    bearer_event_flag_set(m_fill_flag);
+}
+
+#endif /* NRF_MESH_PROV_KEYPOOL_SIZE > 0 */
+
+void prov_keypool_init(void)
+{
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+    pool_fill_start();
+#endif
+}
+
+uint32_t prov_keypool_keys_get(uint8_t * p_public, uint8_t * p_private)
+{
+    NRF_MESH_ASSERT(p_public != NULL && p_private != NULL);
+
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+    bool hit = false;
+
+    bearer_event_critical_section_begin();
+    if (m_count > 0)
+    {
+        m_count--;
+        memcpy(p_public, m_pool[m_count].public_key, NRF_MESH_PROV_PUBKEY_SIZE);
+        memcpy(p_private, m_pool[m_count].private_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+        memset(&m_pool[m_count], 0, sizeof(m_pool[m_count]));
+        hit = true;
+    }
+    bearer_event_critical_section_end();
+
+    pool_fill_start();
+
+    if (hit)
+    {
+        m_stats.hits++;
+        return NRF_SUCCESS;
+    }
+#endif
+
+    m_stats.misses++;
+    __LOG(LOG_SRC_PROV, LOG_LEVEL_DBG1, "Keypool empty, generating keypair\n");
+    return prov_utils_keys_generate(p_public, p_private);
+}
+
+void prov_keypool_stats_get(nrf_mesh_prov_keypool_stats_t * p_stats)
+{
+    NRF_MESH_ASSERT(p_stats != NULL);
+    *p_stats = m_stats;
+}
@@ -79,6 +79,20 @@ static const uint32_t m_numeric_max[] =
 
 static bool m_enabled;
 
+static uint32_t uecc_keys_generate(uint8_t * p_public, uint8_t * p_private);
+static uint32_t uecc_shared_secret_calculate(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared);
+static bool uecc_public_key_is_valid(const uint8_t * p_public);
+
+/** Default ECC backend, using the bundled micro-ecc library. */
+static const nrf_mesh_prov_ecc_backend_t m_uecc_backend =
+{
+    .keys_generate           = uecc_keys_generate,
+    .shared_secret_calculate = uecc_shared_secret_calculate,
+    .public_key_is_valid     = uecc_public_key_is_valid
+};
+
+static const nrf_mesh_prov_ecc_backend_t * mp_ecc_backend = &m_uecc_backend;
+
 /*****************************************************************************
  * Mesh Config wrapper functions
  *****************************************************************************/
@@ -108,6 +122,32 @@ MESH_CONFIG_ENTRY(ecdh_offloading,
                   ecdh_deleter,
                   true);
 
+/*****************************************************************************
+ * micro-ecc backend
+ *****************************************************************************/
+static uint32_t uecc_keys_generate(uint8_t * p_public, uint8_t * p_private)
+{
+#if NRF_MESH_UECC_ENABLE
+    return uECC_make_key(p_public, p_private, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+static uint32_t uecc_shared_secret_calculate(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared)
+{
+#if NRF_MESH_UECC_ENABLE
+    return uECC_shared_secret(p_peer_public, p_private, p_shared, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+static bool uecc_public_key_is_valid(const uint8_t * p_public)
+{
+    return uECC_valid_public_key(p_public, uECC_secp256r1());
+}
+
 static void create_confirmation_salt(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_confirmation_salt)
 {
     /* ConfirmationInputs = AES-CMAC(AES-CMAC(
@@ -224,13 +264,28 @@ void prov_utils_authentication_values_derive(const nrf_mesh_prov_ctx_t * p_ctx,
                  p_confirmation);
 }
 
+uint32_t prov_utils_ecc_backend_set(const nrf_mesh_prov_ecc_backend_t * p_backend)
+{
+    if (p_backend == NULL)
+    {
+        mp_ecc_backend = &m_uecc_backend;
+        return NRF_SUCCESS;
+    }
+
+    if (p_backend->keys_generate == NULL ||
+        p_backend->shared_secret_calculate == NULL ||
+        p_backend->public_key_is_valid == NULL)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    mp_ecc_backend = p_backend;
+    return NRF_SUCCESS;
+}
+
 uint32_t prov_utils_keys_generate(uint8_t * p_public, uint8_t * p_private)
 {
-#if NRF_MESH_UECC_ENABLE
-    return uECC_make_key(p_public, p_private, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
-#else
-    return NRF_ERROR_NOT_SUPPORTED;
-#endif
+    return mp_ecc_backend->keys_generate(p_public, p_private);
 }
 
 void prov_utils_derive_keys(const nrf_mesh_prov_ctx_t * p_ctx,
@@ -282,24 +337,15 @@ void prov_utils_derive_keys(const nrf_mesh_prov_ctx_t * p_ctx,
 
 bool prov_utils_is_valid_public_key(const uint8_t * p_public_key)
 {
-    return uECC_valid_public_key(p_public_key, uECC_secp256r1());
+    return mp_ecc_backend->public_key_is_valid(p_public_key);
 }
 
 uint32_t prov_utils_calculate_shared_secret(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_shared_secret)
 {
-#if NRF_MESH_UECC_ENABLE
     /* We should have validated the public key before this point. */
     NRF_MESH_ASSERT_DEBUG(prov_utils_is_valid_public_key(p_ctx->peer_public_key));
 
-    if (!uECC_shared_secret(p_ctx->peer_public_key, p_ctx->p_private_key, p_shared_secret, uECC_secp256r1()))
-    {
-        return NRF_ERROR_INTERNAL;
-    }
-
-    return NRF_SUCCESS;
-#else
-    return NRF_ERROR_NOT_SUPPORTED;
-#endif
+    return mp_ecc_backend->shared_secret_calculate(p_ctx->peer_public_key, p_ctx->p_private_key, p_shared_secret);
 }
 
 void prov_utils_generate_oob_data(const nrf_mesh_prov_ctx_t * p_ctx, uint8_t * p_auth_value)
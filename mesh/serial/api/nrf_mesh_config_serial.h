@@ -52,6 +52,16 @@
 #define NRF_MESH_SERIAL_BEACON_SLOTS 1
 #endif
 
+/**
+ * Enable per-opcode latency counters for the serial command handlers.
+ *
+ * The counters can be read with the @ref SERIAL_OPCODE_CMD_DEVICE_CMD_LATENCY_GET command, and
+ * take 12 bytes of RAM per opcode.
+ */
+#ifndef NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+#define NRF_MESH_SERIAL_CMD_LATENCY_ENABLE 0
+#endif
+
 /** @} end of NRF_MESH_CONFIG_SERIAL */
 
 
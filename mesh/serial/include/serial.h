@@ -130,6 +130,23 @@ nrf_mesh_serial_state_t serial_state_get(void);
  */
 void serial_cmd_rsp_send(uint8_t opcode, uint8_t status, const uint8_t * p_data, uint16_t length);
 
+/**
+ * Gets the latency counters of the command handler for the given opcode.
+ *
+ * @param[in]  opcode    Opcode of the command.
+ * @param[out] p_latency Pointer to where the counters should be stored.
+ *
+ * @retval NRF_SUCCESS             The counters were stored in @p p_latency.
+ * @retval NRF_ERROR_NOT_SUPPORTED The counters are disabled, see
+ *                                 @ref NRF_MESH_SERIAL_CMD_LATENCY_ENABLE.
+ */
+uint32_t serial_cmd_latency_get(uint8_t opcode, serial_evt_cmd_rsp_data_cmd_latency_t * p_latency);
+
+/**
+ * Clears the latency counters of all command handlers.
+ */
+void serial_cmd_latency_clear(void);
+
 /** @} end of SERIAL_INTERFACE */
 
 #endif
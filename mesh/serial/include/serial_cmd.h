@@ -68,6 +68,8 @@
 #define SERIAL_OPCODE_CMD_DEVICE_BEACON_PARAMS_GET            (0x13) /**< Params: @ref serial_cmd_device_beacon_params_get_t */
 #define SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_GET        (0x14) /**< Params: None. */
 #define SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_CLEAR      (0x15) /**< Params: None. */
+#define SERIAL_OPCODE_CMD_DEVICE_BATCH                        (0x16) /**< Params: @ref serial_cmd_device_batch_t */
+#define SERIAL_OPCODE_CMD_DEVICE_CMD_LATENCY_GET              (0x17) /**< Params: @ref serial_cmd_device_cmd_latency_get_t */
 
 #define SERIAL_OPCODE_CMD_RANGE_DEVICE_END                    (0x1F) /**< DEVICE range end. */
 
@@ -155,6 +157,15 @@
 #define SERIAL_OPCODE_CMD_MESH_CONFIG_SERVER_BIND             (0xAD) /**< Params: @ref serial_cmd_mesh_config_server_devkey_bind_t */
 #define SERIAL_OPCODE_CMD_RANGE_MESH_END                      (0xAF) /**< MESH range end. */
 
+#define SERIAL_OPCODE_CMD_RANGE_STATS_START                   (0xB0) /**< STATS range start. */
+#define SERIAL_OPCODE_CMD_STATS_COUNTERS_GET                  (0xB0) /**< Params: @ref serial_cmd_stats_counters_get_t */
+#define SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET                 (0xB1) /**< Params: @ref serial_cmd_stats_histogram_get_t */
+#define SERIAL_OPCODE_CMD_STATS_CLEAR                         (0xB2) /**< Params: None. */
+#define SERIAL_OPCODE_CMD_STATS_HB_SOURCE_GET                 (0xB3) /**< Params: @ref serial_cmd_stats_hb_source_get_t */
+#define SERIAL_OPCODE_CMD_STATS_HB_SOURCES_LIST               (0xB4) /**< Params: @ref serial_cmd_stats_hb_sources_list_t */
+#define SERIAL_OPCODE_CMD_STATS_HB_SOURCES_CLEAR              (0xB5) /**< Params: None. */
+#define SERIAL_OPCODE_CMD_RANGE_STATS_END                     (0xBF) /**< STATS range end. */
+
 #define SERIAL_OPCODE_CMD_RANGE_DFU_START                     (0xD0) /**< DFU range start. */
 #define SERIAL_OPCODE_CMD_DFU_JUMP_TO_BOOTLOADER              (0xD0) /**< Params: None. */
 #define SERIAL_OPCODE_CMD_DFU_REQUEST                         (0xD1) /**< Params: @ref serial_cmd_dfu_request_t */
@@ -233,6 +244,23 @@ typedef struct __attribute((packed))
     uint8_t beacon_slot; /**< Slot number of the beacon to get the parameters of. */
 } serial_cmd_device_beacon_params_get_t;
 
+/**
+ * Batch cmd parameters.
+ *
+ * The commands are packed back to back, each in the regular serial packet format: a length byte,
+ * followed by the opcode and the command parameters.
+ */
+typedef struct __attribute((packed))
+{
+    uint8_t commands[NRF_MESH_SERIAL_PAYLOAD_MAXLEN]; /**< Commands to process. */
+} serial_cmd_device_batch_t;
+
+/** Command latency get cmd parameters. */
+typedef struct __attribute((packed))
+{
+    uint8_t opcode; /**< Opcode of the command to get the latency counters for. */
+} serial_cmd_device_cmd_latency_get_t;
+
 /** Union of all device command parameters. */
 typedef union __attribute((packed))
 {
@@ -241,6 +269,8 @@ typedef union __attribute((packed))
     serial_cmd_device_beacon_stop_t beacon_stop; /**< Beacon stop parameters. */
     serial_cmd_device_beacon_params_set_t beacon_params_set; /**< Beacon params set parameters. */
     serial_cmd_device_beacon_params_get_t beacon_params_get; /**< Beacon params get parameters. */
+    serial_cmd_device_batch_t batch; /**< Batch parameters. */
+    serial_cmd_device_cmd_latency_get_t cmd_latency_get; /**< Command latency get parameters. */
 } serial_cmd_device_t;
 
 /************** Config commands **************/
@@ -617,6 +647,41 @@ typedef union __attribute((packed))
     serial_cmd_dfu_bank_flash_t bank_flash;   /**< DFU bank flash parameters. */
 } serial_cmd_dfu_t;
 
+/*********** Stats commands ***************/
+/** Stats counters get command parameters. */
+typedef struct __attribute((packed))
+{
+    uint8_t first; /**< First counter to get. */
+    uint8_t count; /**< Number of counters to get. */
+} serial_cmd_stats_counters_get_t;
+
+/** Stats histogram get command parameters. */
+typedef struct __attribute((packed))
+{
+    uint8_t histogram; /**< Histogram to get. */
+} serial_cmd_stats_histogram_get_t;
+
+/** Stats heartbeat source get command parameters. */
+typedef struct __attribute((packed))
+{
+    uint16_t src; /**< Unicast address of the heartbeat source to get. */
+} serial_cmd_stats_hb_source_get_t;
+
+/** Stats heartbeat sources list command parameters. */
+typedef struct __attribute((packed))
+{
+    uint16_t index; /**< Collector table index to start listing from. Use 0 for the first call, and the returned next index for the following calls. */
+} serial_cmd_stats_hb_sources_list_t;
+
+/** Stats command parameters. */
+typedef union __attribute((packed))
+{
+    serial_cmd_stats_counters_get_t    counters_get;    /**< Counters get parameters. */
+    serial_cmd_stats_histogram_get_t   histogram_get;   /**< Histogram get parameters. */
+    serial_cmd_stats_hb_source_get_t   hb_source_get;   /**< Heartbeat source get parameters. */
+    serial_cmd_stats_hb_sources_list_t hb_sources_list; /**< Heartbeat sources list parameters. */
+} serial_cmd_stats_t;
+
 /*********** Access commands ************/
 /** Used by various access commands that work on address handles for a given model */
 typedef struct __attribute((packed))
@@ -714,6 +779,7 @@ typedef union __attribute((packed))
     serial_cmd_prov_t        prov;        /**< Provisioning parameters. */
     serial_cmd_mesh_t        mesh;        /**< Mesh parameters. */
     serial_cmd_dfu_t         dfu;         /**< DFU parameters. */
+    serial_cmd_stats_t       stats;       /**< Stats parameters. */
     serial_cmd_pb_remote_t   pb_remote;   /**< PB-MESH parameters. */
     serial_cmd_application_t application; /**< Application parameters. */
 } serial_cmd_t;
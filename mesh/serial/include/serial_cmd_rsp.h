@@ -60,6 +60,12 @@
 #define SERIAL_EVT_CMD_RSP_LEN_OVERHEAD     (NRF_MESH_SERIAL_PACKET_OVERHEAD + SERIAL_EVT_CMD_RSP_OVERHEAD)
 /** Max length of the command response data field. */
 #define SERIAL_EVT_CMD_RSP_DATA_MAXLEN      (NRF_MESH_SERIAL_PAYLOAD_MAXLEN  - SERIAL_EVT_CMD_RSP_OVERHEAD)
+/** Overhead of the stats counters response data, before the counter values. */
+#define SERIAL_EVT_CMD_RSP_DATA_STATS_COUNTERS_OVERHEAD (3)
+/** Number of buckets in a stats histogram response. */
+#define SERIAL_EVT_CMD_RSP_DATA_STATS_HISTOGRAM_BUCKETS (16)
+/** Overhead of the stats heartbeat sources response data, before the sources. */
+#define SERIAL_EVT_CMD_RSP_DATA_STATS_HB_SOURCES_OVERHEAD (5)
 
 /*lint -align_max(push) -align_max(1) */
 
@@ -69,6 +75,65 @@ typedef struct __attribute((packed))
     uint32_t alloc_fail_count;  /**< Number of failed serial packet allocations. */
 } serial_evt_cmd_rsp_data_housekeeping_t;
 
+/**
+ * Batch command response data.
+ *
+ * The command responses are packed back to back, each in the regular serial packet format of a
+ * command response event.
+ */
+typedef struct __attribute((packed))
+{
+    uint8_t responses[SERIAL_EVT_CMD_RSP_DATA_MAXLEN]; /**< Command responses. */
+} serial_evt_cmd_rsp_data_batch_t;
+
+/** Command handler latency counters. */
+typedef struct __attribute((packed))
+{
+    uint8_t  opcode;   /**< Opcode of the command. */
+    uint32_t count;    /**< Number of times the command has been handled. */
+    uint32_t max_us;   /**< Longest time spent in the command handler, in microseconds. */
+    uint32_t total_us; /**< Total time spent in the command handler, in microseconds. */
+} serial_evt_cmd_rsp_data_cmd_latency_t;
+
+/** Stats counters response data. */
+typedef struct __attribute((packed))
+{
+    uint8_t  total_count; /**< Total number of counters on the device. */
+    uint8_t  first;       /**< First counter in the response. */
+    uint8_t  count;       /**< Number of counters in the response. */
+    uint32_t values[(SERIAL_EVT_CMD_RSP_DATA_MAXLEN - SERIAL_EVT_CMD_RSP_DATA_STATS_COUNTERS_OVERHEAD) / sizeof(uint32_t)]; /**< Counter values. */
+} serial_evt_cmd_rsp_data_stats_counters_t;
+
+/** Stats histogram response data. */
+typedef struct __attribute((packed))
+{
+    uint8_t  histogram; /**< Histogram in the response. */
+    uint32_t max;       /**< Largest sample value. */
+    uint32_t buckets[SERIAL_EVT_CMD_RSP_DATA_STATS_HISTOGRAM_BUCKETS]; /**< Number of samples in each bucket. Bucket 0 counts samples with the value 0, and bucket n counts samples in the range [2^(n-1), 2^n). The last bucket also counts all larger samples. */
+} serial_evt_cmd_rsp_data_stats_histogram_t;
+
+/** Stats heartbeat source response data. */
+typedef struct __attribute((packed))
+{
+    uint16_t src;      /**< Unicast address of the heartbeat source. */
+    uint16_t count;    /**< Number of heartbeats received from the source. Stops counting at 0xFFFF. */
+    uint16_t features; /**< Features state in the last heartbeat. */
+    uint8_t  hops;     /**< Hop count of the last heartbeat. */
+    uint8_t  min_hops; /**< Lowest hop count received. */
+    uint8_t  max_hops; /**< Highest hop count received. */
+    int8_t   rssi;     /**< RSSI of the last heartbeat, or 127 if it wasn't received over the advertising bearer. */
+    uint32_t age_ms;   /**< Time since the last heartbeat, in milliseconds. Wraps around after 2^32 microseconds (about 71 minutes). */
+} serial_evt_cmd_rsp_data_stats_hb_source_t;
+
+/** Stats heartbeat sources list response data. */
+typedef struct __attribute((packed))
+{
+    uint16_t total_count; /**< Total number of heartbeat sources in the collector. */
+    uint16_t next_index;  /**< Collector table index to continue listing from. Equal to the collector size when all sources have been listed. */
+    uint8_t  count;       /**< Number of heartbeat sources in the response. */
+    serial_evt_cmd_rsp_data_stats_hb_source_t sources[(SERIAL_EVT_CMD_RSP_DATA_MAXLEN - SERIAL_EVT_CMD_RSP_DATA_STATS_HB_SOURCES_OVERHEAD) / sizeof(serial_evt_cmd_rsp_data_stats_hb_source_t)]; /**< Heartbeat sources. */
+} serial_evt_cmd_rsp_data_stats_hb_sources_t;
+
 /** Subnetwork access response data */
 typedef struct __attribute((packed))
 {
@@ -308,6 +373,12 @@ typedef struct __attribute((packed))
     union __attribute((packed))
     {
         serial_evt_cmd_rsp_data_housekeeping_t         hk_data;        /**< Housekeeping data response. */
+        serial_evt_cmd_rsp_data_batch_t                batch;          /**< Batch command responses. */
+        serial_evt_cmd_rsp_data_cmd_latency_t          cmd_latency;    /**< Command handler latency counters. */
+        serial_evt_cmd_rsp_data_stats_counters_t       stats_counters; /**< Performance counters. */
+        serial_evt_cmd_rsp_data_stats_histogram_t      stats_histogram; /**< Performance histogram. */
+        serial_evt_cmd_rsp_data_stats_hb_source_t      stats_hb_source; /**< Heartbeat source statistics. */
+        serial_evt_cmd_rsp_data_stats_hb_sources_t     stats_hb_sources; /**< List of heartbeat source statistics. */
         serial_evt_cmd_rsp_data_subnet_t               subnet;         /**< Subnet response. */
         serial_evt_cmd_rsp_data_subnet_list_t          subnet_list;    /**< List of all subnet key indexes. */
         serial_evt_cmd_rsp_data_appkey_t               appkey;         /**< Appkey response. */
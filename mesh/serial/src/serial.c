@@ -50,9 +50,12 @@
 #include "nrf_mesh_serial.h"
 #include "nrf_mesh_opt.h"
 
+#include "nrf_mesh_config_serial.h"
 #include "bearer_event.h"
 #include "log.h"
 #include "rand.h"
+#include "timer.h"
+#include "utils.h"
 
 #include "serial_evt.h"
 #include "serial_cmd.h"
@@ -67,6 +70,7 @@
 #include "serial_handler_access.h"
 #include "serial_handler_models.h"
 #include "serial_handler_openmesh.h"
+#include "serial_handler_stats.h"
 
 
 /* The serial_device_operating_mode_t must fit inside a single byte, to make sure it can go into the packet. */
@@ -89,13 +93,32 @@ typedef struct
     serial_cmd_handler_t handler;   /**< Handler function pointer. */
 } serial_cmd_handler_entry_t;
 
-/** Flash-stored list of serial command handlers. */
+#if NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+/** Latency counters for a single opcode. */
+typedef struct
+{
+    uint32_t count;
+    uint32_t max_us;
+    uint32_t total_us;
+} cmd_latency_t;
+#endif
+
+static void handle_cmd_batch(const serial_packet_t * p_cmd);
+
+/**
+ * Flash-stored list of serial command handlers.
+ *
+ * The batch command is listed before the device range it is part of, as the first entry covering
+ * an opcode takes precedence.
+ */
 static const serial_cmd_handler_entry_t m_cmd_handlers[] =
 {
+    {SERIAL_OPCODE_CMD_DEVICE_BATCH,                 SERIAL_OPCODE_CMD_DEVICE_BATCH,               handle_cmd_batch},
     {SERIAL_OPCODE_CMD_RANGE_DEVICE_START,           SERIAL_OPCODE_CMD_RANGE_DEVICE_END,           serial_handler_device_rx},
     {SERIAL_OPCODE_CMD_RANGE_CONFIG_START,           SERIAL_OPCODE_CMD_RANGE_CONFIG_END,           serial_handler_config_rx},
     {SERIAL_OPCODE_CMD_RANGE_OPENMESH_START,         SERIAL_OPCODE_CMD_RANGE_OPENMESH_END,         serial_handler_openmesh_rx},
     {SERIAL_OPCODE_CMD_RANGE_MESH_START,             SERIAL_OPCODE_CMD_RANGE_MESH_END,             serial_handler_mesh_rx},
+    {SERIAL_OPCODE_CMD_RANGE_STATS_START,            SERIAL_OPCODE_CMD_RANGE_STATS_END,            serial_handler_stats_rx},
     {SERIAL_OPCODE_CMD_RANGE_PROV_START,             SERIAL_OPCODE_CMD_RANGE_PROV_END,             serial_handler_prov_pkt_in},
     {SERIAL_OPCODE_CMD_RANGE_DFU_START,              SERIAL_OPCODE_CMD_RANGE_DFU_END,              serial_handler_dfu_rx},
     {SERIAL_OPCODE_CMD_RANGE_ACCESS_START,           SERIAL_OPCODE_CMD_RANGE_ACCESS_END,           serial_handler_access_rx},
@@ -103,32 +126,175 @@ static const serial_cmd_handler_entry_t m_cmd_handlers[] =
     {SERIAL_OPCODE_CMD_RANGE_APP_START,              SERIAL_OPCODE_CMD_RANGE_APP_END,              serial_handler_app_rx},
 };
 
+/* The handler index lookup table stores the entry index + 1 in a byte. */
+NRF_MESH_STATIC_ASSERT(ARRAY_SIZE(m_cmd_handlers) < UINT8_MAX);
+
 static nrf_mesh_serial_state_t  m_state;
 static bool                     m_cmd_handler_scheduled;
 
-static void serial_process_cmd(void * p_context __attribute((unused)))
+/** Opcode to handler lookup table. Stores the index + 1 of the handler entry, or 0 if the opcode is not handled. */
+static uint8_t m_cmd_handler_index[UINT8_MAX + 1];
+
+/** Command responses collected while processing a batch command. */
+static struct
 {
-    serial_packet_t packet_in;  /* Incoming packet */
-    m_cmd_handler_scheduled = false;
+    bool active;
+    uint16_t length;
+    uint8_t data[SERIAL_EVT_CMD_RSP_DATA_MAXLEN];
+} m_batch_rsp;
 
-    while (serial_bearer_rx_get(&packet_in))
+/** Unpacked copy of the batch command currently being processed. */
+static serial_packet_t m_batch_cmd;
+
+#if NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+static cmd_latency_t m_cmd_latency[UINT8_MAX + 1];
+#endif
+
+static void cmd_handler_index_build(void)
+{
+    memset(m_cmd_handler_index, 0, sizeof(m_cmd_handler_index));
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_cmd_handlers); ++i)
     {
-        bool handled = false;
-        for (uint32_t i = 0; i < sizeof(m_cmd_handlers) / sizeof(serial_cmd_handler_entry_t); ++i)
+        for (uint32_t opcode = m_cmd_handlers[i].range_start; opcode <= m_cmd_handlers[i].range_end; ++opcode)
         {
-            if (m_cmd_handlers[i].range_start <= packet_in.opcode &&
-                m_cmd_handlers[i].range_end >= packet_in.opcode)
+            if (m_cmd_handler_index[opcode] == 0)
             {
-                m_cmd_handlers[i].handler(&packet_in);
-                handled = true;
-                break; /* Handle each packet once. Can't have overlapping ranges. */
+                m_cmd_handler_index[opcode] = i + 1;
             }
         }
-        if (!handled)
+    }
+}
+
+static void cmd_rsp_tx(uint8_t opcode, uint8_t status, const uint8_t * p_data, uint16_t length)
+{
+    serial_packet_t * p_rsp;
+    uint32_t err_code = serial_packet_buffer_get(SERIAL_EVT_CMD_RSP_LEN_OVERHEAD + length, &p_rsp);
+    if (err_code == NRF_SUCCESS)
+    {
+        p_rsp->opcode = SERIAL_OPCODE_EVT_CMD_RSP;
+        p_rsp->payload.evt.cmd_rsp.opcode = opcode;
+        p_rsp->payload.evt.cmd_rsp.status = status;
+
+        if (p_data != NULL)
         {
-            __LOG(LOG_SRC_SERIAL, LOG_LEVEL_WARN, "No handler for 0x%02x\n", packet_in.opcode);
-            serial_cmd_rsp_send(packet_in.opcode, SERIAL_STATUS_ERROR_CMD_UNKNOWN, NULL, 0);
+            memcpy(&p_rsp->payload.evt.cmd_rsp.data, p_data, length);
         }
+
+        (void) serial_tx(p_rsp);
+    }
+}
+
+static void batch_rsp_flush(uint8_t status)
+{
+    cmd_rsp_tx(SERIAL_OPCODE_CMD_DEVICE_BATCH,
+               status,
+               (m_batch_rsp.length > 0) ? m_batch_rsp.data : NULL,
+               m_batch_rsp.length);
+    m_batch_rsp.length = 0;
+}
+
+static void batch_rsp_add(uint8_t opcode, uint8_t status, const uint8_t * p_data, uint16_t length)
+{
+    uint32_t rsp_len = SERIAL_EVT_CMD_RSP_LEN_OVERHEAD + length;
+    if (rsp_len > sizeof(m_batch_rsp.data))
+    {
+        /* Can never be part of a batch response, send it on its own. */
+        cmd_rsp_tx(opcode, status, p_data, length);
+        return;
+    }
+
+    if (m_batch_rsp.length + rsp_len > sizeof(m_batch_rsp.data))
+    {
+        batch_rsp_flush(SERIAL_STATUS_SUCCESS);
+    }
+
+    uint8_t * p_rsp = &m_batch_rsp.data[m_batch_rsp.length];
+    p_rsp[0] = rsp_len - SERIAL_PACKET_LENGTH_OVERHEAD;
+    p_rsp[1] = SERIAL_OPCODE_EVT_CMD_RSP;
+    p_rsp[2] = opcode;
+    p_rsp[3] = status;
+    if (p_data != NULL)
+    {
+        memcpy(&p_rsp[SERIAL_EVT_CMD_RSP_LEN_OVERHEAD], p_data, length);
+    }
+    m_batch_rsp.length += rsp_len;
+}
+
+static void cmd_dispatch(const serial_packet_t * p_cmd)
+{
+    uint8_t index = m_cmd_handler_index[p_cmd->opcode];
+    if (index == 0)
+    {
+        __LOG(LOG_SRC_SERIAL, LOG_LEVEL_WARN, "No handler for 0x%02x\n", p_cmd->opcode);
+        serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_CMD_UNKNOWN, NULL, 0);
+        return;
+    }
+
+#if NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+    /* Store the opcode, as the handler may modify the command buffer. */
+    uint8_t opcode = p_cmd->opcode;
+    timestamp_t start = timer_now();
+#endif
+
+    m_cmd_handlers[index - 1].handler(p_cmd);
+
+#if NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+    uint32_t latency_us = TIMER_DIFF(timer_now(), start);
+    cmd_latency_t * p_latency = &m_cmd_latency[opcode];
+    p_latency->count++;
+    p_latency->total_us += latency_us;
+    if (latency_us > p_latency->max_us)
+    {
+        p_latency->max_us = latency_us;
+    }
+#endif
+}
+
+static void handle_cmd_batch(const serial_packet_t * p_cmd)
+{
+    if (m_batch_rsp.active)
+    {
+        /* Batch commands can't be nested. */
+        serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_REJECTED, NULL, 0);
+        return;
+    }
+
+    m_batch_rsp.active = true;
+    m_batch_rsp.length = 0;
+
+    uint8_t status = SERIAL_STATUS_SUCCESS;
+    const uint8_t * p_commands = p_cmd->payload.cmd.device.batch.commands;
+    uint32_t commands_len = p_cmd->length - SERIAL_PACKET_LENGTH_OVERHEAD;
+    uint32_t offset = 0;
+
+    while (offset < commands_len)
+    {
+        uint32_t cmd_len = p_commands[offset] + SERIAL_PACKET_LENGTH_OVERHEAD;
+        if (p_commands[offset] < SERIAL_PACKET_LENGTH_OVERHEAD ||
+            offset + cmd_len > commands_len)
+        {
+            /* The rest of the batch can't be parsed. */
+            status = SERIAL_STATUS_ERROR_INVALID_LENGTH;
+            break;
+        }
+
+        memcpy(&m_batch_cmd, &p_commands[offset], cmd_len);
+        cmd_dispatch(&m_batch_cmd);
+        offset += cmd_len;
+    }
+
+    m_batch_rsp.active = false;
+    batch_rsp_flush(status);
+}
+
+static void serial_process_cmd(void * p_context __attribute((unused)))
+{
+    serial_packet_t packet_in;  /* Incoming packet */
+    m_cmd_handler_scheduled = false;
+
+    while (serial_bearer_rx_get(&packet_in))
+    {
+        cmd_dispatch(&packet_in);
     }
 }
 
@@ -141,6 +307,7 @@ uint32_t serial_init(void)
     else
     {
         serial_bearer_init();
+        cmd_handler_index_build();
         m_state = NRF_MESH_SERIAL_STATE_INITIALIZED;
         return NRF_SUCCESS;
     }
@@ -279,19 +446,33 @@ void serial_cmd_rsp_send(uint8_t opcode, uint8_t status, const uint8_t * p_data,
         return;
     }
 
-    serial_packet_t * p_rsp;
-    uint32_t err_code = serial_packet_buffer_get(SERIAL_EVT_CMD_RSP_LEN_OVERHEAD + length, &p_rsp);
-    if (err_code == NRF_SUCCESS)
+    if (m_batch_rsp.active)
     {
-        p_rsp->opcode = SERIAL_OPCODE_EVT_CMD_RSP;
-        p_rsp->payload.evt.cmd_rsp.opcode = opcode;
-        p_rsp->payload.evt.cmd_rsp.status = status;
+        batch_rsp_add(opcode, status, p_data, length);
+    }
+    else
+    {
+        cmd_rsp_tx(opcode, status, p_data, length);
+    }
+}
 
-        if (p_data != NULL)
-        {
-            memcpy(&p_rsp->payload.evt.cmd_rsp.data, p_data, length);
-        }
+uint32_t serial_cmd_latency_get(uint8_t opcode, serial_evt_cmd_rsp_data_cmd_latency_t * p_latency)
+{
+    NRF_MESH_ASSERT(p_latency != NULL);
+#if NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+    p_latency->opcode = opcode;
+    p_latency->count = m_cmd_latency[opcode].count;
+    p_latency->max_us = m_cmd_latency[opcode].max_us;
+    p_latency->total_us = m_cmd_latency[opcode].total_us;
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
 
-        (void) serial_tx(p_rsp);
-    }
+void serial_cmd_latency_clear(void)
+{
+#if NRF_MESH_SERIAL_CMD_LATENCY_ENABLE
+    memset(m_cmd_latency, 0, sizeof(m_cmd_latency));
+#endif
 }
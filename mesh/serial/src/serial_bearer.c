@@ -89,7 +89,12 @@ static uint32_t m_event_flag;
 static uint16_t m_ignore_rx_count;
 
 #ifdef SERIAL_SLIP_ENCODING
-static uint8_t m_tx_slip_byte;
+/* Worst case SLIP frame: every byte of the packet escaped, with an END byte on each side. */
+#define TX_FRAME_SIZE (2 * sizeof(serial_packet_t) + 2)
+
+/** SLIP encoded frame being transmitted. */
+static uint8_t m_tx_frame[TX_FRAME_SIZE];
+static uint16_t m_tx_frame_len;
 #endif
 
 /* Serial receive relies on the length field of a serial packet being the first byte and opcode being the second byte */
@@ -224,32 +229,79 @@ static inline void char_tx_simple(void)
 #endif
 
 #ifdef SERIAL_SLIP_ENCODING
-static inline bool valid_slip_byte(uint8_t byte_val)
+/** Word with all bytes set to the given value. */
+#define WORD_BYTES_REPEAT(byte) (0x01010101UL * (uint8_t) (byte))
+/** Non-zero if any of the bytes in the given word is zero. */
+#define WORD_HAS_ZERO_BYTE(word) (((word) - 0x01010101UL) & ~(word) & 0x80808080UL)
+
+static inline bool word_needs_escape(uint32_t word)
+{
+    return (WORD_HAS_ZERO_BYTE(word ^ WORD_BYTES_REPEAT(SLIP_END)) ||
+            WORD_HAS_ZERO_BYTE(word ^ WORD_BYTES_REPEAT(SLIP_ESC)));
+}
+
+static inline uint16_t slip_byte_encode(uint8_t * p_dst, uint8_t value)
 {
-    switch (byte_val)
+    switch (value)
     {
         case SLIP_END:
+            p_dst[0] = SLIP_ESC;
+            p_dst[1] = SLIP_ESC_END;
+            return 2;
         case SLIP_ESC:
-        case SLIP_ESC_END:
-        case SLIP_ESC_ESC:
-            return true;
+            p_dst[0] = SLIP_ESC;
+            p_dst[1] = SLIP_ESC_ESC;
+            return 2;
         default:
-            return false;
+            p_dst[0] = value;
+            return 1;
     }
 }
 
-static inline void slip_encoding_get(uint8_t * p_value, uint8_t * p_slip_byte)
+/**
+ * SLIP encodes a packet into a frame in a single pass, as specified by rfc1055.
+ *
+ * The packet is scanned a word at a time, and words without any bytes to escape are copied
+ * directly, as most packets only have a handful of bytes that need escaping.
+ *
+ * @param[out] p_frame  Frame buffer, must fit the worst case encoding of the packet.
+ * @param[in]  p_packet Packet to encode.
+ * @param[in]  length   Length of the packet.
+ *
+ * @return The length of the encoded frame, including the END bytes on each side.
+ */
+static uint16_t slip_frame_encode(uint8_t * p_frame, const uint8_t * p_packet, uint16_t length)
 {
-    if (SLIP_END == *p_value)
+    uint16_t frame_len = 0;
+    uint16_t i = 0;
+
+    p_frame[frame_len++] = SLIP_END;
+
+    for (; i + WORD_SIZE <= length; i += WORD_SIZE)
     {
-        *p_slip_byte = SLIP_ESC_END;
-        *p_value = SLIP_ESC;
+        uint32_t word;
+        memcpy(&word, &p_packet[i], WORD_SIZE);
+        if (word_needs_escape(word))
+        {
+            for (uint32_t j = 0; j < WORD_SIZE; ++j)
+            {
+                frame_len += slip_byte_encode(&p_frame[frame_len], p_packet[i + j]);
+            }
+        }
+        else
+        {
+            memcpy(&p_frame[frame_len], &word, WORD_SIZE);
+            frame_len += WORD_SIZE;
+        }
     }
-    else if (SLIP_ESC == *p_value)
+
+    for (; i < length; ++i)
     {
-        *p_slip_byte = SLIP_ESC_ESC;
-        *p_value = SLIP_ESC;
+        frame_len += slip_byte_encode(&p_frame[frame_len], p_packet[i]);
     }
+
+    p_frame[frame_len++] = SLIP_END;
+    return frame_len;
 }
 
 /**
@@ -304,25 +356,8 @@ static bool slip_decode(uint8_t * p_c, bool * p_skip_byte, uint8_t * p_prev_char
 
 static inline void char_tx_with_slip_encoding(void)
 {
-    if (valid_slip_byte(m_tx_slip_byte)) /* Did we store a slip byte during the previous tx? */
-    {
-        serial_uart_byte_send(m_tx_slip_byte);
-        m_tx_slip_byte = 0;
-    }
-    else if (m_cur_tx_packet_index == mp_current_tx_packet->size) /* Is it time to send the END byte? */
-    {
-        m_cur_tx_packet_index++;
-        packet_buffer_free(&m_tx_packet_buf, mp_current_tx_packet);
-        mp_current_tx_packet = NULL;
-        serial_uart_byte_send(SLIP_END);
-    }
-    else /* if (m_cur_tx_packet_index < mp_current_tx_packet->size) */
-    { /* Send the next byte in line, and store the slip byte if necessary */
-        uint8_t value = mp_current_tx_packet->packet[m_cur_tx_packet_index];
-        m_cur_tx_packet_index++;
-        slip_encoding_get(&value, &m_tx_slip_byte);
-        serial_uart_byte_send(value);
-    }
+    serial_uart_byte_send(m_tx_frame[m_cur_tx_packet_index]);
+    m_cur_tx_packet_index++;
 }
 
 static inline void char_rx_with_slip_encoding(uint16_t * p_rx_index, uint8_t byte_received)
@@ -381,7 +416,12 @@ static void char_tx(void)
 {
     /* Unexpected event */
     NRF_MESH_ASSERT(m_serial_state != SERIAL_STATE_IDLE);
+#ifdef SERIAL_SLIP_ENCODING
+    /* The packet is freed once it has been encoded, send until the end of the frame. */
+    if (m_cur_tx_packet_index == m_tx_frame_len)
+#else
     if (NULL == mp_current_tx_packet)
+#endif
     {
         /* We have nothing to send. */
         serial_uart_tx_stop();
@@ -406,8 +446,11 @@ static bool do_transmit(void)
         m_serial_state = SERIAL_STATE_TRANSMIT;
 
 #ifdef SERIAL_SLIP_ENCODING
-        serial_uart_byte_send(SLIP_END);
-        m_cur_tx_packet_index = 0;
+        m_tx_frame_len = slip_frame_encode(m_tx_frame, mp_current_tx_packet->packet, mp_current_tx_packet->size);
+        packet_buffer_free(&m_tx_packet_buf, mp_current_tx_packet);
+        mp_current_tx_packet = NULL;
+        serial_uart_byte_send(m_tx_frame[0]);
+        m_cur_tx_packet_index = 1;
 #else
         uint8_t value = mp_current_tx_packet->packet[0];
         serial_uart_byte_send(value);
@@ -431,7 +474,7 @@ void serial_bearer_init(void)
     m_stored_pac_len = 0;
     m_cur_tx_packet_index = 0;
 #ifdef SERIAL_SLIP_ENCODING
-    m_tx_slip_byte = 0;
+    m_tx_frame_len = 0;
 #endif
 
     m_event_flag = bearer_event_flag_add(do_transmit);
@@ -278,9 +278,17 @@ static void handle_cmd_hk_data_get(const serial_packet_t * p_cmd)
 static void handle_cmd_hk_data_clear(const serial_packet_t * p_cmd)
 {
     memset(&m_hk_data, 0, sizeof(m_hk_data));
+    serial_cmd_latency_clear();
     serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
 }
 
+static void handle_cmd_cmd_latency_get(const serial_packet_t * p_cmd)
+{
+    serial_evt_cmd_rsp_data_cmd_latency_t rsp;
+    uint32_t status = serial_cmd_latency_get(p_cmd->payload.cmd.device.cmd_latency_get.opcode, &rsp);
+    serial_handler_common_cmd_rsp_nodata_on_error(p_cmd->opcode, status, (const uint8_t *) &rsp, sizeof(rsp));
+}
+
 
 /* Serial command handler lookup table. */
 static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
@@ -296,6 +304,7 @@ static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
     {SERIAL_OPCODE_CMD_DEVICE_BEACON_PARAMS_GET,       sizeof(serial_cmd_device_beacon_params_get_t),                  0, handle_cmd_device_beacon_params_get},
     {SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_GET,   0,                                                              0, handle_cmd_hk_data_get},
     {SERIAL_OPCODE_CMD_DEVICE_HOUSEKEEPING_DATA_CLEAR, 0,                                                              0, handle_cmd_hk_data_clear},
+    {SERIAL_OPCODE_CMD_DEVICE_CMD_LATENCY_GET,         sizeof(serial_cmd_device_cmd_latency_get_t),                    0, handle_cmd_cmd_latency_get},
 };
 
 /*****************************************************************************
@@ -60,6 +60,9 @@ static bool                       m_scanning_running;
 static nrf_mesh_prov_ctx_t        m_prov_contexts[CONFIG_NUM_PROV_CONTEXTS];
 static uint8_t                    m_public_key[NRF_MESH_ECDH_PUBLIC_KEY_SIZE];
 static uint8_t                    m_private_key[NRF_MESH_ECDH_PRIVATE_KEY_SIZE];
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+static bool                       m_keypair_set_by_host;
+#endif
 static nrf_mesh_prov_oob_caps_t   m_provisioning_caps;
 static nrf_mesh_prov_bearer_adv_t m_pb_adv_contexts[CONFIG_NUM_PROV_CONTEXTS];
 
@@ -262,6 +265,35 @@ static void serial_handler_prov_evt_in(const nrf_mesh_prov_evt_t * p_evt)
     }
 }
 
+/* Draws a fresh keypair from the keypair pool for the next session. The current keypair is kept if
+ * the host has set it, or if another session is still using it. */
+static void session_keys_refresh(void)
+{
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+    if (m_keypair_set_by_host)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < CONFIG_NUM_PROV_CONTEXTS; ++i)
+    {
+        if (m_prov_contexts[i].state != NRF_MESH_PROV_STATE_IDLE)
+        {
+            return;
+        }
+    }
+
+    uint8_t public_key[NRF_MESH_ECDH_PUBLIC_KEY_SIZE];
+    uint8_t private_key[NRF_MESH_ECDH_PRIVATE_KEY_SIZE];
+    if (nrf_mesh_prov_generate_keys(public_key, private_key) == NRF_SUCCESS)
+    {
+        memcpy(m_public_key, public_key, NRF_MESH_ECDH_PUBLIC_KEY_SIZE);
+        memcpy(m_private_key, private_key, NRF_MESH_ECDH_PRIVATE_KEY_SIZE);
+    }
+    memset(private_key, 0, sizeof(private_key));
+#endif
+}
+
 uint32_t serial_handler_prov_init(void)
 {
     __LOG(LOG_SRC_SERIAL, LOG_LEVEL_INFO, "Generating encryption keypair...\n");
@@ -316,6 +348,7 @@ void serial_handler_prov_pkt_in(const serial_packet_t * p_incoming)
                 prov_data.flags.iv_update = p_incoming->payload.cmd.prov.data.iv_update_flag & 0x01;
                 prov_data.flags.key_refresh = p_incoming->payload.cmd.prov.data.key_refresh_flag & 0x01;
 
+                session_keys_refresh();
                 status =
                     nrf_mesh_prov_init(&m_prov_contexts[p_incoming->payload.cmd.prov.data.context_id],
                                        m_public_key, m_private_key, &m_provisioning_caps, serial_handler_prov_evt_in);
@@ -339,6 +372,7 @@ void serial_handler_prov_pkt_in(const serial_packet_t * p_incoming)
         case SERIAL_OPCODE_CMD_PROV_LISTEN:
         {
             /* Default to context 0. */
+            session_keys_refresh();
             uint32_t status = nrf_mesh_prov_init(&m_prov_contexts[0], m_public_key, m_private_key, &m_provisioning_caps, serial_handler_prov_evt_in);
             if (status == NRF_SUCCESS)
             {
@@ -403,6 +437,9 @@ void serial_handler_prov_pkt_in(const serial_packet_t * p_incoming)
         {
             memcpy(m_private_key, p_incoming->payload.cmd.prov.keypair.private_key, NRF_MESH_ECDH_PRIVATE_KEY_SIZE);
             memcpy(m_public_key,  p_incoming->payload.cmd.prov.keypair.public_key,  NRF_MESH_ECDH_PUBLIC_KEY_SIZE);
+#if NRF_MESH_PROV_KEYPOOL_SIZE > 0
+            m_keypair_set_by_host = true;
+#endif
             serial_cmd_rsp_send(p_incoming->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
             break;
         }
@@ -0,0 +1,185 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "serial_handler_stats.h"
+
+#include <string.h>
+#include "serial.h"
+#include "serial_status.h"
+#include "serial_handler_common.h"
+#include "nrf_mesh_assert.h"
+#include "perf_counter.h"
+#include "heartbeat_collector.h"
+#include "timer.h"
+#include "utils.h"
+
+NRF_MESH_STATIC_ASSERT(SERIAL_EVT_CMD_RSP_DATA_STATS_HISTOGRAM_BUCKETS == PERF_HISTOGRAM_BUCKET_COUNT);
+NRF_MESH_STATIC_ASSERT(PERF_COUNTER__LAST <= UINT8_MAX);
+#if HEARTBEAT_COLLECTOR_SIZE > 0
+NRF_MESH_STATIC_ASSERT(HEARTBEAT_COLLECTOR_RSSI_INVALID == 127);
+#endif
+
+/*****************************************************************************
+* Static functions
+*****************************************************************************/
+static void handle_cmd_counters_get(const serial_packet_t * p_cmd)
+{
+    const serial_cmd_stats_counters_get_t * p_params = &p_cmd->payload.cmd.stats.counters_get;
+    serial_evt_cmd_rsp_data_stats_counters_t rsp;
+
+    if (p_params->first >= PERF_COUNTER__LAST)
+    {
+        serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_ERROR_INVALID_PARAMETER, NULL, 0);
+        return;
+    }
+
+    rsp.total_count = PERF_COUNTER__LAST;
+    rsp.first = p_params->first;
+    rsp.count = MIN(MIN(p_params->count, ARRAY_SIZE(rsp.values)), PERF_COUNTER__LAST - p_params->first);
+
+    /* The response is packed, fetch the values into an aligned buffer first. */
+    uint32_t values[ARRAY_SIZE(rsp.values)];
+    uint32_t status = perf_counters_get(rsp.first, rsp.count, values);
+    memcpy(rsp.values, values, rsp.count * sizeof(uint32_t));
+    serial_handler_common_cmd_rsp_nodata_on_error(p_cmd->opcode,
+                                                  status,
+                                                  (const uint8_t *) &rsp,
+                                                  SERIAL_EVT_CMD_RSP_DATA_STATS_COUNTERS_OVERHEAD + rsp.count * sizeof(uint32_t));
+}
+
+static void handle_cmd_histogram_get(const serial_packet_t * p_cmd)
+{
+    serial_evt_cmd_rsp_data_stats_histogram_t rsp;
+    perf_histogram_t histogram;
+
+    rsp.histogram = p_cmd->payload.cmd.stats.histogram_get.histogram;
+    uint32_t status = perf_histogram_get((perf_histogram_id_t) rsp.histogram, &histogram);
+    if (status == NRF_SUCCESS)
+    {
+        rsp.max = histogram.max;
+        memcpy(rsp.buckets, histogram.buckets, sizeof(rsp.buckets));
+    }
+
+    serial_handler_common_cmd_rsp_nodata_on_error(p_cmd->opcode, status, (const uint8_t *) &rsp, sizeof(rsp));
+}
+
+static void handle_cmd_clear(const serial_packet_t * p_cmd)
+{
+    perf_counter_clear();
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
+}
+
+#if HEARTBEAT_COLLECTOR_SIZE > 0
+static void hb_source_serialize(const heartbeat_collector_entry_t * p_entry,
+                                timestamp_t now,
+                                serial_evt_cmd_rsp_data_stats_hb_source_t * p_source)
+{
+    p_source->src      = p_entry->src;
+    p_source->count    = p_entry->count;
+    p_source->features = p_entry->features;
+    p_source->hops     = p_entry->hops;
+    p_source->min_hops = p_entry->min_hops;
+    p_source->max_hops = p_entry->max_hops;
+    p_source->rssi     = p_entry->rssi;
+    p_source->age_ms   = (now - p_entry->last_seen) / 1000;
+}
+
+static void handle_cmd_hb_source_get(const serial_packet_t * p_cmd)
+{
+    serial_evt_cmd_rsp_data_stats_hb_source_t rsp;
+    heartbeat_collector_entry_t entry;
+
+    uint32_t status = heartbeat_collector_get(p_cmd->payload.cmd.stats.hb_source_get.src, &entry);
+    if (status == NRF_SUCCESS)
+    {
+        hb_source_serialize(&entry, timer_now(), &rsp);
+    }
+
+    serial_handler_common_cmd_rsp_nodata_on_error(p_cmd->opcode, status, (const uint8_t *) &rsp, sizeof(rsp));
+}
+
+static void handle_cmd_hb_sources_list(const serial_packet_t * p_cmd)
+{
+    serial_evt_cmd_rsp_data_stats_hb_sources_t rsp;
+    heartbeat_collector_entry_t entries[ARRAY_SIZE(rsp.sources)];
+    uint16_t index = p_cmd->payload.cmd.stats.hb_sources_list.index;
+    uint16_t count = ARRAY_SIZE(entries);
+
+    heartbeat_collector_entries_get(&index, entries, &count);
+
+    timestamp_t now = timer_now();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        hb_source_serialize(&entries[i], now, &rsp.sources[i]);
+    }
+
+    rsp.total_count = heartbeat_collector_source_count_get();
+    rsp.next_index = index;
+    rsp.count = count;
+    serial_cmd_rsp_send(p_cmd->opcode,
+                        SERIAL_STATUS_SUCCESS,
+                        (const uint8_t *) &rsp,
+                        SERIAL_EVT_CMD_RSP_DATA_STATS_HB_SOURCES_OVERHEAD + count * sizeof(rsp.sources[0]));
+}
+
+static void handle_cmd_hb_sources_clear(const serial_packet_t * p_cmd)
+{
+    heartbeat_collector_clear();
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
+}
+#endif
+
+/* Serial command handler lookup table. */
+static const serial_handler_common_opcode_to_fp_map_t m_cmd_handlers[] =
+{
+    {SERIAL_OPCODE_CMD_STATS_COUNTERS_GET,     sizeof(serial_cmd_stats_counters_get_t),    0, handle_cmd_counters_get},
+    {SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET,    sizeof(serial_cmd_stats_histogram_get_t),   0, handle_cmd_histogram_get},
+    {SERIAL_OPCODE_CMD_STATS_CLEAR,            0,                                          0, handle_cmd_clear},
+#if HEARTBEAT_COLLECTOR_SIZE > 0
+    {SERIAL_OPCODE_CMD_STATS_HB_SOURCE_GET,    sizeof(serial_cmd_stats_hb_source_get_t),   0, handle_cmd_hb_source_get},
+    {SERIAL_OPCODE_CMD_STATS_HB_SOURCES_LIST,  sizeof(serial_cmd_stats_hb_sources_list_t), 0, handle_cmd_hb_sources_list},
+    {SERIAL_OPCODE_CMD_STATS_HB_SOURCES_CLEAR, 0,                                          0, handle_cmd_hb_sources_clear},
+#endif
+};
+
+/*****************************************************************************
+* Interface functions
+*****************************************************************************/
+void serial_handler_stats_rx(const serial_packet_t * p_cmd)
+{
+    serial_handler_common_rx(p_cmd, m_cmd_handlers, ARRAY_SIZE(m_cmd_handlers));
+}
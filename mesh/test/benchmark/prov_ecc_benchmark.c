@@ -0,0 +1,212 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * Host benchmark of the provisioning ECC backends.
+ *
+ * Times keypair generation, public key validation and ECDH shared secret calculation through the
+ * @ref nrf_mesh_prov_ecc_backend_t interface, and checks every backend's shared secrets against
+ * micro-ecc. The build makes one binary per micro-ecc configuration, see the CMakeLists.txt in this
+ * directory. To benchmark another backend, add it to @c m_backends.
+ *
+ * Usage: prov_ecc_benchmark_<config> [iterations]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <nrf_error.h>
+
+#include "nrf_mesh_prov_types.h"
+#include "uECC.h"
+
+#ifndef PROV_ECC_BENCHMARK_CONFIG
+#define PROV_ECC_BENCHMARK_CONFIG "default"
+#endif
+
+/** Number of runs of each operation, unless given on the command line. */
+#define ITERATIONS_DEFAULT (100)
+
+typedef struct
+{
+    const char * p_name;
+    const nrf_mesh_prov_ecc_backend_t * p_backend;
+} backend_entry_t;
+
+typedef struct
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+} keypair_t;
+
+/* Same wrapping of micro-ecc as the default backend in prov_utils.c. */
+static uint32_t uecc_keys_generate(uint8_t * p_public, uint8_t * p_private)
+{
+    return uECC_make_key(p_public, p_private, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
+}
+
+static uint32_t uecc_shared_secret_calculate(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared)
+{
+    return uECC_shared_secret(p_peer_public, p_private, p_shared, uECC_secp256r1()) == 1 ? NRF_SUCCESS : NRF_ERROR_INTERNAL;
+}
+
+static bool uecc_public_key_is_valid(const uint8_t * p_public)
+{
+    return uECC_valid_public_key(p_public, uECC_secp256r1());
+}
+
+static const nrf_mesh_prov_ecc_backend_t m_uecc_backend =
+{
+    .keys_generate = uecc_keys_generate,
+    .shared_secret_calculate = uecc_shared_secret_calculate,
+    .public_key_is_valid = uecc_public_key_is_valid
+};
+
+static const backend_entry_t m_backends[] =
+{
+    {"uECC", &m_uecc_backend},
+};
+
+static uint64_t time_us_get(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000ull + (uint64_t) now.tv_nsec / 1000ull;
+}
+
+static void result_print(const char * p_backend_name, const char * p_operation, uint64_t elapsed_us, uint32_t iterations)
+{
+    printf("%-12s %-10s %-14s %10.1f us/op\n",
+           PROV_ECC_BENCHMARK_CONFIG,
+           p_backend_name,
+           p_operation,
+           (double) elapsed_us / iterations);
+}
+
+/* Runs all operations on the given backend. Returns false if the backend failed or disagreed with micro-ecc. */
+static bool backend_run(const backend_entry_t * p_entry, keypair_t * p_keys, uint32_t iterations)
+{
+    const nrf_mesh_prov_ecc_backend_t * p_backend = p_entry->p_backend;
+
+    uint64_t start = time_us_get();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        if (p_backend->keys_generate(p_keys[i].public_key, p_keys[i].private_key) != NRF_SUCCESS)
+        {
+            printf("%s: keypair generation failed\n", p_entry->p_name);
+            return false;
+        }
+    }
+    result_print(p_entry->p_name, "keygen", time_us_get() - start, iterations);
+
+    start = time_us_get();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        if (!p_backend->public_key_is_valid(p_keys[i].public_key))
+        {
+            printf("%s: generated public key is invalid\n", p_entry->p_name);
+            return false;
+        }
+    }
+    result_print(p_entry->p_name, "validate", time_us_get() - start, iterations);
+
+    /* Pair each key with the next one, as a provisioner and a device would. */
+    uint8_t shared_secret[NRF_MESH_PROV_ECDHSECRET_SIZE];
+    start = time_us_get();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        const keypair_t * p_peer = &p_keys[(i + 1) % iterations];
+        if (p_backend->shared_secret_calculate(p_peer->public_key, p_keys[i].private_key, shared_secret) != NRF_SUCCESS)
+        {
+            printf("%s: shared secret calculation failed\n", p_entry->p_name);
+            return false;
+        }
+    }
+    result_print(p_entry->p_name, "ecdh", time_us_get() - start, iterations);
+
+    /* Both sides must end up with the same secret, and micro-ecc must agree with it. */
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        const keypair_t * p_peer = &p_keys[(i + 1) % iterations];
+        uint8_t local_secret[NRF_MESH_PROV_ECDHSECRET_SIZE];
+        uint8_t peer_secret[NRF_MESH_PROV_ECDHSECRET_SIZE];
+        uint8_t reference_secret[NRF_MESH_PROV_ECDHSECRET_SIZE];
+        if (p_backend->shared_secret_calculate(p_peer->public_key, p_keys[i].private_key, local_secret) != NRF_SUCCESS ||
+            p_backend->shared_secret_calculate(p_keys[i].public_key, p_peer->private_key, peer_secret) != NRF_SUCCESS ||
+            uecc_shared_secret_calculate(p_peer->public_key, p_keys[i].private_key, reference_secret) != NRF_SUCCESS ||
+            memcmp(local_secret, peer_secret, sizeof(local_secret)) != 0 ||
+            memcmp(local_secret, reference_secret, sizeof(local_secret)) != 0)
+        {
+            printf("%s: shared secret mismatch\n", p_entry->p_name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t iterations = ITERATIONS_DEFAULT;
+    if (argc > 1)
+    {
+        iterations = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    if (iterations < 2)
+    {
+        printf("Usage: %s [iterations >= 2]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    keypair_t * p_keys = malloc(iterations * sizeof(keypair_t));
+    if (p_keys == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    bool success = true;
+    for (uint32_t i = 0; i < sizeof(m_backends) / sizeof(m_backends[0]) && success; ++i)
+    {
+        success = backend_run(&m_backends[i], p_keys, iterations);
+    }
+
+    free(p_keys);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2425,3 +2425,59 @@ void test_access_model_publish_period_divisor_set(void)
     access_publish_period_set_IgnoreArg_p_pubstate();
     TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_publish_period_divisor_set(handle0, 100));
 }
+
+void test_revisions(void)
+{
+    uint32_t composition_revision = access_composition_revision_get();
+    uint32_t lists_revision = access_model_lists_revision_get();
+
+    access_model_handle_t handle;
+    access_model_add_params_t init_params;
+    init_params.element_index = 0;
+    init_params.model_id.model_id = TEST_MODEL_ID;
+    init_params.model_id.company_id = ACCESS_COMPANY_ID_NONE;
+    init_params.p_opcode_handlers = &m_opcode_handlers[0][0];
+    init_params.opcode_count = OPCODE_COUNT;
+    init_params.p_args = TEST_REFERENCE;
+    init_params.publish_timeout_cb = publish_timeout_cb;
+
+    /* Adding a model changes the composition */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_add(&init_params, &handle));
+    TEST_ASSERT_NOT_EQUAL(composition_revision, access_composition_revision_get());
+    composition_revision = access_composition_revision_get();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_element_location_set(0, 0x0103));
+    TEST_ASSERT_NOT_EQUAL(composition_revision, access_composition_revision_get());
+    composition_revision = access_composition_revision_get();
+
+    /* Setting the same location again does not change anything */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_element_location_set(0, 0x0103));
+    TEST_ASSERT_EQUAL(composition_revision, access_composition_revision_get());
+
+    lists_revision = access_model_lists_revision_get();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_subscription_list_alloc(handle));
+    TEST_ASSERT_NOT_EQUAL(lists_revision, access_model_lists_revision_get());
+    lists_revision = access_model_lists_revision_get();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_subscription_add(handle, 1));
+    TEST_ASSERT_NOT_EQUAL(lists_revision, access_model_lists_revision_get());
+    lists_revision = access_model_lists_revision_get();
+
+    /* Adding an existing subscription does not change anything */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_subscription_add(handle, 1));
+    TEST_ASSERT_EQUAL(lists_revision, access_model_lists_revision_get());
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_subscription_remove(handle, 1));
+    TEST_ASSERT_NOT_EQUAL(lists_revision, access_model_lists_revision_get());
+    lists_revision = access_model_lists_revision_get();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_application_bind(handle, 0));
+    TEST_ASSERT_NOT_EQUAL(lists_revision, access_model_lists_revision_get());
+    lists_revision = access_model_lists_revision_get();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, access_model_application_unbind(handle, 0));
+    TEST_ASSERT_NOT_EQUAL(lists_revision, access_model_lists_revision_get());
+
+    /* Model list changes do not affect the composition */
+    TEST_ASSERT_EQUAL(composition_revision, access_composition_revision_get());
+}
@@ -49,12 +49,13 @@
 #include "scanner_mock.h"
 #include "nrf_mesh_cmsis_mock_mock.h"
 
-#define DEFAULT_ACTION {action_start_cb, action_radio_irq_handler, NULL, 1000, NULL, {NULL, NULL}}
+#define DEFAULT_ACTION {action_start_cb, action_radio_irq_handler, NULL, 1000, NULL, BEARER_ACTION_TYPE_OTHER, NULL, {NULL, NULL}}
 
 static void* mp_expected_args;
 static ts_timestamp_t m_time_now;
 static uint32_t m_expected_start_calls;
 static uint32_t m_expected_radio_irq_calls;
+static uint32_t m_expected_pack_calls;
 static uint32_t m_expected_stop_cb;static bool m_end_action;
 static NRF_RADIO_Type m_radio;
 static NRF_TIMER_Type m_action_timer;
@@ -76,6 +77,7 @@ void setUp(void)
 
     m_expected_start_calls = 0;
     m_expected_radio_irq_calls = 0;
+    m_expected_pack_calls = 0;
     mp_expected_args = NULL;
     m_end_action = false;
 
@@ -126,6 +128,22 @@ static void action_radio_irq_handler(void* p_args)
     }
 }
 
+/** Packs any action that fits in the time limit, by adding its duration to the current action. */
+static bool action_pack_cb(void* p_args, const bearer_action_t* p_next, ts_timestamp_t max_duration_us)
+{
+    TEST_ASSERT_EQUAL(mp_expected_args, p_args);
+    TEST_ASSERT_NOT_EQUAL(0, m_expected_pack_calls);
+    m_expected_pack_calls--;
+
+    bearer_action_t * p_action = (bearer_action_t *) p_args;
+    if (p_action->duration_us + p_next->duration_us > max_duration_us)
+    {
+        return false;
+    }
+    p_action->duration_us += p_next->duration_us;
+    return true;
+}
+
 static void stop_cb(void)
 {
     TEST_ASSERT_NOT_EQUAL(0, m_expected_stop_cb);
@@ -445,6 +463,58 @@ void test_end_action(void)
     TEST_NRF_MESH_ASSERT_EXPECT(bearer_handler_action_end());
 }
 
+void test_pack_actions(void)
+{
+    bearer_action_t action[3];
+    m_setup_actions(action, 3);
+    action[0].pack_cb = action_pack_cb;
+    action[1].queue_elem.p_data = &action[1];
+    action[2].queue_elem.p_data = &action[2];
+    action[2].duration_us = 3000;
+
+    /* The first action packs the second, but there's no time left for the third. */
+    m_time_now = 1000;
+    m_expected_start_calls = 1;
+    m_expected_pack_calls = 2;
+    mp_expected_args = &action[0];
+    timeslot_is_in_cb_ExpectAndReturn(true);
+    timeslot_end_is_pending_ExpectAndReturn(false);
+    m_action_pop_Expect(&action[0], 1000);
+    timeslot_remaining_time_get_ExpectAndReturn(2500 + BEARER_ACTION_POST_PROCESS_TIME_US);
+    queue_peek_ExpectAnyArgsAndReturn(&action[1].queue_elem);
+    queue_pop_ExpectAnyArgsAndReturn(&action[1].queue_elem);
+    queue_peek_ExpectAnyArgsAndReturn(&action[2].queue_elem);
+    m_radio_irq_clear_expect();
+    m_timer_setup_expect(m_time_now);
+    timeslot_state_lock_Expect(true);
+
+    bearer_handler_timer_irq_handler();
+    TEST_ASSERT_EQUAL(0, m_expected_start_calls);
+    TEST_ASSERT_EQUAL(0, m_expected_pack_calls);
+    TEST_ASSERT_EQUAL(2000, action[0].duration_us);
+    TEST_ASSERT_NULL(action[0].queue_elem.p_data);
+    TEST_ASSERT_NULL(action[1].queue_elem.p_data);
+    TEST_ASSERT_EQUAL_PTR(&action[2], action[2].queue_elem.p_data);
+
+    /* The packed action may run for the combined duration, after which the third action starts. */
+    m_time_now = 2900;
+    timeslot_is_in_cb_ExpectAndReturn(true);
+    m_action_end_expect();
+    m_action_start_expect(&action[2], m_time_now, 3000);
+
+    bearer_handler_action_end();
+    TEST_ASSERT_EQUAL(0, m_expected_start_calls);
+
+    /* Actions without a packing function don't look further into the queue. */
+    m_time_now = 5800;
+    timeslot_is_in_cb_ExpectAndReturn(true);
+    m_action_end_expect();
+    m_action_start_expect(&action[1], m_time_now, 1000);
+
+    bearer_handler_action_end();
+    TEST_ASSERT_EQUAL(0, m_expected_start_calls);
+}
+
 void test_fire_action(void)
 {
     bearer_action_t action[2];
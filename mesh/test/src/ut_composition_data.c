@@ -95,10 +95,10 @@ static uint32_t element_models_get_cb(uint16_t element_index,
 {
     TEST_ASSERT(SIG_MODELS_COUNT + VENDOR_MODELS_COUNT <= *p_size);
     *p_size = 0;
-    if (num_calls == 0)
+    /* The stub call counter keeps counting when the composition data is rebuilt. */
+    if (element_index == 0)
     {
-        TEST_ASSERT_EQUAL(0, element_index);
-        TEST_ASSERT_EQUAL(0, num_calls);
+        TEST_ASSERT_EQUAL(0, num_calls % 2);
         for (uint32_t i = 0; i < SIG_MODELS_COUNT+VENDOR_MODELS_COUNT; ++i)
         {
             (*p_size)++;
@@ -108,7 +108,7 @@ static uint32_t element_models_get_cb(uint16_t element_index,
     else
     {
         TEST_ASSERT_EQUAL(1, element_index);
-        TEST_ASSERT_EQUAL(1, num_calls);
+        TEST_ASSERT_EQUAL(1, num_calls % 2);
     }
 
     TEST_ASSERT(p_size != NULL);
@@ -124,19 +124,11 @@ void tearDown(void)
 {
 }
 
-void test_composition_data(void)
+static void composition_data_expect(void)
 {
-    uint8_t data[CONFIG_COMPOSITION_DATA_SIZE + 3];
-    uint8_t sig_models_count0 = SIG_MODELS_COUNT;
-    uint8_t vendor_models_count0 = VENDOR_MODELS_COUNT;
-    uint16_t location0 = ELEMENT_LOCATION;
-    uint16_t size = 0;
-
-    printf("ACCESS_ELEMENT_COUNT: %d\n", ACCESS_ELEMENT_COUNT);
-
-    /* Test with an invalid size: */
-    TEST_NRF_MESH_ASSERT_EXPECT(config_composition_data_get(data, &size));
-    TEST_NRF_MESH_ASSERT_EXPECT(config_composition_data_get(NULL, NULL));
+    static uint8_t sig_models_count0 = SIG_MODELS_COUNT;
+    static uint8_t vendor_models_count0 = VENDOR_MODELS_COUNT;
+    static uint16_t location0 = ELEMENT_LOCATION;
 
     /* Element 0 */
     access_element_sig_model_count_get_ExpectAndReturn(0, NULL, ACCESS_STATUS_SUCCESS);
@@ -155,22 +147,37 @@ void test_composition_data(void)
     access_element_models_get_StubWithCallback(element_models_get_cb);
 
     /* Element 1: no models */
-    uint8_t sig_models_count1 = 0;
+    static uint8_t sig_models_count1 = 0;
     access_element_sig_model_count_get_ExpectAndReturn(1, NULL, ACCESS_STATUS_SUCCESS);
     access_element_sig_model_count_get_IgnoreArg_p_sig_model_count();
     access_element_sig_model_count_get_ReturnThruPtr_p_sig_model_count(&sig_models_count1);
 
-    uint8_t vendor_models_count1 = 0;
+    static uint8_t vendor_models_count1 = 0;
     access_element_vendor_model_count_get_ExpectAndReturn(1, NULL, ACCESS_STATUS_SUCCESS);
     access_element_vendor_model_count_get_IgnoreArg_p_vendor_model_count();
     access_element_vendor_model_count_get_ReturnThruPtr_p_vendor_model_count(&vendor_models_count1);
 
-    uint16_t location1 = 0x0000;  /* Default uninitialized value */
+    static uint16_t location1 = 0x0000;  /* Default uninitialized value */
     access_element_location_get_ExpectAndReturn(1, NULL, ACCESS_STATUS_SUCCESS);
     access_element_location_get_IgnoreArg_p_location();
     access_element_location_get_ReturnThruPtr_p_location(&location1);
 
     access_element_models_get_StubWithCallback(element_models_get_cb);
+}
+
+void test_composition_data(void)
+{
+    uint8_t data[CONFIG_COMPOSITION_DATA_SIZE + 3];
+    uint16_t size = 0;
+
+    printf("ACCESS_ELEMENT_COUNT: %d\n", ACCESS_ELEMENT_COUNT);
+
+    /* Test with an invalid size: */
+    TEST_NRF_MESH_ASSERT_EXPECT(config_composition_data_get(data, &size));
+    TEST_NRF_MESH_ASSERT_EXPECT(config_composition_data_get(NULL, NULL));
+
+    access_composition_revision_get_ExpectAndReturn(1);
+    composition_data_expect();
 
     /* Get the composition data: */
     size = sizeof(data);
@@ -178,5 +185,23 @@ void test_composition_data(void)
     TEST_ASSERT_EQUAL_HEX8_ARRAY(composition_data, data, sizeof(composition_data));
 
     TEST_ASSERT_EQUAL(sizeof(composition_data), size);
-}
+    access_config_mock_Verify();
+
+    /* The composition is unchanged, so the cached data is returned without asking the access layer: */
+    memset(data, 0, sizeof(data));
+    size = sizeof(data);
+    access_composition_revision_get_ExpectAndReturn(1);
+    config_composition_data_get(data, &size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(composition_data, data, sizeof(composition_data));
+    TEST_ASSERT_EQUAL(sizeof(composition_data), size);
+    access_config_mock_Verify();
 
+    /* The composition has changed, so the data is rebuilt: */
+    memset(data, 0, sizeof(data));
+    size = sizeof(data);
+    access_composition_revision_get_ExpectAndReturn(2);
+    composition_data_expect();
+    config_composition_data_get(data, &size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(composition_data, data, sizeof(composition_data));
+    TEST_ASSERT_EQUAL(sizeof(composition_data), size);
+}
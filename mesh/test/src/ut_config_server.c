@@ -151,6 +151,9 @@ static dsm_handle_t * mp_access_model_applications_get_appkey_array;
 static uint16_t m_access_model_applications_get_appkey_count;
 static uint32_t m_access_model_applications_get_retval;
 
+static uint32_t m_model_lists_revision;
+static bool m_model_lists_revision_frozen;
+
 static nrf_mesh_evt_handler_t *mp_mesh_evt_handler;
 
 MOCK_QUEUE_DEF(config_server_evt_mock, config_server_evt_t, NULL);
@@ -236,6 +239,16 @@ static uint32_t access_model_subscriptions_get_mock(access_model_handle_t handle
     return m_access_model_subscriptions_get_retval;
 }
 
+/* Returns a new revision on every call unless frozen, so that the cached model lists are not used. */
+static uint32_t access_model_lists_revision_get_mock(int num_calls)
+{
+    if (!m_model_lists_revision_frozen)
+    {
+        m_model_lists_revision++;
+    }
+    return m_model_lists_revision;
+}
+
 static uint32_t access_model_applications_get_mock(access_model_handle_t handle,
                                                    dsm_handle_t * p_appkey_handles, uint16_t * p_count, int calls)
 {
@@ -329,6 +342,8 @@ void setUp(void)
 
     access_model_add_StubWithCallback(access_model_add_mock);
     access_model_reply_StubWithCallback(access_model_reply_mock);
+    m_model_lists_revision_frozen = false;
+    access_model_lists_revision_get_StubWithCallback(access_model_lists_revision_get_mock);
 
     heartbeat_public_info_getter_register_ExpectAnyArgs();
     nrf_mesh_evt_handler_add_StubWithCallback(nrf_mesh_evt_handler_add_mock);
@@ -2186,6 +2201,85 @@ void test_sig_model_subscription_get(void)
     }
 }
 
+void test_sig_model_subscription_get_cached(void)
+{
+    config_server_evt_t evt;
+    memset(&evt, 0, sizeof(config_server_evt_t));
+    evt.type = CONFIG_SERVER_EVT_SIG_MODEL_SUBSCRIPTION_GET;
+    const config_msg_model_subscription_get_t message =
+    {
+        .element_address = 0x6411,
+        .model_id.sig.model_id = 0x1144
+    };
+    uint16_t element_index = 2;
+    access_model_handle_t model_handle = 0x9c21;
+    dsm_handle_t subscriptions[] = { 1, 22, 882 };
+    uint16_t subscription_count = ARRAY_SIZE(subscriptions);
+    nrf_mesh_address_t addr[ARRAY_SIZE(subscriptions)];
+
+    m_model_lists_revision_frozen = true;
+
+    /* The first request builds the list: */
+    EXPECT_DSM_LOCAL_UNICAST_ADDRESSES_GET(message.element_address, element_index);
+    access_handle_get_ExpectAnyArgsAndReturn(NRF_SUCCESS);
+    access_handle_get_IgnoreArg_p_handle();
+    access_handle_get_ReturnThruPtr_p_handle(&model_handle);
+    access_model_subscriptions_get_StubWithCallback(access_model_subscriptions_get_mock);
+    ACCESS_MODEL_SUBSCRIPTIONS_GET_MOCK_SETUP(model_handle, subscriptions,
+                                              subscription_count, NRF_SUCCESS);
+    for (uint8_t itr = 0; itr < ARRAY_SIZE(subscriptions); itr++)
+    {
+        addr[itr].type = NRF_MESH_ADDRESS_TYPE_GROUP;
+        addr[itr].value = subscriptions[itr];
+        dsm_address_get_ExpectAnyArgsAndReturn(NRF_SUCCESS);
+        dsm_address_get_ReturnThruPtr_p_address(&addr[itr]);
+    }
+    evt.params.model_subscription_get.model_handle = model_handle;
+    config_server_evt_mock_Expect(&evt);
+    send_message(CONFIG_OPCODE_SIG_MODEL_SUBSCRIPTION_GET, (const uint8_t *) &message, sizeof(message) - sizeof(uint16_t));
+    TEST_ASSERT_TRUE(m_previous_reply_received);
+    access_config_mock_Verify();
+    device_state_manager_mock_Verify();
+
+    /* The lists are unchanged, so the second request is served from the cache: */
+    m_previous_reply_received = false;
+    access_model_subscriptions_get_StubWithCallback(NULL);
+    EXPECT_DSM_LOCAL_UNICAST_ADDRESSES_GET(message.element_address, element_index);
+    access_handle_get_ExpectAnyArgsAndReturn(NRF_SUCCESS);
+    access_handle_get_IgnoreArg_p_handle();
+    access_handle_get_ReturnThruPtr_p_handle(&model_handle);
+    config_server_evt_mock_Expect(&evt);
+    send_message(CONFIG_OPCODE_SIG_MODEL_SUBSCRIPTION_GET, (const uint8_t *) &message, sizeof(message) - sizeof(uint16_t));
+
+    TEST_ASSERT_TRUE(m_previous_reply_received);
+    VERIFY_REPLY_OPCODE(CONFIG_OPCODE_SIG_MODEL_SUBSCRIPTION_LIST);
+    TEST_ASSERT_EQUAL(sizeof(config_msg_sig_model_subscription_list_t) + subscription_count * sizeof(uint16_t), m_previous_reply.length);
+    const config_msg_sig_model_subscription_list_t * p_reply = (const config_msg_sig_model_subscription_list_t *) m_previous_reply.p_buffer;
+    TEST_ASSERT_EQUAL(ACCESS_STATUS_SUCCESS, p_reply->status);
+    for (uint16_t i = 0; i < subscription_count; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT16(subscriptions[i], p_reply->subscriptions[i]);
+    }
+    access_config_mock_Verify();
+    device_state_manager_mock_Verify();
+
+    /* A change in the access layer invalidates the cache: */
+    m_model_lists_revision++;
+    EXPECT_DSM_LOCAL_UNICAST_ADDRESSES_GET(message.element_address, element_index);
+    access_handle_get_ExpectAnyArgsAndReturn(NRF_SUCCESS);
+    access_handle_get_IgnoreArg_p_handle();
+    access_handle_get_ReturnThruPtr_p_handle(&model_handle);
+    access_model_subscriptions_get_StubWithCallback(access_model_subscriptions_get_mock);
+    for (uint8_t itr = 0; itr < ARRAY_SIZE(subscriptions); itr++)
+    {
+        dsm_address_get_ExpectAnyArgsAndReturn(NRF_SUCCESS);
+        dsm_address_get_ReturnThruPtr_p_address(&addr[itr]);
+    }
+    config_server_evt_mock_Expect(&evt);
+    send_message(CONFIG_OPCODE_SIG_MODEL_SUBSCRIPTION_GET, (const uint8_t *) &message, sizeof(message) - sizeof(uint16_t));
+    TEST_ASSERT_TRUE(m_previous_reply_received);
+}
+
 void test_vendor_model_subscription_get(void)
 {
     config_server_evt_t evt;
@@ -41,6 +41,7 @@
 
 #include "enc.h"
 #include "packet.h"
+#include "perf_counter.h"
 #include "utils.h"
 
 #define ENC_TEST_S1_INPUT_DATA  { 't', 'e', 's', 't' }
@@ -132,6 +133,7 @@ static const struct
 
 void setUp()
 {
+    perf_counter_clear();
 }
 
 void tearDown()
@@ -232,3 +234,45 @@ void test_k4_2(void)
     TEST_ASSERT_EQUAL_UINT8(expected, result);
 }
 
+void test_perf_counters(void)
+{
+    const uint8_t key[NRF_MESH_KEY_SIZE] = ENC_TEST_K3_INPUT_DATA;
+    const uint8_t nonce[CCM_NONCE_LENGTH] = {0};
+    const uint8_t message[] = ENC_TEST_S1_INPUT_DATA;
+    uint8_t result[NRF_MESH_KEY_SIZE];
+    uint8_t encrypted[sizeof(message)];
+    uint8_t decrypted[sizeof(message)];
+    uint8_t mic[4];
+
+    enc_aes_encrypt(key, key, result);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_AES_ECB]);
+
+    enc_aes_cmac(key, message, sizeof(message), result);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_AES_CMAC]);
+
+    /* Each CMAC call in the key derivation functions is counted: */
+    enc_k3(key, result);
+    TEST_ASSERT_EQUAL(4, g_perf_counters[PERF_COUNTER_CRYPTO_AES_CMAC]);
+
+    ccm_soft_data_t ccm_data = {key, nonce, message, sizeof(message), NULL, 0, encrypted, mic, sizeof(mic)};
+    enc_aes_ccm_encrypt(&ccm_data);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_CCM_ENCRYPT]);
+
+    bool mic_passed = false;
+    ccm_data.p_m = encrypted;
+    ccm_data.p_out = decrypted;
+    enc_aes_ccm_decrypt(&ccm_data, &mic_passed);
+    TEST_ASSERT_TRUE(mic_passed);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_CCM_DECRYPT]);
+    TEST_ASSERT_EQUAL(0, g_perf_counters[PERF_COUNTER_CRYPTO_CCM_MIC_FAIL]);
+
+    mic[0] ^= 0x01;
+    enc_aes_ccm_decrypt(&ccm_data, &mic_passed);
+    TEST_ASSERT_FALSE(mic_passed);
+    TEST_ASSERT_EQUAL(2, g_perf_counters[PERF_COUNTER_CRYPTO_CCM_DECRYPT]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_CCM_MIC_FAIL]);
+
+    /* Nothing else was counted as a crypto operation: */
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_AES_ECB]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_CRYPTO_CCM_ENCRYPT]);
+}
@@ -94,6 +94,16 @@ static void mem_listener_cb(void * p_args)
     }
 }
 
+static void batch_write_complete_cb(const flash_manager_t * p_manager, const fm_entry_t * p_entry, fm_result_t result)
+{
+    TEST_ASSERT_EQUAL_PTR(gp_active_manager, p_manager);
+    TEST_ASSERT_EQUAL(g_expected_result, result);
+    TEST_ASSERT_EQUAL_PTR(gp_expected_entry, p_entry);
+    /* Entries in a batch are reported in the order they're stored in. */
+    gp_expected_entry = p_entry + p_entry->header.len_words;
+    g_completes++;
+}
+
 static fm_iterate_action_t read_cb(const fm_entry_t * p_entry, void * p_args)
 {
     test_entry_t * p_expect = p_args;
@@ -350,6 +360,199 @@ void test_invalidate_duplicate_of_last_entry(void)
     FLASH_EXPECT(&area[0], 0x40*4, 0x80, 0x00, 0x00, 0x00);
 }
 
+void test_batch_interrupted(void)
+{
+    flash_manager_defrag_init_ExpectAndReturn(false);
+    flash_manager_init();
+    g_flash_queue_slots = 0xFFFFFF;
+
+    flash_manager_defragging_IgnoreAndReturn(false);
+
+    static flash_manager_page_t area[2] __attribute__((aligned(PAGE_SIZE)));
+    memset(area, 0xFF, sizeof(area));
+    flash_manager_t        manager;
+    flash_manager_config_t config = {.p_area                 = area,
+                                     .page_count             = 2,
+                                     .min_available_space    = 0,
+                                     .write_complete_cb      = NULL,
+                                     .invalidate_complete_cb = NULL};
+
+    /* Power loss after a batch replacing 0x0001 and 0x0002 was sealed, but before the old copies were invalidated: */
+    test_entry_t entries[] = {
+        {0x0002, 0x0001, 0x01010101},
+        {0x0002, 0x0002, 0x02020202},
+        {0x0002, 0x0003, 0x03030303},
+        {0x0002, 0x0001, 0x11111111},
+        {0x0002, 0x0002, 0x22222222},
+    };
+    memset(&manager, 0, sizeof(manager));
+    build_test_page(area, 2, entries, ARRAY_SIZE(entries), true);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_add(&manager, &config));
+    flash_execute();
+
+    /* Both old copies are invalidated, the entry that wasn't replaced is left alone. */
+    FLASH_EXPECT(&area[0], 0, 0x02, 0x00, 0x00, 0x00);
+    FLASH_EXPECT(&area[0], 8, 0x02, 0x00, 0x00, 0x00);
+    FLASH_EXPECT(&area[0], 16, 0x02, 0x00, 0x03, 0x00);
+    FLASH_EXPECT(&area[0], 24, 0x02, 0x00, 0x01, 0x00);
+    FLASH_EXPECT(&area[0], 32, 0x02, 0x00, 0x02, 0x00);
+}
+
+void test_batch(void)
+{
+    flash_manager_defrag_init_ExpectAndReturn(false);
+    flash_manager_init();
+    g_flash_queue_slots = 0xFFFFFF;
+
+    static flash_manager_page_t area[2] __attribute__((aligned(PAGE_SIZE)));
+    memset(area, 0xFF, sizeof(area));
+    flash_manager_t manager;
+    flash_manager_config_t config =
+    {
+        .p_area = area,
+        .page_count = 2,
+        .min_available_space = 0,
+        .write_complete_cb = batch_write_complete_cb,
+        .invalidate_complete_cb = NULL
+    };
+    fm_batch_t batch;
+
+    TEST_NRF_MESH_ASSERT_EXPECT(flash_manager_batch_begin(&batch, &manager, 0));
+    TEST_NRF_MESH_ASSERT_EXPECT(flash_manager_batch_begin(&batch, &manager, 3));
+    TEST_NRF_MESH_ASSERT_EXPECT(flash_manager_batch_begin(&batch, &manager, FLASH_MANAGER_BATCH_MAX_SIZE + WORD_SIZE));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_add(&manager, &config));
+    flash_execute();
+
+    gp_active_manager = &manager;
+    g_expected_result = FM_RESULT_SUCCESS;
+
+    /* Write an entry the normal way */
+    fm_entry_t * p_entry = flash_manager_entry_alloc(&manager, 0x0001, 4);
+    TEST_ASSERT_NOT_NULL(p_entry);
+    p_entry->data[0] = 0x01010101;
+    flash_manager_entry_commit(p_entry);
+    gp_expected_entry = (const fm_entry_t *) &area[0].raw[8];
+    flash_execute();
+    TEST_ASSERT_EQUAL(1, g_completes);
+
+    /* Replace it in a batch with two new entries */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_batch_begin(&batch,
+                                                             &manager,
+                                                             FLASH_MANAGER_BATCH_ENTRY_SIZE(4) * 3));
+    p_entry = flash_manager_batch_entry_append(&batch, 0x0001, 4);
+    TEST_ASSERT_NOT_NULL(p_entry);
+    TEST_ASSERT_EQUAL(2, p_entry->header.len_words);
+    TEST_ASSERT_EQUAL(0x0001, p_entry->header.handle);
+    p_entry->data[0] = 0x11111111;
+    TEST_NRF_MESH_ASSERT_EXPECT(flash_manager_batch_entry_append(&batch, 0x0001, 4));
+    p_entry = flash_manager_batch_entry_append(&batch, 0x0002, 4);
+    TEST_ASSERT_NOT_NULL(p_entry);
+    p_entry->data[0] = 0x22222222;
+    p_entry = flash_manager_batch_entry_append(&batch, 0x0003, 0);
+    TEST_ASSERT_NOT_NULL(p_entry);
+    TEST_ASSERT_EQUAL(1, p_entry->header.len_words);
+    TEST_ASSERT_EQUAL(FLASH_MANAGER_BATCH_ENTRY_SIZE(4) * 2 + FLASH_MANAGER_BATCH_ENTRY_SIZE(0), batch.length);
+    /* Doesn't fit: */
+    TEST_ASSERT_NULL(flash_manager_batch_entry_append(&batch, 0x0004, 4));
+    flash_manager_batch_commit(&batch);
+
+    gp_expected_entry = (const fm_entry_t *) &area[0].raw[16];
+    flash_execute();
+    TEST_ASSERT_EQUAL(4, g_completes);
+
+    /* The old entry is invalidated, and the entry replacing it is moved to the end of the batch. */
+    FLASH_EXPECT(&area[0], 0, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01);
+    FLASH_EXPECT(&area[0], 8,
+                 0x02, 0x00, 0x02, 0x00, 0x22, 0x22, 0x22, 0x22,
+                 0x01, 0x00, 0x03, 0x00,
+                 0x02, 0x00, 0x01, 0x00, 0x11, 0x11, 0x11, 0x11,
+                 0xff, 0xff, 0xff, 0x7f); /* seal */
+    TEST_ASSERT_EQUAL_PTR(&area[0].raw[8 + 28], manager.internal.p_seal);
+    TEST_ASSERT_EQUAL(8, manager.internal.invalid_bytes);
+
+    /* Empty batches don't write anything. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_batch_begin(&batch, &manager, FLASH_MANAGER_BATCH_ENTRY_SIZE(4)));
+    flash_manager_batch_commit(&batch);
+    flash_manager_defrag_is_running_ExpectAndReturn(false);
+    TEST_ASSERT_TRUE(flash_manager_is_stable());
+
+    /* Released batches don't write anything. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_batch_begin(&batch, &manager, FLASH_MANAGER_BATCH_ENTRY_SIZE(4)));
+    TEST_ASSERT_NOT_NULL(flash_manager_batch_entry_append(&batch, 0x0004, 4));
+    flash_manager_batch_release(&batch);
+    flash_manager_defrag_is_running_ExpectAndReturn(false);
+    TEST_ASSERT_TRUE(flash_manager_is_stable());
+    flash_execute();
+    TEST_ASSERT_EQUAL(4, g_completes);
+}
+
+void test_batch_max_size(void)
+{
+    flash_manager_defrag_init_ExpectAndReturn(false);
+    flash_manager_init();
+    g_flash_queue_slots = 0xFFFFFF;
+
+    static flash_manager_page_t area[2] __attribute__((aligned(PAGE_SIZE)));
+    memset(area, 0xFF, sizeof(area));
+    flash_manager_t manager;
+    flash_manager_config_t config =
+    {
+        .p_area = area,
+        .page_count = 2,
+        .min_available_space = 0,
+        .write_complete_cb = batch_write_complete_cb,
+        .invalidate_complete_cb = NULL
+    };
+    fm_batch_t batch;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_add(&manager, &config));
+    flash_execute();
+
+    gp_active_manager = &manager;
+    g_expected_result = FM_RESULT_SUCCESS;
+
+    /* Put the seal in the middle of the first page */
+    fm_entry_t * p_entry = flash_manager_entry_alloc(&manager, 0x0001, 4);
+    TEST_ASSERT_NOT_NULL(p_entry);
+    p_entry->data[0] = 0x01010101;
+    flash_manager_entry_commit(p_entry);
+    gp_expected_entry = (const fm_entry_t *) &area[0].raw[8];
+    flash_execute();
+    TEST_ASSERT_EQUAL(1, g_completes);
+
+    /* Fill a batch to the limit */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_batch_begin(&batch, &manager, FLASH_MANAGER_BATCH_MAX_SIZE));
+    fm_handle_t handle = 0x0010;
+    while (batch.length < FLASH_MANAGER_BATCH_MAX_SIZE)
+    {
+        uint32_t data_length = FLASH_MANAGER_BATCH_MAX_SIZE - batch.length - sizeof(fm_header_t);
+        if (data_length > FLASH_MANAGER_ENTRY_MAX_SIZE)
+        {
+            data_length = FLASH_MANAGER_ENTRY_MAX_SIZE;
+        }
+        p_entry = flash_manager_batch_entry_append(&batch, handle, data_length);
+        TEST_ASSERT_NOT_NULL(p_entry);
+        memset(p_entry->data, handle, data_length);
+        handle++;
+    }
+    TEST_ASSERT_EQUAL(FLASH_MANAGER_BATCH_MAX_SIZE, batch.length);
+    flash_manager_batch_commit(&batch);
+
+    /* The batch doesn't fit after the first entry, so the first page is padded and the batch goes
+     * on the second page, with its seal in the last word of the area. */
+    gp_expected_entry = get_first_entry(&area[1]);
+    flash_execute();
+    TEST_ASSERT_EQUAL(1 + handle - 0x0010, g_completes);
+
+    TEST_ASSERT_EQUAL(HANDLE_PADDING, ((const fm_entry_t *) &area[0].raw[16])->header.handle);
+    FLASH_EXPECT(&area[1], FLASH_MANAGER_DATA_PER_PAGE - WORD_SIZE, 0xff, 0xff, 0xff, 0x7f); /* seal */
+    TEST_ASSERT_EQUAL_PTR(&area[1].raw[PAGE_SIZE - WORD_SIZE], manager.internal.p_seal);
+
+    TEST_ASSERT_EQUAL_PTR(&area[0].raw[8], flash_manager_entry_get(&manager, 0x0001));
+    TEST_ASSERT_EQUAL_PTR(get_first_entry(&area[1]), flash_manager_entry_get(&manager, 0x0010));
+}
+
 void test_replace(void)
 {
     flash_manager_defrag_init_ExpectAndReturn(false);
@@ -820,6 +1023,137 @@ void test_invalidate(void)
     TEST_NRF_MESH_ASSERT_EXPECT(flash_manager_entry_invalidate(NULL, handle));
 }
 
+void test_incremental_defrag(void)
+{
+    flash_manager_defrag_init_ExpectAndReturn(false);
+    flash_manager_init();
+    g_flash_queue_slots = 0xFFFFFF;
+
+    flash_manager_defragging_IgnoreAndReturn(false);
+
+    static flash_manager_page_t area[2] __attribute__((aligned(PAGE_SIZE)));
+    memset(area, 0xFF, sizeof(area));
+    flash_manager_t manager;
+    flash_manager_config_t config =
+    {
+        .p_area = area,
+        .page_count = 2,
+        .min_available_space = 0,
+        .incremental_defrag_threshold = 24,
+        .write_complete_cb = NULL,
+        .invalidate_complete_cb = NULL
+    };
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_add(&manager, &config));
+    flash_execute();
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        fm_entry_t * p_entry = flash_manager_entry_alloc(&manager, 0x1000 + i, 8);
+        TEST_ASSERT_NOT_NULL(p_entry);
+        p_entry->data[0] = 0x55555555;
+        p_entry->data[1] = 0xaaaaaaaa;
+        flash_manager_entry_commit(p_entry);
+        flash_execute();
+    }
+
+    /* Below the threshold, nothing happens */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_entry_invalidate(&manager, 0x1000));
+    flash_execute();
+    TEST_ASSERT_EQUAL(12, manager.internal.invalid_bytes);
+    TEST_ASSERT_EQUAL(FM_STATE_READY, manager.internal.state);
+
+    /* Reaching the threshold starts an incremental defrag once the queue is empty */
+    flash_manager_defrag_incremental_Expect(&manager);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_entry_invalidate(&manager, 0x1001));
+    flash_execute();
+    TEST_ASSERT_EQUAL(FM_STATE_DEFRAG, manager.internal.state);
+    TEST_ASSERT_NULL(flash_manager_entry_get(&manager, 0x1002));
+
+    /* The defrag didn't get rid of the invalid entries, so we'll start another one */
+    flash_manager_defrag_incremental_Expect(&manager);
+    flash_manager_on_defrag_end(&manager);
+    TEST_ASSERT_EQUAL(24, manager.internal.invalid_bytes);
+    TEST_ASSERT_EQUAL(FM_STATE_DEFRAG, manager.internal.state);
+
+    /* Emulate the defrag result, should make the manager go back to normal */
+    test_entry_t entries[] = {{.handle = 0x1002, .len = 8, .data_value = 0x55555555}};
+    memset(area, 0xFF, sizeof(area));
+    build_test_page(area, 2, entries, ARRAY_SIZE(entries), true);
+    flash_manager_on_defrag_end(&manager);
+    TEST_ASSERT_EQUAL(0, manager.internal.invalid_bytes);
+    TEST_ASSERT_EQUAL(FM_STATE_READY, manager.internal.state);
+    TEST_ASSERT_NOT_NULL(flash_manager_entry_get(&manager, 0x1002));
+
+    /* A full defrag resets the counter without starting an incremental one. */
+    manager.internal.state = FM_STATE_DEFRAG;
+    manager.internal.invalid_bytes = 36;
+    flash_manager_on_defrag_end(&manager);
+    TEST_ASSERT_EQUAL(0, manager.internal.invalid_bytes);
+    TEST_ASSERT_EQUAL(FM_STATE_READY, manager.internal.state);
+}
+
+void test_incremental_defrag_queue(void)
+{
+    flash_manager_defrag_init_ExpectAndReturn(false);
+    flash_manager_init();
+    g_flash_queue_slots = 0xFFFFFF;
+
+    flash_manager_defragging_IgnoreAndReturn(false);
+
+    static flash_manager_page_t area[2][2] __attribute__((aligned(PAGE_SIZE)));
+    memset(area, 0xFF, sizeof(area));
+    flash_manager_t managers[2];
+    for (uint32_t i = 0; i < ARRAY_SIZE(managers); i++)
+    {
+        flash_manager_config_t config =
+        {
+            .p_area = area[i],
+            .page_count = 2,
+            .min_available_space = 0,
+            .incremental_defrag_threshold = 12,
+            .write_complete_cb = NULL,
+            .invalidate_complete_cb = NULL
+        };
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_add(&managers[i], &config));
+        flash_execute();
+
+        for (uint32_t j = 0; j < 2; j++)
+        {
+            fm_entry_t * p_entry = flash_manager_entry_alloc(&managers[i], 0x1000 + j, 8);
+            TEST_ASSERT_NOT_NULL(p_entry);
+            p_entry->data[0] = 0x55555555;
+            p_entry->data[1] = 0xaaaaaaaa;
+            flash_manager_entry_commit(p_entry);
+            flash_execute();
+        }
+    }
+
+    /* Both managers pass their threshold before the action queue is empty. Only the first one is
+     * defragmented right away, the second one waits for its turn. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_entry_invalidate(&managers[0], 0x1000));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, flash_manager_entry_invalidate(&managers[1], 0x1000));
+    flash_manager_defrag_incremental_Expect(&managers[0]);
+    flash_execute();
+    TEST_ASSERT_EQUAL(FM_STATE_DEFRAG, managers[0].internal.state);
+    TEST_ASSERT_EQUAL(FM_STATE_READY, managers[1].internal.state);
+
+    /* Emulate the defrag result of the first manager, the second one is started next */
+    test_entry_t entries[] = {{.handle = 0x1001, .len = 3, .data_value = 0x55555555}};
+    memset(area[0], 0xFF, sizeof(area[0]));
+    build_test_page(area[0], 2, entries, ARRAY_SIZE(entries), true);
+    flash_manager_defrag_incremental_Expect(&managers[1]);
+    flash_manager_on_defrag_end(&managers[0]);
+    TEST_ASSERT_EQUAL(0, managers[0].internal.invalid_bytes);
+    TEST_ASSERT_EQUAL(FM_STATE_READY, managers[0].internal.state);
+    TEST_ASSERT_EQUAL(FM_STATE_DEFRAG, managers[1].internal.state);
+
+    memset(area[1], 0xFF, sizeof(area[1]));
+    build_test_page(area[1], 2, entries, ARRAY_SIZE(entries), true);
+    flash_manager_on_defrag_end(&managers[1]);
+    TEST_ASSERT_EQUAL(0, managers[1].internal.invalid_bytes);
+    TEST_ASSERT_EQUAL(FM_STATE_READY, managers[1].internal.state);
+}
+
 void test_getters(void)
 {
     test_entry_t entries[] =
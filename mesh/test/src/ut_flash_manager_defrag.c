@@ -591,6 +591,45 @@ void test_invalid_last_page(void)
     TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_result[1].raw, area[1].raw, PAGE_SIZE);
 }
 
+/** Incremental defrag should stop after the first page it rewrites, and pick up from there the next time. */
+void test_incremental(void)
+{
+    flash_manager_page_t expected_result[3] __attribute__((aligned((PAGE_SIZE))));
+    flash_manager_page_t area[3] __attribute__((aligned(PAGE_SIZE)));
+    flash_manager_page_t untouched_page;
+    /* The valid entries take up one and a half page: */
+    setup_test_areas(area, expected_result, 3, PAGE_SIZE / WORD_SIZE, 4);
+    memcpy(&untouched_page, &area[2], PAGE_SIZE);
+    flash_manager_t manager = DEFAULT_MANAGER(area, 3);
+
+    TEST_ASSERT_FALSE(flash_manager_defrag_init());
+    g_flash_queue_slots = 0xFFFFFF;
+    mp_on_defrag_end_expected_manager = &manager;
+    flash_manager_defrag_incremental(&manager);
+    flash_execute();
+    TEST_ASSERT_NULL(mp_on_defrag_end_expected_manager);
+    TEST_ASSERT_FALSE(flash_manager_defrag_is_running());
+    TEST_ASSERT_NULL(mp_recovery_area->p_storage_page);
+
+    /* Only the first page has been compacted, the entries moved from the second page got
+     * invalidated there, and the last page hasn't been touched. */
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_result[0].raw, area[0].raw, PAGE_SIZE);
+    TEST_ASSERT_NOT_NULL(entry_get(get_first_entry(&area[1]), &area[2], FLASH_MANAGER_HANDLE_INVALID));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(untouched_page.raw, area[2].raw, PAGE_SIZE);
+
+    /* The second run skips the clean first page, and finishes the area, as the second page takes the
+     * rest of the entries. */
+    mp_on_defrag_end_expected_manager = &manager;
+    flash_manager_defrag_incremental(&manager);
+    flash_execute();
+    TEST_ASSERT_NULL(mp_on_defrag_end_expected_manager);
+    TEST_ASSERT_FALSE(flash_manager_defrag_is_running());
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_result[0].raw, area[0].raw, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_result[1].raw, area[1].raw, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_result[2].raw, area[2].raw, PAGE_SIZE);
+}
+
 /** Give the module an arbitrary, low number of available flash operations, until it runs to completion */
 void test_resource_constrained(void)
 {
@@ -823,3 +823,84 @@ void test_check_sar_seqauth_exists(void)
     // Check that packet doesn't exist anymore in the queue
     TEST_ASSERT_FALSE(friend_queue_sar_exists(&m_queue, metadata.net.src, 1));
 }
+
+#if MESH_FRIEND_QUEUE_PREENCRYPT
+void test_preencrypt(void)
+{
+    nrf_mesh_network_secmat_t secmat = {.nid = 1};
+    nrf_mesh_network_secmat_t secmat_updated = {.nid = 2};
+    packet_mesh_trs_packet_t packet = {.pdu = {1, 2, 3, 4, 5, 6, 7, 8, 9}};
+    transport_packet_metadata_t metadata = m_initial_metadata;
+
+    TEST_ASSERT_NULL(friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+
+    // Friend Updates and originated packets are encrypted when they're sent:
+    packet_mesh_trs_packet_t friend_update = packet;
+    packet_mesh_trs_control_opcode_set(&friend_update, TRANSPORT_CONTROL_OPCODE_FRIEND_UPDATE);
+    packet_mesh_trs_common_seg_set(&friend_update, false);
+    metadata.net.control_packet = true;
+    friend_queue_packet_push(&m_queue,
+                             &friend_update,
+                             PACKET_MESH_TRS_UNSEG_PDU_OFFSET + PACKET_MESH_TRS_CONTROL_FRIEND_UPDATE_SIZE,
+                             &metadata,
+                             CORE_TX_ROLE_ORIGINATOR);
+    metadata.net.control_packet = false;
+    friend_queue_packet_push(&m_queue, &packet, 8, &metadata, CORE_TX_ROLE_ORIGINATOR);
+    TEST_ASSERT_NULL(friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+
+    // Segments aren't available until the SAR session is complete:
+    metadata.segmented = true;
+    friend_queue_packet_push(&m_queue, &packet, 8, &metadata, CORE_TX_ROLE_RELAY);
+    TEST_ASSERT_NULL(friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+    friend_queue_sar_complete(&m_queue, metadata.net.src, true);
+    friend_packet_t * p_segment = friend_queue_packet_to_encrypt_get(&m_queue, &secmat);
+    TEST_ASSERT_NOT_NULL(p_segment);
+    TEST_ASSERT_NULL(p_segment->encrypted.p_secmat);
+
+    metadata.segmented = false;
+    metadata.net.internal.sequence_number++;
+    friend_queue_packet_push(&m_queue, &packet, 8, &metadata, CORE_TX_ROLE_RELAY);
+
+    // Packets are returned oldest first until they're all encrypted:
+    TEST_ASSERT_EQUAL_PTR(p_segment, friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+    p_segment->encrypted.p_secmat = &secmat;
+    friend_packet_t * p_unseg = friend_queue_packet_to_encrypt_get(&m_queue, &secmat);
+    TEST_ASSERT_NOT_NULL(p_unseg);
+    TEST_ASSERT_TRUE(p_segment != p_unseg);
+    p_unseg->encrypted.p_secmat = &secmat;
+    TEST_ASSERT_NULL(friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+
+    // New security material needs a new encryption:
+    TEST_ASSERT_EQUAL_PTR(p_segment, friend_queue_packet_to_encrypt_get(&m_queue, &secmat_updated));
+
+    // Invalidate drops all encryption:
+    friend_queue_encrypted_invalidate(&m_queue);
+    TEST_ASSERT_EQUAL_PTR(p_segment, friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+
+    // Reused packet buffers are never marked as encrypted:
+    p_segment->encrypted.p_secmat = &secmat;
+    p_unseg->encrypted.p_secmat = &secmat;
+    for (uint32_t i = 0; i < MESH_FRIEND_QUEUE_SIZE; ++i)
+    {
+        const friend_packet_t * p_packet = friend_queue_packet_get(&m_queue);
+        if (p_packet == NULL)
+        {
+            break;
+        }
+        friend_queue_packet_release(&m_queue);
+    }
+    for (uint32_t i = 0; i < MESH_FRIEND_QUEUE_SIZE; ++i)
+    {
+        metadata.net.internal.sequence_number++;
+        friend_queue_packet_push(&m_queue, &packet, 8, &metadata, CORE_TX_ROLE_RELAY);
+    }
+    for (uint32_t i = 0; i < MESH_FRIEND_QUEUE_SIZE; ++i)
+    {
+        friend_packet_t * p_packet = friend_queue_packet_to_encrypt_get(&m_queue, &secmat);
+        TEST_ASSERT_NOT_NULL(p_packet);
+        TEST_ASSERT_NULL(p_packet->encrypted.p_secmat);
+        p_packet->encrypted.p_secmat = &secmat;
+    }
+    TEST_ASSERT_NULL(friend_queue_packet_to_encrypt_get(&m_queue, &secmat));
+}
+#endif
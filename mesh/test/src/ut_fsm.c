@@ -38,6 +38,7 @@
 #include "fsm.h"
 
 #include <stddef.h>
+#include <string.h>
 #include <unity.h>
 #include "utils.h"
 #include "nordic_common.h"
@@ -554,3 +555,103 @@ void test_fsm_unexpected_only(void)
     fsm_event_post(&m_tst_fsm, E_3, NULL);
     TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_0);
 }
+
+void test_fsm_index(void)
+{
+    /* test verifies that the dispatch index gives the same behavior as the table lookup */
+
+    const fsm_transition_t tst_fsm_transitions[] =
+    {
+        FSM_STATE       (S_0),
+        FSM_TRANSITION  (E_1,   G_1,                 A_1,                S_1),
+        FSM_TRANSITION  (E_0,   FSM_NO_GUARD,        FSM_NO_ACTION,      FSM_SAME_STATE),
+        FSM_TRANSITION  (E_1,   G_2,                 A_2,                S_2),
+
+        FSM_STATE       (S_1),
+        FSM_TRANSITION  (E_2,   G_2,                 FSM_NO_ACTION,      S_2),
+
+        FSM_STATE       (S_2),
+        // empty state (without specific transitions)
+
+        FSM_STATE       (FSM_ANY_STATE),
+        FSM_TRANSITION  (E_2,   FSM_NO_GUARD,        A_0,                S_0),
+        FSM_TRANSITION  (E_3,   FSM_NO_GUARD,        FSM_NO_ACTION,      S_3),
+    };
+
+    uint8_t index[FSM_INDEX_SIZE(4, 5)];
+    memset(index, 0xAA, sizeof(index));
+
+    const fsm_const_descriptor_t m_tst_fsm_const =
+    {
+        .transition_table = tst_fsm_transitions,
+        .transitions_count = ARRAY_SIZE(tst_fsm_transitions),
+        .initial_state = S_0,
+        .guard = tst_guard,
+        .action = tst_action,
+        .p_index = index,
+        .state_count = 4,
+        .event_count = 5
+    };
+
+    fsm_init(&m_tst_fsm, &m_tst_fsm_const);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_0);
+
+    // the index points at the first transition of every state and event
+    const uint8_t expected_index[FSM_INDEX_SIZE(4, 5)] =
+    {
+        2,    1,    0xFF, 0xFF, 0xFF, /* S_0 */
+        0xFF, 0xFF, 5,    0xFF, 0xFF, /* S_1 */
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* S_2 */
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* S_3 */
+        0xFF, 0xFF, 8,    9,    0xFF, /* FSM_ANY_STATE */
+    };
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_index, index, sizeof(index));
+
+    // in S_0:
+
+    // both guards fail, and there are no "any state" transitions for the event
+    m_tst_data = 0;
+    m_tst_action_data = 0;
+    fsm_event_post(&m_tst_fsm, E_1, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_0);
+    TEST_ASSERT_TRUE(m_tst_action_data == 0);
+
+    // the second guarded transition is found past a transition for another event
+    m_tst_data = 2;
+    fsm_event_post(&m_tst_fsm, E_1, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_2);
+    TEST_ASSERT_TRUE(m_tst_action_data == 102);
+
+    // in S_2:
+
+    // events without transitions in the empty state are ignored
+    m_tst_action_data = 0;
+    fsm_event_post(&m_tst_fsm, E_0, &m_tst_data);
+    fsm_event_post(&m_tst_fsm, E_4, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_2);
+    TEST_ASSERT_TRUE(m_tst_action_data == 0);
+
+    // the "any state" transition applies
+    fsm_event_post(&m_tst_fsm, E_2, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_0);
+    TEST_ASSERT_TRUE(m_tst_action_data == 100);
+
+    // in S_0:
+
+    m_tst_data = 1;
+    fsm_event_post(&m_tst_fsm, E_1, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_1);
+    TEST_ASSERT_TRUE(m_tst_action_data == 101);
+
+    // in S_1:
+
+    // the state's guard fails, so the "any state" transition applies
+    m_tst_data = 0;
+    m_tst_action_data = 0;
+    fsm_event_post(&m_tst_fsm, E_2, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_0);
+    TEST_ASSERT_TRUE(m_tst_action_data == 100);
+
+    fsm_event_post(&m_tst_fsm, E_3, &m_tst_data);
+    TEST_ASSERT_TRUE(m_tst_fsm.current_state == S_3);
+}
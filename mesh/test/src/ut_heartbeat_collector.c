@@ -0,0 +1,244 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "heartbeat_collector.h"
+
+#include <string.h>
+#include <unity.h>
+#include "nrf_error.h"
+#include "nrf_mesh_defines.h"
+#include "utils.h"
+#include "nordic_common.h"
+
+#include "timer_mock.h"
+
+#define RX_TIMESTAMP 0x12345678
+#define SRC_BASE     0x0100
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    timer_mock_Init();
+    heartbeat_collector_clear();
+}
+
+void tearDown(void)
+{
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static void hb_rx(uint16_t src, uint8_t hops, uint16_t features, int8_t rssi, timestamp_t timestamp)
+{
+    nrf_mesh_evt_hb_message_t hb_message = {
+        .init_ttl = 0x7F,
+        .hops = hops,
+        .features = features,
+        .src = src
+    };
+    nrf_mesh_rx_metadata_t metadata;
+    memset(&metadata, 0, sizeof(metadata));
+    metadata.source = NRF_MESH_RX_SOURCE_SCANNER;
+    metadata.params.scanner.rssi = rssi;
+    metadata.params.scanner.timestamp = timestamp;
+    heartbeat_collector_process(&hb_message, &metadata);
+}
+
+static void entry_verify(const heartbeat_collector_entry_t * p_entry,
+                         uint16_t src,
+                         uint16_t count,
+                         uint8_t hops,
+                         uint8_t min_hops,
+                         uint8_t max_hops)
+{
+    TEST_ASSERT_EQUAL(src, p_entry->src);
+    TEST_ASSERT_EQUAL(count, p_entry->count);
+    TEST_ASSERT_EQUAL(hops, p_entry->hops);
+    TEST_ASSERT_EQUAL(min_hops, p_entry->min_hops);
+    TEST_ASSERT_EQUAL(max_hops, p_entry->max_hops);
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_process(void)
+{
+    heartbeat_collector_entry_t entry;
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, heartbeat_collector_get(SRC_BASE, &entry));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, heartbeat_collector_get(NRF_MESH_ADDR_UNASSIGNED, &entry));
+
+    hb_rx(SRC_BASE, 3, 0x0001, -40, RX_TIMESTAMP);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE, &entry));
+    entry_verify(&entry, SRC_BASE, 1, 3, 3, 3);
+    TEST_ASSERT_EQUAL(0x0001, entry.features);
+    TEST_ASSERT_EQUAL(-40, entry.rssi);
+    TEST_ASSERT_EQUAL(RX_TIMESTAMP, entry.last_seen);
+
+    hb_rx(SRC_BASE, 5, 0x0003, -60, RX_TIMESTAMP + 1000);
+    hb_rx(SRC_BASE, 1, 0x0002, -50, RX_TIMESTAMP + 2000);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE, &entry));
+    entry_verify(&entry, SRC_BASE, 3, 1, 1, 5);
+    TEST_ASSERT_EQUAL(0x0002, entry.features);
+    TEST_ASSERT_EQUAL(-50, entry.rssi);
+    TEST_ASSERT_EQUAL(RX_TIMESTAMP + 2000, entry.last_seen);
+
+    /* Other sources are tracked separately: */
+    hb_rx(SRC_BASE + 1, 2, 0, -70, RX_TIMESTAMP + 3000);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE + 1, &entry));
+    entry_verify(&entry, SRC_BASE + 1, 1, 2, 2, 2);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE, &entry));
+    entry_verify(&entry, SRC_BASE, 3, 1, 1, 5);
+    TEST_ASSERT_EQUAL(2, heartbeat_collector_source_count_get());
+
+    /* Heartbeats from GATT and loopback have no RSSI: */
+    nrf_mesh_evt_hb_message_t hb_message = {.hops = 1, .src = SRC_BASE + 2};
+    nrf_mesh_rx_metadata_t metadata = {.source = NRF_MESH_RX_SOURCE_LOOPBACK};
+    timer_now_ExpectAndReturn(RX_TIMESTAMP + 4000);
+    heartbeat_collector_process(&hb_message, &metadata);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE + 2, &entry));
+    TEST_ASSERT_EQUAL(HEARTBEAT_COLLECTOR_RSSI_INVALID, entry.rssi);
+    TEST_ASSERT_EQUAL(RX_TIMESTAMP + 4000, entry.last_seen);
+
+    metadata.source = NRF_MESH_RX_SOURCE_GATT;
+    metadata.params.gatt.timestamp = RX_TIMESTAMP + 5000;
+    heartbeat_collector_process(&hb_message, &metadata);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE + 2, &entry));
+    TEST_ASSERT_EQUAL(HEARTBEAT_COLLECTOR_RSSI_INVALID, entry.rssi);
+    TEST_ASSERT_EQUAL(RX_TIMESTAMP + 5000, entry.last_seen);
+    TEST_ASSERT_EQUAL(2, entry.count);
+}
+
+void test_count_saturation(void)
+{
+    heartbeat_collector_entry_t entry;
+
+    for (uint32_t i = 0; i < UINT16_MAX + 10; ++i)
+    {
+        hb_rx(SRC_BASE, 1, 0, -40, RX_TIMESTAMP);
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE, &entry));
+    TEST_ASSERT_EQUAL(UINT16_MAX, entry.count);
+}
+
+void test_full(void)
+{
+    heartbeat_collector_entry_t entry;
+
+    /* Use a stride, like the addresses of nodes with several elements: */
+    for (uint32_t i = 0; i < HEARTBEAT_COLLECTOR_SIZE; ++i)
+    {
+        hb_rx(SRC_BASE + i * 3, i, 0, -40, RX_TIMESTAMP + i);
+    }
+    TEST_ASSERT_EQUAL(HEARTBEAT_COLLECTOR_SIZE, heartbeat_collector_source_count_get());
+    TEST_ASSERT_EQUAL(0, heartbeat_collector_dropped_get());
+
+    /* Known sources are still updated, new ones are dropped: */
+    hb_rx(SRC_BASE, 10, 0, -40, RX_TIMESTAMP);
+    hb_rx(SRC_BASE + 1, 1, 0, -40, RX_TIMESTAMP);
+    hb_rx(SRC_BASE + 2, 1, 0, -40, RX_TIMESTAMP);
+    TEST_ASSERT_EQUAL(2, heartbeat_collector_dropped_get());
+    TEST_ASSERT_EQUAL(HEARTBEAT_COLLECTOR_SIZE, heartbeat_collector_source_count_get());
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, heartbeat_collector_get(SRC_BASE + 1, &entry));
+
+    for (uint32_t i = 1; i < HEARTBEAT_COLLECTOR_SIZE; ++i)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE + i * 3, &entry));
+        entry_verify(&entry, SRC_BASE + i * 3, 1, i, i, i);
+        TEST_ASSERT_EQUAL(RX_TIMESTAMP + i, entry.last_seen);
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE, &entry));
+    entry_verify(&entry, SRC_BASE, 2, 10, 0, 10);
+
+    heartbeat_collector_clear();
+    TEST_ASSERT_EQUAL(0, heartbeat_collector_source_count_get());
+    TEST_ASSERT_EQUAL(0, heartbeat_collector_dropped_get());
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, heartbeat_collector_get(SRC_BASE, &entry));
+    hb_rx(SRC_BASE + 1, 1, 0, -40, RX_TIMESTAMP);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, heartbeat_collector_get(SRC_BASE + 1, &entry));
+}
+
+void test_entries_get(void)
+{
+    heartbeat_collector_entry_t entries[HEARTBEAT_COLLECTOR_SIZE];
+    uint16_t index = 0;
+    uint16_t count = ARRAY_SIZE(entries);
+
+    /* Empty table: */
+    heartbeat_collector_entries_get(&index, entries, &count);
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ASSERT_EQUAL(HEARTBEAT_COLLECTOR_SIZE, index);
+
+    const uint32_t source_count = HEARTBEAT_COLLECTOR_SIZE - 3;
+    for (uint32_t i = 0; i < source_count; ++i)
+    {
+        hb_rx(SRC_BASE + i, 1, 0, -40, RX_TIMESTAMP);
+    }
+
+    /* Read out in batches of two, and check that every source shows up exactly once: */
+    uint32_t seen = 0;
+    uint32_t total = 0;
+    index = 0;
+    while (index < HEARTBEAT_COLLECTOR_SIZE)
+    {
+        count = 2;
+        heartbeat_collector_entries_get(&index, entries, &count);
+        TEST_ASSERT_TRUE(count <= 2);
+        TEST_ASSERT_TRUE(count > 0);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t bit = (1u << (entries[i].src - SRC_BASE));
+            TEST_ASSERT_EQUAL(0, seen & bit);
+            seen |= bit;
+        }
+        total += count;
+    }
+    TEST_ASSERT_EQUAL(source_count, total);
+    TEST_ASSERT_EQUAL((1u << source_count) - 1, seen);
+
+    /* Reading past the end gives no entries: */
+    count = ARRAY_SIZE(entries);
+    heartbeat_collector_entries_get(&index, entries, &count);
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ASSERT_EQUAL(HEARTBEAT_COLLECTOR_SIZE, index);
+}
@@ -0,0 +1,219 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "log.h"
+
+#include <string.h>
+#include <unity.h>
+#include "utils.h"
+#include "nordic_common.h"
+
+#define RECORD_HEADER(DROPPED, WORDS) (((uint32_t) LOG_DEFERRED_SYNC << 24) | ((DROPPED) << 8) | (WORDS))
+
+static const log_deferred_meta_t m_meta = {"file.c", "value: %u %d\n", 123, LOG_LEVEL_INFO, LOG_DEFERRED_TYPE_PRINTF};
+static const log_deferred_meta_t m_array_meta = {"file.c", NULL, 456, LOG_LEVEL_INFO, LOG_DEFERRED_TYPE_ARRAY};
+static const char m_array_msg[] = "array";
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    __LOG_INIT(LOG_SRC_TEST, LOG_LEVEL_INFO, NULL);
+
+    uint8_t buffer[64];
+    while (log_deferred_read(buffer, sizeof(buffer)) > 0)
+    {
+        /* Discard leftovers from previous tests. */
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static uint32_t words_read(uint32_t * p_words, uint32_t max_count)
+{
+    uint32_t length = log_deferred_read((uint8_t *) p_words, max_count * sizeof(uint32_t));
+    TEST_ASSERT_EQUAL(0, length % sizeof(uint32_t));
+    return length / sizeof(uint32_t);
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_write(void)
+{
+    uint32_t words[LOG_DEFERRED_ARGS_MAX + 4];
+
+    log_deferred_write(&m_meta, 0x12345678, 2, 7, -1);
+    TEST_ASSERT_EQUAL(5, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 4), words[0]);
+    TEST_ASSERT_EQUAL_HEX32((uint32_t) (uintptr_t) &m_meta, words[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x12345678, words[2]);
+    TEST_ASSERT_EQUAL(7, words[3]);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, words[4]);
+    TEST_ASSERT_EQUAL(0, words_read(words, ARRAY_SIZE(words)));
+
+    /* Argument count is capped */
+    log_deferred_write(&m_meta, 0, LOG_DEFERRED_ARGS_MAX + 1,
+                       1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17);
+    TEST_ASSERT_EQUAL(3 + LOG_DEFERRED_ARGS_MAX, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 2 + LOG_DEFERRED_ARGS_MAX), words[0]);
+    TEST_ASSERT_EQUAL(16, words[2 + LOG_DEFERRED_ARGS_MAX]);
+}
+
+void test_macros(void)
+{
+    uint32_t words[LOG_DEFERRED_ARGS_MAX + 4];
+
+    __LOG(LOG_SRC_TEST, LOG_LEVEL_INFO, "no arguments\n");
+    TEST_ASSERT_EQUAL(3, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 2), words[0]);
+
+    __LOG(LOG_SRC_TEST, LOG_LEVEL_INFO, "%u %u %u\n", 1, 2, 3);
+    TEST_ASSERT_EQUAL(6, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 5), words[0]);
+    TEST_ASSERT_EQUAL(1, words[3]);
+    TEST_ASSERT_EQUAL(2, words[4]);
+    TEST_ASSERT_EQUAL(3, words[5]);
+
+    /* Filtered by level and source */
+    __LOG(LOG_SRC_TEST, LOG_LEVEL_DBG1, "%u\n", 1);
+    __LOG(LOG_SRC_NETWORK, LOG_LEVEL_INFO, "%u\n", 1);
+    __LOG_XB(LOG_SRC_TEST, LOG_LEVEL_DBG1, "array", words, 4);
+    TEST_ASSERT_EQUAL(0, words_read(words, ARRAY_SIZE(words)));
+
+    const uint8_t array[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    __LOG_XB(LOG_SRC_TEST, LOG_LEVEL_INFO, m_array_msg, array, sizeof(array));
+    TEST_ASSERT_EQUAL(7, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 6), words[0]);
+    TEST_ASSERT_EQUAL_HEX32((uint32_t) (uintptr_t) m_array_msg, words[3]);
+    TEST_ASSERT_EQUAL(5, words[4]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(array, &words[5], sizeof(array));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY((uint8_t[3]) {0}, (uint8_t *) &words[5] + sizeof(array), 3);
+}
+
+void test_write_array(void)
+{
+    uint8_t array[LOG_ARRAY_LEN_MAX + 1];
+    uint32_t words[5 + LOG_ARRAY_LEN_MAX / 4 + 1];
+    for (uint32_t i = 0; i < sizeof(array); i++)
+    {
+        array[i] = i;
+    }
+
+    log_deferred_write_array(&m_array_meta, 1, m_array_msg, array, 0);
+    TEST_ASSERT_EQUAL(5, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 4), words[0]);
+    TEST_ASSERT_EQUAL_HEX32((uint32_t) (uintptr_t) &m_array_meta, words[1]);
+    TEST_ASSERT_EQUAL(0, words[4]);
+
+    /* Length is capped */
+    log_deferred_write_array(&m_array_meta, 1, m_array_msg, array, sizeof(array));
+    TEST_ASSERT_EQUAL(5 + LOG_ARRAY_LEN_MAX / 4, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL(LOG_ARRAY_LEN_MAX, words[4]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(array, &words[5], LOG_ARRAY_LEN_MAX);
+}
+
+void test_overflow(void)
+{
+    /* Each record is 4 words */
+    const uint32_t record_size = 4 * sizeof(uint32_t);
+    const uint32_t capacity = LOG_DEFERRED_BUFFER_SIZE / record_size;
+
+    for (uint32_t i = 0; i < capacity + 3; i++)
+    {
+        log_deferred_write(&m_meta, i, 1, i);
+    }
+
+    uint32_t words[4];
+    for (uint32_t i = 0; i < capacity; i++)
+    {
+        TEST_ASSERT_EQUAL(4, words_read(words, ARRAY_SIZE(words)));
+        TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 3), words[0]);
+        TEST_ASSERT_EQUAL(i, words[3]);
+    }
+    TEST_ASSERT_EQUAL(0, words_read(words, ARRAY_SIZE(words)));
+
+    /* The next record reports the dropped ones */
+    log_deferred_write(&m_meta, 0, 1, 0xAB);
+    TEST_ASSERT_EQUAL(4, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(3, 3), words[0]);
+    TEST_ASSERT_EQUAL(0xAB, words[3]);
+
+    log_deferred_write(&m_meta, 0, 1, 0xCD);
+    TEST_ASSERT_EQUAL(4, words_read(words, ARRAY_SIZE(words)));
+    TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 3), words[0]);
+}
+
+void test_partial_read(void)
+{
+    /* Wrap around the end of the buffer in the middle of a record, and read in odd sized chunks. */
+    for (uint32_t i = 0; i < LOG_DEFERRED_BUFFER_SIZE / (5 * sizeof(uint32_t)); i++)
+    {
+        log_deferred_write(&m_meta, 0, 2, 0, 0);
+    }
+    uint8_t buffer[LOG_DEFERRED_BUFFER_SIZE];
+    (void) log_deferred_read(buffer, sizeof(buffer));
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        log_deferred_write(&m_meta, i, 2, i, ~i);
+    }
+
+    uint32_t words[50];
+    uint32_t length = 0;
+    uint32_t read;
+    do
+    {
+        read = log_deferred_read((uint8_t *) words + length, 3);
+        length += read;
+    } while (read > 0);
+
+    TEST_ASSERT_EQUAL(sizeof(words), length);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(RECORD_HEADER(0, 4), words[i * 5]);
+        TEST_ASSERT_EQUAL(i, words[i * 5 + 2]);
+        TEST_ASSERT_EQUAL(i, words[i * 5 + 3]);
+        TEST_ASSERT_EQUAL_HEX32(~i, words[i * 5 + 4]);
+    }
+}
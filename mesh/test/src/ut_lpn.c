@@ -49,6 +49,7 @@
 #include "scanner_mock.h"
 #include "event_mock.h"
 #include "nrf_mesh_externs_mock.h"
+#include "timer_mock.h"
 
 void setUp(void)
 {
@@ -58,6 +59,8 @@ void setUp(void)
     scanner_mock_Init();
     event_mock_Init();
     nrf_mesh_externs_mock_Init();
+    timer_mock_Init();
+    timer_now_IgnoreAndReturn(0);
 }
 
 void tearDown(void)
@@ -74,6 +77,8 @@ void tearDown(void)
     event_mock_Destroy();
     nrf_mesh_externs_mock_Verify();
     nrf_mesh_externs_mock_Destroy();
+    timer_mock_Verify();
+    timer_mock_Destroy();
 }
 
 void mesh_lpn_subman_init(void)
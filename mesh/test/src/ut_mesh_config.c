@@ -96,6 +96,10 @@ static bool m_active[NRF_SECTION_ENTRIES + EXTRA_ENTRIES];
 static mesh_config_backend_evt_cb_t m_backend_evt_cb;
 static const mesh_config_entry_id_t m_invalid_id = {0, 0};
 static bool m_is_legacy_handled;
+static bool m_batch_open;
+static uint32_t m_batch_count;
+static uint32_t m_batch_store_count;
+static uint32_t m_store_result;
 
 static uint32_t entry_set(mesh_config_entry_id_t id, const void * p_entry);
 static void entry_get(mesh_config_entry_id_t id, void * p_entry);
@@ -126,6 +130,35 @@ static void mesh_config_backend_init_callback(const mesh_config_entry_params_t *
     m_backend_evt_cb = cb;
 }
 
+static void mesh_config_backend_batch_begin_callback(int calls)
+{
+    TEST_ASSERT_FALSE(m_batch_open);
+    m_batch_open = true;
+    m_batch_count++;
+    m_batch_store_count = 0;
+}
+
+static void mesh_config_backend_batch_end_callback(int calls)
+{
+    TEST_ASSERT_TRUE(m_batch_open);
+    m_batch_open = false;
+}
+
+static uint32_t mesh_config_backend_store_callback(mesh_config_entry_id_t id,
+                                                   const uint8_t * p_entry,
+                                                   uint32_t entry_len,
+                                                   int calls)
+{
+    TEST_ASSERT_TRUE(m_batch_open);
+    TEST_ASSERT_EQUAL(sizeof(entry_t), entry_len);
+    TEST_ASSERT_EQUAL_MEMORY(&m_entries[id.record - TEST_ENTRY(0).record], p_entry, entry_len);
+    if (m_store_result == NRF_SUCCESS)
+    {
+        m_batch_store_count++;
+    }
+    return m_store_result;
+}
+
 void dsm_legacy_pretreatment_do(mesh_config_entry_id_t * p_id, uint32_t entry_len)
 {
     (void)p_id;
@@ -170,12 +203,17 @@ void setUp(void)
     event_mock_Init();
     event_handle_StubWithCallback(event_handler);
 
+    m_batch_open = false;
+    m_batch_count = 0;
+    mesh_config_backend_batch_begin_StubWithCallback(mesh_config_backend_batch_begin_callback);
+    mesh_config_backend_batch_end_StubWithCallback(mesh_config_backend_batch_end_callback);
     mesh_config_backend_init_StubWithCallback(mesh_config_backend_init_callback);
     mesh_config_init();
 }
 
 void tearDown(void)
 {
+    TEST_ASSERT_FALSE(m_batch_open);
     mesh_config_backend_mock_Verify();
     mesh_config_backend_mock_Destroy();
     config_evt_Verify();
@@ -1144,3 +1182,100 @@ void test_file_to_entry_prioritization(void)
 
     TEST_ASSERT_FALSE(mesh_config_is_busy());
 }
+
+void test_dirty_queue(void)
+{
+    entry_t entry = {1, 2};
+    entry_t entry_new = {3, 4};
+    entry_set_params_t expect_params[] = {
+        {.id = *mesh_config_entries[0].p_id, .entry = entry, .return_value = NRF_SUCCESS},
+        {.id = *mesh_config_entries[3].p_id, .entry = entry, .return_value = NRF_SUCCESS},
+        {.id = *mesh_config_entries[1].p_id, .entry = entry, .return_value = NRF_SUCCESS},
+        {.id = *mesh_config_entries[3].p_id, .entry = entry_new, .return_value = NRF_SUCCESS},
+    };
+
+    /* Keep the backend busy with the first entry: */
+    entry_set_Expect(&expect_params[0]);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(expect_params[0].id, (const uint8_t *) &entry, sizeof(entry), sizeof(entry), NRF_SUCCESS);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(expect_params[0].id, &entry));
+
+    /* The backend rejects the second entry: */
+    entry_set_Expect(&expect_params[1]);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(expect_params[1].id, (const uint8_t *) &entry, sizeof(entry), sizeof(entry), NRF_ERROR_NO_MEM);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(expect_params[1].id, &entry));
+
+    /* Entries are retried in the order they were changed, even if they come before in the entry list: */
+    entry_set_Expect(&expect_params[2]);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(expect_params[1].id, (const uint8_t *) &entry, sizeof(entry), sizeof(entry), NRF_ERROR_NO_MEM);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(expect_params[2].id, &entry));
+
+    /* Changing a waiting entry again only changes the stored value: */
+    entry_set_Expect(&expect_params[3]);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(expect_params[3].id, (const uint8_t *) &entry_new, sizeof(entry), sizeof(entry), NRF_ERROR_NO_MEM);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(expect_params[3].id, &entry_new));
+    TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_DIRTY | MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[3].p_state[0]);
+    TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_DIRTY | MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[1].p_state[0]);
+
+    /* The backend is done with the first entry, and accepts both waiting entries once: */
+    mesh_config_backend_store_ExpectWithArrayAndReturn(expect_params[3].id, (const uint8_t *) &entry_new, sizeof(entry), sizeof(entry), NRF_SUCCESS);
+    mesh_config_backend_store_ExpectWithArrayAndReturn(expect_params[2].id, (const uint8_t *) &entry, sizeof(entry), sizeof(entry), NRF_SUCCESS);
+    mesh_config_backend_evt_t backend_evt = {.type = MESH_CONFIG_BACKEND_EVT_TYPE_STORE_COMPLETE,
+                                             .id   = expect_params[0].id};
+    m_backend_evt_cb(&backend_evt);
+    TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_BUSY | MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[3].p_state[0]);
+    TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_BUSY | MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[1].p_state[0]);
+
+    mesh_config_stats_t stats;
+    mesh_config_backend_bytes_written_get_ExpectAndReturn(36);
+    mesh_config_stats_get(&stats);
+    TEST_ASSERT_EQUAL(4, stats.changes);
+    TEST_ASSERT_EQUAL(1, stats.coalesced);
+    TEST_ASSERT_EQUAL(3, stats.backend_writes);
+    TEST_ASSERT_EQUAL(36, stats.flash_bytes);
+
+    backend_evt.id = expect_params[3].id;
+    m_backend_evt_cb(&backend_evt);
+
+    nrf_mesh_evt_t stable_evt = {.type = NRF_MESH_EVT_CONFIG_STABLE};
+    config_evt_Expect(&stable_evt);
+    backend_evt.id = expect_params[2].id;
+    m_backend_evt_cb(&backend_evt);
+    TEST_ASSERT_FALSE(mesh_config_is_busy());
+}
+
+void test_batched_store(void)
+{
+    mesh_config_backend_store_StubWithCallback(mesh_config_backend_store_callback);
+    entry_t entry = {1, 2};
+    entry_set_params_t expect_params = {.entry = entry, .return_value = NRF_SUCCESS};
+
+    /* The first entry is passed on right away: */
+    m_store_result = NRF_SUCCESS;
+    expect_params.id = *mesh_config_entries[0].p_id;
+    entry_set_Expect(&expect_params);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(expect_params.id, &entry));
+    TEST_ASSERT_EQUAL(1, m_batch_count);
+    TEST_ASSERT_EQUAL(1, m_batch_store_count);
+
+    /* The backend is out of resources, and the next entries have to wait: */
+    m_store_result = NRF_ERROR_NO_MEM;
+    for (uint32_t i = 1; i < 3; ++i)
+    {
+        expect_params.id = *mesh_config_entries[i].p_id;
+        entry.var1 = i;
+        expect_params.entry = entry;
+        entry_set_Expect(&expect_params);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_entry_set(expect_params.id, &entry));
+    }
+    TEST_ASSERT_EQUAL(3, m_batch_count);
+
+    /* When the first entry has been stored, both waiting entries are passed on in the same batch: */
+    m_store_result = NRF_SUCCESS;
+    mesh_config_backend_evt_t evt = {.type = MESH_CONFIG_BACKEND_EVT_TYPE_STORE_COMPLETE,
+                                     .id = *mesh_config_entries[0].p_id};
+    m_backend_evt_cb(&evt);
+    TEST_ASSERT_EQUAL(4, m_batch_count);
+    TEST_ASSERT_EQUAL(2, m_batch_store_count);
+    TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_BUSY | MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[1].p_state[0]);
+    TEST_ASSERT_EQUAL(MESH_CONFIG_ENTRY_FLAG_BUSY | MESH_CONFIG_ENTRY_FLAG_ACTIVE, mesh_config_entries[2].p_state[0]);
+}
@@ -212,11 +212,31 @@ void test_store_negative(void)
 
 void test_store_positive(void)
 {
+    uint32_t bytes_written = mesh_config_backend_bytes_written_get();
+    uint32_t expected_bytes = 0;
+
     mesh_config_backend_record_write_StubWithCallback(mesh_config_backend_record_write_cb);
+    mesh_config_record_size_calculate_StubWithCallback(mesh_config_record_size_calculate_cb);
     for (uint32_t itr = 0; itr < TABLE_SIZE; itr++)
     {
         mesh_config_backend_store(*m_entry_table[itr].p_id, &m_data, m_entry_table[itr].max_count * m_entry_table[itr].entry_size);
+        expected_bytes += m_entry_table[itr].max_count * m_entry_table[itr].entry_size;
     }
+    TEST_ASSERT_EQUAL(bytes_written + expected_bytes, mesh_config_backend_bytes_written_get());
+}
+
+void test_store_batch(void)
+{
+    mesh_config_backend_records_batch_begin_Expect();
+    mesh_config_backend_batch_begin();
+
+    mesh_config_backend_record_write_StubWithCallback(mesh_config_backend_record_write_cb);
+    mesh_config_record_size_calculate_StubWithCallback(mesh_config_record_size_calculate_cb);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_store(*m_entry_table[0].p_id, &m_data,
+                                                             m_entry_table[0].max_count * m_entry_table[0].entry_size));
+
+    mesh_config_backend_records_batch_end_Expect();
+    mesh_config_backend_batch_end();
 }
 
 void test_erase_negative(void)
@@ -229,8 +249,15 @@ void test_erase_negative(void)
 
 void test_erase_positive(void)
 {
+    uint32_t bytes_written = mesh_config_backend_bytes_written_get();
+
     mesh_config_backend_record_erase_StubWithCallback(mesh_config_backend_record_erase_cb);
-    for (uint32_t itr = 0; itr < TABLE_SIZE; itr++)
+    mesh_config_record_size_calculate_ExpectAndReturn(0, 4);
+    mesh_config_backend_erase(*m_entry_table[0].p_id);
+    TEST_ASSERT_EQUAL(bytes_written + 4, mesh_config_backend_bytes_written_get());
+
+    mesh_config_record_size_calculate_StubWithCallback(mesh_config_record_size_calculate_cb);
+    for (uint32_t itr = 1; itr < TABLE_SIZE; itr++)
     {
         mesh_config_backend_erase(*m_entry_table[itr].p_id);
     }
@@ -132,6 +132,9 @@ static uint32_t flash_manager_add_cb(flash_manager_t * p_manager, const flash_ma
     TEST_ASSERT_NOT_NULL(p_config->invalidate_complete_cb);
     TEST_ASSERT_NOT_NULL(p_config->remove_complete_cb);
     TEST_ASSERT_TRUE(p_config->min_available_space == m_file.size);
+    /* The test is built with a 25 percent incremental defrag threshold. */
+    TEST_ASSERT_NOT_EQUAL(0, p_config->incremental_defrag_threshold);
+    TEST_ASSERT_EQUAL(p_config->page_count * FLASH_MANAGER_DATA_PER_PAGE / 4, p_config->incremental_defrag_threshold);
     TEST_ASSERT_TRUE((uint8_t *)(p_config->p_area) == (uint8_t *)&m_flash_recovery_area - p_config->page_count * PAGE_SIZE);
     TEST_ASSERT_TRUE(p_config->page_count == (uint32_t)CEIL_DIV(m_file.size, FLASH_MANAGER_DATA_PER_PAGE));
 
@@ -229,6 +232,90 @@ void test_record_write(void)
     free(p_fm_entry);
 }
 
+void test_record_write_batch(void)
+{
+    uint8_t * p_fm_entries = malloc(3 * (sizeof(fm_entry_t) + sizeof(m_entry)));
+    fm_entry_t * p_fm_entry[3];
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        p_fm_entry[i] = (fm_entry_t *) &p_fm_entries[i * (sizeof(fm_entry_t) + sizeof(m_entry))];
+    }
+
+    mesh_config_backend_records_batch_begin();
+
+    /* The first record starts a batch, and the next record of the same file goes in the same batch: */
+    flash_manager_batch_begin_ExpectAndReturn(NULL, &m_file.glue_data.flash_manager, MESH_CONFIG_BATCH_SIZE, NRF_SUCCESS);
+    flash_manager_batch_begin_IgnoreArg_p_batch();
+    flash_manager_batch_entry_append_ExpectAndReturn(NULL, RECORD_ID, sizeof(m_entry), p_fm_entry[0]);
+    flash_manager_batch_entry_append_IgnoreArg_p_batch();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_write(&m_file, m_entry, sizeof(m_entry)));
+
+    m_file.curr_pos = RECORD_ID + 1;
+    flash_manager_batch_entry_append_ExpectAndReturn(NULL, RECORD_ID + 1, sizeof(m_entry), p_fm_entry[1]);
+    flash_manager_batch_entry_append_IgnoreArg_p_batch();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_write(&m_file, m_entry, sizeof(m_entry)));
+
+    /* When the batch is full, it's committed. If there's no room for a new batch, the record is
+     * written on its own: */
+    m_file.curr_pos = RECORD_ID + 2;
+    flash_manager_batch_entry_append_ExpectAndReturn(NULL, RECORD_ID + 2, sizeof(m_entry), NULL);
+    flash_manager_batch_entry_append_IgnoreArg_p_batch();
+    flash_manager_batch_commit_Expect(NULL);
+    flash_manager_batch_commit_IgnoreArg_p_batch();
+    flash_manager_batch_begin_ExpectAndReturn(NULL, &m_file.glue_data.flash_manager, MESH_CONFIG_BATCH_SIZE, NRF_ERROR_NO_MEM);
+    flash_manager_batch_begin_IgnoreArg_p_batch();
+    flash_manager_entry_alloc_ExpectAndReturn(&m_file.glue_data.flash_manager, RECORD_ID + 2, sizeof(m_entry), p_fm_entry[2]);
+    flash_manager_entry_commit_Expect(p_fm_entry[2]);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_write(&m_file, m_entry, sizeof(m_entry)));
+
+    /* Nothing left to commit: */
+    mesh_config_backend_records_batch_end();
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT_EQUAL_MEMORY(m_entry, p_fm_entry[i]->data, sizeof(m_entry));
+    }
+
+    /* Erasing a record commits the open batch first, and the batch is committed at the end: */
+    mesh_config_backend_records_batch_begin();
+    m_file.curr_pos = RECORD_ID;
+    flash_manager_batch_begin_ExpectAndReturn(NULL, &m_file.glue_data.flash_manager, MESH_CONFIG_BATCH_SIZE, NRF_SUCCESS);
+    flash_manager_batch_begin_IgnoreArg_p_batch();
+    flash_manager_batch_entry_append_ExpectAndReturn(NULL, RECORD_ID, sizeof(m_entry), p_fm_entry[0]);
+    flash_manager_batch_entry_append_IgnoreArg_p_batch();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_write(&m_file, m_entry, sizeof(m_entry)));
+
+    m_file.curr_pos = RECORD_ID + 1;
+    fm_handle_filter_t filter = {
+        .mask = 0xffff,
+        .match = m_file.curr_pos,
+    };
+    flash_manager_entry_count_get_ExpectAndReturn(&m_file.glue_data.flash_manager, &filter, 1);
+    flash_manager_batch_commit_Expect(NULL);
+    flash_manager_batch_commit_IgnoreArg_p_batch();
+    flash_manager_entry_invalidate_ExpectAndReturn(&m_file.glue_data.flash_manager, m_file.curr_pos, NRF_SUCCESS);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_erase(&m_file));
+
+    m_file.curr_pos = RECORD_ID + 2;
+    flash_manager_batch_begin_ExpectAndReturn(NULL, &m_file.glue_data.flash_manager, MESH_CONFIG_BATCH_SIZE, NRF_SUCCESS);
+    flash_manager_batch_begin_IgnoreArg_p_batch();
+    flash_manager_batch_entry_append_ExpectAndReturn(NULL, RECORD_ID + 2, sizeof(m_entry), p_fm_entry[2]);
+    flash_manager_batch_entry_append_IgnoreArg_p_batch();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_write(&m_file, m_entry, sizeof(m_entry)));
+
+    flash_manager_batch_commit_Expect(NULL);
+    flash_manager_batch_commit_IgnoreArg_p_batch();
+    mesh_config_backend_records_batch_end();
+
+    /* Outside of a batch, records are written on their own: */
+    flash_manager_entry_alloc_ExpectAndReturn(&m_file.glue_data.flash_manager, RECORD_ID + 2, sizeof(m_entry), p_fm_entry[2]);
+    flash_manager_entry_commit_Expect(p_fm_entry[2]);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, mesh_config_backend_record_write(&m_file, m_entry, sizeof(m_entry)));
+
+    m_file.curr_pos = RECORD_ID;
+    free(p_fm_entries);
+}
+
 void test_record_erase(void)
 {
     fm_handle_filter_t filter = {
@@ -0,0 +1,210 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mesh_lpn_poll_policy.h"
+
+#include <string.h>
+#include <unity.h>
+#include "utils.h"
+
+#define MIN_INTERVAL_MS  2000
+#define MAX_INTERVAL_MS  60000
+
+/* Simulation parameters */
+#define SIM_DURATION_MS         (24 * 60 * 60 * 1000ul)
+#define SIM_BURST_INTERVAL_MS   (10 * 60 * 1000ul)
+#define SIM_BURST_LENGTH        5
+#define SIM_BURST_SPACING_MAX_MS 20000
+/** Radio-on time for each response from the Friend node, including the final Friend Update. */
+#define SIM_RESPONSE_SCAN_MS    30
+
+typedef struct
+{
+    uint32_t sessions;
+    uint32_t delivered;
+    uint64_t scan_time_ms;
+    uint64_t total_latency_ms;
+} sim_result_t;
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static uint32_t m_rand_state;
+
+/** Deterministic pseudo random number, to keep the simulation results stable. */
+static uint32_t sim_rand(uint32_t max)
+{
+    m_rand_state = m_rand_state * 1664525u + 1013904223u;
+    return (m_rand_state >> 8) % max;
+}
+
+/**
+ * Generates the arrival times of the messages at the Friend node. The messages come in bursts at
+ * random times, with random spacing within each burst.
+ */
+static uint32_t sim_traffic_generate(uint32_t * p_arrivals, uint32_t max_count)
+{
+    uint32_t count = 0;
+    m_rand_state = 1;
+    for (uint32_t burst = 0; burst < SIM_DURATION_MS / SIM_BURST_INTERVAL_MS; ++burst)
+    {
+        uint32_t time = burst * SIM_BURST_INTERVAL_MS + sim_rand(SIM_BURST_INTERVAL_MS / 2);
+        for (uint32_t i = 0; i < SIM_BURST_LENGTH && count < max_count; ++i)
+        {
+            p_arrivals[count++] = time;
+            time += 1 + sim_rand(SIM_BURST_SPACING_MAX_MS);
+        }
+    }
+    return count;
+}
+
+/**
+ * Simulates an LPN that empties the Friend Queue in each poll session, with messages arriving in
+ * bursts at the Friend node.
+ */
+static void simulate(const uint32_t * p_arrivals,
+                     uint32_t msg_count,
+                     uint32_t min_interval_ms,
+                     uint32_t max_interval_ms,
+                     sim_result_t * p_result)
+{
+    mesh_lpn_poll_policy_t policy;
+    mesh_lpn_poll_policy_reset(&policy, min_interval_ms, max_interval_ms);
+    memset(p_result, 0, sizeof(*p_result));
+
+    uint32_t next_msg = 0;
+    uint32_t now = max_interval_ms;
+    while (now < SIM_DURATION_MS)
+    {
+        uint32_t delivered = 0;
+        while (next_msg < msg_count && p_arrivals[next_msg] <= now)
+        {
+            p_result->total_latency_ms += now - p_arrivals[next_msg];
+            next_msg++;
+            delivered++;
+        }
+
+        p_result->sessions++;
+        p_result->delivered += delivered;
+        p_result->scan_time_ms += (delivered + 1) * SIM_RESPONSE_SCAN_MS;
+
+        now += mesh_lpn_poll_policy_next(&policy, delivered > 0, max_interval_ms);
+    }
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_fixed(void)
+{
+    mesh_lpn_poll_policy_t policy;
+    mesh_lpn_poll_policy_reset(&policy, 0, MAX_INTERVAL_MS);
+
+    TEST_ASSERT_EQUAL(MAX_INTERVAL_MS, mesh_lpn_poll_policy_next(&policy, true, MAX_INTERVAL_MS));
+    TEST_ASSERT_EQUAL(MAX_INTERVAL_MS, mesh_lpn_poll_policy_next(&policy, false, MAX_INTERVAL_MS));
+    /* Follows changes to the poll interval: */
+    TEST_ASSERT_EQUAL(1000, mesh_lpn_poll_policy_next(&policy, true, 1000));
+
+    /* The adaptive policy falls back to the fixed interval if the minimum is too high: */
+    mesh_lpn_poll_policy_reset(&policy, MAX_INTERVAL_MS, MAX_INTERVAL_MS);
+    TEST_ASSERT_EQUAL(MAX_INTERVAL_MS, mesh_lpn_poll_policy_next(&policy, true, MAX_INTERVAL_MS));
+    TEST_ASSERT_EQUAL(MAX_INTERVAL_MS / 2, mesh_lpn_poll_policy_next(&policy, true, MAX_INTERVAL_MS / 2));
+}
+
+void test_adaptive(void)
+{
+    mesh_lpn_poll_policy_t policy;
+    mesh_lpn_poll_policy_reset(&policy, MIN_INTERVAL_MS, MAX_INTERVAL_MS);
+
+    /* Fast follow-up after data: */
+    TEST_ASSERT_EQUAL(MIN_INTERVAL_MS, mesh_lpn_poll_policy_next(&policy, true, MAX_INTERVAL_MS));
+    TEST_ASSERT_EQUAL(MIN_INTERVAL_MS, mesh_lpn_poll_policy_next(&policy, true, MAX_INTERVAL_MS));
+
+    /* Exponential backoff when the queue is empty, bounded by the poll interval: */
+    uint32_t expected = MIN_INTERVAL_MS;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        expected = MIN(expected * 2, MAX_INTERVAL_MS);
+        TEST_ASSERT_EQUAL(expected, mesh_lpn_poll_policy_next(&policy, false, MAX_INTERVAL_MS));
+    }
+    TEST_ASSERT_EQUAL(MAX_INTERVAL_MS, expected);
+
+    /* Shortening the poll interval takes effect immediately: */
+    TEST_ASSERT_EQUAL(10000, mesh_lpn_poll_policy_next(&policy, false, 10000));
+
+    /* No overflow on very long intervals: */
+    mesh_lpn_poll_policy_reset(&policy, MIN_INTERVAL_MS, UINT32_MAX - 1);
+    TEST_ASSERT_EQUAL(UINT32_MAX - 1, mesh_lpn_poll_policy_next(&policy, false, UINT32_MAX - 1));
+    TEST_ASSERT_EQUAL(UINT32_MAX - 1, mesh_lpn_poll_policy_next(&policy, false, UINT32_MAX - 1));
+}
+
+void test_simulation(void)
+{
+    static uint32_t arrivals[(SIM_DURATION_MS / SIM_BURST_INTERVAL_MS) * SIM_BURST_LENGTH];
+    uint32_t msg_count = sim_traffic_generate(arrivals, ARRAY_SIZE(arrivals));
+    sim_result_t fixed_long;
+    sim_result_t fixed_short;
+    sim_result_t adaptive;
+
+    simulate(arrivals, msg_count, 0, MAX_INTERVAL_MS, &fixed_long);
+    simulate(arrivals, msg_count, 0, MIN_INTERVAL_MS, &fixed_short);
+    simulate(arrivals, msg_count, MIN_INTERVAL_MS, MAX_INTERVAL_MS, &adaptive);
+
+    /* All schemes deliver the same messages: */
+    TEST_ASSERT_EQUAL(msg_count, fixed_long.delivered);
+    TEST_ASSERT_EQUAL(msg_count, fixed_short.delivered);
+    TEST_ASSERT_EQUAL(msg_count, adaptive.delivered);
+
+    /* The adaptive scheme stays close to the radio-on time of the long fixed interval... */
+    TEST_ASSERT_TRUE(adaptive.scan_time_ms < 2 * fixed_long.scan_time_ms);
+    TEST_ASSERT_TRUE(adaptive.scan_time_ms * 10 < fixed_short.scan_time_ms);
+
+    /* ...while cutting the average delivery latency of bursty traffic. */
+    TEST_ASSERT_TRUE(adaptive.total_latency_ms * 4 < fixed_long.total_latency_ms * 3);
+}
@@ -414,11 +414,8 @@ void test_packet_in(void)
         net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
         TEST_ASSERT_EQUAL(1, sample_data.info.p_tx_info->rx_count);
 
-        /* Try again, should bump the tx count */
+        /* Try again, should bump the tx count without calculating the CMAC again */
         m_info_index = 0;
-        enc_aes_cmac_ExpectWithArray(sample_data.info.secmat.key, NRF_MESH_KEY_SIZE, sample_data.beacon, 13, 13, NULL, 0);
-        enc_aes_cmac_IgnoreArg_p_result();
-        enc_aes_cmac_ReturnMemThruPtr_p_result(sample_data.auth, 16);
         event_handle_Expect(&evt);
         net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
         TEST_ASSERT_EQUAL(2, sample_data.info.p_tx_info->rx_count);
@@ -426,9 +423,6 @@ void test_packet_in(void)
         /* Try again without permitting IV update. Should still produce an event, and should count the RX */
         sample_data.info.iv_update_permitted = false;
         m_info_index = 0;
-        enc_aes_cmac_ExpectWithArray(sample_data.info.secmat.key, NRF_MESH_KEY_SIZE, sample_data.beacon, 13, 13, NULL, 0);
-        enc_aes_cmac_IgnoreArg_p_result();
-        enc_aes_cmac_ReturnMemThruPtr_p_result(sample_data.auth, 16);
         event_handle_Expect(&evt);
         net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
         TEST_ASSERT_EQUAL(3, sample_data.info.p_tx_info->rx_count);
@@ -438,9 +432,6 @@ void test_packet_in(void)
         m_info_index = 0;
         sample_data.info.iv_update_permitted = true;
         sample_data.info.p_tx_info->rx_count = 0xFFFF;
-        enc_aes_cmac_ExpectWithArray(sample_data.info.secmat.key, NRF_MESH_KEY_SIZE, sample_data.beacon, 13, 13, NULL, 0);
-        enc_aes_cmac_IgnoreArg_p_result();
-        enc_aes_cmac_ReturnMemThruPtr_p_result(sample_data.auth, 16);
         event_handle_Expect(&evt);
         net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
         TEST_ASSERT_EQUAL(0xFFFF, sample_data.info.p_tx_info->rx_count);
@@ -448,14 +439,28 @@ void test_packet_in(void)
         /* Invalid auth, shouldn't handle the beacon: */
         uint8_t dummy_auth[NRF_MESH_KEY_SIZE];
         memset(dummy_auth, 0xDA, NRF_MESH_KEY_SIZE);
+        memcpy(&sample_data.beacon[13], dummy_auth, NET_BEACON_CMAC_SIZE);
         sample_data.info.p_tx_info->rx_count = 0;
         m_info_index = 0;
         enc_aes_cmac_ExpectWithArray(sample_data.info.secmat.key, NRF_MESH_KEY_SIZE, sample_data.beacon, 13, 13, NULL, 0);
         enc_aes_cmac_IgnoreArg_p_result();
-        enc_aes_cmac_ReturnMemThruPtr_p_result(dummy_auth, 16);
+        enc_aes_cmac_ReturnMemThruPtr_p_result(sample_data.auth, 16);
+        net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
+        TEST_ASSERT_EQUAL(0, sample_data.info.p_tx_info->rx_count);
+
+        /* Invalid beacons are never cached: */
+        m_info_index = 0;
+        enc_aes_cmac_ExpectWithArray(sample_data.info.secmat.key, NRF_MESH_KEY_SIZE, sample_data.beacon, 13, 13, NULL, 0);
+        enc_aes_cmac_IgnoreArg_p_result();
+        enc_aes_cmac_ReturnMemThruPtr_p_result(sample_data.auth, 16);
         net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
         TEST_ASSERT_EQUAL(0, sample_data.info.p_tx_info->rx_count);
     }
+
+    net_beacon_auth_cache_stats_t stats;
+    net_beacon_auth_cache_stats_get(&stats);
+    TEST_ASSERT_EQUAL(3 * ARRAY_SIZE(sample_datas), stats.hits);
+    TEST_ASSERT_EQUAL(3 * ARRAY_SIZE(sample_datas), stats.misses);
 }
 
 void test_pkt_in_multi(void)
@@ -521,6 +526,18 @@ void test_pkt_in_multi(void)
     TEST_ASSERT_EQUAL(1, tx_infos[0].rx_count);
     TEST_ASSERT_EQUAL(0, tx_infos[1].rx_count); /* Had invalid auth, didn't get a match */
     TEST_ASSERT_EQUAL(1, tx_infos[2].rx_count);
+
+    /* The same beacon again. Only the network that failed verification needs a new CMAC: */
+    m_info_index = 0;
+    enc_aes_cmac_ExpectWithArray(p_info[1]->secmat.key, NRF_MESH_KEY_SIZE, sample_data.beacon, 13, 13, NULL, 0);
+    enc_aes_cmac_IgnoreArg_p_result();
+    enc_aes_cmac_ReturnMemThruPtr_p_result(stored_beacons[1].auth, 16);
+    event_handle_Expect(&evt[0]);
+    event_handle_Expect(&evt[2]);
+    net_beacon_packet_in(sample_data.beacon, sizeof(sample_data.beacon), NULL);
+    TEST_ASSERT_EQUAL(2, tx_infos[0].rx_count);
+    TEST_ASSERT_EQUAL(0, tx_infos[1].rx_count);
+    TEST_ASSERT_EQUAL(2, tx_infos[2].rx_count);
 }
 
 void test_beacon_state_change(void)
@@ -457,7 +457,7 @@ void test_packet_in(void)
         static const uint32_t expected_statuses[] = {
             [STEP_LENGTH_CHECK] = NRF_ERROR_INVALID_LENGTH,
             [STEP_DEOBFUSCATION_VERIFICATION] = NRF_ERROR_NOT_FOUND,
-            [STEP_MSG_CACHE] = NRF_ERROR_NOT_FOUND,
+            [STEP_MSG_CACHE] = NRF_ERROR_INVALID_STATE,
             [STEP_DECRYPTION] = NRF_ERROR_NOT_FOUND,
             [STEP_SUCCESS] = NRF_SUCCESS,
         };
@@ -47,6 +47,7 @@
 
 #include "log.h"
 #include "packet_mesh.h"
+#include "perf_counter.h"
 
 #include "core_tx_mock.h"
 #include "core_tx_adv_mock.h"
@@ -112,6 +113,7 @@ void setUp(void)
     mesh_lpn_mock_Init();
 
     core_tx_packet_alloc_StubWithCallback(core_tx_packet_alloc_mock);
+    perf_counter_clear();
 }
 
 void tearDown(void)
@@ -438,6 +440,92 @@ void test_discard(void)
     }
 }
 
+void test_encrypt(void)
+{
+    nrf_mesh_network_secmat_t secmat;
+    network_packet_metadata_t metadata;
+    packet_mesh_net_packet_t packet;
+    uint8_t payload[PACKET_MESH_NET_PDU_MAX_SIZE];
+    memset(payload, 0xAB, sizeof(payload));
+    memset(&metadata, 0, sizeof(metadata));
+    metadata.p_security_material = &secmat;
+
+    for (uint32_t control = 0; control < 2U; ++control)
+    {
+        uint8_t len = (control ? 12 : 16);
+        metadata.control_packet = control;
+        memset(&packet, 0, sizeof(packet));
+
+        net_packet_header_set_Expect(&packet, &metadata);
+        net_packet_encrypt_Expect(&metadata, len, &packet, NET_PACKET_KIND_TRANSPORT);
+        network_packet_encrypt(&metadata, payload, len, packet.pdu);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, &packet.pdu[9], len);
+    }
+
+    /* Doesn't fit in a network packet: */
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypt(&metadata, payload, 13, packet.pdu));
+    /* Invalid params */
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypt(NULL, payload, 10, packet.pdu));
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypt(&metadata, NULL, 10, packet.pdu));
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypt(&metadata, payload, 10, NULL));
+    metadata.p_security_material = NULL;
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypt(&metadata, payload, 10, packet.pdu));
+}
+
+void test_encrypted_send(void)
+{
+    nrf_mesh_network_secmat_t secmat;
+    network_packet_metadata_t metadata;
+    network_tx_packet_buffer_t buffer;
+    uint8_t encrypted[PACKET_MESH_NET_MAX_SIZE];
+    uint8_t tx_packet[PACKET_MESH_NET_MAX_SIZE];
+    uint8_t len = 10;
+
+    for (uint32_t i = 0; i < sizeof(encrypted); ++i)
+    {
+        encrypted[i] = i;
+    }
+
+    memset(&metadata, 0, sizeof(metadata));
+    metadata.p_security_material = &secmat;
+    buffer.user_data.p_metadata      = &metadata;
+    buffer.user_data.token           = NRF_MESH_RELAY_TOKEN;
+    buffer.user_data.payload_len     = len;
+    buffer.user_data.role            = CORE_TX_ROLE_RELAY;
+    buffer.user_data.bearer_selector = CORE_TX_BEARER_TYPE_FRIEND;
+    buffer.p_payload                 = NULL;
+
+    for (uint32_t control = 0; control < 2U; ++control)
+    {
+        uint32_t net_packet_len = 9 + len + (control ? 8 : 4);
+        metadata.control_packet = control;
+        memset(tx_packet, 0, sizeof(tx_packet));
+
+        /* The encrypted packet is copied as-is, without any encryption: */
+        packet_alloc_Expect(&metadata, net_packet_len, tx_packet, CORE_TX_ROLE_RELAY, true, CORE_TX_BEARER_TYPE_FRIEND);
+        core_tx_packet_send_Expect();
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, network_packet_encrypted_send(&buffer, encrypted));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(encrypted, tx_packet, net_packet_len);
+        TEST_ASSERT_EQUAL_HEX8(0, tx_packet[net_packet_len]);
+
+        packet_alloc_Expect(&metadata, net_packet_len, tx_packet, CORE_TX_ROLE_RELAY, false, CORE_TX_BEARER_TYPE_FRIEND);
+        TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, network_packet_encrypted_send(&buffer, encrypted));
+    }
+
+    /* Only relayed packets keep their sequence number: */
+    buffer.user_data.role = CORE_TX_ROLE_ORIGINATOR;
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypted_send(&buffer, encrypted));
+    buffer.user_data.role = CORE_TX_ROLE_RELAY;
+    /* Invalid params */
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypted_send(NULL, encrypted));
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypted_send(&buffer, NULL));
+    buffer.user_data.bearer_selector = CORE_TX_BEARER_TYPE_INVALID;
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypted_send(&buffer, encrypted));
+    buffer.user_data.bearer_selector = CORE_TX_BEARER_TYPE_FRIEND;
+    buffer.user_data.p_metadata = NULL;
+    TEST_NRF_MESH_ASSERT_EXPECT(network_packet_encrypted_send(&buffer, encrypted));
+}
+
 /**
  * Test packet in function, to make sure it parses the header and calls the encryption module
  * correctly, as well as discarding packets correctly.
@@ -566,6 +654,7 @@ void test_packet_in(void)
             }
         }
 
+        perf_counter_clear();
         network_packet_in(net_packet.pdu, vector[i].length, &rx_meta);
 
         TEST_ASSERT_EQUAL(0, m_transport_packet_in_expect.calls);
@@ -575,6 +664,60 @@ void test_packet_in(void)
         nrf_mesh_externs_mock_Verify();
         net_packet_mock_Verify();
         friend_internal_mock_Verify();
+
+        TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_NET_RX]);
+        TEST_ASSERT_EQUAL(vector[i].fail_step == STEP_DECRYPTION, g_perf_counters[PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED]);
+        TEST_ASSERT_EQUAL(0, g_perf_counters[PERF_COUNTER_NET_RX_DROP_CACHE]);
+        TEST_ASSERT_EQUAL(vector[i].fail_step == STEP_SUCCESS, g_perf_counters[PERF_COUNTER_NET_RELAY]);
+        TEST_ASSERT_EQUAL(vector[i].fail_step == STEP_SUCCESS, g_perf_counters[PERF_COUNTER_NET_TX]);
+        TEST_ASSERT_EQUAL(vector[i].fail_step == STEP_PACKET_ALLOC, g_perf_counters[PERF_COUNTER_NET_RELAY_DROP_NO_MEM]);
+    }
+}
+
+/* Every dropped packet is counted once, under the reason it was dropped for. */
+void test_packet_in_drop_counters(void)
+{
+    nrf_mesh_network_secmat_t secmat;
+    secmat.nid = 0xAF;
+    struct
+    {
+        network_packet_metadata_t meta;
+        uint32_t decrypt_status;
+        perf_counter_id_t counter;
+    } vector[] = {
+        {{{NRF_MESH_ADDRESS_TYPE_GROUP, 0xFFFF}, 0x0001, 5, false, {SEQNUM, IV_INDEX}, &secmat}, NRF_ERROR_INVALID_LENGTH, PERF_COUNTER_NET_RX_DROP_LENGTH},
+        {{{NRF_MESH_ADDRESS_TYPE_GROUP, 0xFFFF}, 0x0001, 5, false, {SEQNUM, IV_INDEX}, &secmat}, NRF_ERROR_INVALID_STATE, PERF_COUNTER_NET_RX_DROP_CACHE},
+        {{{NRF_MESH_ADDRESS_TYPE_GROUP, 0xFFFF}, 0x0001, 5, false, {SEQNUM, IV_INDEX}, &secmat}, NRF_ERROR_NOT_FOUND, PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED},
+        {{{NRF_MESH_ADDRESS_TYPE_VIRTUAL, 0x8000}, 0x0001, 5, true, {SEQNUM, IV_INDEX}, &secmat}, NRF_SUCCESS, PERF_COUNTER_NET_RX_DROP_INVALID}, /* Virtual address used in control packet */
+    };
+    static const perf_counter_id_t drop_counters[] = {
+        PERF_COUNTER_NET_RX_DROP_LENGTH,
+        PERF_COUNTER_NET_RX_DROP_CACHE,
+        PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED,
+        PERF_COUNTER_NET_RX_DROP_INVALID,
+    };
+    nrf_mesh_rx_metadata_t rx_meta;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(vector); ++i)
+    {
+        packet_mesh_net_packet_t net_packet;
+        memset(&net_packet, 0xAB, sizeof(net_packet));
+
+        net_packet_obfuscation_start_get_ExpectAndReturn(&net_packet, &net_packet.pdu[1]);
+        net_packet_decrypt_ExpectAndReturn(NULL, 18, &net_packet, NULL, NET_PACKET_KIND_TRANSPORT, vector[i].decrypt_status);
+        net_packet_decrypt_IgnoreArg_p_net_decrypted_packet();
+        net_packet_decrypt_IgnoreArg_p_net_metadata();
+        net_packet_decrypt_ReturnThruPtr_p_net_metadata(&vector[i].meta);
+
+        perf_counter_clear();
+        network_packet_in(net_packet.pdu, 18, &rx_meta);
+        net_packet_mock_Verify();
+
+        TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_NET_RX]);
+        for (uint32_t j = 0; j < ARRAY_SIZE(drop_counters); ++j)
+        {
+            TEST_ASSERT_EQUAL(drop_counters[j] == vector[i].counter, g_perf_counters[drop_counters[j]]);
+        }
     }
 }
 
@@ -0,0 +1,207 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "packet_trace.h"
+
+#include <string.h>
+#include <unity.h>
+#include "nrf_error.h"
+#include "utils.h"
+#include "nordic_common.h"
+
+#include "timer_mock.h"
+
+#define RX_TIMESTAMP 1000
+
+/*****************************************************************************
+* Static globals
+*****************************************************************************/
+static timestamp_t m_time_now;
+
+/*****************************************************************************
+* Mock functions
+*****************************************************************************/
+static timestamp_t timer_now_cb(int num_calls)
+{
+    return m_time_now;
+}
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    timer_mock_Init();
+    timer_now_StubWithCallback(timer_now_cb);
+    m_time_now = RX_TIMESTAMP;
+    packet_trace_reset();
+}
+
+void tearDown(void)
+{
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static void record_verify(const packet_trace_record_t * p_record,
+                          uint16_t id,
+                          packet_trace_stage_t stage,
+                          uint32_t value)
+{
+    TEST_ASSERT_EQUAL(id, p_record->id);
+    TEST_ASSERT_EQUAL(stage, p_record->stage);
+    TEST_ASSERT_EQUAL(value, p_record->value);
+    TEST_ASSERT_EQUAL(0, p_record->_rfu);
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_rx(void)
+{
+    packet_trace_record_t records[8];
+
+    /* No records without a packet: */
+    packet_trace_rx_stage(PACKET_TRACE_STAGE_NET_DECRYPT);
+    TEST_ASSERT_EQUAL(0, packet_trace_read(records, ARRAY_SIZE(records)));
+
+    m_time_now = RX_TIMESTAMP + 100;
+    packet_trace_rx_begin(RX_TIMESTAMP);
+    packet_trace_rx_stage(PACKET_TRACE_STAGE_FILTER);
+    m_time_now += 10;
+    packet_trace_rx_stage(PACKET_TRACE_STAGE_NET_DECRYPT);
+    m_time_now += 10;
+    packet_trace_rx_stage(PACKET_TRACE_STAGE_TRANSPORT);
+    m_time_now += 10;
+    packet_trace_rx_stage(PACKET_TRACE_STAGE_ACCESS);
+    packet_trace_rx_end();
+
+    /* Stages after the packet is done are ignored: */
+    packet_trace_rx_stage(PACKET_TRACE_STAGE_ACCESS);
+
+    /* Second packet gets the next ID, and only gets the filter stage if it's a mesh packet: */
+    packet_trace_rx_begin(RX_TIMESTAMP + 200);
+    packet_trace_rx_end();
+
+    TEST_ASSERT_EQUAL(6, packet_trace_read(records, ARRAY_SIZE(records)));
+    record_verify(&records[0], 1, PACKET_TRACE_STAGE_SCANNER_RX, RX_TIMESTAMP);
+    record_verify(&records[1], 1, PACKET_TRACE_STAGE_FILTER, RX_TIMESTAMP + 100);
+    record_verify(&records[2], 1, PACKET_TRACE_STAGE_NET_DECRYPT, RX_TIMESTAMP + 110);
+    record_verify(&records[3], 1, PACKET_TRACE_STAGE_TRANSPORT, RX_TIMESTAMP + 120);
+    record_verify(&records[4], 1, PACKET_TRACE_STAGE_ACCESS, RX_TIMESTAMP + 130);
+    record_verify(&records[5], 2, PACKET_TRACE_STAGE_SCANNER_RX, RX_TIMESTAMP + 200);
+
+    /* The records were consumed: */
+    TEST_ASSERT_EQUAL(0, packet_trace_read(records, ARRAY_SIZE(records)));
+    TEST_ASSERT_EQUAL(0, packet_trace_dropped_get());
+}
+
+void test_tx(void)
+{
+    packet_trace_record_t records[8];
+
+    /* Locally originated packet: */
+    uint16_t local_id = packet_trace_tx_begin();
+    TEST_ASSERT_EQUAL(1, local_id);
+
+    /* Relayed packet: */
+    packet_trace_rx_begin(RX_TIMESTAMP);
+    m_time_now += 50;
+    uint16_t relay_id = packet_trace_tx_begin();
+    TEST_ASSERT_EQUAL(3, relay_id);
+    packet_trace_tx_stage(relay_id, PACKET_TRACE_STAGE_ADV_QUEUE, RX_TIMESTAMP + 60);
+    packet_trace_rx_end();
+
+    packet_trace_tx_stage(relay_id, PACKET_TRACE_STAGE_RADIO_TX, RX_TIMESTAMP + 5000);
+    /* Packets that weren't traced are ignored: */
+    packet_trace_tx_stage(0, PACKET_TRACE_STAGE_RADIO_TX, RX_TIMESTAMP + 5000);
+
+    TEST_ASSERT_EQUAL(6, packet_trace_read(records, ARRAY_SIZE(records)));
+    record_verify(&records[0], local_id, PACKET_TRACE_STAGE_CORE_TX_ALLOC, RX_TIMESTAMP);
+    record_verify(&records[1], 2, PACKET_TRACE_STAGE_SCANNER_RX, RX_TIMESTAMP);
+    record_verify(&records[2], relay_id, PACKET_TRACE_STAGE_CORE_TX_ALLOC, RX_TIMESTAMP + 50);
+    record_verify(&records[3], relay_id, PACKET_TRACE_STAGE_TX_ORIGIN, 2);
+    record_verify(&records[4], relay_id, PACKET_TRACE_STAGE_ADV_QUEUE, RX_TIMESTAMP + 60);
+    record_verify(&records[5], relay_id, PACKET_TRACE_STAGE_RADIO_TX, RX_TIMESTAMP + 5000);
+}
+
+void test_id_wrap(void)
+{
+    for (uint32_t i = 1; i <= UINT16_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL(i, packet_trace_tx_begin());
+    }
+    /* ID 0 is reserved for untraced packets: */
+    TEST_ASSERT_EQUAL(1, packet_trace_tx_begin());
+}
+
+void test_overflow(void)
+{
+    packet_trace_record_t records[PACKET_TRACE_BUFFER_SIZE];
+
+    TEST_ASSERT_EQUAL(0, packet_trace_read(NULL, 0));
+
+    for (uint32_t i = 0; i < PACKET_TRACE_BUFFER_SIZE + 3; i++)
+    {
+        packet_trace_tx_stage(1, PACKET_TRACE_STAGE_RADIO_TX, i);
+    }
+    TEST_ASSERT_EQUAL(3, packet_trace_dropped_get());
+
+    /* Read out in chunks, across the buffer wrap: */
+    TEST_ASSERT_EQUAL(5, packet_trace_read(records, 5));
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        packet_trace_tx_stage(1, PACKET_TRACE_STAGE_RADIO_TX, PACKET_TRACE_BUFFER_SIZE + i);
+    }
+    TEST_ASSERT_EQUAL(3, packet_trace_dropped_get());
+    TEST_ASSERT_EQUAL(PACKET_TRACE_BUFFER_SIZE, packet_trace_read(records, ARRAY_SIZE(records)));
+    for (uint32_t i = 0; i < PACKET_TRACE_BUFFER_SIZE; i++)
+    {
+        record_verify(&records[i], 1, PACKET_TRACE_STAGE_RADIO_TX, i + 5);
+    }
+
+    /* Reset drops all records and restarts the IDs: */
+    packet_trace_tx_stage(1, PACKET_TRACE_STAGE_RADIO_TX, 0);
+    packet_trace_reset();
+    TEST_ASSERT_EQUAL(0, packet_trace_dropped_get());
+    TEST_ASSERT_EQUAL(0, packet_trace_read(records, ARRAY_SIZE(records)));
+    TEST_ASSERT_EQUAL(1, packet_trace_tx_begin());
+}
@@ -0,0 +1,186 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf_counter.h"
+
+#include <string.h>
+#include <unity.h>
+#include "nrf_error.h"
+#include "log.h"
+#include "utils.h"
+#include "nordic_common.h"
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    __LOG_INIT(LOG_SRC_CORE, LOG_LEVEL_REPORT, LOG_CALLBACK_DEFAULT);
+    perf_counter_clear();
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static uint32_t counter_get(perf_counter_id_t id)
+{
+    uint32_t value;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_counters_get(id, 1, &value));
+    return value;
+}
+
+/** Simulates the processing of a received network PDU. */
+static void simulated_rx(bool authenticated, bool relay)
+{
+    PERF_COUNTER_INC(PERF_COUNTER_SCANNER_RX);
+    PERF_COUNTER_INC(PERF_COUNTER_NET_RX);
+    PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_AES_ECB);
+    PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_CCM_DECRYPT);
+    if (!authenticated)
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_CCM_MIC_FAIL);
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED);
+        return;
+    }
+
+    PERF_COUNTER_INC(PERF_COUNTER_TRS_RX);
+    if (relay)
+    {
+        PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_AES_ECB);
+        PERF_COUNTER_INC(PERF_COUNTER_CRYPTO_CCM_ENCRYPT);
+        PERF_COUNTER_INC(PERF_COUNTER_NET_TX);
+        PERF_COUNTER_INC(PERF_COUNTER_NET_RELAY);
+    }
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_counters(void)
+{
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        simulated_rx((i % 10) != 0, (i % 4) == 0);
+    }
+
+    TEST_ASSERT_EQUAL(100, counter_get(PERF_COUNTER_SCANNER_RX));
+    TEST_ASSERT_EQUAL(100, counter_get(PERF_COUNTER_NET_RX));
+    TEST_ASSERT_EQUAL(10, counter_get(PERF_COUNTER_NET_RX_DROP_UNAUTHENTICATED));
+    TEST_ASSERT_EQUAL(10, counter_get(PERF_COUNTER_CRYPTO_CCM_MIC_FAIL));
+    TEST_ASSERT_EQUAL(90, counter_get(PERF_COUNTER_TRS_RX));
+    /* Every 4th packet is relayed, except the ones that failed authentication (0, 20, 40, 60, 80). */
+    TEST_ASSERT_EQUAL(20, counter_get(PERF_COUNTER_NET_RELAY));
+    TEST_ASSERT_EQUAL(20, counter_get(PERF_COUNTER_NET_TX));
+    TEST_ASSERT_EQUAL(120, counter_get(PERF_COUNTER_CRYPTO_AES_ECB));
+    TEST_ASSERT_EQUAL(0, counter_get(PERF_COUNTER_SCANNER_DROP_CRC));
+
+    uint32_t values[PERF_COUNTER__LAST];
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_counters_get(0, PERF_COUNTER__LAST, values));
+    TEST_ASSERT_EQUAL(100, values[PERF_COUNTER_SCANNER_RX]);
+    TEST_ASSERT_EQUAL(20, values[PERF_COUNTER_NET_RELAY]);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_counters_get(PERF_COUNTER__LAST, 0, values));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, perf_counters_get(0, PERF_COUNTER__LAST + 1, values));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, perf_counters_get(PERF_COUNTER__LAST, 1, values));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, perf_counters_get(1, UINT32_MAX, values));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, perf_counters_get(0, 1, NULL));
+
+    perf_counter_dump();
+
+    perf_counter_clear();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_counters_get(0, PERF_COUNTER__LAST, values));
+    for (uint32_t i = 0; i < PERF_COUNTER__LAST; i++)
+    {
+        TEST_ASSERT_EQUAL(0, values[i]);
+    }
+}
+
+void test_histograms(void)
+{
+    const uint32_t lateness_us[] = {0, 0, 1, 2, 3, 4, 7, 8, 100, 16383, 16384, 1000000};
+    for (uint32_t i = 0; i < ARRAY_SIZE(lateness_us); i++)
+    {
+        PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_LATENESS_US, lateness_us[i]);
+    }
+
+    for (uint32_t depth = 1; depth <= 5; depth++)
+    {
+        PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_BEARER_EVENT_QUEUE_DEPTH, depth);
+    }
+
+    perf_histogram_t histogram;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_histogram_get(PERF_HISTOGRAM_TIMER_LATENESS_US, &histogram));
+    TEST_ASSERT_EQUAL(1000000, histogram.max);
+    TEST_ASSERT_EQUAL(2, histogram.buckets[0]);  /* 0 */
+    TEST_ASSERT_EQUAL(1, histogram.buckets[1]);  /* 1 */
+    TEST_ASSERT_EQUAL(2, histogram.buckets[2]);  /* 2-3 */
+    TEST_ASSERT_EQUAL(2, histogram.buckets[3]);  /* 4-7 */
+    TEST_ASSERT_EQUAL(1, histogram.buckets[4]);  /* 8-15 */
+    TEST_ASSERT_EQUAL(1, histogram.buckets[7]);  /* 64-127 */
+    TEST_ASSERT_EQUAL(1, histogram.buckets[14]); /* 8192-16383 */
+    TEST_ASSERT_EQUAL(2, histogram.buckets[15]); /* 16384 and above */
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < PERF_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        total += histogram.buckets[i];
+    }
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(lateness_us), total);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_histogram_get(PERF_HISTOGRAM_BEARER_EVENT_QUEUE_DEPTH, &histogram));
+    TEST_ASSERT_EQUAL(5, histogram.max);
+    TEST_ASSERT_EQUAL(1, histogram.buckets[1]);
+    TEST_ASSERT_EQUAL(2, histogram.buckets[2]);
+    TEST_ASSERT_EQUAL(2, histogram.buckets[3]);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_histogram_get(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, &histogram));
+    TEST_ASSERT_EQUAL(0, histogram.max);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, perf_histogram_get(PERF_HISTOGRAM__LAST, &histogram));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, perf_histogram_get(PERF_HISTOGRAM_TIMER_LATENESS_US, NULL));
+
+    perf_counter_dump();
+
+    perf_counter_clear();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_histogram_get(PERF_HISTOGRAM_TIMER_LATENESS_US, &histogram));
+    TEST_ASSERT_EQUAL(0, histogram.max);
+    TEST_ASSERT_EQUAL(0, histogram.buckets[0]);
+}
@@ -825,6 +825,40 @@ void test_multiple_bearer(void)
     rx_link_close(&bearer4.prov_bearer, NRF_MESH_PROV_LINK_CLOSE_REASON_SUCCESS, link_id4, true);
 }
 
+void test_multiple_bearer_same_bucket(void)
+{
+    /* Make bearer static so linked list internally won't be corrupted across tests. */
+    static nrf_mesh_prov_bearer_adv_t bearer1;
+    static nrf_mesh_prov_bearer_adv_t bearer2;
+    static nrf_mesh_prov_bearer_adv_t bearer3;
+
+    setup_interface(&bearer1);
+    setup_interface(&bearer2);
+    setup_interface(&bearer3);
+
+    /* All link IDs map to the same lookup bucket. */
+    uint32_t link_id1 = 0x3;
+    uint32_t link_id2 = 0x3 + NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE;
+    uint32_t link_id3 = 0x3 + 2 * NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE;
+
+    tx_link_open(&bearer1.prov_bearer, uuid1, link_id1);
+    tx_link_open(&bearer2.prov_bearer, uuid2, link_id2);
+    tx_link_open(&bearer3.prov_bearer, uuid1, link_id3);
+
+    /* Unknown link ID in the same bucket must not match any of the bearers. */
+    rx_link_ack(&bearer1.prov_bearer, 0x3 + 3 * NRF_MESH_PROV_BEARER_ADV_LINK_HASH_SIZE, false);
+
+    rx_link_ack(&bearer2.prov_bearer, link_id2, true);
+    rx_link_ack(&bearer1.prov_bearer, link_id1, true);
+    rx_link_ack(&bearer3.prov_bearer, link_id3, true);
+
+    /* Remove from the middle of the bucket first. */
+    rx_link_close(&bearer2.prov_bearer, NRF_MESH_PROV_LINK_CLOSE_REASON_SUCCESS, link_id2, true);
+    rx_link_close(&bearer2.prov_bearer, NRF_MESH_PROV_LINK_CLOSE_REASON_SUCCESS, link_id2, false);
+    rx_link_close(&bearer3.prov_bearer, NRF_MESH_PROV_LINK_CLOSE_REASON_SUCCESS, link_id3, true);
+    rx_link_close(&bearer1.prov_bearer, NRF_MESH_PROV_LINK_CLOSE_REASON_SUCCESS, link_id1, true);
+}
+
 void test_packet_send(void)
 {
     /* Make bearer static so linked list internally won't be corrupted across tests. */
@@ -0,0 +1,162 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "prov_keypool.h"
+#include "test_assert.h"
+
+#include "bearer_event_mock.h"
+#include "prov_utils_mock.h"
+
+#define FILL_FLAG 3
+
+static bearer_event_flag_callback_t m_fill_cb;
+static uint8_t m_next_key;
+
+static bearer_event_flag_t bearer_event_flag_add_cb(bearer_event_flag_callback_t cb, int num_calls)
+{
+    TEST_ASSERT_NOT_NULL(cb);
+    /* The flag is only added once. */
+    TEST_ASSERT_EQUAL(0, num_calls);
+    m_fill_cb = cb;
+    return FILL_FLAG;
+}
+
+static uint32_t prov_utils_keys_generate_cb(uint8_t * p_public, uint8_t * p_private, int num_calls)
+{
+    memset(p_public, m_next_key, NRF_MESH_PROV_PUBKEY_SIZE);
+    memset(p_private, m_next_key, NRF_MESH_PROV_PRIVKEY_SIZE);
+    m_next_key++;
+    return NRF_SUCCESS;
+}
+
+static void keys_verify(const uint8_t * p_public, const uint8_t * p_private, uint8_t value)
+{
+    uint8_t expected[NRF_MESH_PROV_PUBKEY_SIZE];
+    memset(expected, value, sizeof(expected));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, p_public, NRF_MESH_PROV_PUBKEY_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, p_private, NRF_MESH_PROV_PRIVKEY_SIZE);
+}
+
+void setUp(void)
+{
+    bearer_event_mock_Init();
+    prov_utils_mock_Init();
+    bearer_event_flag_add_StubWithCallback(bearer_event_flag_add_cb);
+    prov_utils_keys_generate_StubWithCallback(prov_utils_keys_generate_cb);
+    bearer_event_critical_section_begin_Ignore();
+    bearer_event_critical_section_end_Ignore();
+}
+
+void tearDown(void)
+{
+    bearer_event_mock_Verify();
+    bearer_event_mock_Destroy();
+    prov_utils_mock_Verify();
+    prov_utils_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+
+void test_keypool(void)
+{
+    uint8_t public_key[NRF_MESH_PROV_PUBKEY_SIZE];
+    uint8_t private_key[NRF_MESH_PROV_PRIVKEY_SIZE];
+    nrf_mesh_prov_keypool_stats_t stats;
+
+    TEST_NRF_MESH_ASSERT_EXPECT(prov_keypool_keys_get(NULL, private_key));
+    TEST_NRF_MESH_ASSERT_EXPECT(prov_keypool_keys_get(public_key, NULL));
+    TEST_NRF_MESH_ASSERT_EXPECT(prov_keypool_stats_get(NULL));
+
+    /* The pool is filled in the background after init: */
+    m_next_key = 0;
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    prov_keypool_init();
+    TEST_ASSERT_NOT_NULL(m_fill_cb);
+
+    /* One keypair is generated per call to the bearer event callback: */
+    TEST_ASSERT_FALSE(m_fill_cb());
+    TEST_ASSERT_TRUE(m_fill_cb());
+    /* Calling it on a full pool doesn't generate more keys: */
+    TEST_ASSERT_TRUE(m_fill_cb());
+    TEST_ASSERT_EQUAL(2, m_next_key);
+
+    /* Initializing again only restarts the fill, the flag is only added once: */
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    prov_keypool_init();
+
+    /* The first sessions get prefilled keypairs: */
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_keypool_keys_get(public_key, private_key));
+    keys_verify(public_key, private_key, 1);
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_keypool_keys_get(public_key, private_key));
+    keys_verify(public_key, private_key, 0);
+
+    prov_keypool_stats_get(&stats);
+    TEST_ASSERT_EQUAL(2, stats.hits);
+    TEST_ASSERT_EQUAL(0, stats.misses);
+
+    /* The pool is empty, the keypair is generated on request: */
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_keypool_keys_get(public_key, private_key));
+    keys_verify(public_key, private_key, 2);
+
+    prov_keypool_stats_get(&stats);
+    TEST_ASSERT_EQUAL(2, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+
+    /* Refill one keypair and draw it, so the pool is empty again: */
+    TEST_ASSERT_FALSE(m_fill_cb());
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_keypool_keys_get(public_key, private_key));
+    keys_verify(public_key, private_key, 3);
+
+    /* Key generation failure is retried the next time the pool is drawn from: */
+    prov_utils_keys_generate_StubWithCallback(NULL);
+    prov_utils_keys_generate_ExpectAnyArgsAndReturn(NRF_ERROR_INTERNAL);
+    TEST_ASSERT_TRUE(m_fill_cb());
+
+    /* Errors from on-request key generation are forwarded: */
+    prov_utils_keys_generate_ExpectAndReturn(public_key, private_key, NRF_ERROR_INTERNAL);
+    bearer_event_flag_set_Expect(FILL_FLAG);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, prov_keypool_keys_get(public_key, private_key));
+}
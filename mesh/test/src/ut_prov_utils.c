@@ -625,3 +625,59 @@ void test_ecdh_deleter(void)
     TEST_ASSERT_FALSE(result);
 }
 
+static uint32_t m_backend_keys_generate_calls;
+static uint32_t m_backend_shared_secret_calls;
+static uint8_t m_backend_private_key[NRF_MESH_ECDH_PRIVATE_KEY_SIZE];
+
+static uint32_t backend_keys_generate(uint8_t * p_public, uint8_t * p_private)
+{
+    m_backend_keys_generate_calls++;
+    return NRF_SUCCESS;
+}
+
+static uint32_t backend_shared_secret_calculate(const uint8_t * p_peer_public, const uint8_t * p_private, uint8_t * p_shared)
+{
+    TEST_ASSERT_EQUAL_PTR(m_ctx.peer_public_key, p_peer_public);
+    TEST_ASSERT_EQUAL_PTR(m_ctx.p_private_key, p_private);
+    m_backend_shared_secret_calls++;
+    return NRF_ERROR_INTERNAL;
+}
+
+static bool backend_public_key_is_valid(const uint8_t * p_public)
+{
+    return true;
+}
+
+void test_ecc_backend(void)
+{
+    uint8_t pubkey[NRF_MESH_ECDH_PUBLIC_KEY_SIZE];
+    uint8_t shared_secret[NRF_MESH_KEY_SIZE] = {};
+    /* m_ctx outlives the test, so it can't point to a stack buffer. */
+    m_ctx.p_private_key = m_backend_private_key;
+
+    nrf_mesh_prov_ecc_backend_t backend =
+    {
+        .keys_generate = backend_keys_generate,
+        .shared_secret_calculate = backend_shared_secret_calculate,
+        .public_key_is_valid = NULL
+    };
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, prov_utils_ecc_backend_set(&backend));
+
+    backend.public_key_is_valid = backend_public_key_is_valid;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_utils_ecc_backend_set(&backend));
+
+    /* The custom backend is used instead of uECC. */
+    m_backend_keys_generate_calls = 0;
+    m_backend_shared_secret_calls = 0;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_utils_keys_generate(pubkey, m_backend_private_key));
+    TEST_ASSERT_EQUAL(1, m_backend_keys_generate_calls);
+    TEST_ASSERT_TRUE(prov_utils_is_valid_public_key(m_ctx.peer_public_key));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, prov_utils_calculate_shared_secret(&m_ctx, shared_secret));
+    TEST_ASSERT_EQUAL(1, m_backend_shared_secret_calls);
+
+    /* Restore the default backend. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, prov_utils_ecc_backend_set(NULL));
+    uECC_secp256r1_ExpectAndReturn(NULL);
+    uECC_make_key_ExpectAndReturn(pubkey, m_backend_private_key, NULL, 1);
+    TEST_ASSERT_EQUAL_HEX32(NRF_SUCCESS, prov_utils_keys_generate(pubkey, m_backend_private_key));
+}
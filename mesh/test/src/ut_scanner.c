@@ -42,6 +42,7 @@
 
 #include "utils.h"
 #include "test_assert.h"
+#include "perf_counter.h"
 
 #include "bearer_event_mock.h"
 #include "filter_engine_mock.h"
@@ -172,6 +173,7 @@ void setUp(void)
     NRF_TIMER2          = (NRF_TIMER_Type*) &m_timer2;
 
     packet_buffer_free_callback_cnt = 0;
+    perf_counter_clear();
 }
 
 void tearDown(void)
@@ -547,6 +549,7 @@ void test_radio_start_IN_WINDOW_BUFFER_RESERVE_FAILED(void)
     TEST_ASSERT_EQUAL(0, m_radio.TASKS_RXEN);
     TEST_ASSERT_EQUAL(0, m_radio.PACKETPTR);
     TEST_ASSERT_EQUAL(true, m_scanner.waiting_for_memory);
+    TEST_ASSERT_EQUAL_UINT32(1, g_perf_counters[PERF_COUNTER_SCANNER_DROP_NO_MEM]);
 }
 
 void test_radio_stop(void)
@@ -597,6 +600,9 @@ void test_radio_irq_handler_END_EVENT_CRC_ERROR(void)
     TEST_ASSERT_EQUAL_UINT32(0, scanner_stats_get()->successful_receives);
     TEST_ASSERT_EQUAL_UINT32(1, scanner_stats_get()->crc_failures);
     TEST_ASSERT_EQUAL_UINT32(0, scanner_stats_get()->length_out_of_bounds);
+    TEST_ASSERT_EQUAL_UINT32(0, g_perf_counters[PERF_COUNTER_SCANNER_RX]);
+    TEST_ASSERT_EQUAL_UINT32(1, g_perf_counters[PERF_COUNTER_SCANNER_DROP_CRC]);
+    TEST_ASSERT_EQUAL_UINT32(0, g_perf_counters[PERF_COUNTER_SCANNER_DROP_LENGTH]);
 }
 
 void test_radio_irq_handler_END_EVENT_LENGTH_ERROR(void)
@@ -633,6 +639,9 @@ void test_radio_irq_handler_END_EVENT_LENGTH_ERROR(void)
     TEST_ASSERT_EQUAL_UINT32(0, scanner_stats_get()->successful_receives);
     TEST_ASSERT_EQUAL_UINT32(0, scanner_stats_get()->crc_failures);
     TEST_ASSERT_EQUAL_UINT32(1, scanner_stats_get()->length_out_of_bounds);
+    TEST_ASSERT_EQUAL_UINT32(0, g_perf_counters[PERF_COUNTER_SCANNER_RX]);
+    TEST_ASSERT_EQUAL_UINT32(0, g_perf_counters[PERF_COUNTER_SCANNER_DROP_CRC]);
+    TEST_ASSERT_EQUAL_UINT32(1, g_perf_counters[PERF_COUNTER_SCANNER_DROP_LENGTH]);
 }
 
 void test_radio_irq_handler_END_EVENT_SUCCESSFUL(void)
@@ -684,6 +693,9 @@ void test_radio_irq_handler_END_EVENT_SUCCESSFUL(void)
     TEST_ASSERT_EQUAL_UINT32(1, scanner_stats_get()->successful_receives);
     TEST_ASSERT_EQUAL_UINT32(0, scanner_stats_get()->crc_failures);
     TEST_ASSERT_EQUAL_UINT32(0, scanner_stats_get()->length_out_of_bounds);
+    TEST_ASSERT_EQUAL_UINT32(1, g_perf_counters[PERF_COUNTER_SCANNER_RX]);
+    TEST_ASSERT_EQUAL_UINT32(0, g_perf_counters[PERF_COUNTER_SCANNER_DROP_CRC]);
+    TEST_ASSERT_EQUAL_UINT32(0, g_perf_counters[PERF_COUNTER_SCANNER_DROP_LENGTH]);
 }
 
 static void packet_buffer_free_callback_AFTER_WINDOW_START(packet_buffer_t* const p_buffer, packet_buffer_packet_t* const p_packet, int cmock_num_calls)
@@ -949,6 +961,70 @@ void test_timer_scan_window_start_callback_CHANNEL_INDEX_WRAP(void)
     TEST_ASSERT_EQUAL(SCAN_WINDOW_STATE_NEXT_CHANNEL, m_scanner.window_state);
 }
 
+void test_config_adaptive_set(void)
+{
+    scanner_adaptive_config_t config = {.scan_interval_us = MS_TO_US(100),
+                                        .window_min_us = MS_TO_US(10),
+                                        .current_budget_ua = SCANNER_RX_CURRENT_UA / 2};
+    scanner_init_helper();
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, scanner_config_adaptive_set(NULL));
+    config.window_min_us = MS_TO_US(BEARER_SCAN_WIN_MIN_MS) - 1;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scanner_config_adaptive_set(&config));
+    config.window_min_us = MS_TO_US(101);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scanner_config_adaptive_set(&config));
+    /* The budget only covers half the interval */
+    config.window_min_us = MS_TO_US(60);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scanner_config_adaptive_set(&config));
+    config.window_min_us = MS_TO_US(10);
+    config.scan_interval_us = MS_TO_US(BEARER_SCAN_INT_MAX_MS) + 1;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, scanner_config_adaptive_set(&config));
+    TEST_ASSERT_FALSE(m_scanner.adaptive_enabled);
+
+    /* Without any traffic, the scanner starts out with the shortest window. */
+    config.scan_interval_us = MS_TO_US(100);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, scanner_config_adaptive_set(&config));
+    TEST_ASSERT_TRUE(m_scanner.adaptive_enabled);
+    TEST_ASSERT_EQUAL(MS_TO_US(100), m_scanner.config.scan_interval_us);
+    TEST_ASSERT_EQUAL(MS_TO_US(10), m_scanner.config.scan_window_us);
+    TEST_ASSERT_EQUAL(MS_TO_US(10), m_scanner.adaptive.window_min_us);
+    TEST_ASSERT_EQUAL(MS_TO_US(50), m_scanner.adaptive.window_max_us);
+
+    timer_now_ExpectAndReturn(TIME_NOW);
+    timer_sch_reschedule_Expect(&m_scanner.timer_window_end, TIME_NOW + MS_TO_US(10));
+    timer_sch_reschedule_Expect(&m_scanner.timer_window_start, TIME_NOW);
+    bearer_handler_wake_up_Expect();
+    scanner_enable();
+
+    /* The first window stays on the current channel. */
+    timer_sch_reschedule_Expect(&m_scanner.timer_window_end, TIME_NOW + MS_TO_US(10));
+    m_scanner.timer_window_start.cb(TIME_NOW, NULL);
+    TEST_ASSERT_EQUAL(0, m_scanner.channel_index);
+    TEST_ASSERT_EQUAL(SCAN_WINDOW_STATE_ON, m_scanner.window_state);
+
+    m_scanner.timer_window_end.cb(TIME_NOW + MS_TO_US(10), NULL);
+    TEST_ASSERT_EQUAL(SCAN_WINDOW_STATE_OFF, m_scanner.window_state);
+
+    /* The next window moves on to the next channel, and records the scan time of the first. */
+    timer_sch_reschedule_Expect(&m_scanner.timer_window_end, TIME_NOW + MS_TO_US(110));
+    m_scanner.timer_window_start.cb(TIME_NOW + MS_TO_US(100), NULL);
+    TEST_ASSERT_EQUAL(1, m_scanner.channel_index);
+    TEST_ASSERT_EQUAL(SCAN_WINDOW_STATE_NEXT_CHANNEL, m_scanner.window_state);
+
+    scanner_traffic_report_t report;
+    scanner_traffic_report_get(&report);
+    TEST_ASSERT_EQUAL(10, report.scan_time_ms[0]);
+    TEST_ASSERT_EQUAL(0, report.scan_time_ms[1]);
+    TEST_ASSERT_EQUAL(MS_TO_US(10), report.window_us);
+
+    /* Static scan times turn off adaptive scanning. */
+    timer_now_ExpectAndReturn(TIME_NOW);
+    timer_sch_abort_Expect(&m_scanner.timer_window_end);
+    timer_sch_reschedule_Expect(&m_scanner.timer_window_start, TIME_NOW);
+    scanner_config_scan_time_set(MS_TO_US(BEARER_SCAN_INT_DEFAULT_MS), MS_TO_US(BEARER_SCAN_WINDOW_DEFAULT_MS));
+    TEST_ASSERT_FALSE(m_scanner.adaptive_enabled);
+}
+
 void test_timer_scan_window_end_callback(void)
 {
     scanner_window_started_helper();
@@ -0,0 +1,197 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "scanner_adaptive.h"
+
+#include <string.h>
+#include <unity.h>
+#include "utils.h"
+
+#define WINDOW_MIN_US   10000
+#define WINDOW_MAX_US   100000
+#define SIM_WINDOWS     300
+
+static scanner_adaptive_t m_adaptive;
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    memset(&m_adaptive, 0, sizeof(m_adaptive));
+    scanner_adaptive_init(&m_adaptive, SCANNER_CHANNELS_MAX);
+    scanner_adaptive_window_limits_set(&m_adaptive, WINDOW_MIN_US, WINDOW_MAX_US);
+}
+
+void tearDown(void)
+{
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+/**
+ * Runs a number of scan windows with a fixed window length, with the given rates of packets and
+ * CRC failures per second on each channel. Returns the number of windows on each channel.
+ */
+static void simulate(const uint32_t * p_packets_per_s, const uint32_t * p_crc_failures_per_s, uint32_t * p_windows)
+{
+    memset(p_windows, 0, sizeof(uint32_t) * SCANNER_CHANNELS_MAX);
+    for (uint32_t i = 0; i < SIM_WINDOWS; i++)
+    {
+        uint8_t channel = scanner_adaptive_channel_next(&m_adaptive);
+        TEST_ASSERT_TRUE(channel < SCANNER_CHANNELS_MAX);
+        p_windows[channel]++;
+
+        for (uint32_t j = 0; j < (p_packets_per_s[channel] * WINDOW_MAX_US) / 1000000; j++)
+        {
+            scanner_adaptive_rx(&m_adaptive, channel, true);
+        }
+        for (uint32_t j = 0; j < (p_crc_failures_per_s[channel] * WINDOW_MAX_US) / 1000000; j++)
+        {
+            scanner_adaptive_rx(&m_adaptive, channel, false);
+        }
+        scanner_adaptive_window_end(&m_adaptive, channel, WINDOW_MAX_US);
+    }
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_round_robin_without_traffic(void)
+{
+    uint32_t no_traffic[SCANNER_CHANNELS_MAX] = {0};
+    uint32_t windows[SCANNER_CHANNELS_MAX];
+
+    simulate(no_traffic, no_traffic, windows);
+    for (uint32_t i = 0; i < SCANNER_CHANNELS_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL(SIM_WINDOWS / SCANNER_CHANNELS_MAX, windows[i]);
+    }
+    TEST_ASSERT_EQUAL(WINDOW_MIN_US, scanner_adaptive_window_get(&m_adaptive));
+}
+
+void test_dwell_follows_yield(void)
+{
+    uint32_t packets[SCANNER_CHANNELS_MAX] = {10, 100, 10};
+    uint32_t no_noise[SCANNER_CHANNELS_MAX] = {0};
+    uint32_t windows[SCANNER_CHANNELS_MAX];
+
+    simulate(packets, no_noise, windows);
+
+    /* The busy channel gets most of the windows, but the others are still visited. */
+    TEST_ASSERT_TRUE(windows[1] > SIM_WINDOWS / 2);
+    TEST_ASSERT_TRUE(windows[0] > SIM_WINDOWS / 20);
+    TEST_ASSERT_TRUE(windows[2] > SIM_WINDOWS / 20);
+}
+
+void test_dwell_avoids_noise(void)
+{
+    uint32_t packets[SCANNER_CHANNELS_MAX] = {50, 50, 50};
+    uint32_t noise[SCANNER_CHANNELS_MAX] = {0, 0, 200};
+    uint32_t windows[SCANNER_CHANNELS_MAX];
+
+    simulate(packets, noise, windows);
+
+    TEST_ASSERT_TRUE(windows[2] < windows[0]);
+    TEST_ASSERT_TRUE(windows[2] < windows[1]);
+    TEST_ASSERT_TRUE(windows[2] > 0);
+}
+
+void test_window_follows_traffic(void)
+{
+    uint32_t no_noise[SCANNER_CHANNELS_MAX] = {0};
+    uint32_t windows[SCANNER_CHANNELS_MAX];
+
+    TEST_ASSERT_EQUAL(WINDOW_MIN_US, scanner_adaptive_window_get(&m_adaptive));
+
+    /* Half rate gives a window halfway between the limits. */
+    uint32_t half_rate[SCANNER_CHANNELS_MAX] = {SCANNER_ADAPTIVE_HALF_RATE, SCANNER_ADAPTIVE_HALF_RATE, SCANNER_ADAPTIVE_HALF_RATE};
+    simulate(half_rate, no_noise, windows);
+    uint32_t window_us = scanner_adaptive_window_get(&m_adaptive);
+    TEST_ASSERT_TRUE(window_us > (WINDOW_MIN_US + WINDOW_MAX_US) / 2 - 1000);
+    TEST_ASSERT_TRUE(window_us < (WINDOW_MIN_US + WINDOW_MAX_US) / 2 + 1000);
+
+    /* Heavy traffic gets close to the longest window. */
+    uint32_t heavy[SCANNER_CHANNELS_MAX] = {SCANNER_ADAPTIVE_HALF_RATE * 50, 0, 0};
+    simulate(heavy, no_noise, windows);
+    window_us = scanner_adaptive_window_get(&m_adaptive);
+    TEST_ASSERT_TRUE(window_us > WINDOW_MAX_US - (WINDOW_MAX_US - WINDOW_MIN_US) / 20);
+    TEST_ASSERT_TRUE(window_us <= WINDOW_MAX_US);
+
+    /* The window shrinks back when the traffic stops. */
+    simulate(no_noise, no_noise, windows);
+    TEST_ASSERT_EQUAL(WINDOW_MIN_US, scanner_adaptive_window_get(&m_adaptive));
+}
+
+void test_report(void)
+{
+    scanner_traffic_report_t report;
+    memset(&report, 0xFF, sizeof(report));
+    scanner_adaptive_report_get(&m_adaptive, 5000, &report);
+    TEST_ASSERT_EQUAL(SCANNER_CHANNELS_MAX, report.channel_count);
+    TEST_ASSERT_EQUAL(0, report.charge_mas);
+    TEST_ASSERT_EQUAL(0, report.packets_per_mas_x100);
+
+    /* 2 seconds of scanning at 5 mA is 10 mA*s. */
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        scanner_adaptive_rx(&m_adaptive, 0, true);
+    }
+    scanner_adaptive_rx(&m_adaptive, 1, false);
+    scanner_adaptive_window_end(&m_adaptive, 0, 1500000);
+    scanner_adaptive_window_end(&m_adaptive, 1, 500000);
+
+    scanner_adaptive_report_get(&m_adaptive, 5000, &report);
+    TEST_ASSERT_EQUAL(25, report.packets[0]);
+    TEST_ASSERT_EQUAL(0, report.packets[1]);
+    TEST_ASSERT_EQUAL(1, report.crc_failures[1]);
+    TEST_ASSERT_EQUAL(1500, report.scan_time_ms[0]);
+    TEST_ASSERT_EQUAL(500, report.scan_time_ms[1]);
+    TEST_ASSERT_EQUAL(0, report.scan_time_ms[2]);
+    TEST_ASSERT_EQUAL(10, report.charge_mas);
+    TEST_ASSERT_EQUAL(250, report.packets_per_mas_x100);
+
+    /* Setting a new channel map clears the history, but keeps the window limits. */
+    scanner_adaptive_init(&m_adaptive, 2);
+    scanner_adaptive_report_get(&m_adaptive, 5000, &report);
+    TEST_ASSERT_EQUAL(2, report.channel_count);
+    TEST_ASSERT_EQUAL(0, report.packets[0]);
+    TEST_ASSERT_EQUAL(0, report.charge_mas);
+    TEST_ASSERT_EQUAL(WINDOW_MIN_US, scanner_adaptive_window_get(&m_adaptive));
+}
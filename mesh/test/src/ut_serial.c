@@ -60,6 +60,7 @@
 #include "serial_handler_mesh_mock.h"
 #include "serial_handler_prov_mock.h"
 #include "serial_handler_openmesh_mock.h"
+#include "serial_handler_stats_mock.h"
 
 NRF_POWER_Type  * NRF_POWER;
 static NRF_POWER_Type m_power;
@@ -87,6 +88,7 @@ void setUp(void)
     serial_handler_mesh_mock_Init();
     serial_handler_prov_mock_Init();
     serial_handler_openmesh_mock_Init();
+    serial_handler_stats_mock_Init();
 
     bearer_event_generic_post_StubWithCallback(m_bearer_event_generic_post);
 }
@@ -123,6 +125,8 @@ void tearDown(void)
     serial_handler_prov_mock_Destroy();
     serial_handler_openmesh_mock_Verify();
     serial_handler_openmesh_mock_Destroy();
+    serial_handler_stats_mock_Verify();
+    serial_handler_stats_mock_Destroy();
 }
 
 void test_serial_invalid(void)
@@ -318,6 +322,21 @@ void test_serial_rx(void)
     serial_bearer_rx_get_IgnoreArg_p_packet();
     m_serial_process_cmd(NULL);
 
+    /* Call serial process cmd and test with valid packets of STATS type */
+    serial_packet.opcode = SERIAL_OPCODE_CMD_RANGE_STATS_START;
+    serial_bearer_rx_get_ExpectAndReturn(&serial_packet, true);
+    serial_bearer_rx_get_IgnoreArg_p_packet();
+    serial_bearer_rx_get_ReturnThruPtr_p_packet(&serial_packet);
+    serial_handler_stats_rx_Expect(&serial_packet);
+    serial_packet.opcode = SERIAL_OPCODE_CMD_RANGE_STATS_END;
+    serial_bearer_rx_get_ExpectAndReturn(&serial_packet, true);
+    serial_bearer_rx_get_IgnoreArg_p_packet();
+    serial_bearer_rx_get_ReturnThruPtr_p_packet(&serial_packet);
+    serial_handler_stats_rx_Expect(&serial_packet);
+    serial_bearer_rx_get_ExpectAndReturn(NULL, false);
+    serial_bearer_rx_get_IgnoreArg_p_packet();
+    m_serial_process_cmd(NULL);
+
     /* Call serial process cmd and test with valid packets of PROV type */
     serial_packet.opcode = SERIAL_OPCODE_CMD_RANGE_PROV_START;
     serial_bearer_rx_get_ExpectAndReturn(&serial_packet, true);
@@ -366,8 +385,8 @@ void test_serial_rx(void)
     /** Test the reception of invalid packets */
     serial_packet_t serial_packet2;
     serial_packet_t * p_packet = &serial_packet2;
-    /* No opcodes between SERIAL_OPCODE_CMD_RANGE_MESH_END and SERIAL_OPCODE_CMD_RANGE_DFU_START are supported*/
-    for (uint32_t i = SERIAL_OPCODE_CMD_RANGE_MESH_END+1; i < SERIAL_OPCODE_CMD_RANGE_DFU_START; ++i)
+    /* No opcodes between SERIAL_OPCODE_CMD_RANGE_STATS_END and SERIAL_OPCODE_CMD_RANGE_DFU_START are supported*/
+    for (uint32_t i = SERIAL_OPCODE_CMD_RANGE_STATS_END+1; i < SERIAL_OPCODE_CMD_RANGE_DFU_START; ++i)
     {
         serial_packet.opcode = i;
         serial_bearer_packet_buffer_get_ExpectAndReturn(SERIAL_EVT_CMD_RSP_LEN_OVERHEAD, &p_packet, NRF_SUCCESS);
@@ -404,6 +423,106 @@ void test_serial_rx(void)
     serial_bearer_rx_get_IgnoreArg_p_packet();
     serial_handler_device_alloc_fail_report_Expect();
     m_serial_process_cmd(NULL);
+}
+
+static void serial_handler_config_rx_cb(const serial_packet_t * p_cmd, int num_calls)
+{
+    serial_cmd_rsp_send(p_cmd->opcode, SERIAL_STATUS_SUCCESS, NULL, 0);
+}
+
+static void serial_handler_mesh_rx_cb(const serial_packet_t * p_cmd, int num_calls)
+{
+    /* Echo the command parameters in the response. */
+    serial_cmd_rsp_send(p_cmd->opcode,
+                        SERIAL_STATUS_SUCCESS,
+                        (const uint8_t *) &p_cmd->payload,
+                        p_cmd->length - SERIAL_PACKET_LENGTH_OVERHEAD);
+}
+
+static void batch_rx(const serial_packet_t * p_batch, serial_packet_t * p_rsp_packet, uint16_t expected_rsp_len)
+{
+    serial_bearer_rx_get_ExpectAndReturn(NULL, true);
+    serial_bearer_rx_get_IgnoreArg_p_packet();
+    serial_bearer_rx_get_ReturnThruPtr_p_packet((serial_packet_t *) p_batch);
+    serial_bearer_packet_buffer_get_ExpectAndReturn(SERIAL_EVT_CMD_RSP_LEN_OVERHEAD + expected_rsp_len, NULL, NRF_SUCCESS);
+    serial_bearer_packet_buffer_get_IgnoreArg_pp_packet();
+    serial_bearer_packet_buffer_get_ReturnThruPtr_pp_packet(&p_rsp_packet);
+    serial_bearer_tx_Expect(p_rsp_packet);
+    serial_bearer_rx_get_ExpectAndReturn(NULL, false);
+    serial_bearer_rx_get_IgnoreArg_p_packet();
+    m_serial_process_cmd(NULL);
+}
 
+/* Since serial module can only be initialized and started once the following test case relies on the previous test case initializing the serial.*/
+void test_serial_batch(void)
+{
+    TEST_ASSERT_EQUAL(NRF_MESH_SERIAL_STATE_RUNNING, serial_state_get());
+    serial_handler_config_rx_StubWithCallback(serial_handler_config_rx_cb);
+    serial_handler_mesh_rx_StubWithCallback(serial_handler_mesh_rx_cb);
+
+    serial_packet_t batch;
+    serial_packet_t rsp_packet;
+    const uint8_t commands[] = {
+        1, SERIAL_OPCODE_CMD_RANGE_CONFIG_START,
+        3, SERIAL_OPCODE_CMD_RANGE_MESH_START, 0xAA, 0xBB,
+        1, SERIAL_OPCODE_CMD_RANGE_SAR_END + 1,
+        1, SERIAL_OPCODE_CMD_DEVICE_BATCH,
+    };
+    const uint8_t expected_responses[] = {
+        3, SERIAL_OPCODE_EVT_CMD_RSP, SERIAL_OPCODE_CMD_RANGE_CONFIG_START, SERIAL_STATUS_SUCCESS,
+        5, SERIAL_OPCODE_EVT_CMD_RSP, SERIAL_OPCODE_CMD_RANGE_MESH_START, SERIAL_STATUS_SUCCESS, 0xAA, 0xBB,
+        3, SERIAL_OPCODE_EVT_CMD_RSP, SERIAL_OPCODE_CMD_RANGE_SAR_END + 1, SERIAL_STATUS_ERROR_CMD_UNKNOWN,
+        /* Nested batches are rejected */
+        3, SERIAL_OPCODE_EVT_CMD_RSP, SERIAL_OPCODE_CMD_DEVICE_BATCH, SERIAL_STATUS_ERROR_REJECTED,
+    };
 
+    /* All responses are sent in a single packet: */
+    batch.opcode = SERIAL_OPCODE_CMD_DEVICE_BATCH;
+    batch.length = SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(commands);
+    memcpy(batch.payload.cmd.device.batch.commands, commands, sizeof(commands));
+    batch_rx(&batch, &rsp_packet, sizeof(expected_responses));
+    TEST_ASSERT_EQUAL(SERIAL_OPCODE_EVT_CMD_RSP, rsp_packet.opcode);
+    TEST_ASSERT_EQUAL(SERIAL_OPCODE_CMD_DEVICE_BATCH, rsp_packet.payload.evt.cmd_rsp.opcode);
+    TEST_ASSERT_EQUAL(SERIAL_STATUS_SUCCESS, rsp_packet.payload.evt.cmd_rsp.status);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_responses, rsp_packet.payload.evt.cmd_rsp.data.batch.responses, sizeof(expected_responses));
+
+    /* Empty batch: */
+    batch.length = SERIAL_PACKET_LENGTH_OVERHEAD;
+    batch_rx(&batch, &rsp_packet, 0);
+    TEST_ASSERT_EQUAL(SERIAL_OPCODE_CMD_DEVICE_BATCH, rsp_packet.payload.evt.cmd_rsp.opcode);
+    TEST_ASSERT_EQUAL(SERIAL_STATUS_SUCCESS, rsp_packet.payload.evt.cmd_rsp.status);
+
+    /* Commands running past the end of the batch are not processed: */
+    const uint8_t truncated_commands[] = {
+        1, SERIAL_OPCODE_CMD_RANGE_CONFIG_START,
+        3, SERIAL_OPCODE_CMD_RANGE_MESH_START, 0xAA,
+    };
+    batch.length = SERIAL_PACKET_LENGTH_OVERHEAD + sizeof(truncated_commands);
+    memcpy(batch.payload.cmd.device.batch.commands, truncated_commands, sizeof(truncated_commands));
+    batch_rx(&batch, &rsp_packet, 4);
+    TEST_ASSERT_EQUAL(SERIAL_STATUS_ERROR_INVALID_LENGTH, rsp_packet.payload.evt.cmd_rsp.status);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_responses, rsp_packet.payload.evt.cmd_rsp.data.batch.responses, 4);
+
+    /* Responses that don't fit in a single packet are split: */
+    uint8_t * p_commands = batch.payload.cmd.device.batch.commands;
+    uint32_t command_count = 0;
+    for (uint32_t offset = 0; offset + 2 <= NRF_MESH_SERIAL_PAYLOAD_MAXLEN; offset += 2)
+    {
+        p_commands[offset] = 1;
+        p_commands[offset + 1] = SERIAL_OPCODE_CMD_RANGE_CONFIG_START;
+        command_count++;
+    }
+    batch.length = SERIAL_PACKET_LENGTH_OVERHEAD + command_count * 2;
+    const uint32_t rsps_per_packet = SERIAL_EVT_CMD_RSP_DATA_MAXLEN / SERIAL_EVT_CMD_RSP_LEN_OVERHEAD;
+    serial_packet_t rsp_packet2;
+    serial_packet_t * p_rsp_packet = &rsp_packet2;
+    for (uint32_t i = rsps_per_packet; i < command_count; i += rsps_per_packet)
+    {
+        serial_bearer_packet_buffer_get_ExpectAndReturn(SERIAL_EVT_CMD_RSP_LEN_OVERHEAD + rsps_per_packet * SERIAL_EVT_CMD_RSP_LEN_OVERHEAD, NULL, NRF_SUCCESS);
+        serial_bearer_packet_buffer_get_IgnoreArg_pp_packet();
+        serial_bearer_packet_buffer_get_ReturnThruPtr_pp_packet(&p_rsp_packet);
+        serial_bearer_tx_Expect(p_rsp_packet);
+    }
+    batch_rx(&batch, &rsp_packet, (command_count % rsps_per_packet) * SERIAL_EVT_CMD_RSP_LEN_OVERHEAD);
+    TEST_ASSERT_EQUAL(SERIAL_STATUS_SUCCESS, rsp_packet.payload.evt.cmd_rsp.status);
 }
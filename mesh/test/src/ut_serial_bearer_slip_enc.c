@@ -111,6 +111,9 @@ void test_uart_tx(void)
     /* Copy the contents of test_data */
     memcpy(&p_packet->opcode, test_data, p_packet->length);
     /* State IDLE so can start transmit */
+    /* The packet is encoded and freed before the first byte goes out. */
+    packet_buffer_free_Expect(NULL, p_buf_packet);
+    packet_buffer_free_IgnoreArg_p_buffer();
     /* First byte is END byte */
     transmit_bearer_event(p_buf_packet, true);
     TEST_ASSERT_EQUAL(0xc0, NRF_UART0->TXD);
@@ -131,8 +134,6 @@ void test_uart_tx(void)
         transmit_bearer_event(p_buf_packet, false);
     }
     /* All data has been sent, serial_bearer should know this and send out a SLIP_END code.*/
-    packet_buffer_free_Expect(NULL, p_buf_packet);
-    packet_buffer_free_IgnoreArg_p_buffer();
     m_tx_cb();
     TEST_ASSERT_EQUAL(SLIP_END, NRF_UART0->TXD);
     /* Calls to transmit should cause no effect while in transmit state*/
@@ -156,6 +157,8 @@ void test_uart_tx(void)
     serial_transmit(p_packet, p_buf_packet2);
 
     /* Transmit the first buffer*/
+    packet_buffer_free_Expect(NULL, p_buf_packet);
+    packet_buffer_free_IgnoreArg_p_buffer();
     transmit_bearer_event(p_buf_packet, true);
 
     TEST_ASSERT_EQUAL(0xc0, NRF_UART0->TXD); /* END byte */
@@ -165,9 +168,6 @@ void test_uart_tx(void)
     TEST_ASSERT_EQUAL(1, NRF_UART0->TXD); /* Length field of the first packet*/
     m_tx_cb();
     TEST_ASSERT_EQUAL(1, NRF_UART0->TXD); /* Opcode of the first packet */
-    /* After sending out the last byte, the packet should be freed in the following interrupt. */
-    packet_buffer_free_Expect(NULL, p_buf_packet);
-    packet_buffer_free_IgnoreArg_p_buffer();
     m_tx_cb();
     TEST_ASSERT_EQUAL(SLIP_END, NRF_UART0->TXD); /* End of transmission*/
 
@@ -177,6 +177,8 @@ void test_uart_tx(void)
     NRF_UART0->TASKS_STOPTX = 0;
 
     /* Transmit the second buffer */
+    packet_buffer_free_Expect(NULL, p_buf_packet2);
+    packet_buffer_free_IgnoreArg_p_buffer();
     transmit_bearer_event(p_buf_packet2, true);
     TEST_ASSERT_EQUAL(0xc0, NRF_UART0->TXD); /* END byte */
     m_tx_cb();
@@ -192,13 +194,65 @@ void test_uart_tx(void)
     TEST_ASSERT_EQUAL(SLIP_ESC, NRF_UART0->TXD); /* First byte is an escape character */
     m_tx_cb();
     TEST_ASSERT_EQUAL(SLIP_ESC_ESC, NRF_UART0->TXD); /* Second byte is an esc_end character */
-    /* Now we have transmitted all 3 bytes given via the packet. The packet should be freed. */
-    packet_buffer_free_Expect(NULL, p_buf_packet2);
-    packet_buffer_free_IgnoreArg_p_buffer();
+    /* Now we have transmitted all 3 bytes given via the packet. */
     m_tx_cb();
     TEST_ASSERT_EQUAL(SLIP_END, NRF_UART0->TXD); /* End of transmission*/
 }
 
+void test_uart_tx_frame_encoding(void)
+{
+    serial_packet_t * p_packet;
+    packet_buffer_packet_t * p_buf_packet = (packet_buffer_packet_t *) m_buffer;
+    uint8_t expected_frame[2 * sizeof(serial_packet_t) + 2];
+    uint32_t expected_frame_len = 0;
+
+    /* Mix runs of plain bytes with bytes that need escaping, at all alignments within a word. */
+    serial_buffer_get(sizeof(serial_packet_t) - 1, &p_packet, p_buf_packet);
+    uint8_t * p_data = (uint8_t *) p_packet;
+    expected_frame[expected_frame_len++] = SLIP_END;
+    for (uint32_t i = 0; i < sizeof(serial_packet_t); ++i)
+    {
+        if (i > 0)
+        {
+            p_data[i] = (i % 7 == 0) ? SLIP_END : ((i % 11 == 0) ? SLIP_ESC : (i % 80));
+        }
+
+        if (p_data[i] == SLIP_END)
+        {
+            expected_frame[expected_frame_len++] = SLIP_ESC;
+            expected_frame[expected_frame_len++] = SLIP_ESC_END;
+        }
+        else if (p_data[i] == SLIP_ESC)
+        {
+            expected_frame[expected_frame_len++] = SLIP_ESC;
+            expected_frame[expected_frame_len++] = SLIP_ESC_ESC;
+        }
+        else
+        {
+            expected_frame[expected_frame_len++] = p_data[i];
+        }
+    }
+    expected_frame[expected_frame_len++] = SLIP_END;
+    serial_transmit(p_packet, p_buf_packet);
+
+    packet_buffer_free_Expect(NULL, p_buf_packet);
+    packet_buffer_free_IgnoreArg_p_buffer();
+    transmit_bearer_event(p_buf_packet, true);
+
+    uint8_t frame[sizeof(expected_frame)];
+    uint32_t frame_len = 0;
+    NRF_UART0->TASKS_STOPTX = 0;
+    while (NRF_UART0->TASKS_STOPTX == 0)
+    {
+        TEST_ASSERT_TRUE(frame_len < sizeof(frame));
+        frame[frame_len++] = NRF_UART0->TXD;
+        m_tx_cb();
+    }
+    TEST_ASSERT_EQUAL(expected_frame_len, frame_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_frame, frame, expected_frame_len);
+    NRF_UART0->TASKS_STOPTX = 0;
+}
+
 void test_uart_rx(void)
 {
     serial_packet_t * p_packet = (serial_packet_t*)test_data;
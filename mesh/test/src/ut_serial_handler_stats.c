@@ -0,0 +1,291 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include <unity.h>
+#include <cmock.h>
+
+#include "serial_handler_stats.h"
+#include "serial_status.h"
+#include "perf_counter.h"
+#include "utils.h"
+#include "serial_mock.h"
+#include "heartbeat_collector_mock.h"
+#include "timer_mock.h"
+
+#define EXPECT_ACK(_opcode, _error_code, _serial_status)                          \
+    do {                                                                          \
+        serial_translate_error_ExpectAndReturn(_error_code, _serial_status);      \
+        serial_cmd_rsp_send_ExpectWithArray(_opcode, _serial_status, NULL, 0, 0); \
+    } while (0)
+
+#define EXPECT_ACK_WITH_PAYLOAD(_opcode, _data, _len)                                              \
+    do {                                                                                           \
+        serial_translate_error_ExpectAndReturn(NRF_SUCCESS, SERIAL_STATUS_SUCCESS);                \
+        serial_cmd_rsp_send_ExpectWithArray(_opcode, SERIAL_STATUS_SUCCESS, (const uint8_t *) (_data), _len, _len); \
+    } while (0)
+
+static serial_packet_t m_cmd;
+
+static void cmd_set(uint8_t opcode, uint32_t params_len)
+{
+    m_cmd.opcode = opcode;
+    m_cmd.length = SERIAL_PACKET_LENGTH_OVERHEAD + params_len;
+}
+
+void setUp(void)
+{
+    serial_mock_Init();
+    heartbeat_collector_mock_Init();
+    timer_mock_Init();
+    perf_counter_clear();
+    memset(&m_cmd, 0, sizeof(m_cmd));
+}
+
+void tearDown(void)
+{
+    serial_mock_Verify();
+    serial_mock_Destroy();
+    heartbeat_collector_mock_Verify();
+    heartbeat_collector_mock_Destroy();
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_invalid_length(void)
+{
+    cmd_set(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET, sizeof(serial_cmd_stats_counters_get_t) - 1);
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0, 0);
+    serial_handler_stats_rx(&m_cmd);
+
+    cmd_set(SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET, sizeof(serial_cmd_stats_histogram_get_t) + 1);
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0, 0);
+    serial_handler_stats_rx(&m_cmd);
+
+    cmd_set(SERIAL_OPCODE_CMD_STATS_CLEAR, 1);
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_CLEAR, SERIAL_STATUS_ERROR_INVALID_LENGTH, NULL, 0, 0);
+    serial_handler_stats_rx(&m_cmd);
+}
+
+void test_counters_get(void)
+{
+    serial_evt_cmd_rsp_data_stats_counters_t expected;
+
+    PERF_COUNTER_INC(PERF_COUNTER_SCANNER_RX);
+    PERF_COUNTER_INC(PERF_COUNTER_SCANNER_RX);
+    PERF_COUNTER_INC(PERF_COUNTER_NET_RX);
+
+    /* First counters */
+    cmd_set(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET, sizeof(serial_cmd_stats_counters_get_t));
+    m_cmd.payload.cmd.stats.counters_get.first = PERF_COUNTER_SCANNER_RX;
+    m_cmd.payload.cmd.stats.counters_get.count = PERF_COUNTER_NET_RX + 1;
+    memset(&expected, 0, sizeof(expected));
+    expected.total_count = PERF_COUNTER__LAST;
+    expected.first = PERF_COUNTER_SCANNER_RX;
+    expected.count = PERF_COUNTER_NET_RX + 1;
+    expected.values[PERF_COUNTER_SCANNER_RX] = 2;
+    expected.values[PERF_COUNTER_NET_RX] = 1;
+    EXPECT_ACK_WITH_PAYLOAD(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET,
+                            &expected,
+                            SERIAL_EVT_CMD_RSP_DATA_STATS_COUNTERS_OVERHEAD + expected.count * sizeof(uint32_t));
+    serial_handler_stats_rx(&m_cmd);
+
+    /* The count is clipped at the last counter */
+    m_cmd.payload.cmd.stats.counters_get.first = PERF_COUNTER__LAST - 1;
+    m_cmd.payload.cmd.stats.counters_get.count = 0xFF;
+    memset(&expected, 0, sizeof(expected));
+    expected.total_count = PERF_COUNTER__LAST;
+    expected.first = PERF_COUNTER__LAST - 1;
+    expected.count = 1;
+    EXPECT_ACK_WITH_PAYLOAD(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET,
+                            &expected,
+                            SERIAL_EVT_CMD_RSP_DATA_STATS_COUNTERS_OVERHEAD + sizeof(uint32_t));
+    serial_handler_stats_rx(&m_cmd);
+
+    /* Zero counters is a valid, empty read */
+    m_cmd.payload.cmd.stats.counters_get.first = PERF_COUNTER_NET_RX;
+    m_cmd.payload.cmd.stats.counters_get.count = 0;
+    expected.first = PERF_COUNTER_NET_RX;
+    expected.count = 0;
+    EXPECT_ACK_WITH_PAYLOAD(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET,
+                            &expected,
+                            SERIAL_EVT_CMD_RSP_DATA_STATS_COUNTERS_OVERHEAD);
+    serial_handler_stats_rx(&m_cmd);
+
+    /* Out of range */
+    m_cmd.payload.cmd.stats.counters_get.first = PERF_COUNTER__LAST;
+    m_cmd.payload.cmd.stats.counters_get.count = 1;
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_COUNTERS_GET, SERIAL_STATUS_ERROR_INVALID_PARAMETER, NULL, 0, 0);
+    serial_handler_stats_rx(&m_cmd);
+}
+
+void test_histogram_get(void)
+{
+    serial_evt_cmd_rsp_data_stats_histogram_t expected;
+
+    PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, 0);
+    PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, 3);
+    PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, 3);
+    PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, UINT32_MAX);
+
+    cmd_set(SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET, sizeof(serial_cmd_stats_histogram_get_t));
+    m_cmd.payload.cmd.stats.histogram_get.histogram = PERF_HISTOGRAM_TIMER_QUEUE_DEPTH;
+    memset(&expected, 0, sizeof(expected));
+    expected.histogram = PERF_HISTOGRAM_TIMER_QUEUE_DEPTH;
+    expected.max = UINT32_MAX;
+    expected.buckets[0] = 1;
+    expected.buckets[2] = 2;
+    expected.buckets[PERF_HISTOGRAM_BUCKET_COUNT - 1] = 1;
+    EXPECT_ACK_WITH_PAYLOAD(SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET, &expected, sizeof(expected));
+    serial_handler_stats_rx(&m_cmd);
+
+    /* Other histograms are untouched */
+    m_cmd.payload.cmd.stats.histogram_get.histogram = PERF_HISTOGRAM_TIMER_LATENESS_US;
+    memset(&expected, 0, sizeof(expected));
+    expected.histogram = PERF_HISTOGRAM_TIMER_LATENESS_US;
+    EXPECT_ACK_WITH_PAYLOAD(SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET, &expected, sizeof(expected));
+    serial_handler_stats_rx(&m_cmd);
+
+    m_cmd.payload.cmd.stats.histogram_get.histogram = PERF_HISTOGRAM__LAST;
+    EXPECT_ACK(SERIAL_OPCODE_CMD_STATS_HISTOGRAM_GET, NRF_ERROR_INVALID_PARAM, SERIAL_STATUS_ERROR_INVALID_PARAMETER);
+    serial_handler_stats_rx(&m_cmd);
+}
+
+void test_clear(void)
+{
+    uint32_t value;
+
+    PERF_COUNTER_INC(PERF_COUNTER_NET_TX);
+    PERF_HISTOGRAM_RECORD(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, 1);
+
+    cmd_set(SERIAL_OPCODE_CMD_STATS_CLEAR, 0);
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_CLEAR, SERIAL_STATUS_SUCCESS, NULL, 0, 0);
+    serial_handler_stats_rx(&m_cmd);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_counters_get(PERF_COUNTER_NET_TX, 1, &value));
+    TEST_ASSERT_EQUAL(0, value);
+
+    perf_histogram_t histogram;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, perf_histogram_get(PERF_HISTOGRAM_TIMER_QUEUE_DEPTH, &histogram));
+    TEST_ASSERT_EQUAL(0, histogram.buckets[1]);
+    TEST_ASSERT_EQUAL(0, histogram.max);
+}
+
+void test_hb_source_get(void)
+{
+    heartbeat_collector_entry_t entry = {
+        .src = 0x0123,
+        .count = 5,
+        .features = 0x0003,
+        .hops = 2,
+        .min_hops = 1,
+        .max_hops = 4,
+        .rssi = -50,
+        .last_seen = 1000000
+    };
+    serial_evt_cmd_rsp_data_stats_hb_source_t expected = {
+        .src = 0x0123,
+        .count = 5,
+        .features = 0x0003,
+        .hops = 2,
+        .min_hops = 1,
+        .max_hops = 4,
+        .rssi = -50,
+        .age_ms = 2500
+    };
+
+    cmd_set(SERIAL_OPCODE_CMD_STATS_HB_SOURCE_GET, sizeof(serial_cmd_stats_hb_source_get_t));
+    m_cmd.payload.cmd.stats.hb_source_get.src = 0x0123;
+    heartbeat_collector_get_ExpectAndReturn(0x0123, NULL, NRF_SUCCESS);
+    heartbeat_collector_get_IgnoreArg_p_entry();
+    heartbeat_collector_get_ReturnThruPtr_p_entry(&entry);
+    timer_now_ExpectAndReturn(3500000);
+    EXPECT_ACK_WITH_PAYLOAD(SERIAL_OPCODE_CMD_STATS_HB_SOURCE_GET, &expected, sizeof(expected));
+    serial_handler_stats_rx(&m_cmd);
+
+    heartbeat_collector_get_ExpectAndReturn(0x0123, NULL, NRF_ERROR_NOT_FOUND);
+    heartbeat_collector_get_IgnoreArg_p_entry();
+    EXPECT_ACK(SERIAL_OPCODE_CMD_STATS_HB_SOURCE_GET, NRF_ERROR_NOT_FOUND, SERIAL_STATUS_ERROR_REJECTED);
+    serial_handler_stats_rx(&m_cmd);
+}
+
+void test_hb_sources_list(void)
+{
+    heartbeat_collector_entry_t entries[2] = {
+        {.src = 0x0001, .count = 1, .hops = 1, .min_hops = 1, .max_hops = 1, .rssi = -40, .last_seen = 0},
+        {.src = 0x0002, .count = 7, .hops = 3, .min_hops = 2, .max_hops = 3, .rssi = HEARTBEAT_COLLECTOR_RSSI_INVALID, .last_seen = 9000}
+    };
+    serial_evt_cmd_rsp_data_stats_hb_sources_t expected;
+    uint16_t next_index = 5;
+    uint16_t count = ARRAY_SIZE(entries);
+
+    memset(&expected, 0, sizeof(expected));
+    expected.total_count = 3;
+    expected.next_index = next_index;
+    expected.count = count;
+    expected.sources[0] = (serial_evt_cmd_rsp_data_stats_hb_source_t) {
+        .src = 0x0001, .count = 1, .hops = 1, .min_hops = 1, .max_hops = 1, .rssi = -40, .age_ms = 10};
+    expected.sources[1] = (serial_evt_cmd_rsp_data_stats_hb_source_t) {
+        .src = 0x0002, .count = 7, .hops = 3, .min_hops = 2, .max_hops = 3, .rssi = 127, .age_ms = 1};
+
+    cmd_set(SERIAL_OPCODE_CMD_STATS_HB_SOURCES_LIST, sizeof(serial_cmd_stats_hb_sources_list_t));
+    m_cmd.payload.cmd.stats.hb_sources_list.index = 2;
+    heartbeat_collector_entries_get_ExpectAnyArgs();
+    heartbeat_collector_entries_get_ReturnThruPtr_p_index(&next_index);
+    heartbeat_collector_entries_get_ReturnArrayThruPtr_p_entries(entries, ARRAY_SIZE(entries));
+    heartbeat_collector_entries_get_ReturnThruPtr_p_count(&count);
+    timer_now_ExpectAndReturn(10000);
+    heartbeat_collector_source_count_get_ExpectAndReturn(3);
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_HB_SOURCES_LIST,
+                                        SERIAL_STATUS_SUCCESS,
+                                        (const uint8_t *) &expected,
+                                        SERIAL_EVT_CMD_RSP_DATA_STATS_HB_SOURCES_OVERHEAD + count * sizeof(expected.sources[0]),
+                                        SERIAL_EVT_CMD_RSP_DATA_STATS_HB_SOURCES_OVERHEAD + count * sizeof(expected.sources[0]));
+    serial_handler_stats_rx(&m_cmd);
+}
+
+void test_hb_sources_clear(void)
+{
+    cmd_set(SERIAL_OPCODE_CMD_STATS_HB_SOURCES_CLEAR, 0);
+    heartbeat_collector_clear_Expect();
+    serial_cmd_rsp_send_ExpectWithArray(SERIAL_OPCODE_CMD_STATS_HB_SOURCES_CLEAR, SERIAL_STATUS_SUCCESS, NULL, 0, 0);
+    serial_handler_stats_rx(&m_cmd);
+}
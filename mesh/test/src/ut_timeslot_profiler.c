@@ -0,0 +1,228 @@
+/* Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "timeslot_profiler.h"
+
+#include <string.h>
+#include <unity.h>
+#include <cmock.h>
+#include "nrf_error.h"
+#include "utils.h"
+
+#include "timer_mock.h"
+
+static timestamp_t m_time_now;
+
+/*****************************************************************************
+* Setup functions
+*****************************************************************************/
+void setUp(void)
+{
+    timer_mock_Init();
+    m_time_now = 0;
+    timeslot_profiler_clear();
+}
+
+void tearDown(void)
+{
+    timer_mock_Verify();
+    timer_mock_Destroy();
+}
+
+/*****************************************************************************
+* Mock functions
+*****************************************************************************/
+static timestamp_t timer_now_cb(int count)
+{
+    return m_time_now;
+}
+
+/*****************************************************************************
+* Helper functions
+*****************************************************************************/
+static timeslot_profiler_stats_t stats_get(void)
+{
+    timeslot_profiler_stats_t stats;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, timeslot_profiler_stats_get(&stats));
+    return stats;
+}
+
+/*****************************************************************************
+* Tests
+*****************************************************************************/
+void test_stats_get(void)
+{
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, timeslot_profiler_stats_get(NULL));
+
+    timeslot_profiler_stats_t stats = stats_get();
+    timeslot_profiler_stats_t empty;
+    memset(&empty, 0, sizeof(empty));
+    TEST_ASSERT_EQUAL_MEMORY(&empty, &stats, sizeof(stats));
+}
+
+void test_category_time(void)
+{
+    timeslot_profiler_ts_begin(0);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_IDLE, 100);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_SCANNER, 300);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST, 1300);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_IDLE, 1800);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_ACTION_FLASH, 2000);
+    timeslot_profiler_ts_end(10000);
+
+    timeslot_profiler_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(1, stats.timeslot_count);
+    TEST_ASSERT_EQUAL(100, stats.time_us[TIMESLOT_PROFILER_CATEGORY_EXTEND]);
+    TEST_ASSERT_EQUAL(400, stats.time_us[TIMESLOT_PROFILER_CATEGORY_IDLE]);
+    TEST_ASSERT_EQUAL(1000, stats.time_us[TIMESLOT_PROFILER_CATEGORY_SCANNER]);
+    TEST_ASSERT_EQUAL(500, stats.time_us[TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST]);
+    TEST_ASSERT_EQUAL(8000, stats.time_us[TIMESLOT_PROFILER_CATEGORY_ACTION_FLASH]);
+    TEST_ASSERT_EQUAL(0, stats.time_us[TIMESLOT_PROFILER_CATEGORY_ACTION_OTHER]);
+
+    /* Time accumulates over multiple timeslots, and each timeslot starts out extending. */
+    timeslot_profiler_ts_begin(50);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_SCANNER, 150);
+    timeslot_profiler_ts_end(1150);
+
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(2, stats.timeslot_count);
+    TEST_ASSERT_EQUAL(200, stats.time_us[TIMESLOT_PROFILER_CATEGORY_EXTEND]);
+    TEST_ASSERT_EQUAL(2000, stats.time_us[TIMESLOT_PROFILER_CATEGORY_SCANNER]);
+}
+
+void test_duty_cycle(void)
+{
+    /* 0 % radio usage */
+    timeslot_profiler_ts_begin(0);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_IDLE, 100);
+    timeslot_profiler_ts_end(1000);
+
+    /* 25 % radio usage, split between scanner and actions */
+    timeslot_profiler_ts_begin(0);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_SCANNER, 100);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_ACTION_ADV_EXT_TX, 200);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_IDLE, 350);
+    timeslot_profiler_ts_end(1000);
+
+    /* 100 % radio usage ends up in the last bucket */
+    timeslot_profiler_ts_begin(0);
+    timeslot_profiler_switch(TIMESLOT_PROFILER_CATEGORY_SCANNER, 0);
+    timeslot_profiler_ts_end(1000);
+
+    /* Empty timeslots aren't counted */
+    timeslot_profiler_ts_begin(500);
+    timeslot_profiler_ts_end(500);
+
+    timeslot_profiler_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(4, stats.timeslot_count);
+    for (uint32_t i = 0; i < TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT; i++)
+    {
+        uint32_t expected = (i == 0 || i == 2 || i == TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT - 1) ? 1 : 0;
+        TEST_ASSERT_EQUAL(expected, stats.duty_cycle[i]);
+    }
+}
+
+void test_counters(void)
+{
+    timeslot_profiler_extend_end(true);
+    timeslot_profiler_extend_end(false);
+    timeslot_profiler_extend_end(true);
+    timeslot_profiler_blocked();
+    timeslot_profiler_canceled();
+    timeslot_profiler_canceled();
+
+    timeslot_profiler_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(3, stats.extend_count);
+    TEST_ASSERT_EQUAL(1, stats.extend_fail_count);
+    TEST_ASSERT_EQUAL(1, stats.blocked_count);
+    TEST_ASSERT_EQUAL(2, stats.canceled_count);
+
+    timeslot_profiler_dump();
+
+    timeslot_profiler_clear();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.extend_count);
+    TEST_ASSERT_EQUAL(0, stats.extend_fail_count);
+    TEST_ASSERT_EQUAL(0, stats.blocked_count);
+    TEST_ASSERT_EQUAL(0, stats.canceled_count);
+}
+
+void test_hooks_use_device_time(void)
+{
+    timer_now_StubWithCallback(timer_now_cb);
+
+    /* Call the hooks in the same order as the timeslot module does, starting far away from 0 to
+     * catch any mixup with the timeslot local time, which restarts at 0 in every timeslot and isn't
+     * valid until the timeslot has been extended. */
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        m_time_now = 5000000 + i * 100000;
+        TIMESLOT_PROFILER_TS_BEGIN();
+        m_time_now += 200;
+        TIMESLOT_PROFILER_EXTEND_END(true);
+        m_time_now += 300;
+        TIMESLOT_PROFILER_EXTEND_END(false);
+        /* on_ts_begin(), before the timeslot timer is started: */
+        TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_IDLE);
+        m_time_now += 100;
+        /* bearer_handler_on_ts_begin(): */
+        TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_SCANNER);
+        m_time_now += 4000;
+        TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST);
+        m_time_now += 1000;
+        TIMESLOT_PROFILER_SWITCH(TIMESLOT_PROFILER_CATEGORY_IDLE);
+        m_time_now += 4400;
+        /* on_ts_end(), after the timeslot timer is stopped: */
+        TIMESLOT_PROFILER_TS_END();
+    }
+
+    timeslot_profiler_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(2, stats.timeslot_count);
+    TEST_ASSERT_EQUAL(4, stats.extend_count);
+    TEST_ASSERT_EQUAL(2, stats.extend_fail_count);
+    TEST_ASSERT_EQUAL(2 * 500, stats.time_us[TIMESLOT_PROFILER_CATEGORY_EXTEND]);
+    TEST_ASSERT_EQUAL(2 * 4500, stats.time_us[TIMESLOT_PROFILER_CATEGORY_IDLE]);
+    TEST_ASSERT_EQUAL(2 * 4000, stats.time_us[TIMESLOT_PROFILER_CATEGORY_SCANNER]);
+    TEST_ASSERT_EQUAL(2 * 1000, stats.time_us[TIMESLOT_PROFILER_CATEGORY_ACTION_BROADCAST]);
+
+    /* 5 ms of radio usage in 10 ms timeslots */
+    for (uint32_t i = 0; i < TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL((i == TIMESLOT_PROFILER_DUTY_CYCLE_BUCKET_COUNT / 2) ? 2 : 0, stats.duty_cycle[i]);
+    }
+}
@@ -41,6 +41,7 @@
 
 #include "utils.h"
 #include "packet_mesh.h"
+#include "perf_counter.h"
 
 #include "bearer_event_mock.h"
 #include "network_mock.h"
@@ -81,6 +82,7 @@ void setUp(void)
     bearer_event_critical_section_end_Ignore();
 
     is_network_allocation_count_checked = true;
+    perf_counter_clear();
 }
 
 void tearDown(void)
@@ -285,6 +287,81 @@ void test_control_handlers(void)
     TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, transport_control_packet_consumer_add(&out_of_bounds_handler, 1));
 }
 
+void test_rx_perf_counters(void)
+{
+    expect_init();
+    transport_init();
+    replay_cache_add_IgnoreAndReturn(NRF_SUCCESS);
+
+    const uint32_t control_payload_len = 9;
+    packet_mesh_trs_packet_t transport_packet;
+    memset(&transport_packet, 0, sizeof(transport_packet));
+    packet_mesh_trs_common_seg_set(&transport_packet, false);
+    packet_mesh_trs_control_opcode_set(&transport_packet, TRANSPORT_CONTROL_OPCODE_FRIEND_CLEAR);
+
+    network_packet_metadata_t net_meta;
+    memset(&net_meta, 0, sizeof(net_meta));
+    net_meta.dst.type = NRF_MESH_ADDRESS_TYPE_UNICAST;
+    net_meta.dst.value = 0x0001;
+    net_meta.src = 0x0004;
+    net_meta.control_packet = true;
+    net_meta.p_security_material = &m_net_secmat;
+
+    /* Not addressed to this device */
+    nrf_mesh_rx_address_get_ExpectAndReturn(0x0001, NULL, false);
+    nrf_mesh_rx_address_get_IgnoreArg_p_address();
+    replay_cache_has_elem_ExpectAnyArgsAndReturn(false);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, transport_packet_in(&transport_packet,
+                                                       PACKET_MESH_TRS_UNSEG_PDU_OFFSET + control_payload_len,
+                                                       &net_meta,
+                                                       &m_rx_meta));
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_UNKNOWN_ADDRESS]);
+    TEST_ASSERT_EQUAL(0, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_REPLAY]);
+
+    /* Replayed */
+    nrf_mesh_rx_address_get_ExpectAndReturn(0x0001, NULL, true);
+    nrf_mesh_rx_address_get_IgnoreArg_p_address();
+    replay_cache_has_elem_ExpectAnyArgsAndReturn(true);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, transport_packet_in(&transport_packet,
+                                                       PACKET_MESH_TRS_UNSEG_PDU_OFFSET + control_payload_len,
+                                                       &net_meta,
+                                                       &m_rx_meta));
+    TEST_ASSERT_EQUAL(2, g_perf_counters[PERF_COUNTER_TRS_RX]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_UNKNOWN_ADDRESS]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_REPLAY]);
+
+    /* Accepted */
+    nrf_mesh_rx_address_get_ExpectAndReturn(0x0001, NULL, true);
+    nrf_mesh_rx_address_get_IgnoreArg_p_address();
+    replay_cache_has_elem_ExpectAnyArgsAndReturn(false);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, transport_packet_in(&transport_packet,
+                                                       PACKET_MESH_TRS_UNSEG_PDU_OFFSET + control_payload_len,
+                                                       &net_meta,
+                                                       &m_rx_meta));
+    TEST_ASSERT_EQUAL(3, g_perf_counters[PERF_COUNTER_TRS_RX]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_UNKNOWN_ADDRESS]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_REPLAY]);
+    TEST_ASSERT_EQUAL(0, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_DECRYPT]);
+
+    /* Access packet without any matching application key */
+    const uint32_t access_payload_len = 4 + PACKET_MESH_TRS_TRANSMIC_SMALL_SIZE;
+    net_meta.control_packet = false;
+    packet_mesh_trs_access_akf_set(&transport_packet, 1);
+    packet_mesh_trs_access_aid_set(&transport_packet, 0x12);
+    nrf_mesh_rx_address_get_ExpectAndReturn(0x0001, NULL, true);
+    nrf_mesh_rx_address_get_IgnoreArg_p_address();
+    replay_cache_has_elem_ExpectAnyArgsAndReturn(false);
+    enc_nonce_generate_ExpectAnyArgs();
+    nrf_mesh_app_secmat_next_get_ExpectAnyArgs();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, transport_packet_in(&transport_packet,
+                                                       PACKET_MESH_TRS_UNSEG_PDU_OFFSET + access_payload_len,
+                                                       &net_meta,
+                                                       &m_rx_meta));
+    TEST_ASSERT_EQUAL(4, g_perf_counters[PERF_COUNTER_TRS_RX]);
+    TEST_ASSERT_EQUAL(1, g_perf_counters[PERF_COUNTER_TRS_RX_DROP_DECRYPT]);
+}
+
 void test_control_tx(void)
 {
     expect_init();
@@ -110,6 +110,9 @@ typedef enum
 /**
  * Gets the composition data block.
  *
+ * The block is kept in RAM and only rebuilt when the access layer composition changes, see
+ * @ref access_composition_revision_get.
+ *
  * @param[in,out] p_data Pointer to block of memory to write the composition data.
  * @param[in,out] p_size Size of the data block. Actual size is written back to the variable.
  *
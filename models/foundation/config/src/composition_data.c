@@ -43,6 +43,11 @@
 #include "access_config.h"
 #include "nrf_mesh_assert.h"
 
+/** Serialized composition data page 0, rebuilt whenever the access layer composition changes. */
+static uint8_t m_composition_data[CONFIG_COMPOSITION_DATA_SIZE];
+static uint16_t m_composition_data_size;
+static uint32_t m_composition_revision;
+
 static uint16_t composition_data_vendor_models_write(uint16_t element_index, const access_model_handle_t * p_handles, uint16_t count, uint8_t * p_buffer)
 {
     uint16_t bytes = 0;
@@ -79,11 +84,8 @@ static uint16_t composition_data_sig_models_write(uint16_t element_index, const
     return bytes;
 }
 
-void config_composition_data_get(uint8_t * p_data, uint16_t * p_size)
+static void composition_data_build(uint8_t * p_data, uint16_t * p_size)
 {
-    NRF_MESH_ASSERT(p_data != NULL && p_size != NULL);
-    NRF_MESH_ASSERT(*p_size >= CONFIG_COMPOSITION_DATA_SIZE);
-
     access_model_handle_t model_handles[ACCESS_MODEL_COUNT];
     uint16_t element_models_count = 0;
     config_composition_data_header_t device;
@@ -142,3 +144,19 @@ void config_composition_data_get(uint8_t * p_data, uint16_t * p_size)
         }
     }
 }
+
+void config_composition_data_get(uint8_t * p_data, uint16_t * p_size)
+{
+    NRF_MESH_ASSERT(p_data != NULL && p_size != NULL);
+    NRF_MESH_ASSERT(*p_size >= CONFIG_COMPOSITION_DATA_SIZE);
+
+    uint32_t revision = access_composition_revision_get();
+    if (m_composition_data_size == 0 || revision != m_composition_revision)
+    {
+        composition_data_build(m_composition_data, &m_composition_data_size);
+        m_composition_revision = revision;
+    }
+
+    memcpy(p_data, m_composition_data, m_composition_data_size);
+    *p_size = m_composition_data_size;
+}
@@ -148,6 +148,24 @@ static nrf_mesh_evt_handler_t m_mesh_evt_handler = { .evt_cb = mesh_event_cb };
 static nrf_mesh_tx_token_t m_reset_token;
 static node_reset_state_t m_node_reset_pending = NODE_RESET_IDLE;
 
+/** Last subscription list served, valid while the access model lists revision is unchanged. */
+static struct
+{
+    access_model_handle_t model_handle;
+    uint32_t revision;
+    uint16_t count;
+    uint16_t addresses[DSM_ADDR_MAX];
+} m_subscription_list_cache = { .model_handle = ACCESS_HANDLE_INVALID };
+
+/** Last application key index list served, valid while the access model lists revision is unchanged. */
+static struct
+{
+    access_model_handle_t model_handle;
+    uint32_t revision;
+    uint16_t count;
+    mesh_key_index_t appkey_indexes[DSM_APP_MAX];
+} m_appkey_list_cache = { .model_handle = ACCESS_HANDLE_INVALID };
+
 /********** Helper functions **********/
 
 static inline void app_evt_send(const config_server_evt_t * p_evt)
@@ -547,6 +565,15 @@ static uint16_t get_element_index(uint16_t element_address)
 
 static inline access_status_t get_subscription_list(access_model_handle_t model_handle, uint16_t * p_sublist, uint16_t * p_subcount)
 {
+    const uint32_t revision = access_model_lists_revision_get();
+    if (m_subscription_list_cache.model_handle == model_handle &&
+        m_subscription_list_cache.revision == revision)
+    {
+        memcpy(p_sublist, m_subscription_list_cache.addresses, m_subscription_list_cache.count * sizeof(uint16_t));
+        *p_subcount = m_subscription_list_cache.count;
+        return ACCESS_STATUS_SUCCESS;
+    }
+
     uint32_t status = access_model_subscriptions_get(model_handle, p_sublist, p_subcount);
     switch (status)
     {
@@ -556,7 +583,7 @@ static inline access_status_t get_subscription_list(access_model_handle_t model_
             nrf_mesh_address_t addr;
             for (uint32_t i = 0; i < *p_subcount; i++)
             {
-                if (dsm_address_get(*p_sublist, &addr) != NRF_SUCCESS)
+                if (dsm_address_get(p_sublist[i], &addr) != NRF_SUCCESS)
                 {
                     return ACCESS_STATUS_UNSPECIFIED_ERROR;
                 }
@@ -565,7 +592,7 @@ static inline access_status_t get_subscription_list(access_model_handle_t model_
                     if (addr.type == NRF_MESH_ADDRESS_TYPE_VIRTUAL ||
                         addr.type == NRF_MESH_ADDRESS_TYPE_GROUP)
                     {
-                        *(p_sublist++) = addr.value;
+                        p_sublist[i] = addr.value;
                     }
                     else
                     {
@@ -573,6 +600,11 @@ static inline access_status_t get_subscription_list(access_model_handle_t model_
                     }
                 }
             }
+
+            m_subscription_list_cache.model_handle = model_handle;
+            m_subscription_list_cache.revision = revision;
+            m_subscription_list_cache.count = *p_subcount;
+            memcpy(m_subscription_list_cache.addresses, p_sublist, *p_subcount * sizeof(uint16_t));
             return ACCESS_STATUS_SUCCESS;
         }
         case NRF_ERROR_NOT_SUPPORTED:
@@ -584,6 +616,31 @@ static inline access_status_t get_subscription_list(access_model_handle_t model_
     }
 }
 
+static void get_appkey_index_list(access_model_handle_t model_handle, mesh_key_index_t * p_appkey_list, uint16_t * p_appkey_count)
+{
+    const uint32_t revision = access_model_lists_revision_get();
+    if (m_appkey_list_cache.model_handle == model_handle &&
+        m_appkey_list_cache.revision == revision)
+    {
+        memcpy(p_appkey_list, m_appkey_list_cache.appkey_indexes, m_appkey_list_cache.count * sizeof(mesh_key_index_t));
+        *p_appkey_count = m_appkey_list_cache.count;
+        return;
+    }
+
+    NRF_MESH_ASSERT(access_model_applications_get(model_handle, p_appkey_list, p_appkey_count) == NRF_SUCCESS);
+
+    /* Retrieve the appkey indexes from the DSM: */
+    for (uint16_t i = 0; i < *p_appkey_count; ++i)
+    {
+        NRF_MESH_ASSERT(dsm_appkey_handle_to_appkey_index(p_appkey_list[i], &p_appkey_list[i]) == NRF_SUCCESS);
+    }
+
+    m_appkey_list_cache.model_handle = model_handle;
+    m_appkey_list_cache.revision = revision;
+    m_appkey_list_cache.count = *p_appkey_count;
+    memcpy(m_appkey_list_cache.appkey_indexes, p_appkey_list, *p_appkey_count * sizeof(mesh_key_index_t));
+}
+
 static uint32_t config_server_heartbeat_publication_params_get(heartbeat_publication_information_t * p_pub_info)
 {
 
@@ -777,6 +834,8 @@ static void handle_appkey_delete(access_model_handle_t handle, const access_mess
             {
                 NRF_MESH_ERROR_CHECK(access_model_publication_by_appkey_stop(evt.params.appkey_delete.appkey_handle));
                 NRF_MESH_ERROR_CHECK(dsm_appkey_delete(evt.params.appkey_delete.appkey_handle));
+                /* Models stay bound to the deleted handle, which may be reused by another key. */
+                m_appkey_list_cache.model_handle = ACCESS_HANDLE_INVALID;
             }
             else
             {
@@ -2699,6 +2758,7 @@ static void handle_netkey_delete(access_model_handle_t handle, const access_mess
 
         if (NRF_SUCCESS == status)
         {
+            m_appkey_list_cache.model_handle = ACCESS_HANDLE_INVALID;
             for (uint32_t i = 0; i < counter; i++)
             {
                 NRF_MESH_ERROR_CHECK(access_model_publication_by_appkey_stop(appkey_instances[i]));
@@ -2965,13 +3025,7 @@ static void handle_model_app_get(access_model_handle_t handle, const access_mess
     /* Get the application list: */
     uint16_t appkey_instances[DSM_APP_MAX];
     uint16_t appkey_count = DSM_APP_MAX;
-    NRF_MESH_ASSERT(access_model_applications_get(model_handle, appkey_instances, &appkey_count) == NRF_SUCCESS);
-
-    /* Retrieve the appkey indexes from the DSM: */
-    for (uint16_t i = 0; i < appkey_count; ++i)
-    {
-        NRF_MESH_ASSERT(dsm_appkey_handle_to_appkey_index(appkey_instances[i], &appkey_instances[i]) == NRF_SUCCESS);
-    }
+    get_appkey_index_list(model_handle, appkey_instances, &appkey_count);
 
     uint8_t response_size = model_app_response_create(p_message->opcode.opcode,
                                                       response_buffer,
@@ -3175,6 +3229,8 @@ uint32_t config_server_init(config_server_evt_cb_t evt_cb)
 #endif
 
     m_evt_cb = evt_cb;
+    m_subscription_list_cache.model_handle = ACCESS_HANDLE_INVALID;
+    m_appkey_list_cache.model_handle = ACCESS_HANDLE_INVALID;
     return access_model_add(&init_params, &m_config_server_handle);
 }
 
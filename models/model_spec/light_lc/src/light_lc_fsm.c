@@ -206,6 +206,8 @@ static const char * m_state_lookup_table[] =
 };
 #endif  /* FSM_DEBUG */
 
+static uint8_t m_lc_fsm_index[FSM_INDEX_SIZE(VA_NARGS(STATE_LIST), VA_NARGS(EVENT_LIST))];
+
 static fsm_const_descriptor_t m_lc_fsm_descriptor =
 {
     .transition_table = m_lc_fsm_transition_table,
@@ -213,6 +215,9 @@ static fsm_const_descriptor_t m_lc_fsm_descriptor =
     .initial_state = S_OFF,
     .guard = lc_fsm_guard,
     .action = lc_fsm_action,
+    .p_index = m_lc_fsm_index,
+    .state_count = VA_NARGS(STATE_LIST),
+    .event_count = VA_NARGS(EVENT_LIST),
 #if FSM_DEBUG
     .fsm_name = "LC-SRV-fsm",
     .action_lookup = m_action_lookup_table,
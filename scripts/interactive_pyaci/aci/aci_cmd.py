@@ -150,12 +150,40 @@ class HousekeepingDataGet(CommandPacket):
 
 
 class HousekeepingDataClear(CommandPacket):
-    """Clear the current housekeeping data values."""
+    """Clear the current housekeeping data values, including the command latency counters."""
     def __init__(self):
         __data = bytearray()
         super(HousekeepingDataClear, self).__init__(0x15, __data)
 
 
+class Batch(CommandPacket):
+    """Process several commands from a single packet.
+
+    Parameters
+    ----------
+        commands : uint8_t[254]
+            Commands to process.
+    """
+    def __init__(self, commands):
+        __data = bytearray()
+        __data += iterable_to_barray(commands)
+        super(Batch, self).__init__(0x16, __data)
+
+
+class CmdLatencyGet(CommandPacket):
+    """Get the latency counters of the command handler for the given opcode.
+
+    Parameters
+    ----------
+        opcode : uint8_t
+            Opcode of the command to get the latency counters for.
+    """
+    def __init__(self, opcode):
+        __data = bytearray()
+        __data += struct.pack("<B", opcode)
+        super(CmdLatencyGet, self).__init__(0x17, __data)
+
+
 class Application(CommandPacket):
     """Application-specific command.
 
@@ -939,6 +967,80 @@ class ConfigServerBind(CommandPacket):
         super(ConfigServerBind, self).__init__(0xAD, __data)
 
 
+class CountersGet(CommandPacket):
+    """Get a range of performance counter values.
+
+    Parameters
+    ----------
+        first : uint8_t
+            First counter to get.
+        count : uint8_t
+            Number of counters to get.
+    """
+    def __init__(self, first, count):
+        __data = bytearray()
+        __data += struct.pack("<B", first)
+        __data += struct.pack("<B", count)
+        super(CountersGet, self).__init__(0xB0, __data)
+
+
+class HistogramGet(CommandPacket):
+    """Get the buckets and the largest sample of a performance histogram.
+
+    Parameters
+    ----------
+        histogram : uint8_t
+            Histogram to get.
+    """
+    def __init__(self, histogram):
+        __data = bytearray()
+        __data += struct.pack("<B", histogram)
+        super(HistogramGet, self).__init__(0xB1, __data)
+
+
+class Clear(CommandPacket):
+    """Clear all performance counters and histograms."""
+    def __init__(self):
+        __data = bytearray()
+        super(Clear, self).__init__(0xB2, __data)
+
+
+class HbSourceGet(CommandPacket):
+    """Get the heartbeat statistics the heartbeat collector keeps for a single source.
+
+    Parameters
+    ----------
+        src : uint16_t
+            Unicast address of the heartbeat source to get.
+    """
+    def __init__(self, src):
+        __data = bytearray()
+        __data += struct.pack("<H", src)
+        super(HbSourceGet, self).__init__(0xB3, __data)
+
+
+class HbSourcesList(CommandPacket):
+    """List the heartbeat statistics of all sources in the heartbeat collector.
+
+    Parameters
+    ----------
+        index : uint16_t
+            Collector table index to start listing from. Use 0 for the first call, and the returned
+            next index for the following calls.
+    """
+    def __init__(self, index):
+        __data = bytearray()
+        __data += struct.pack("<H", index)
+        super(HbSourcesList, self).__init__(0xB4, __data)
+
+
+class HbSourcesClear(CommandPacket):
+    """Remove all sources from the heartbeat collector."""
+    def __init__(self):
+        __data = bytearray()
+        super(HbSourcesClear, self).__init__(0xB5, __data)
+
+
 class JumpToBootloader(CommandPacket):
     """Immediately jump to bootloader mode."""
     def __init__(self):
@@ -1437,6 +1539,25 @@ class HousekeepingDataGetRsp(ResponsePacket):
         super(HousekeepingDataGetRsp, self).__init__("HousekeepingDataGet", 0x14, __data)
 
 
+class BatchRsp(ResponsePacket):
+    """Response to a(n) Batch command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["responses"] = raw_data[0:252]
+        super(BatchRsp, self).__init__("Batch", 0x16, __data)
+
+
+class CmdLatencyGetRsp(ResponsePacket):
+    """Response to a(n) CmdLatencyGet command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["opcode"], = struct.unpack("<B", raw_data[0:1])
+        __data["count"], = struct.unpack("<I", raw_data[1:5])
+        __data["max_us"], = struct.unpack("<I", raw_data[5:9])
+        __data["total_us"], = struct.unpack("<I", raw_data[9:13])
+        super(CmdLatencyGetRsp, self).__init__("CmdLatencyGet", 0x17, __data)
+
+
 class AdvAddrGetRsp(ResponsePacket):
     """Response to a(n) AdvAddrGet command."""
     def __init__(self, raw_data):
@@ -1700,6 +1821,53 @@ class PacketSendRsp(ResponsePacket):
         super(PacketSendRsp, self).__init__("PacketSend", 0xAB, __data)
 
 
+class CountersGetRsp(ResponsePacket):
+    """Response to a(n) CountersGet command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["total_count"], = struct.unpack("<B", raw_data[0:1])
+        __data["first"], = struct.unpack("<B", raw_data[1:2])
+        __data["count"], = struct.unpack("<B", raw_data[2:3])
+        __data["values"] = raw_data[3:251]
+        super(CountersGetRsp, self).__init__("CountersGet", 0xB0, __data)
+
+
+class HistogramGetRsp(ResponsePacket):
+    """Response to a(n) HistogramGet command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["histogram"], = struct.unpack("<B", raw_data[0:1])
+        __data["max"], = struct.unpack("<I", raw_data[1:5])
+        __data["buckets"] = raw_data[5:69]
+        super(HistogramGetRsp, self).__init__("HistogramGet", 0xB1, __data)
+
+
+class HbSourceGetRsp(ResponsePacket):
+    """Response to a(n) HbSourceGet command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["src"], = struct.unpack("<H", raw_data[0:2])
+        __data["count"], = struct.unpack("<H", raw_data[2:4])
+        __data["features"], = struct.unpack("<H", raw_data[4:6])
+        __data["hops"], = struct.unpack("<B", raw_data[6:7])
+        __data["min_hops"], = struct.unpack("<B", raw_data[7:8])
+        __data["max_hops"], = struct.unpack("<B", raw_data[8:9])
+        __data["rssi"], = struct.unpack("<b", raw_data[9:10])
+        __data["age_ms"], = struct.unpack("<I", raw_data[10:14])
+        super(HbSourceGetRsp, self).__init__("HbSourceGet", 0xB3, __data)
+
+
+class HbSourcesListRsp(ResponsePacket):
+    """Response to a(n) HbSourcesList command."""
+    def __init__(self, raw_data):
+        __data = {}
+        __data["total_count"], = struct.unpack("<H", raw_data[0:2])
+        __data["next_index"], = struct.unpack("<H", raw_data[2:4])
+        __data["count"], = struct.unpack("<B", raw_data[4:5])
+        __data["sources"] = raw_data[5:243]
+        super(HbSourcesListRsp, self).__init__("HbSourcesList", 0xB4, __data)
+
+
 class BankInfoGetRsp(ResponsePacket):
     """Response to a(n) BankInfoGet command."""
     def __init__(self, raw_data):
@@ -1856,6 +2024,8 @@ RESPONSE_LUT = {
     0x0A: {"object": FwInfoGetRsp, "name": "FwInfoGet"},
     0x13: {"object": BeaconParamsGetRsp, "name": "BeaconParamsGet"},
     0x14: {"object": HousekeepingDataGetRsp, "name": "HousekeepingDataGet"},
+    0x16: {"object": BatchRsp, "name": "Batch"},
+    0x17: {"object": CmdLatencyGetRsp, "name": "CmdLatencyGet"},
     0x41: {"object": AdvAddrGetRsp, "name": "AdvAddrGet"},
     0x45: {"object": TxPowerGetRsp, "name": "TxPowerGet"},
     0x54: {"object": UuidGetRsp, "name": "UuidGet"},
@@ -1888,6 +2058,10 @@ RESPONSE_LUT = {
     0xA5: {"object": AddrPublicationAddVirtualRsp, "name": "AddrPublicationAddVirtual"},
     0xA6: {"object": AddrPublicationRemoveRsp, "name": "AddrPublicationRemove"},
     0xAB: {"object": PacketSendRsp, "name": "PacketSend"},
+    0xB0: {"object": CountersGetRsp, "name": "CountersGet"},
+    0xB1: {"object": HistogramGetRsp, "name": "HistogramGet"},
+    0xB3: {"object": HbSourceGetRsp, "name": "HbSourceGet"},
+    0xB4: {"object": HbSourcesListRsp, "name": "HbSourcesList"},
     0xD4: {"object": BankInfoGetRsp, "name": "BankInfoGet"},
     0xD6: {"object": StateGetRsp, "name": "StateGet"},
     0xE1: {"object": ModelPubAddrGetRsp, "name": "ModelPubAddrGet"},
@@ -0,0 +1,249 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Compressed and delta encoding of firmware images for mesh DFU.
+
+The encoded image is decoded by the bootloader as it arrives, see mesh/bootloader/include/dfu_decode.h
+for the format. Parts of the new firmware that are unchanged from the firmware currently on the
+device (the base) are copied from the device's own flash, and repeated parts are copied from earlier
+in the new firmware, so only the changes have to be sent over the air.
+"""
+
+import argparse
+import struct
+import sys
+
+LITERAL_LEN_MAX = 0x80
+MATCH_LEN_MIN = 4
+MATCH_LEN_MAX = 0x3F + MATCH_LEN_MIN
+MATCH_DISTANCE_MAX = 0xFFFF
+BASE_COPY_LEN_MAX = 0x4000
+BASE_OFFSET_MAX = 0xFFFFFF
+
+# Only use copies that are cheaper than sending the data as part of a literal.
+MATCH_LEN_USE_MIN = 5
+BASE_COPY_LEN_USE_MIN = 8
+
+HASH_LEN = 4
+HASH_CANDIDATES_MAX = 16
+
+SEGMENT_LENGTH = 16
+# Each DFU data packet carries one segment. On air, it's a 24 byte DFU packet inside a 4 byte AD
+# structure, with 16 bytes of preamble, access address, header, advertising address and CRC.
+DATA_PACKET_AIRTIME_US = (24 + 4 + 16) * 8
+
+
+class DecodeError(Exception):
+    pass
+
+
+def _index_add(index, data, pos):
+    key = bytes(data[pos:pos + HASH_LEN])
+    candidates = index.setdefault(key, [])
+    candidates.append(pos)
+    if len(candidates) > HASH_CANDIDATES_MAX:
+        del candidates[0]
+
+
+def _match_length(a, a_pos, b, b_pos, max_len):
+    length = 0
+    while length < max_len and a_pos + length < len(a) and b_pos + length < len(b) and \
+            a[a_pos + length] == b[b_pos + length]:
+        length += 1
+    return length
+
+
+def _literal(data):
+    return bytearray([len(data) - 1]) + data
+
+
+def pad(firmware):
+    """Pad firmware with erased flash to the word length the transfer is done in."""
+    return bytes(firmware) + b"\xff" * ((-len(firmware)) % 4)
+
+
+def encode(firmware, base=None):
+    """Encode firmware, optionally as a delta against the base firmware on the device.
+
+    The firmware is padded to a whole number of words first, as the device decodes the length in the
+    start packet, which is given in words.
+    """
+    firmware = bytearray(pad(firmware))
+    base = bytearray(base) if base else bytearray()
+    base_index = {}
+    for pos in range(min(len(base), BASE_OFFSET_MAX) - HASH_LEN + 1):
+        _index_add(base_index, base, pos)
+    window_index = {}
+
+    out = bytearray()
+    literal = bytearray()
+    pos = 0
+    while pos < len(firmware):
+        key = bytes(firmware[pos:pos + HASH_LEN])
+
+        # Firmware that's been rebuilt tends to keep its layout, so try the same offset first.
+        base_offset, base_len = 0, 0
+        for candidate in [pos] + base_index.get(key, []):
+            if candidate >= len(base) or candidate > BASE_OFFSET_MAX:
+                continue
+            length = _match_length(firmware, pos, base, candidate, BASE_COPY_LEN_MAX)
+            if length > base_len:
+                base_offset, base_len = candidate, length
+
+        match_distance, match_len = 0, 0
+        for candidate in reversed(window_index.get(key, [])):
+            if pos - candidate > MATCH_DISTANCE_MAX:
+                break
+            length = _match_length(firmware, pos, firmware, candidate, MATCH_LEN_MAX)
+            if length > match_len:
+                match_distance, match_len = pos - candidate, length
+
+        if base_len >= BASE_COPY_LEN_USE_MIN and base_len - 5 >= match_len - 3:
+            command = struct.pack("<BBHB", 0xC0 | ((base_len - 1) >> 8), (base_len - 1) & 0xFF,
+                                  base_offset & 0xFFFF, base_offset >> 16)
+            length = base_len
+        elif match_len >= MATCH_LEN_USE_MIN:
+            command = struct.pack("<BH", 0x80 | (match_len - MATCH_LEN_MIN), match_distance)
+            length = match_len
+        else:
+            command = None
+            length = 1
+            literal.append(firmware[pos])
+            if len(literal) == LITERAL_LEN_MAX:
+                out += _literal(literal)
+                literal = bytearray()
+
+        if command:
+            if literal:
+                out += _literal(literal)
+                literal = bytearray()
+            out += command
+
+        for i in range(pos, pos + length):
+            _index_add(window_index, firmware, i)
+        pos += length
+
+    if literal:
+        out += _literal(literal)
+
+    # The transfer is done in words, the decoder ignores anything after the end of the firmware.
+    out += bytearray((-len(out)) % 4)
+    return bytes(out)
+
+
+def decode(encoded, length, base=None):
+    """Reference decoder, works the same way as the one in the bootloader."""
+    encoded = bytearray(encoded)
+    base = bytearray(base) if base else None
+    out = bytearray()
+    pos = 0
+    while len(out) < length:
+        if pos >= len(encoded):
+            raise DecodeError("Encoded firmware ended at %d of %d bytes" % (len(out), length))
+        header = encoded[pos]
+        if header < 0x80:
+            count = (header & 0x7F) + 1
+            data = encoded[pos + 1:pos + 1 + count]
+            if len(data) < count:
+                raise DecodeError("Truncated literal")
+            pos += 1 + count
+        elif header < 0xC0:
+            if pos + 3 > len(encoded):
+                raise DecodeError("Truncated match")
+            count = (header & 0x3F) + MATCH_LEN_MIN
+            distance = encoded[pos + 1] | (encoded[pos + 2] << 8)
+            if distance == 0 or distance > len(out):
+                raise DecodeError("Invalid match distance %d" % distance)
+            data = bytearray()
+            for i in range(count):
+                # Matches may overlap themselves.
+                source = len(out) - distance + i
+                data.append(out[source] if source < len(out) else data[source - len(out)])
+            pos += 3
+        else:
+            if pos + 5 > len(encoded):
+                raise DecodeError("Truncated base copy")
+            count = (((header & 0x3F) << 8) | encoded[pos + 1]) + 1
+            offset = encoded[pos + 2] | (encoded[pos + 3] << 8) | (encoded[pos + 4] << 16)
+            if base is None or offset + count > len(base):
+                raise DecodeError("Invalid base copy at 0x%x" % offset)
+            data = base[offset:offset + count]
+            pos += 5
+        if len(out) + len(data) > length:
+            raise DecodeError("Command goes past the end of the firmware")
+        out += data
+    return bytes(out)
+
+
+def segment_count(length):
+    return (length + SEGMENT_LENGTH - 1) // SEGMENT_LENGTH
+
+
+def airtime_us(length):
+    """Airtime of one transmission of all data packets in a transfer of the given length."""
+    return segment_count(length) * DATA_PACKET_AIRTIME_US
+
+
+def read_firmware(path):
+    if path.lower().endswith(".hex"):
+        from intelhex import IntelHex
+        ih = IntelHex(path)
+        return ih.tobinstr()
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Encode firmware for compressed or delta mesh DFU")
+    parser.add_argument("firmware", help="New firmware, as a .hex or .bin file")
+    parser.add_argument("-b", "--base", help="Firmware currently on the devices, for delta encoding. "
+                        "The devices must use a separate bank for the transfer.")
+    parser.add_argument("-o", "--output-file", required=True, help="Encoded output .bin file")
+    args = parser.parse_args()
+
+    firmware = pad(read_firmware(args.firmware))
+    base = read_firmware(args.base) if args.base else None
+    encoded = encode(firmware, base)
+    if decode(encoded, len(firmware), base) != firmware:
+        print("Error: Encoded firmware doesn't decode correctly.")
+        sys.exit(1)
+
+    with open(args.output_file, "wb") as f:
+        f.write(encoded)
+
+    saved = 100.0 * (1.0 - float(airtime_us(len(encoded))) / airtime_us(len(firmware)))
+    print("Firmware length:  %d bytes (%d words)" % (len(firmware), len(firmware) // 4))
+    print("Encoded length:   %d bytes (%d words)" % (len(encoded), len(encoded) // 4))
+    print("Data packets:     %d -> %d" % (segment_count(len(firmware)), segment_count(len(encoded))))
+    print("Airtime per hop:  %.1f ms -> %.1f ms (%.1f%% saved)" %
+          (airtime_us(len(firmware)) / 1000.0, airtime_us(len(encoded)) / 1000.0, saved))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Tests for dfu_encode.py. Run with: python -m unittest test_dfu_encode"""
+
+import random
+import unittest
+
+import dfu_encode
+
+
+def random_firmware(length, seed):
+    rng = random.Random(seed)
+    # Mix of random data and repeated instruction-like patterns, like compiled code.
+    firmware = bytearray()
+    while len(firmware) < length:
+        if rng.random() < 0.5:
+            firmware += bytearray(rng.getrandbits(8) for _ in range(rng.randint(1, 32)))
+        else:
+            firmware += bytearray([0x00, 0xBF, 0x70, 0x47]) * rng.randint(1, 8)
+    return bytes(firmware[:length])
+
+
+class TestDfuEncode(unittest.TestCase):
+    def assertRoundTrip(self, firmware, base=None):
+        encoded = dfu_encode.encode(firmware, base)
+        self.assertEqual(len(encoded) % 4, 0)
+        # The device decodes the firmware length in words.
+        padded = dfu_encode.pad(firmware)
+        self.assertEqual(len(padded) % 4, 0)
+        self.assertEqual(dfu_encode.decode(encoded, len(padded), base), padded)
+        return encoded
+
+    def test_empty_and_short(self):
+        for length in range(0, 10):
+            self.assertRoundTrip(bytes(bytearray(range(length))))
+
+    def test_unaligned_length(self):
+        firmware = random_firmware(1027, 5)
+        encoded = self.assertRoundTrip(firmware)
+        decoded = dfu_encode.decode(encoded, 1028)
+        self.assertEqual(decoded[:1027], firmware)
+        self.assertEqual(decoded[1027:], b"\xff")
+
+    def test_compressed(self):
+        firmware = random_firmware(8192, 1)
+        encoded = self.assertRoundTrip(firmware)
+        self.assertLess(len(encoded), len(firmware))
+
+    def test_erased_flash(self):
+        firmware = b"\xff" * 4096
+        encoded = self.assertRoundTrip(firmware)
+        # Each match covers up to 67 bytes at a cost of 3.
+        self.assertLess(len(encoded), 4096 // 16)
+
+    def test_incompressible(self):
+        rng = random.Random(2)
+        firmware = bytes(bytearray(rng.getrandbits(8) for _ in range(4096)))
+        encoded = self.assertRoundTrip(firmware)
+        # Literals cost one byte per 128 bytes of data, plus padding.
+        self.assertLessEqual(len(encoded), 4096 + 4096 // 128 + 4)
+
+    def test_delta(self):
+        base = random_firmware(16384, 3)
+        firmware = bytearray(base)
+        # Change a constant, and insert a few bytes of code that shifts the rest of the image.
+        firmware[100:104] = b"\x01\x02\x03\x04"
+        firmware[8000:8000] = b"\x10\xb5\x00\xf0"
+        firmware = bytes(firmware)
+        encoded = self.assertRoundTrip(firmware, base)
+        self.assertLess(len(encoded), 64)
+
+    def test_delta_without_base_fails(self):
+        base = random_firmware(1024, 4)
+        encoded = dfu_encode.encode(base, base)
+        with self.assertRaises(dfu_encode.DecodeError):
+            dfu_encode.decode(encoded, len(base))
+
+    def test_invalid_match_distance(self):
+        encoded = bytes(bytearray([0x00, 0xAA, 0x80, 0x02, 0x00]))
+        with self.assertRaises(dfu_encode.DecodeError):
+            dfu_encode.decode(encoded, 5)
+
+    def test_truncated(self):
+        firmware = random_firmware(1024, 5)
+        encoded = dfu_encode.encode(firmware)
+        with self.assertRaises(dfu_encode.DecodeError):
+            dfu_encode.decode(encoded[:len(encoded) // 2], len(firmware))
+
+    def test_airtime_saved(self):
+        """A typical small application update should take a fraction of the airtime."""
+        base = random_firmware(32768, 6)
+        firmware = bytearray(base)
+        firmware[0x1000:0x1010] = bytearray(range(16))
+        firmware[0x4000:0x4000] = b"\x00\xbf" * 8
+        firmware[-8:] = b"\x02\x00\x00\x00\x01\x00\x00\x00"
+        firmware = bytes(firmware)
+
+        plain_us = dfu_encode.airtime_us(len(firmware))
+        compressed_us = dfu_encode.airtime_us(len(self.assertRoundTrip(firmware)))
+        delta_us = dfu_encode.airtime_us(len(self.assertRoundTrip(firmware, base)))
+        print("\nAirtime per hop: plain %.1f ms, compressed %.1f ms, delta %.1f ms" %
+              (plain_us / 1000.0, compressed_us / 1000.0, delta_us / 1000.0))
+        self.assertLess(compressed_us, plain_us)
+        self.assertLess(delta_us, plain_us / 50)
+
+
+if __name__ == "__main__":
+    unittest.main()
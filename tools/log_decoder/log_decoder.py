@@ -0,0 +1,193 @@
+# Copyright (c) 2010 - 2020, Nordic Semiconductor ASA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Decoder for the deferred binary log of the mesh stack.
+
+Reads the raw log stream written with LOG_DEFERRED_ENABLE and prints the messages as text, in the
+same format as the RTT log callback. The format strings and source locations are looked up in the
+ELF file of the firmware that produced the log.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.constants import SH_FLAGS
+
+LOG_DEFERRED_SYNC = 0xA5
+LOG_DEFERRED_TYPE_PRINTF = 0
+LOG_DEFERRED_TYPE_ARRAY = 1
+
+# const char * p_filename, const char * p_format, uint16_t line, uint8_t level, uint8_t type
+META_FORMAT = "<IIHBB"
+META_SIZE = struct.calcsize(META_FORMAT)
+
+CONVERSION_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t)?([diouxXcsp%])")
+
+
+class FirmwareImage(object):
+    """Read-only view of the initialized memory of an ELF file."""
+
+    def __init__(self, elf_file):
+        self.regions = []
+        for section in ELFFile(elf_file).iter_sections():
+            if (section["sh_flags"] & SH_FLAGS.SHF_ALLOC) and section["sh_type"] != "SHT_NOBITS":
+                self.regions.append((section["sh_addr"], section.data()))
+
+    def read(self, address, length):
+        for start, data in self.regions:
+            if start <= address and address + length <= start + len(data):
+                return data[address - start:address - start + length]
+        return None
+
+    def read_string(self, address):
+        for start, data in self.regions:
+            if start <= address < start + len(data):
+                end = data.find(b"\0", address - start)
+                if end < 0:
+                    return None
+                return data[address - start:end].decode("utf-8", "replace")
+        return None
+
+    def read_meta(self, address):
+        data = self.read(address, META_SIZE)
+        if data is None:
+            return None
+        p_filename, p_format, line, level, record_type = struct.unpack(META_FORMAT, data)
+        if record_type not in (LOG_DEFERRED_TYPE_PRINTF, LOG_DEFERRED_TYPE_ARRAY):
+            return None
+        filename = self.read_string(p_filename)
+        if filename is None:
+            return None
+        fmt = self.read_string(p_format) if record_type == LOG_DEFERRED_TYPE_PRINTF else None
+        return {"filename": filename.replace("\\", "/").split("/")[-1],
+                "format": fmt,
+                "line": line,
+                "level": level,
+                "type": record_type}
+
+
+def format_message(image, fmt, args):
+    """Applies C printf() conversions to a list of 32-bit arguments."""
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    def convert(match):
+        flags, width, precision, _, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            width = str(next_arg())
+        if precision == "*":
+            precision = str(next_arg())
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+        value = next_arg()
+        if conversion in "di":
+            return (spec + "d") % (value - (1 << 32) if value & 0x80000000 else value)
+        if conversion == "u":
+            return (spec + "d") % value
+        if conversion in "oxX":
+            return (spec + conversion) % value
+        if conversion == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conversion == "p":
+            return "0x%08x" % value
+        string = image.read_string(value)
+        return (spec + "s") % (string if string is not None else "<0x%08x>" % value)
+
+    return CONVERSION_SPEC.sub(convert, fmt)
+
+
+def decode(image, stream, out):
+    buffer = b""
+    while True:
+        data = stream.read(4096)
+        if not data:
+            break
+        buffer += data
+
+        while len(buffer) >= 4:
+            header, = struct.unpack("<I", buffer[:4])
+            word_count = header & 0xFF
+            dropped = (header >> 8) & 0xFFFF
+            if (header >> 24) != LOG_DEFERRED_SYNC or word_count < 2:
+                # Out of sync, search for the next header.
+                buffer = buffer[1:]
+                continue
+
+            if len(buffer) < 4 * (word_count + 1):
+                break
+
+            words = struct.unpack("<%dI" % word_count, buffer[4:4 * (word_count + 1)])
+            meta = image.read_meta(words[0])
+            if meta is None:
+                buffer = buffer[1:]
+                continue
+            buffer = buffer[4 * (word_count + 1):]
+
+            if dropped > 0:
+                out.write("<%u messages dropped>\n" % dropped)
+
+            prefix = "<t: %10u>, %s, %4d, " % (words[1], meta["filename"], meta["line"])
+            if meta["type"] == LOG_DEFERRED_TYPE_PRINTF:
+                out.write(prefix + format_message(image, meta["format"], words[2:]))
+            else:
+                msg = image.read_string(words[2])
+                length = words[3]
+                array = struct.pack("<%dI" % (word_count - 4), *words[4:])[:length]
+                out.write(prefix + "%s: %s\n" % (msg if msg is not None else "<0x%08x>" % words[2],
+                                                 "".join("%02X" % b for b in bytearray(array))))
+        out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Deferred binary log decoder")
+    parser.add_argument("elf", help="ELF file of the firmware that produced the log")
+    parser.add_argument("log", nargs="?", default="-",
+                        help="File with the raw log data, for instance captured with JLinkRTTLogger. "
+                             "Reads from stdin if omitted.")
+    args = parser.parse_args()
+
+    with open(args.elf, "rb") as elf_file:
+        image = FirmwareImage(elf_file)
+
+    if args.log == "-":
+        stream = sys.stdin.buffer if hasattr(sys.stdin, "buffer") else sys.stdin
+        decode(image, stream, sys.stdout)
+    else:
+        with open(args.log, "rb") as stream:
+            decode(image, stream, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()